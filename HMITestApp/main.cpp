@@ -8,19 +8,94 @@
  *  - Toggle telltale states
  *
  * The data is sent over ZMQ and consumed by the main application.
+ *
+ * With --replay <file> the application runs headless instead and
+ * publishes the frames of a capture file on tcp://*:5555 with their
+ * recorded timing, so the real HMI can be driven by field traffic.
  */
 
 #include <QGuiApplication>
 #include <QQmlApplicationEngine>
 #include <QQmlContext>
+#include <QCommandLineParser>
+#include <QTimer>
+#include <QDebug>
+#include <cstring>
 #include "zmqpublisher.h"
 #include "zmqsubscriber.h"
+#include "replayframesource.h"
+
+/**
+ * @brief Delay before the first replayed frame, in ms.
+ *
+ * Gives already running subscribers time to connect to the new PUB
+ * socket (ZMQ slow joiner), so the start of the capture is not lost.
+ */
+static constexpr int REPLAY_SETTLE_MS = 1000;
 
+/**
+ * @brief Publishes a capture file on the frame port and exits when done.
+ *
+ * @param app Application instance.
+ * @param parser Parsed command line with the replay options.
+ * @return Exit code.
+ */
+static int runReplay(QGuiApplication &app, const QCommandLineParser &parser)
+{
+    zmq::context_t context(1);
+    zmq::socket_t publisher(context, zmq::socket_type::pub);
+    publisher.bind("tcp://*:5555");
+
+    ReplayFrameSource replay(parser.value("replay"));
+    replay.setSpeed(parser.value("replay-speed").toDouble());
+    replay.setLoop(parser.isSet("replay-loop"));
+    replay.setStartOffsetMs(qint64(parser.value("replay-start").toDouble() * 1000.0));
+
+    // Runs on the replay thread, the only user of the socket after bind
+    replay.setFrameHandler([&publisher](uint32_t id, const QByteArray &payload) {
+        char frame[12];
+        memcpy(frame, &id, sizeof(id));
+        memcpy(frame + 4, payload.constData(), 8);
+        publisher.send(zmq::buffer(frame, sizeof(frame)), zmq::send_flags::dontwait);
+    });
+
+    QObject::connect(&replay, &ReplayFrameSource::finished,
+                     &app, &QCoreApplication::quit, Qt::QueuedConnection);
+
+    int exitCode = 0;
+    QTimer::singleShot(REPLAY_SETTLE_MS, &app, [&]() {
+        if (!replay.start()) {
+            qCritical() << "[REPLAY] Cannot open" << replay.path() << ":" << replay.errorString();
+            exitCode = 1;
+            app.quit();
+            return;
+        }
+        qDebug() << "[REPLAY] Publishing" << replay.path() << "on tcp://*:5555";
+    });
+
+    app.exec();
+    replay.stop();
+    qDebug() << "[REPLAY] Frames published:" << replay.framesDelivered();
+    return exitCode;
+}
 
 int main(int argc, char *argv[])
 {
     QGuiApplication app(argc, argv);
 
+    QCommandLineParser parser;
+    parser.addHelpOption();
+    parser.addOptions({
+        { "replay", "Publish capture <file> headless instead of showing the UI.", "file" },
+        { "replay-speed", "Replay speed factor, 0 = as fast as possible (default 1).", "factor", "1" },
+        { "replay-loop", "Restart the replay after the last frame." },
+        { "replay-start", "Start the replay <seconds> into the capture.", "seconds", "0" }
+    });
+    parser.process(app);
+
+    if (parser.isSet("replay"))
+        return runReplay(app, parser);
+
     QQmlApplicationEngine engine;
 
     /**
@@ -1,7 +1,8 @@
 #include "zmqpublisher.h"
 #include <QByteArray>
+#include <QCoreApplication>
 #include <QDebug>
-#include<QSettings>
+#include "settingsservice.h"
 
 /**
  * @enum GaugeType
@@ -29,6 +30,24 @@ ZmqPublisher::ZmqPublisher(QObject *parent)
 
     qDebug() << "[ZMQ PUB] Bound to tcp://*:5555";
     qDebug() << "[ZMQ PUB] Restored Engine Hours =" << m_engineHours;
+
+    connect(&m_rateTimer, &QTimer::timeout, this, &ZmqPublisher::rebroadcastRates);
+    m_rateTimer.start(RATE_BROADCAST_INTERVAL_MS);
+}
+
+void ZmqPublisher::sendFrame(const QByteArray &frame)
+{
+    zmq::message_t msg(frame.size());
+    memcpy(msg.data(), frame.data(), frame.size());
+    m_publisher.send(msg, zmq::send_flags::none);
+}
+
+void ZmqPublisher::rebroadcastRates()
+{
+    for (const QByteArray *frame : { &m_fuelRateFrame, &m_defRateFrame, &m_engineLoadFrame }) {
+        if (!frame->isEmpty())
+            sendFrame(*frame);
+    }
 }
 
 void ZmqPublisher::publishRPM(int rpm)
@@ -180,9 +199,8 @@ void ZmqPublisher::publishFuelRate(float value)
     frame.append(reinterpret_cast<char*>(&id), 4);
     frame.append(payload);
 
-    zmq::message_t msg(frame.size());
-    memcpy(msg.data(), frame.data(), frame.size());
-    m_publisher.send(msg, zmq::send_flags::none);
+    m_fuelRateFrame = frame;
+    sendFrame(frame);
 
     qDebug() << "[PUB] Fuel Rate =" << QString::number(value, 'f', 1);
 }
@@ -204,9 +222,8 @@ void ZmqPublisher :: publishDefRate(float value){
     frame.append(reinterpret_cast<char*>(&id), 4);
     frame.append(payload);
 
-    zmq::message_t msg(frame.size());
-    memcpy(msg.data(), frame.data(), frame.size());
-    m_publisher.send(msg, zmq::send_flags::none);
+    m_defRateFrame = frame;
+    sendFrame(frame);
 
     qDebug() << "[PUB] Def Rate =" << QString::number(value, 'f', 1);
 }
@@ -227,23 +244,37 @@ void ZmqPublisher::publishAvgEngineLoad(int percent)
     frame.append(reinterpret_cast<const char*>(&id), sizeof(id));
     frame.append(payload);
 
-    zmq::message_t msg(frame.size());
-    memcpy(msg.data(), frame.data(), frame.size());
-
-    m_publisher.send(msg, zmq::send_flags::none);
+    m_engineLoadFrame = frame;
+    sendFrame(frame);
 
     qDebug() << "[PUB] Avg Engine Load" << percent << "%";
 }
 
-#include <QSettings>
+/**
+ * @brief Publisher settings, loaded once.
+ *
+ * Slider moves only update memory; the file is written in the background
+ * once the slider rests, and on aboutToQuit, while the application still
+ * exists (the destructor only runs during static destruction).
+ */
+static SettingsService &publisherSettings()
+{
+    static SettingsService settings("NextGen", "TestPublisher");
+    static const bool flushOnQuit = []() {
+        QCoreApplication *app = QCoreApplication::instance();
+        if (app)
+            QObject::connect(app, &QCoreApplication::aboutToQuit, []() { settings.flush(); });
+        return app != nullptr;
+    }();
+    Q_UNUSED(flushOnQuit);
+    return settings;
+}
 
 void ZmqPublisher::loadEngineHours()
 
 {
 
-    QSettings s("NextGen", "TestPublisher");
-
-    m_engineHours = s.value("EngineHours", 0.0).toFloat();
+    m_engineHours = publisherSettings().value("EngineHours", 0.0).toFloat();
 
     if (m_engineHours < 0.0f) m_engineHours = 0.0f;
 
@@ -255,9 +286,7 @@ void ZmqPublisher::saveEngineHours()
 
 {
 
-    QSettings s("NextGen", "TestPublisher");
-
-    s.setValue("EngineHours", m_engineHours);
+    publisherSettings().setValue("EngineHours", m_engineHours);
 
 }
 
@@ -12,6 +12,7 @@
  */
 
 #include <QObject>
+#include <QTimer>
 #include <zmq.hpp>
 
 /**
@@ -20,6 +21,17 @@
  */
 #define CAN_ID_FUEL_LEVEL   0xDE004000
 
+/**
+ * @def RATE_BROADCAST_INTERVAL_MS
+ * @brief Repetition period of the fuel rate, DEF rate and engine load frames.
+ *
+ * A J1939 ECU broadcasts these signals every 100 ms whether they change or
+ * not, and the trip computer integrates only between consecutive frames.
+ * Sending them on slider changes alone would stop the integration once
+ * the slider rests.
+ */
+#define RATE_BROADCAST_INTERVAL_MS 100
+
 /**
  * @class ZmqPublisher
  * @brief Publishes RPM and telltale CAN frames via ZMQ.
@@ -90,7 +102,18 @@ public slots:
 
     void publishAvgEngineLoad(int percent);
 
+private slots:
+    /**
+     * @brief Sends the latest fuel rate, DEF rate and engine load frames again.
+     */
+    void rebroadcastRates();
+
 private:
+    /**
+     * @brief Sends one frame (4-byte id followed by the payload).
+     */
+    void sendFrame(const QByteArray &frame);
+
     /**
      * @brief ZMQ context used for publisher socket.
      */
@@ -103,6 +126,13 @@ private:
      */
     zmq::socket_t  m_publisher;
 
+    /**
+     * @brief Latest rate frames, repeated by m_rateTimer; empty until set.
+     */
+    QByteArray m_fuelRateFrame;
+    QByteArray m_defRateFrame;
+    QByteArray m_engineLoadFrame;
+    QTimer m_rateTimer;
 
     float m_engineHours = 0.0f;
     void loadEngineHours();
@@ -11,11 +11,8 @@ ZmqSubscriber::ZmqSubscriber(QObject *parent)
             this, &ZmqSubscriber::startZmqSubscriber,
             Qt::DirectConnection);
 
-    m_queueTimer = new QTimer(this);
-    connect(m_queueTimer, &QTimer::timeout,
-            this, &ZmqSubscriber::processQueue);
-    m_queueTimer->start(5);
-
+    // No polling timer: the receive loop posts processQueue() when
+    // the queue turns non-empty.
     m_zmqThread.start();
 }
 
@@ -50,26 +47,29 @@ void ZmqSubscriber::startZmqSubscriber()
         QByteArray payload(
             static_cast<char*>(msg.data()) + 4, 8);
 
+        bool wasEmpty;
         {
             QMutexLocker locker(&m_queueMutex);
+            wasEmpty = m_frameQueue.isEmpty();
             m_frameQueue.enqueue({id, payload});
         }
+
+        if (wasEmpty)
+            QMetaObject::invokeMethod(this, &ZmqSubscriber::processQueue, Qt::QueuedConnection);
     }
 }
 
 void ZmqSubscriber::processQueue()
 {
-    QPair<uint32_t, QByteArray> frame;
+    QQueue<QPair<uint32_t, QByteArray>> frames;
 
     {
         QMutexLocker locker(&m_queueMutex);
-        if (m_frameQueue.isEmpty())
-            return;
-
-        frame = m_frameQueue.dequeue();
+        frames.swap(m_frameQueue);
     }
 
-    processFrame(frame.first, frame.second);
+    for (const auto &frame : std::as_const(frames))
+        processFrame(frame.first, frame.second);
 }
 
 
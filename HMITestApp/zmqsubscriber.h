@@ -17,7 +17,6 @@
 #include <QQueue>
 #include <QPair>
 #include <QMutex>
-#include <QTimer>
 #include <QByteArray>
 #include <zmq.hpp>
 
@@ -126,9 +125,10 @@ private slots:
     void startZmqSubscriber();
 
     /**
-     * @brief Processes queued CAN frames on Qt event loop.
+     * @brief Processes all queued CAN frames on Qt event loop.
      *
-     * Ensures thread-safe frame handling.
+     * Posted by the receive thread when the queue turns
+     * non-empty. Ensures thread-safe frame handling.
      */
     void processQueue();
 
@@ -156,11 +156,6 @@ private:
      */
     QThread m_zmqThread;
 
-    /**
-     * @brief Timer to process queued frames periodically.
-     */
-    QTimer *m_queueTimer {nullptr};
-
     /**
      * @brief Thread-safe queue holding received frames.
      */
@@ -0,0 +1,177 @@
+#ifndef ALARMCHANNEL_H
+#define ALARMCHANNEL_H
+/**
+ * @file alarmchannel.h
+ * @brief Declaration of the AlarmChannel alarm delivery pipeline.
+ *
+ * Alarms (qCCritical(_alarm_), category "alarm.global") must reach their
+ * consumer quickly even while the normal log path is saturated. The
+ * AlarmChannel therefore shares nothing with it: post() copies the alarm
+ * into the channel's own bounded lock-free queue and returns, and a
+ * dedicated worker thread at time-critical priority hands each alarm to
+ * the consumer. Neither side takes the log mutex or waits for the log
+ * queue, so the time from post() to delivery is bounded by the worker's
+ * wake-up time plus the consumer's own run time.
+ *
+ * Every delivery is timed from post() to the consumer's return. stats()
+ * reports the counts and the latency percentiles of the last
+ * LATENCY_WINDOW alarms; deliveries slower than the deadline are
+ * counted as misses.
+ *
+ * @date 18-Oct-2026
+ * @author Gangadhar Thalange
+ */
+
+#include <QString>
+#include <QThread>
+#include <QVariantMap>
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <vector>
+#include "mpscqueue.h"
+#include "logcontext.h"
+
+class AlarmChannel
+{
+public:
+    static constexpr int DEFAULT_CAPACITY = 256;
+    static constexpr int LATENCY_WINDOW = 1024;
+    static constexpr qint64 DEFAULT_DEADLINE_US = 10000;
+
+    /**
+     * @struct Alarm
+     * @brief One alarm message with its origin.
+     */
+    struct Alarm {
+        qint64 utcMs = 0;           /**< Time of the call, ms since epoch (UTC) */
+        qint64 postedNs = 0;        /**< now() at post(), set by post() */
+        LogContext context;         /**< Where the alarm was raised */
+        QString message;            /**< Alarm text */
+    };
+
+    /**
+     * @struct Stats
+     * @brief Counters and delivery latency of the channel.
+     */
+    struct Stats {
+        quint64 posted = 0;         /**< Alarms accepted by post() */
+        quint64 delivered = 0;      /**< Alarms handed to the consumer */
+        quint64 dropped = 0;        /**< Alarms rejected because the queue was full */
+        quint64 deadlineMisses = 0; /**< Deliveries slower than the deadline */
+        qint64 deadlineUs = 0;      /**< Deadline in force */
+        qint64 p50Us = 0;           /**< Median latency of the last LATENCY_WINDOW deliveries */
+        qint64 p99Us = 0;           /**< 99th percentile of the same */
+        qint64 maxUs = 0;           /**< Slowest delivery since start() */
+
+        /**
+         * @brief Converts the stats to a map for QML/diagnostics.
+         */
+        QVariantMap toVariantMap() const;
+    };
+
+    /**
+     * @brief Receives each alarm on the worker thread.
+     */
+    using Consumer = std::function<void(const Alarm &alarm)>;
+
+    /**
+     * @brief Constructs a stopped channel.
+     * @param capacity Queued alarms before post() drops (rounded up to a power of two).
+     */
+    explicit AlarmChannel(int capacity = DEFAULT_CAPACITY);
+
+    /**
+     * @brief Destructor. Stops the worker after delivering queued alarms.
+     */
+    ~AlarmChannel();
+
+    AlarmChannel(const AlarmChannel &) = delete;
+    AlarmChannel &operator=(const AlarmChannel &) = delete;
+
+    /**
+     * @brief Sets the consumer. Must be called while the channel is stopped.
+     */
+    void setConsumer(Consumer consumer);
+
+    /**
+     * @brief Sets the latency above which a delivery counts as a miss.
+     */
+    void setDeadlineUs(qint64 deadlineUs);
+
+    /**
+     * @brief Starts the worker thread. Does nothing if it is running.
+     */
+    void start();
+
+    /**
+     * @brief Delivers the queued alarms and stops the worker thread.
+     */
+    void stop();
+
+    bool isRunning() const { return m_thread.isRunning(); }
+
+    /**
+     * @brief Queues @p alarm for delivery. Safe from any thread.
+     *
+     * Never blocks on the consumer. While the channel is stopped the
+     * alarm is delivered on the calling thread instead.
+     *
+     * @return false if the queue was full and the alarm was dropped.
+     */
+    bool post(Alarm &&alarm);
+
+    /**
+     * @brief Returns the counters and latency percentiles.
+     */
+    Stats stats() const;
+
+    /**
+     * @brief Monotonic clock used for latencies, in ns.
+     */
+    static qint64 now();
+
+private:
+    /**
+     * @brief Worker loop: delivers alarms until stop().
+     */
+    void run();
+
+    /**
+     * @brief Calls the consumer and records the latency.
+     */
+    void deliver(const Alarm &alarm);
+
+    void wake();
+
+    MpscQueue<Alarm> m_queue;
+    Consumer m_consumer;
+    QThread m_thread;
+
+    std::atomic<bool> m_stop{false};
+    std::atomic<bool> m_sleeping{false};
+    std::atomic<quint64> m_posted{0};
+    std::atomic<quint64> m_delivered{0};
+    std::atomic<quint64> m_dropped{0};
+    std::atomic<quint64> m_deadlineMisses{0};
+    std::atomic<qint64> m_deadlineUs{DEFAULT_DEADLINE_US};
+    std::mutex m_wakeMutex;
+    std::condition_variable m_wakeCondition;
+
+    /**
+     * @brief Serializes deliveries made without the worker (stopped channel).
+     */
+    std::mutex m_deliverMutex;
+
+    /**
+     * @brief Latencies of the last deliveries, in µs (protected by m_statsMutex).
+     */
+    mutable std::mutex m_statsMutex;
+    std::vector<qint64> m_latencies;
+    size_t m_latencyNext = 0;
+    qint64 m_maxUs = 0;
+};
+
+#endif // ALARMCHANNEL_H
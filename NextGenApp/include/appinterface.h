@@ -19,11 +19,17 @@
 #include <QMutex>
 #include <QByteArray>
 #include <QQueue>
-#include <QThread>
-#include <QTimer>
 #include <zmq.hpp>
 #include <QDateTime>
 #include<QString>
+#include <QPointer>
+#include <QVariantMap>
+#include "scheduler.h"
+#include "zmqreceiver.h"
+#include "capturerecorder.h"
+#include "tripjournal.h"
+#include "tripcomputer.h"
+#include "signalgraph.h"
 
 
 class AppInterface : public QObject
@@ -55,7 +61,7 @@ class AppInterface : public QObject
      * @brief .
      *
      * This property represents the current time
-     * QML updates time automatically with currentTimeChanged for every second.
+     * QML updates time automatically with currentTimeChanged on every minute boundary.
      */
     Q_PROPERTY(QString currentTime READ currentTime NOTIFY currentTimeChanged)
 
@@ -83,7 +89,8 @@ class AppInterface : public QObject
      * @property fuelUsage
      * @brief Current fuel usage  value for UI.
      *
-     * This property represents the Total amount of fuel consumed. its computed based on fuel rate and trip hours,
+     * This property represents the Total amount of fuel consumed since the last reset, integrated
+     * over time from the fuel rate by the TripComputer and published once per second.
      * QML updates automatically when fuelUsageChanged() is emitted.
      */
     Q_PROPERTY(float fuelUsage READ fuelUsage WRITE setFuelUsage NOTIFY fuelUsageChanged FINAL)
@@ -119,7 +126,8 @@ class AppInterface : public QObject
      * @property defUsage
      * @brief  Volume of DEF used for the trip since last reset
      *
-     * This property represents the Volume of DEF used for the trip since last reset
+     * This property represents the Volume of DEF used for the trip since last reset, integrated
+     * over time from the DEF rate by the TripComputer and published once per second.
      * QML updates automatically when defUsageChanged() is emitted.
      */
     Q_PROPERTY(float defUsage READ defUsage WRITE setDefUsage NOTIFY defUsageChanged FINAL)
@@ -128,7 +136,9 @@ class AppInterface : public QObject
      * @property avgEngineLoad
      * @brief  Average load on engine in % terms
      *
-     * This property represents the Average load on engine in % terms computed based on trip hours and Current Instantaneous engine load
+     * This property represents the Average load on engine in % terms, time-weighted over the
+     * TripComputer engine load window ("TripComputer/engineLoadWindowMs", default 10 minutes)
+     * and published once per second.
      * QML updates automatically when avgEngineLoadChanged() is emitted.
      */
     Q_PROPERTY(int avgEngineLoad READ avgEngineLoad WRITE setAvgEngineLoad NOTIFY avgEngineLoadChanged FINAL)
@@ -306,6 +316,72 @@ public:
      */
     Q_INVOKABLE void setCreepActive(bool active);
 
+    /**
+     * @brief Returns runtime diagnostics for service screens.
+     *
+     * Contains the effective ingest thread settings under "ingestThread"
+     * (CPU, scheduling policy, priority, memory lock and any settings
+     * that could not be applied), the capture state (active, path,
+     * records, dropped) under "capture", the logger state (async,
+     * dropped, rotations, suppressed) under "log", the trip computer
+     * results (usage, averages, frames, gaps) under "tripComputer" and
+     * the trip journal state (open, path, writes, restoreUs) under
+     * "tripJournal".
+     *
+     * @return Diagnostics map.
+     */
+    Q_INVOKABLE QVariantMap diagnostics() const;
+
+    /**
+     * @brief Returns the most recent log messages for the service screen.
+     *
+     * Served from the logger's in-memory ring, without file I/O. Each
+     * entry is a map with "time" (QDateTime, UTC), "level", "module",
+     * "thread" and "message".
+     *
+     * @param maxEntries Maximum number of messages.
+     * @return Messages, oldest first.
+     */
+    Q_INVOKABLE QVariantList recentLogEntries(int maxEntries) const;
+
+    /**
+     * @brief Starts recording all received messages to a capture file.
+     *
+     * @param path Capture file path; overwritten if it exists.
+     * @return True if recording started.
+     */
+    Q_INVOKABLE bool startCapture(const QString &path);
+
+    /**
+     * @brief Stops recording and closes the capture file.
+     */
+    Q_INVOKABLE void stopCapture();
+
+    /**
+     * @brief Replaces the source frames are decoded from.
+     *
+     * Stops the current source, installs the frame handler on the new one
+     * and starts it. Used to feed a capture replay instead of the live
+     * ZMQ stream. The source is not owned; if it is destroyed, frames
+     * simply stop.
+     *
+     * @param source New frame source, or nullptr for the live receiver.
+     * @return True if the new source started.
+     */
+    bool setFrameSource(FrameSource *source);
+
+    /**
+     * @brief Keeps the trip and usage counters in the journal @p path.
+     *
+     * Restores the last reset date, last trip hours, fuel usage and DEF
+     * usage saved there, then saves every change of them. Without a
+     * journal the counters start from LAST_RESET_DATE and zero.
+     *
+     * @param path Journal file; created if it does not exist.
+     * @return True if the journal is open.
+     */
+    bool openTripJournal(const QString &path);
+
     /**
      * @brief Destructor.
      *
@@ -493,32 +569,42 @@ private:
      * @brief Initializes ZMQ communication infrastructure.
      *
      * This function:
-     *  - Sets up a worker object in a dedicated QThread
-     *  - Creates and configures a ZMQ SUB socket
-     *  - Continuously receives frames and enqueues them
+     *  - Configures the ingest thread and the capture tap
+     *  - Makes the ZmqReceiver the frame source and starts it
      *
      * No UI updates are performed directly here.
      */
     void initZmq();
 
     /**
-     * @brief Entry point for ZMQ subscriber thread.
+     * @brief Queues a received frame for the UI thread.
+     *
+     * Called on the ingest thread for every valid frame.
      *
-     * Creates ZMQ context and SUB socket, subscribes
-     * to backend publisher and continuously receives
-     * CAN-like frames for processing.
+     * @param id Frame identifier.
+     * @param payload Raw 8-byte payload.
+     * @param timeNs Frame time from the source, or FrameSource::NO_TIMESTAMP.
      */
-    void startZmqSubscriber();
+    void enqueueFrame(uint32_t id, const QByteArray &payload, qint64 timeNs);
 
     /**
-     * @brief Processes queued frames periodically.
+     * @brief Processes all queued frames.
      *
-     * Called by a QTimer running in the UI thread.
-     * Dequeues one frame at a time and forwards it
+     * Posted to the UI thread by the ZMQ thread whenever the
+     * queue turns non-empty, so nothing runs while no frames
+     * arrive. Drains the whole queue and forwards each frame
      * to processFrame() for decoding.
      */
     void processQueue();
 
+    /**
+     * @brief Refreshes the currentTime property from the wall clock.
+     *
+     * Registered with the Scheduler on minute boundaries, which is
+     * the resolution of the "hh:mm AP" display format.
+     */
+    void updateCurrentTime();
+
     /**
      * @brief Decodes a single received frame.
      *
@@ -539,22 +625,58 @@ private:
     void processFrame(uint32_t id, const QByteArray &payload);
 
 private:
+    /**
+     * @brief Queues the current trip and usage counters for the journal.
+     *
+     * Called on every change of them; cheap enough for bus-rate frames,
+     * the journal writes at most once per interval.
+     */
+    void journalTripState();
 
     /**
-     * @brief Dedicated thread for ZMQ receiving.
+     * @brief Declares the derived values in m_signals.
+     */
+    void initSignals();
+
+    /**
+     * @brief Copies the trip computer results to the fuelUsage, defUsage
+     *        and avgEngineLoad properties.
      *
-     * Keeps blocking socket operations away
-     * from the UI thread.
+     * Runs on the Scheduler at TRIP_PUBLISH_INTERVAL_MS; emits only the
+     * signals of values that changed.
+     */
+    void publishTripResults();
+
+    /**
+     * @brief Saves the trip and usage counters across restarts.
      */
-    QThread m_zmqThread;
+    TripJournal m_tripJournal;
 
     /**
-     * @brief Timer used to process frame queue.
+     * @brief Set while restored counters are applied one by one.
+     */
+    bool m_restoringTrip = false;
+
+    /**
+     * @brief Records received messages on request.
+     *
+     * Declared before m_receiver, which taps into it, so it is
+     * destroyed after the ingest thread.
+     */
+    CaptureRecorder m_capture;
+
+    /**
+     * @brief Ingest thread receiving frames from the backend.
      *
-     * Runs in the main/UI thread to safely
-     * update Qt properties and emit signals.
+     * Keeps socket operations away from the UI thread
+     * and stops within milliseconds on destruction.
+     */
+    ZmqReceiver m_receiver;
+
+    /**
+     * @brief Source currently feeding enqueueFrame().
      */
-    QTimer* m_queueTimer{nullptr};
+    QPointer<FrameSource> m_source;
 
     /**
      * @brief Queue holding received frames.
@@ -631,18 +753,42 @@ private:
     float m_engineHours = 0.0f;
 
     QString m_currentTime;
-    QTimer* m_timeTimer = nullptr;
 
+    /**
+     * @brief Scheduler task refreshing currentTime every full minute.
+     */
+    Scheduler::TaskId m_clockTask = 0;
 
     /**
-     * @brief Current fuel rate value exposed to UI.
+     * @brief Scheduler task publishing the trip computer results.
      */
-    float m_fuelRate=0.0f;
+    Scheduler::TaskId m_tripTask = 0;
 
     /**
-     * @brief actualFuelRate value for calculating fuel usage.
+     * @brief Integrates fuel and DEF usage and averages engine load.
+     *
+     * Fed on the frame source's thread in enqueueFrame(); read by
+     * publishTripResults() on the UI thread.
      */
-    float actualFuelRate = 0.0f;
+    TripComputer m_tripComputer;
+
+    /**
+     * @brief Derived values (tripHours) and the inputs they depend on.
+     *
+     * Inputs are set where they are decoded or written; derived values
+     * are recomputed once per update cycle (a frame batch or a setter
+     * call) and notify only when they changed.
+     */
+    SignalGraph m_signals;
+    SignalGraph::SignalId m_engineHoursSignal = -1;
+    SignalGraph::SignalId m_lastTripHoursSignal = -1;
+    SignalGraph::SignalId m_tripHoursSignal = -1;
+
+
+    /**
+     * @brief Current fuel rate value exposed to UI.
+     */
+    float m_fuelRate=0.0f;
 
     /**
      * @brief Current fuel usage value exposed to UI.
@@ -0,0 +1,268 @@
+#ifndef BINLOG_H
+#define BINLOG_H
+/**
+ * @file binlog.h
+ * @brief Binary log sink for hot-path messages and the NG_BINLOG() macro.
+ *
+ * NG_BINLOG() takes a logging category, a message type and a printf
+ * format with its arguments:
+ *
+ * @code
+ * NG_BINLOG(lcFrames, QtDebugMsg, "Safety Button Index: %d State: %d", index, pressed);
+ * @endcode
+ *
+ * Each call site registers its format string once (a function-local
+ * static) and gets a format ID. When the category is selected for binary
+ * logging (BinLog::setBinary()), a call only appends the ID, a time stamp
+ * and the raw arguments to a per-thread buffer; no text is formatted.
+ * Buffers are written to the binary file in chunks. Otherwise the message
+ * goes through the normal Qt message handler and cLogger's text sink.
+ *
+ * tools/binlog_decode turns binary files back into the text lines cLogger
+ * writes (see BinLogReader). Arguments must be numbers, enums, pointers
+ * or C strings (use qUtf8Printable() for QString). A disabled category
+ * costs the same single branch as qCDebug(). Message types below
+ * NG_LOG_MIN_LEVEL (see logtrace.h) are compiled out.
+ *
+ * Binary messages bypass cLogger, so they are neither folded into
+ * "previous message repeats" lines nor rate limited.
+ *
+ * @date 18-Oct-2026
+ * @author Gangadhar Thalange
+ */
+
+#include <QLoggingCategory>
+#include <QString>
+#include <QStringList>
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <type_traits>
+#include "binlogformat.h"
+#include "logtrace.h"
+
+/**
+ * @brief Per-thread record buffer, flushed to the file as one chunk.
+ */
+struct BinLogBuffer
+{
+    std::mutex mutex;           ///< Owner appends, BinLog::flush() drains
+    std::string data;           ///< Encoded records of the current chunk
+    int64_t baseUs = 0;         ///< Time of the first record in data
+    int64_t lastUs = 0;         ///< Time of the last record in data
+    std::string threadName;
+};
+
+/**
+ * @brief A registered NG_BINLOG() call site.
+ */
+class BinLogSite
+{
+public:
+    template <typename... Args>
+    BinLogSite(const char *category, QtMsgType type, const char *file, int line,
+               const char *function, const char *format, const Args &...)
+        : category(category), type(type), file(file), line(line), function(function),
+          format(format), signature(signatureOf<Args...>())
+    {
+        registerSite();
+    }
+
+    BinLogSite(const BinLogSite &) = delete;
+    BinLogSite &operator=(const BinLogSite &) = delete;
+
+    /**
+     * @brief Returns whether calls go to the binary sink.
+     */
+    bool isBinary() const { return binary.load(std::memory_order_relaxed); }
+
+    /**
+     * @brief Returns the signature code of one argument type.
+     */
+    template <typename T>
+    static constexpr char typeCode()
+    {
+        using U = std::decay_t<T>;
+        if constexpr (std::is_same<U, bool>::value)
+            return 'u';
+        else if constexpr (std::is_enum<U>::value)
+            return std::is_signed<std::underlying_type_t<U>>::value ? 'i' : 'u';
+        else if constexpr (std::is_integral<U>::value)
+            return std::is_signed<U>::value ? 'i' : 'u';
+        else if constexpr (std::is_floating_point<U>::value)
+            return 'd';
+        else if constexpr (std::is_same<U, const char *>::value || std::is_same<U, char *>::value)
+            return 's';
+        else if constexpr (std::is_pointer<U>::value)
+            return 'p';
+        else
+            static_assert(std::is_pointer<U>::value,
+                          "NG_BINLOG arguments must be numbers, enums, pointers or C strings");
+        return '?';
+    }
+
+    const char *const category;
+    const QtMsgType type;
+    const char *const file;
+    const int line;
+    const char *const function;
+    const char *const format;
+    const char *const signature;
+    uint32_t id = 0;                    ///< Assigned by registerSite()
+    std::atomic<bool> binary{false};    ///< Updated by BinLog::setBinary()
+
+private:
+    template <typename... Args>
+    static const char *signatureOf()
+    {
+        static const char signature[] = { typeCode<Args>()..., '\0' };
+        return signature;
+    }
+
+    void registerSite();
+};
+
+class BinLog
+{
+public:
+    /**
+     * @brief Sets the binary log file; an empty path closes it.
+     *
+     * The file is appended to. A session block and the formats of all
+     * sites registered so far are written first. While no file is set,
+     * all sites log as text.
+     */
+    static void setPath(const QString &path);
+
+    /**
+     * @brief Returns the binary log file path, empty if none.
+     */
+    static QString path();
+
+    /**
+     * @brief Selects categories (name prefixes, as for log levels) for binary logging.
+     *
+     * @param categoryPrefix Category name or prefix ("ngapp.frames").
+     * @param binary true to log the category in binary form.
+     */
+    static void setBinary(const QString &categoryPrefix, bool binary);
+
+    /**
+     * @brief Replaces the set of binary categories.
+     */
+    static void setBinaryCategories(const QStringList &categoryPrefixes);
+
+    /**
+     * @brief Sets the size at which the file is moved to `<path>.1`.
+     */
+    static void setMaxFileSize(qint64 bytes);
+
+    /**
+     * @brief Writes the buffered records of all threads to the file.
+     */
+    static void flush();
+
+    /**
+     * @brief Returns the number of binary records written since start-up.
+     */
+    static quint64 recordCount();
+
+    /**
+     * @brief Appends one record for @p site to the calling thread's buffer.
+     */
+    template <typename... Args>
+    static void write(const BinLogSite &site, const char *, const Args &... args)
+    {
+        BinLogBuffer &buffer = threadBuffer();
+        std::lock_guard<std::mutex> lock(buffer.mutex);
+        const int64_t nowUs = currentTimeUs();
+        if (buffer.data.empty())
+            buffer.baseUs = buffer.lastUs = nowUs;
+        BinLogFormat::putVarint(buffer.data, site.id);
+        BinLogFormat::putVarint(buffer.data, BinLogFormat::zigzag(nowUs - buffer.lastUs));
+        buffer.lastUs = nowUs;
+        (putArg(buffer.data, args), ...);
+        s_records.fetch_add(1, std::memory_order_relaxed);
+        if (buffer.data.size() >= BinLogFormat::CHUNK_BYTES)
+            writeChunk(buffer);
+    }
+
+    /**
+     * @brief Logs the message of @p site as text through the Qt message handler.
+     *
+     * Without arguments the format is logged as it is, as the decoder does.
+     */
+    template <typename... Args>
+    static void writeText(const BinLogSite &site, const char *format, const Args &... args)
+    {
+        QMessageLogger logger(site.file, site.line, site.function, site.category);
+        if constexpr (sizeof...(Args) == 0) {
+            writeText(logger, site.type, "%s", format);
+        } else {
+            writeText(logger, site.type, format, args...);
+        }
+    }
+
+private:
+    template <typename... Args>
+    static void writeText(const QMessageLogger &logger, QtMsgType type, const char *format, const Args &... args)
+    {
+        switch (type) {
+        case QtInfoMsg:     logger.info(format, args...); break;
+        case QtWarningMsg:  logger.warning(format, args...); break;
+        case QtCriticalMsg: logger.critical(format, args...); break;
+        default:            logger.debug(format, args...); break;
+        }
+    }
+
+    template <typename T>
+    static void putArg(std::string &out, const T &value)
+    {
+        using U = std::decay_t<T>;
+        constexpr char code = BinLogSite::typeCode<U>();
+        if constexpr (code == 'd') {
+            const double number = double(value);
+            BinLogFormat::putFixed(out, &number, sizeof(number));
+        } else if constexpr (code == 's') {
+            const char *text = value ? value : "(null)";
+            BinLogFormat::putString(out, text, strlen(text));
+        } else if constexpr (code == 'p') {
+            BinLogFormat::putVarint(out, uint64_t(reinterpret_cast<uintptr_t>(value)));
+        } else if constexpr (code == 'i') {
+            BinLogFormat::putVarint(out, BinLogFormat::zigzag(int64_t(value)));
+        } else {
+            BinLogFormat::putVarint(out, uint64_t(value));
+        }
+    }
+
+    static BinLogBuffer &threadBuffer();
+    static int64_t currentTimeUs();
+    static void writeChunk(BinLogBuffer &buffer);
+
+    static std::atomic<quint64> s_records;
+};
+
+/**
+ * @brief Logs a printf-style message, in binary form if its category is selected.
+ *
+ * @param category Logging category function (from Q_LOGGING_CATEGORY).
+ * @param type QtDebugMsg, QtInfoMsg, QtWarningMsg or QtCriticalMsg (a constant).
+ * @param ... Format string literal followed by its arguments.
+ */
+#define NG_BINLOG(category, type, ...) \
+    do { \
+        if constexpr (NgLog::compiledIn(type)) { \
+            const QLoggingCategory &ngBinLogCategory_ = category(); \
+            if (ngBinLogCategory_.isEnabled(type)) { \
+                static BinLogSite ngBinLogSite_(ngBinLogCategory_.categoryName(), type, \
+                                                __FILE__, __LINE__, Q_FUNC_INFO, __VA_ARGS__); \
+                if (ngBinLogSite_.isBinary()) \
+                    BinLog::write(ngBinLogSite_, __VA_ARGS__); \
+                else \
+                    BinLog::writeText(ngBinLogSite_, __VA_ARGS__); \
+            } \
+        } \
+    } while (false)
+
+#endif // BINLOG_H
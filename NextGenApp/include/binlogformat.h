@@ -0,0 +1,140 @@
+#ifndef BINLOGFORMAT_H
+#define BINLOGFORMAT_H
+/**
+ * @file binlogformat.h
+ * @brief On-disk layout of binary log files (<log>.bin).
+ *
+ * A binary log file is a FileHeader followed by blocks. Every block
+ * starts with a BlockHeader (tag and payload length):
+ *
+ * @code
+ * FileHeader
+ * Block TAG_SESSION   process start: forget all format IDs seen so far
+ * Block TAG_FORMAT    format ID -> category, level, file, line, function,
+ *                     printf format and argument signature
+ * Block TAG_CHUNK     base time (int64 us since epoch, UTC), thread name,
+ *                     then records of one thread
+ * ...
+ * @endcode
+ *
+ * A record is the varint format ID, the zigzag varint time difference in
+ * us to the previous record of the chunk (the first one to the base
+ * time), and the arguments in signature order:
+ *
+ * | Code | Argument                       | Encoding                  |
+ * |------|--------------------------------|---------------------------|
+ * | i    | signed integer, enum           | zigzag varint             |
+ * | u    | unsigned integer, bool         | varint                    |
+ * | d    | float, double                  | 8 bytes IEEE 754          |
+ * | s    | C string                       | varint length, UTF-8 bytes|
+ * | p    | pointer                        | varint                    |
+ *
+ * Format IDs are assigned per process; a TAG_FORMAT block is always
+ * written before the first chunk that uses the ID. Fixed-size fields are
+ * little-endian, as written by the target platform.
+ *
+ * @date 18-Oct-2026
+ * @author Gangadhar Thalange
+ */
+
+#include <cstdint>
+#include <cstring>
+#include <string>
+
+namespace BinLogFormat {
+
+/**
+ * @brief File magic, first 8 bytes of every binary log file.
+ */
+static constexpr char MAGIC[8] = { 'N', 'G', 'B', 'I', 'N', 'L', 'G', '\0' };
+
+/**
+ * @brief Current format version.
+ */
+static constexpr uint32_t VERSION = 1;
+
+/**
+ * @brief Block tags.
+ */
+enum BlockTag : uint32_t {
+    TAG_SESSION = 0x53534553,   /**< "SESS" */
+    TAG_FORMAT = 0x544D5246,    /**< "FRMT" */
+    TAG_CHUNK = 0x4B4E4843      /**< "CHNK" */
+};
+
+/**
+ * @struct FileHeader
+ * @brief Start of every binary log file.
+ */
+struct FileHeader {
+    char magic[8];          /**< MAGIC */
+    uint32_t version;       /**< VERSION */
+    uint32_t reserved;      /**< Zero */
+};
+
+static_assert(sizeof(FileHeader) == 16, "FileHeader layout is part of the file format");
+
+/**
+ * @struct BlockHeader
+ * @brief Start of every block.
+ */
+struct BlockHeader {
+    uint32_t tag;           /**< BlockTag */
+    uint32_t length;        /**< Payload bytes following the header */
+};
+
+static_assert(sizeof(BlockHeader) == 8, "BlockHeader layout is part of the file format");
+
+/**
+ * @brief Records of one thread are written as a chunk once it reaches this size.
+ */
+static constexpr size_t CHUNK_BYTES = 16 * 1024;
+
+inline void putVarint(std::string &out, uint64_t value)
+{
+    while (value >= 0x80) {
+        out.push_back(char(uint8_t(value) | 0x80));
+        value >>= 7;
+    }
+    out.push_back(char(value));
+}
+
+inline uint64_t zigzag(int64_t value)
+{
+    return (uint64_t(value) << 1) ^ uint64_t(value >> 63);
+}
+
+inline int64_t unzigzag(uint64_t value)
+{
+    return int64_t(value >> 1) ^ -int64_t(value & 1);
+}
+
+inline void putFixed(std::string &out, const void *value, size_t size)
+{
+    out.append(static_cast<const char *>(value), size);
+}
+
+inline void putString(std::string &out, const char *text, size_t length)
+{
+    putVarint(out, length);
+    out.append(text, length);
+}
+
+/**
+ * @brief Reads a varint at @p pos; returns false if it runs past @p end.
+ */
+inline bool getVarint(const uint8_t *&pos, const uint8_t *end, uint64_t &value)
+{
+    value = 0;
+    for (int shift = 0; shift < 64 && pos < end; shift += 7) {
+        const uint8_t byte = *pos++;
+        value |= uint64_t(byte & 0x7F) << shift;
+        if (!(byte & 0x80))
+            return true;
+    }
+    return false;
+}
+
+} // namespace BinLogFormat
+
+#endif // BINLOGFORMAT_H
@@ -0,0 +1,89 @@
+#ifndef BINLOGREADER_H
+#define BINLOGREADER_H
+/**
+ * @file binlogreader.h
+ * @brief Decoder for binary log files written by BinLog.
+ *
+ * BinLogReader reads one or more binary log files (see binlogformat.h),
+ * expands every record with its printf format and returns the entries in
+ * time order. formatLine() renders an entry exactly like the line cLogger
+ * would have written for the same message in text form.
+ *
+ * A file cut off in the middle of a block (the process died while
+ * writing) is read up to the last complete block.
+ *
+ * @date 18-Oct-2026
+ * @author Gangadhar Thalange
+ */
+
+#include <QByteArray>
+#include <QString>
+#include <QVector>
+#include "logformat.h"
+
+class BinLogReader
+{
+public:
+    /**
+     * @brief One decoded message.
+     */
+    struct Entry
+    {
+        qint64 utcUs = 0;           ///< Time of the call, us since epoch (UTC)
+        QtMsgType type = QtDebugMsg;
+        QByteArray category;
+        QByteArray file;
+        int line = 0;
+        QByteArray function;
+        QByteArray threadName;
+        QByteArray message;         ///< Formatted message text, UTF-8
+    };
+
+    /**
+     * @brief Reads all records of @p path and adds them to entries().
+     * @return false if the file cannot be read or is no binary log file.
+     */
+    bool read(const QString &path);
+
+    /**
+     * @brief Removes all entries.
+     */
+    void clear() { m_entries.clear(); }
+
+    /**
+     * @brief Returns the entries read so far, ordered by time.
+     */
+    const QVector<Entry> &entries() const { return m_entries; }
+
+    /**
+     * @brief Returns whether the last read() stopped at a truncated block.
+     */
+    bool truncated() const { return m_truncated; }
+
+    /**
+     * @brief Returns the reason the last read() failed.
+     */
+    QString errorString() const { return m_errorString; }
+
+    /**
+     * @brief Returns @p entry as cLogger's text line, without the newline.
+     */
+    QByteArray formatLine(const Entry &entry);
+
+    /**
+     * @brief Formats @p format like printf from the encoded arguments at @p pos.
+     *
+     * @param signature Argument codes (binlogformat.h), one per argument.
+     * @return false if the arguments run past @p end.
+     */
+    static bool formatMessage(const char *format, const char *signature,
+                              const uint8_t *&pos, const uint8_t *end, QByteArray &out);
+
+private:
+    QVector<Entry> m_entries;
+    QString m_errorString;
+    bool m_truncated = false;
+    LogLineFormatter m_line;
+};
+
+#endif // BINLOGREADER_H
@@ -0,0 +1,126 @@
+#ifndef CAPTUREFORMAT_H
+#define CAPTUREFORMAT_H
+/**
+ * @file captureformat.h
+ * @brief On-disk layout of ingest capture files (*.ngcap).
+ *
+ * A capture file consists of one header page followed by fixed-size
+ * records in arrival order:
+ *
+ * @code
+ * offset 0          CaptureHeader (CAPTURE_HEADER_SIZE bytes)
+ * offset 4096       CaptureRecord[0], CaptureRecord[1], ...
+ * @endcode
+ *
+ * Records are written in segments of CaptureHeader::segmentRecords
+ * entries. The header stores the timestamp of the first record of every
+ * segment, so a reader locates a point in time by a binary search over
+ * the segment index followed by one inside the segment, without scanning
+ * the file. CaptureHeader::recordCount is updated after every written
+ * batch; records beyond it (preallocated space or an interrupted write)
+ * are ignored by readers.
+ *
+ * All fields are little-endian, as written by the target platform.
+ *
+ * @date 18-Oct-2026
+ * @author Gangadhar Thalange
+ */
+
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+namespace Capture {
+
+/**
+ * @brief File magic, first 8 bytes of every capture file.
+ */
+static constexpr char MAGIC[8] = { 'N', 'G', 'C', 'A', 'P', 'T', 'R', '\0' };
+
+/**
+ * @brief Current format version.
+ */
+static constexpr uint32_t VERSION = 1;
+
+/**
+ * @brief Size of the header page; records start at this offset.
+ */
+static constexpr uint32_t CAPTURE_HEADER_SIZE = 4096;
+
+/**
+ * @brief Default number of records per segment (24 MiB).
+ */
+static constexpr uint32_t DEFAULT_SEGMENT_RECORDS = 1u << 20;
+
+/**
+ * @brief Payload bytes stored per record.
+ */
+static constexpr uint32_t PAYLOAD_SIZE = 8;
+
+/**
+ * @enum RecordFlag
+ * @brief Flags describing how the received message differed from a frame.
+ */
+enum RecordFlag : uint8_t {
+    FlagShort = 0x01,     /**< Message was shorter than id + 8 payload bytes */
+    FlagTruncated = 0x02  /**< Message was longer; extra bytes not stored */
+};
+
+/**
+ * @struct CaptureRecord
+ * @brief One received message.
+ */
+struct CaptureRecord {
+    uint64_t tNs;                    /**< Receive time, ns since capture start (monotonic) */
+    uint32_t id;                     /**< Frame identifier */
+    uint8_t length;                  /**< Valid payload bytes (0..8) */
+    uint8_t flags;                   /**< RecordFlag bits */
+    uint16_t reserved;               /**< Zero */
+    uint8_t payload[PAYLOAD_SIZE];   /**< Payload bytes */
+};
+
+static_assert(sizeof(CaptureRecord) == 24, "CaptureRecord layout is part of the file format");
+static_assert(std::is_trivially_copyable<CaptureRecord>::value, "CaptureRecord is copied raw");
+
+/**
+ * @brief Number of segment index entries that fit into the header page.
+ */
+static constexpr uint32_t MAX_SEGMENTS = (CAPTURE_HEADER_SIZE - 64) / sizeof(uint64_t);
+
+/**
+ * @struct CaptureHeader
+ * @brief Header page at the start of every capture file.
+ */
+struct CaptureHeader {
+    char magic[8];                        /**< MAGIC */
+    uint32_t version;                     /**< VERSION */
+    uint32_t headerSize;                  /**< CAPTURE_HEADER_SIZE */
+    uint32_t recordSize;                  /**< sizeof(CaptureRecord) */
+    uint32_t segmentRecords;              /**< Records per segment */
+    uint64_t recordCount;                 /**< Committed records */
+    uint64_t droppedCount;                /**< Frames lost because the writer fell behind */
+    int64_t startWallMs;                  /**< Wall clock at capture start, ms since epoch */
+    uint32_t segmentCount;                /**< Valid entries in segmentFirstNs */
+    uint32_t reserved0;                   /**< Zero */
+    uint64_t reserved1;                   /**< Zero */
+    uint64_t segmentFirstNs[MAX_SEGMENTS]; /**< tNs of the first record of each segment */
+};
+
+static_assert(sizeof(CaptureHeader) == CAPTURE_HEADER_SIZE, "CaptureHeader must fill the header page");
+
+/**
+ * @brief Returns true if @p header describes a file this build can read.
+ */
+inline bool isValidHeader(const CaptureHeader &header)
+{
+    return memcmp(header.magic, MAGIC, sizeof(MAGIC)) == 0
+        && header.version == VERSION
+        && header.headerSize == CAPTURE_HEADER_SIZE
+        && header.recordSize == sizeof(CaptureRecord)
+        && header.segmentRecords > 0
+        && header.segmentCount <= MAX_SEGMENTS;
+}
+
+} // namespace Capture
+
+#endif // CAPTUREFORMAT_H
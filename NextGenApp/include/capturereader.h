@@ -0,0 +1,92 @@
+#ifndef CAPTUREREADER_H
+#define CAPTUREREADER_H
+/**
+ * @file capturereader.h
+ * @brief Declaration of the CaptureReader class.
+ *
+ * CaptureReader memory-maps a capture file written by CaptureRecorder and
+ * gives random access to its records. Seeking by time uses the segment
+ * index in the header followed by a binary search inside one segment, so
+ * it costs O(log n) regardless of the file size.
+ *
+ * @date 18-Oct-2026
+ * @author Gangadhar Thalange
+ */
+
+#include <QFile>
+#include <QString>
+#include "captureformat.h"
+
+class CaptureReader
+{
+public:
+    CaptureReader() = default;
+    ~CaptureReader();
+
+    CaptureReader(const CaptureReader &) = delete;
+    CaptureReader &operator=(const CaptureReader &) = delete;
+
+    /**
+     * @brief Opens and maps a capture file.
+     *
+     * Files still being written can be opened; only records committed in
+     * the header are visible.
+     *
+     * @param path Capture file path.
+     * @return false if the file cannot be mapped or is not a capture file.
+     */
+    bool open(const QString &path);
+
+    /**
+     * @brief Unmaps and closes the file.
+     */
+    void close();
+
+    /**
+     * @brief Returns whether a capture file is open.
+     */
+    bool isOpen() const { return m_header != nullptr; }
+
+    /**
+     * @brief Returns the reason of the last failed open().
+     */
+    QString errorString() const { return m_error; }
+
+    /**
+     * @brief Returns the header of the open file.
+     */
+    const Capture::CaptureHeader &header() const { return *m_header; }
+
+    /**
+     * @brief Returns the number of readable records.
+     */
+    quint64 recordCount() const { return m_count; }
+
+    /**
+     * @brief Returns record @p index; must be below recordCount().
+     */
+    const Capture::CaptureRecord &record(quint64 index) const { return m_records[index]; }
+
+    /**
+     * @brief Returns the timestamp of the last record in ns, 0 if empty.
+     */
+    quint64 durationNs() const { return m_count ? m_records[m_count - 1].tNs : 0; }
+
+    /**
+     * @brief Returns the index of the first record at or after @p tNs.
+     *
+     * @param tNs Time in ns since capture start.
+     * @return Record index; recordCount() if @p tNs is past the end.
+     */
+    quint64 indexAtTime(quint64 tNs) const;
+
+private:
+    QFile m_file;
+    uchar *m_data = nullptr;
+    const Capture::CaptureHeader *m_header = nullptr;
+    const Capture::CaptureRecord *m_records = nullptr;
+    quint64 m_count = 0;
+    QString m_error;
+};
+
+#endif // CAPTUREREADER_H
@@ -0,0 +1,211 @@
+#ifndef CAPTURERECORDER_H
+#define CAPTURERECORDER_H
+/**
+ * @file capturerecorder.h
+ * @brief Declaration of the CaptureRecorder class.
+ *
+ * CaptureRecorder writes every message received by the ingest thread to a
+ * binary capture file (see captureformat.h) so that field issues can be
+ * reproduced with exactly the traffic the HMI saw. The ingest thread only
+ * timestamps the message and pushes a fixed-size record into a
+ * preallocated SPSC ring and wakes the background writer thread if it is
+ * idle; the writer copies the records into memory-mapped, preallocated
+ * file segments. Frames that do not fit
+ * into the ring are counted as dropped instead of blocking the receiver.
+ *
+ * @date 18-Oct-2026
+ * @author Gangadhar Thalange
+ */
+
+#include <QObject>
+#include <QThread>
+#include <QFile>
+#include <QMutex>
+#include <QString>
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include "captureformat.h"
+#include "spscring.h"
+
+class CaptureRecorder : public QObject
+{
+    Q_OBJECT
+public:
+    /**
+     * @brief Default ring capacity, ~0.6 s of traffic at 100k frames/s.
+     */
+    static constexpr quint32 DEFAULT_RING_CAPACITY = 1u << 16;
+
+    /**
+     * @brief Constructs an idle recorder.
+     *
+     * The ring is allocated here so that record() never allocates.
+     *
+     * @param ringCapacity Records buffered between ingest and writer thread.
+     * @param segmentRecords Records per preallocated file segment.
+     * @param parent Optional QObject parent.
+     */
+    explicit CaptureRecorder(quint32 ringCapacity = DEFAULT_RING_CAPACITY,
+                             quint32 segmentRecords = Capture::DEFAULT_SEGMENT_RECORDS,
+                             QObject *parent = nullptr);
+
+    /**
+     * @brief Destructor. Stops an active capture.
+     */
+    ~CaptureRecorder();
+
+    /**
+     * @brief Creates @p path and starts recording into it.
+     *
+     * An existing file is overwritten.
+     *
+     * @param path Capture file path.
+     * @return false if already recording or the file cannot be created.
+     */
+    bool start(const QString &path);
+
+    /**
+     * @brief Stops recording, writes all pending records and closes the file.
+     *
+     * The file is truncated to its committed records.
+     */
+    void stop();
+
+    /**
+     * @brief Returns whether a capture is running.
+     */
+    bool isActive() const { return m_active.load(std::memory_order_acquire); }
+
+    /**
+     * @brief Records one received message.
+     *
+     * Called from the ingest thread (single producer). Never allocates and
+     * only takes a mutex, briefly, to wake an idle writer; does nothing
+     * while no capture is running.
+     *
+     * @param data Raw message bytes (4-byte id followed by the payload).
+     * @param size Message size in bytes.
+     */
+    void record(const void *data, size_t size);
+
+    /**
+     * @brief Returns the path of the current or last capture.
+     */
+    QString path() const;
+
+    /**
+     * @brief Returns the number of records written in the current capture.
+     */
+    quint64 recordedCount() const { return m_recorded.load(std::memory_order_relaxed); }
+
+    /**
+     * @brief Returns the number of frames dropped in the current capture.
+     */
+    quint64 droppedCount() const { return m_dropped.load(std::memory_order_relaxed); }
+
+private:
+    /**
+     * @brief Writer loop executed on the writer thread.
+     */
+    void run();
+
+    /**
+     * @brief Wakes the writer thread if it waits for records.
+     */
+    void wakeWriter();
+
+    /**
+     * @brief Moves all queued records into the file.
+     * @return Number of records written.
+     */
+    quint64 drain();
+
+    /**
+     * @brief Preallocates and maps segment @p index.
+     * @return false if the segment cannot be allocated.
+     */
+    bool openSegment(quint32 index);
+
+    /**
+     * @brief Truncates the file to its committed records and closes it.
+     */
+    void closeFile();
+
+    /**
+     * @brief Records handed from the ingest thread to the writer.
+     */
+    SpscRing<Capture::CaptureRecord> m_ring;
+
+    /**
+     * @brief Records per file segment.
+     */
+    quint32 m_segmentRecords;
+
+    /**
+     * @brief Capture file.
+     */
+    QFile m_file;
+
+    /**
+     * @brief Mapped header page.
+     */
+    Capture::CaptureHeader *m_header = nullptr;
+
+    /**
+     * @brief Mapped current segment.
+     */
+    Capture::CaptureRecord *m_segment = nullptr;
+
+    /**
+     * @brief Index of the mapped segment.
+     */
+    quint32 m_segmentIndex = 0;
+
+    /**
+     * @brief Records written into the mapped segment.
+     */
+    quint32 m_segmentFill = 0;
+
+    /**
+     * @brief Monotonic time of capture start in ns.
+     */
+    std::atomic<qint64> m_startNs{0};
+
+    /**
+     * @brief Set while record() accepts frames.
+     */
+    std::atomic<bool> m_active{false};
+
+    /**
+     * @brief Set once the file has no room left; further frames are dropped.
+     */
+    bool m_full = false;
+
+    std::atomic<quint64> m_recorded{0};
+    std::atomic<quint64> m_dropped{0};
+
+    /**
+     * @brief Set while the writer waits on m_wakeCondition.
+     */
+    std::atomic<bool> m_writerSleeping{false};
+
+    /**
+     * @brief Wakes the idle writer thread.
+     */
+    std::mutex m_wakeMutex;
+    std::condition_variable m_wakeCondition;
+
+    /**
+     * @brief Protects m_path.
+     */
+    mutable QMutex m_pathMutex;
+    QString m_path;
+
+    /**
+     * @brief Background writer thread.
+     */
+    QThread m_thread;
+};
+
+#endif // CAPTURERECORDER_H
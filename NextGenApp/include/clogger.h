@@ -9,7 +9,8 @@
  * function and line). It also declares the cLogger singleton class
  * which provides application-wide logging facilities, including a
  * custom message handler, log file management and previous-message
- * buffering.
+ * buffering. Messages can be written synchronously by the logging
+ * thread or handed to a dedicated writer thread (asynchronous mode).
  *
  * @date 08-Dec-2025
  * @author Gangadhar Thalange
@@ -17,7 +18,13 @@
  
 #include <QObject>
 #include <QLoggingCategory>
+#include <QStringList>
+#include <QVariantMap>
+#include <functional>
 #include "commonlib_global.h"
+#include "logbatch.h"
+#include "alarmchannel.h"
+#include "logcontext.h"
 
 /**
   * @class LogMessageContext
@@ -51,6 +58,17 @@ public:
                            QString file, QString function, qint32 line,
                            QObject *parent=0);
 
+    /**
+     * @brief Constructs a LogMessageContext from a LogContext.
+     *
+     * Used where a context crosses into QML; elsewhere pass the
+     * LogContext itself.
+     *
+     * @param context Source context.
+     * @param parent QObject parent (optional).
+     */
+    explicit LogMessageContext(const LogContext &context, QObject *parent=0);
+
     /**
      * @brief Copy constructor.
      * @param other Source context to copy.
@@ -162,6 +180,28 @@ class COMMONSHARED_EXPORT cLogger : public QObject
             WRITE setPreviousMessageBufferSize)
     Q_PROPERTY(QString logFilePath READ logFilePath WRITE setLogFilePath)
 public:
+    /**
+     * @enum OverflowPolicy
+     * @brief Behaviour of the asynchronous backend when its queue is full.
+     */
+    enum OverflowPolicy {
+        OverflowDrop = 0,   /**< Discard the message and count it (never blocks) */
+        OverflowBlock       /**< Wait until the writer thread has made room */
+    };
+    Q_ENUM(OverflowPolicy)
+
+    /**
+     * @struct LogEntry
+     * @brief A recent log message as returned by recentEntries().
+     */
+    struct LogEntry {
+        qint64 utcMs = 0;               /**< Time of the message, ms since epoch (UTC) */
+        QtMsgType type = QtDebugMsg;    /**< Message level */
+        QString module;                 /**< "App" or "QML" */
+        QString thread;                 /**< Name of the logging thread */
+        QString message;                /**< Text, with source location for warnings and above */
+    };
+
     /**
      * @brief Returns the global cLogger instance.
      * @return Reference to the singleton instance.
@@ -170,10 +210,17 @@ public:
 
     /**
      * @brief Initialize logger resources (e.g., open log file).
+     *
+     * Logging options are read from the application settings ("logAsync",
+     * "logRateLimit", "logFlightRecorderBytes", ...). @p settingDefaults
+     * supplies the program's defaults for keys the settings do not
+     * contain, so a unit's configuration can still change every option.
+     *
      * @param fileName Path to the log file to use.
+     * @param settingDefaults Values for settings keys that are not set.
      * @return true on successful initialization; false otherwise.
      */
-    bool init(QString fileName);
+    bool init(QString fileName, const QVariantMap &settingDefaults = QVariantMap());
 
     /**
      * @brief Qt message handler to route Qt log messages through cLogger.
@@ -192,7 +239,9 @@ public:
      * @brief Set minimum logging level for a module.
      *
      * Messages below the specified minLevel for the (optional) module
-     * will be ignored.
+     * will be ignored. A module is a logging category name prefix (e.g.
+     * "qml" or "ngapp.ingest"); the change applies immediately to all
+     * categories (see LogCategoryFilter).
      *
      * @param minLevel Minimum Qt message severity to accept.
      * @param module Optional module name to limit the level to (empty for global).
@@ -236,19 +285,55 @@ public:
     QString logFilePath() const;
 
     /**
-     * @brief Returns a copy of the buffered previous messages.
-     * @return List of previous log messages.
+     * @brief Returns the most recent log messages.
+     *
+     * Same as tail(previousMessageBufferSize()): full lines as written to
+     * the log file. recentEntries() serves truncated messages from memory
+     * without reading the file.
+     *
+     * @return List of previous log messages, oldest first.
      */
     QList<QString> previousMessages() const;
 
+    /**
+     * @brief Returns the most recent messages as structured entries.
+     *
+     * Every written message is also kept in a fixed ring of the last 1024
+     * messages (texts longer than 200 bytes are truncated). Reading it
+     * never blocks logging threads and does no file I/O, so it can be
+     * polled by service screens.
+     *
+     * @param maxEntries Maximum number of entries (at most 1024).
+     * @return Entries, oldest first.
+     */
+    QList<LogEntry> recentEntries(int maxEntries) const;
+
+    /**
+     * @brief Returns the last @p count lines of the log.
+     *
+     * Reads backwards from the end of the live log file through a
+     * read-only mapping and continues into the previous generation
+     * (`<log>.1`) when the live file is shorter. The cost is proportional
+     * to the lines returned; the file used for logging is left untouched.
+     * Safe to call from any thread.
+     *
+     * @param count Number of lines to return.
+     * @return Lines in file order, oldest first.
+     */
+    QList<QString> tail(int count) const;
+
     /**
      * @brief Returns previous messages starting at a given time.
      *
-     * Retrieves up to maxMessages messages that occurred at or after start.
+     * Retrieves up to maxMessages messages of the live log file that
+     * occurred after start. The position is found through the sparse time
+     * index kept in `<log>.idx`, so the cost does not depend on the size
+     * of the file and logging is not blocked while the lines are read.
      *
      * @param start Start time for filtering messages.
      * @param maxMessages Maximum number of messages to return.
-     * @param reverse If true, messages are returned in reverse chronological order.
+     * @param reverse If true, the last maxMessages messages at or before
+     *        start are returned instead (still in chronological order).
      * @return List of matching log messages.
      */
     QList<QString> previousMessages(const QDateTime &start, int maxMessages, bool reverse) const;
@@ -277,20 +362,228 @@ public:
      */
     static void clearLogTypes();
 
+    /**
+     * @brief Enables or disables asynchronous logging.
+     *
+     * In asynchronous mode the message handler only copies the message
+     * into a bounded lock-free queue; a dedicated writer thread formats
+     * and writes the messages in batches. Disabling flushes the queue and
+     * stops the writer thread. Fatal messages are always written
+     * synchronously after the queue has been flushed.
+     *
+     * @param enabled True for asynchronous mode.
+     */
+    void setAsync(bool enabled);
+
+    /**
+     * @brief Returns whether asynchronous logging is enabled.
+     */
+    bool isAsync() const;
+
+    /**
+     * @brief Sets what happens when the asynchronous queue is full.
+     * @param policy Drop (default) or block the logging thread.
+     */
+    void setOverflowPolicy(OverflowPolicy policy);
+
+    /**
+     * @brief Returns the asynchronous queue overflow policy.
+     */
+    OverflowPolicy overflowPolicy() const;
+
+    /**
+     * @brief Sets the capacity of the asynchronous queue.
+     *
+     * Takes effect only before asynchronous mode is enabled for the
+     * first time; the queue is never reallocated afterwards.
+     *
+     * @param capacity Number of messages (rounded up to a power of two).
+     */
+    void setQueueCapacity(int capacity);
+
+    /**
+     * @brief Returns the number of messages dropped because the
+     *        asynchronous queue was full.
+     */
+    quint64 droppedMessageCount() const;
+
+    /**
+     * @brief Limits the messages logged per call site (file:line and category).
+     *
+     * A message identical to the last one logged from the same call site
+     * within a second is suppressed; other messages pass a token bucket
+     * of @p burst messages refilled at @p messagesPerSecond. Suppressed
+     * messages are reported as "(N messages suppressed from file:line)"
+     * at most once a second and on flush(). Fatal messages and alarms are
+     * never limited. Off by default.
+     *
+     * @param messagesPerSecond Sustained rate per call site, 0 to disable.
+     * @param burst Messages a quiet call site may log at once.
+     */
+    void setRateLimit(int messagesPerSecond, int burst = 50);
+
+    /**
+     * @brief Returns the number of messages suppressed by the rate limit.
+     */
+    quint64 suppressedMessageCount() const;
+
+    /**
+     * @brief Sets the alarm delivery time counted as a miss in alarmStats().
+     *
+     * @param microseconds Deadline from qCCritical(_alarm_) to the return
+     *        of the postAlarmMessage receivers (default 10 ms).
+     */
+    void setAlarmDeadline(qint64 microseconds);
+
+    /**
+     * @brief Returns the counters and delivery latency of alarms.
+     *
+     * Alarms (qCCritical(_alarm_)) do not go through the log queue or the
+     * log lock: they are queued on their own AlarmChannel and delivered
+     * by its time-critical thread (see alarmchannel.h), so a saturated
+     * log path does not delay them.
+     */
+    AlarmChannel::Stats alarmStats() const;
+
+    /**
+     * @brief Logs NG_BINLOG() messages of these categories in binary form.
+     *
+     * Selected messages are written to `<log>.bin` without being formatted
+     * (see binlog.h); tools/binlog_decode turns them back into log lines.
+     * The binary file is only created while categories are selected.
+     *
+     * @param categoryPrefixes Category names or prefixes ("ngapp.frames").
+     */
+    void setBinaryCategories(const QStringList &categoryPrefixes);
+
+    /**
+     * @brief Keeps the last lines in a crash-surviving ring file next to the log.
+     *
+     * Every line is also copied into `<log>.ring`, a file of
+     * @p capacityBytes mapped into memory (see flightrecorder.h). Because
+     * the ring holds the latest lines after a crash, the log file is then
+     * flushed at most once a second instead of after every line. Read the
+     * ring with tools/flightrec_dump.
+     *
+     * @param capacityBytes Ring size, 0 to stop recording.
+     */
+    void setFlightRecorder(qint64 capacityBytes);
+
+    /**
+     * @brief Serves the live log lines on a local Unix-domain socket.
+     *
+     * Local clients (tools/logstream_tail) connect to @p path, choose a
+     * level and modules, and receive the lines as they are written, from
+     * memory and not from the log file. Each client has a bounded buffer;
+     * lines a slow client cannot take are dropped for that client and
+     * reported to it, so clients never slow down logging. See
+     * logstreamserver.h for the protocol.
+     *
+     * @param path Socket path, empty to stop serving.
+     * @return false if the socket cannot be created.
+     */
+    bool setLogStreamSocket(const QString &path);
+
+    /**
+     * @brief Returns the socket set with setLogStreamSocket(), empty if none.
+     */
+    QString logStreamSocket() const;
+
+    /**
+     * @brief Receives a complete batch of log lines.
+     */
+    using LogBatchHandler = std::function<void(const LogBatchPtr &batch)>;
+
+    /**
+     * @brief Delivers the lines written from now on to @p handler in batches.
+     *
+     * A batch is complete at 256 lines, when its first line is 50 ms old
+     * (checked as lines arrive, and in synchronous mode by a timer in the
+     * thread that created the logger, which needs a running event loop),
+     * when the writer thread goes idle and on flush(). @p handler is then
+     * called through the event loop of @p context's thread, so the
+     * subscriber chooses the thread (move @p context to a consumer
+     * QThread to keep work off the GUI thread). No logger lock is held
+     * while batches are handed out or handled, and the handler may log.
+     * All subscribers share the same immutable batch.
+     *
+     * The subscription ends when @p context is destroyed or with
+     * unsubscribe(); batches already posted are still delivered.
+     *
+     * @return Subscription id for unsubscribe(), 0 if @p context or
+     *         @p handler is missing.
+     */
+    int subscribe(QObject *context, LogBatchHandler handler);
+
+    /**
+     * @brief Ends the subscription @p id.
+     */
+    void unsubscribe(int id);
+
+    /**
+     * @brief Configures log file rotation.
+     *
+     * The live file is rotated once the bytes written to it exceed
+     * @p rolloverBytes. Generation 1 (`<log>.1`) is plain text, older
+     * generations (`<log>.N.z`) are compressed with qCompress(). Renaming
+     * and compression run on a background thread. When @p diskBudgetBytes
+     * is set, the oldest compressed generations are deleted until the
+     * live file and all generations fit into it.
+     *
+     * @param rolloverBytes Live file size that triggers a rotation.
+     * @param generations Rotated files to keep (at least 1).
+     * @param diskBudgetBytes Total size limit in bytes, 0 for none.
+     */
+    void setLogRotation(qint64 rolloverBytes, int generations, qint64 diskBudgetBytes = 0);
+
+    /**
+     * @brief Returns the number of completed log rotations.
+     */
+    int rotationCount() const;
+
+    /**
+     * @brief Writes all queued messages and flushes the log file.
+     *
+     * Blocks until the writer thread has written every message queued
+     * before the call. Pending rate limit summaries are written first.
+     * Intended for exit and crash paths.
+     */
+    void flush();
+
 signals:
     /**
      * @brief Emitted when new log messages are available.
+     *
+     * Emitted once per completed batch (see subscribe()), without holding
+     * the log lock, on the thread that completed the batch.
+     *
      * @param msgs List of formatted log message strings.
      */
     void newLogMessages(const QList<QString> &msgs);
 
     /**
      * @brief Emitted when an alarm-level message is posted.
+     *
+     * Emitted on the alarm channel's thread (see alarmStats()); receivers
+     * in other threads should use a queued connection.
+     *
      * @param msg Alarm message text (formatted).
      * @param context Context information describing where the alarm originated.
      */
     void postAlarmMessage(const QString &msg, const LogMessageContext &context);
 
+    /**
+     * @brief Emitted for every alarm, with the context as a plain value.
+     *
+     * Same thread and timing as postAlarmMessage, which is only built
+     * and emitted while it has receivers (QML). C++ receivers should
+     * prefer this signal.
+     *
+     * @param msg Alarm message text.
+     * @param context Where the alarm originated.
+     */
+    void alarmRaised(const QString &msg, const LogContext &context);
+
 public slots:
 
     /**
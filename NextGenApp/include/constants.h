@@ -62,6 +62,7 @@ static constexpr const char* LOCAL_HOST_IP = "tcp://127.0.0.1:5555";
 static constexpr float FUEL_TANK_CAPACITY_L = 100.0f;
 static const QString LAST_RESET_DATE = "11/05/1998";
 static constexpr float FUEL_USAGE = 99999.0f;
+static constexpr int TRIP_PUBLISH_INTERVAL_MS = 1000;
 static constexpr int LEVEL1  = 12;
 static constexpr int LEVEL2  = 25;
 static constexpr int LEVEL3 = 37;
@@ -0,0 +1,126 @@
+#ifndef FLIGHTRECORDER_H
+#define FLIGHTRECORDER_H
+/**
+ * @file flightrecorder.h
+ * @brief Crash-surviving ring of the last log lines in a memory-mapped file.
+ *
+ * FlightRecorder keeps a fixed-size file (`<log>.ring`) mapped shared and
+ * copies every log line into it with plain memory stores. The pages
+ * belong to the kernel's page cache, so the lines survive a crash of the
+ * process without any system call per line; they do not survive a power
+ * loss. After a restart, read() (or tools/flightrec_dump) returns the
+ * lines oldest first.
+ *
+ * File layout:
+ *
+ * @code
+ * Header      HEADER_SIZE bytes: magic, version, capacity, write position
+ * Data area   capacity bytes of records, wrapping around
+ * @endcode
+ *
+ * A record is a RecordHeader followed by the line and padded to 8 bytes.
+ * The line is stored before its header, and the header carries a checksum
+ * of the line, so read() skips records torn by a crash and records partly
+ * overwritten by newer ones. Records are ordered by their sequence number.
+ *
+ * append() is not thread-safe; cLogger calls it under its log mutex.
+ *
+ * @date 18-Oct-2026
+ * @author Gangadhar Thalange
+ */
+
+#include <QByteArrayList>
+#include <QFile>
+#include <QString>
+#include <cstdint>
+
+class FlightRecorder
+{
+public:
+    static constexpr char MAGIC[8] = { 'N', 'G', 'F', 'L', 'T', 'R', 'C', '\0' };
+    static constexpr uint32_t VERSION = 1;
+    static constexpr uint32_t RECORD_MAGIC = 0x4C52464E;   // "NFRL"
+    static constexpr qint64 HEADER_SIZE = 4096;
+    static constexpr qint64 MIN_CAPACITY = 4096;
+
+    /**
+     * @struct Header
+     * @brief Start of the ring file.
+     */
+    struct Header {
+        char magic[8];              /**< MAGIC */
+        uint32_t version;           /**< VERSION */
+        uint32_t headerSize;        /**< HEADER_SIZE */
+        uint64_t capacity;          /**< Bytes in the data area */
+        uint64_t head;              /**< Offset of the next record in the data area */
+        uint64_t nextSequence;      /**< Sequence number of the next record */
+    };
+
+    /**
+     * @struct RecordHeader
+     * @brief Start of every record in the data area.
+     */
+    struct RecordHeader {
+        uint32_t magic;             /**< RECORD_MAGIC, written last */
+        uint32_t length;            /**< Line bytes following the header */
+        uint64_t sequence;          /**< Increases by one per record */
+        uint32_t checksum;          /**< FNV-1a of the line */
+        uint32_t reserved;          /**< Zero */
+    };
+
+    FlightRecorder() = default;
+    ~FlightRecorder();
+
+    FlightRecorder(const FlightRecorder &) = delete;
+    FlightRecorder &operator=(const FlightRecorder &) = delete;
+
+    /**
+     * @brief Maps @p path, creating or resizing it to @p capacityBytes of records.
+     *
+     * An existing ring of the same capacity is continued, so the lines from
+     * before a crash stay readable until they are overwritten.
+     *
+     * @return false if the file cannot be created or mapped.
+     */
+    bool open(const QString &path, qint64 capacityBytes);
+
+    /**
+     * @brief Unmaps and closes the file. The contents stay in the file.
+     */
+    void close();
+
+    bool isOpen() const { return m_header != nullptr; }
+
+    /**
+     * @brief Returns the path of the open ring file, empty if none.
+     */
+    QString path() const { return isOpen() ? m_file.fileName() : QString(); }
+
+    /**
+     * @brief Copies one line into the ring, overwriting the oldest lines.
+     *
+     * Lines longer than a quarter of the capacity are cut.
+     */
+    void append(const char *data, size_t length);
+
+    /**
+     * @brief Returns the lines of the ring file @p path, oldest first.
+     *
+     * @param path Ring file, also while another process has it open.
+     * @param errorString Set to the reason if the file cannot be read.
+     */
+    static QByteArrayList read(const QString &path, QString *errorString = nullptr);
+
+    /**
+     * @brief Returns the checksum stored with a line.
+     */
+    static uint32_t checksum(const char *data, size_t length);
+
+private:
+    QFile m_file;
+    Header *m_header = nullptr;
+    uchar *m_data = nullptr;
+    uint64_t m_capacity = 0;
+};
+
+#endif // FLIGHTRECORDER_H
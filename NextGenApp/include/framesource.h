@@ -0,0 +1,130 @@
+#ifndef FRAMESOURCE_H
+#define FRAMESOURCE_H
+/**
+ * @file framesource.h
+ * @brief Declaration of the FrameSource interface.
+ *
+ * A FrameSource delivers CAN-like frames (32-bit id plus 8-byte payload)
+ * to a frame handler from its own thread. AppInterface consumes frames
+ * through this interface, so the live ZMQ receiver (ZmqReceiver) and the
+ * capture file replay (ReplayFrameSource) are interchangeable.
+ *
+ * Sources that do not deliver frames as they arrive (a replay at another
+ * speed) pass the frame's own time stamp to a TimedFrameHandler, so time
+ * based consumers such as the trip computer do not depend on the pace.
+ *
+ * @date 18-Oct-2026
+ * @author Gangadhar Thalange
+ */
+
+#include <QObject>
+#include <QByteArray>
+#include <functional>
+#include <cstdint>
+#include <QtGlobal>
+
+class FrameSource : public QObject
+{
+    Q_OBJECT
+public:
+    /**
+     * @brief Callback invoked for each valid frame.
+     *
+     * Runs on the source's thread; implementations must be thread-safe
+     * with respect to the consumer of the frames.
+     *
+     * @param id Frame identifier (CAN/ZMQ ID).
+     * @param payload Raw 8-byte payload.
+     */
+    using FrameHandler = std::function<void(uint32_t id, const QByteArray &payload)>;
+
+    /**
+     * @brief Time stamp of frames delivered as they arrive; the consumer
+     *        uses its own arrival time.
+     */
+    static constexpr qint64 NO_TIMESTAMP = -1;
+
+    /**
+     * @brief Callback invoked for each valid frame with its time stamp.
+     *
+     * @param id Frame identifier (CAN/ZMQ ID).
+     * @param payload Raw 8-byte payload.
+     * @param timeNs Frame time in ns on the source's monotonic clock, or
+     *        NO_TIMESTAMP. The clock may restart (a looping replay).
+     */
+    using TimedFrameHandler = std::function<void(uint32_t id, const QByteArray &payload, qint64 timeNs)>;
+
+    explicit FrameSource(QObject *parent = nullptr) : QObject(parent) {}
+
+    /**
+     * @brief Sets the callback invoked for every frame.
+     *
+     * Replaces a handler set with setTimedFrameHandler(). Must be called
+     * before start().
+     *
+     * @param handler Frame callback.
+     */
+    void setFrameHandler(FrameHandler handler)
+    {
+        m_handler = std::move(handler);
+        m_timedHandler = TimedFrameHandler();
+    }
+
+    /**
+     * @brief Sets the callback invoked for every frame with its time stamp.
+     *
+     * Replaces a handler set with setFrameHandler(). Must be called
+     * before start().
+     *
+     * @param handler Frame callback.
+     */
+    void setTimedFrameHandler(TimedFrameHandler handler)
+    {
+        m_timedHandler = std::move(handler);
+        m_handler = FrameHandler();
+    }
+
+    /**
+     * @brief Starts delivering frames.
+     * @return false if the source is already running or cannot start.
+     */
+    virtual bool start() = 0;
+
+    /**
+     * @brief Stops delivering frames and joins the source's thread.
+     *
+     * No handler call is in progress or made once this returns.
+     */
+    virtual void stop() = 0;
+
+    /**
+     * @brief Returns whether the source's thread is running.
+     */
+    virtual bool isRunning() const = 0;
+
+protected:
+    /**
+     * @brief Passes a frame to whichever handler is set.
+     */
+    void deliverFrame(uint32_t id, const QByteArray &payload, qint64 timeNs = NO_TIMESTAMP) const
+    {
+        if (m_timedHandler)
+            m_timedHandler(id, payload, timeNs);
+        else if (m_handler)
+            m_handler(id, payload);
+    }
+
+    /**
+     * @brief Returns whether a handler is set.
+     */
+    bool hasFrameHandler() const { return m_handler || m_timedHandler; }
+
+private:
+    /**
+     * @brief Callbacks receiving frames; at most one is set.
+     */
+    FrameHandler m_handler;
+    TimedFrameHandler m_timedHandler;
+};
+
+#endif // FRAMESOURCE_H
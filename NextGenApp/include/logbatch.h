@@ -0,0 +1,131 @@
+#ifndef LOGBATCH_H
+#define LOGBATCH_H
+/**
+ * @file logbatch.h
+ * @brief Immutable batch of log lines handed to cLogger subscribers.
+ *
+ * cLogger collects the lines it writes into a LogBatch while subscribers
+ * exist and hands the batch out as a LogBatchPtr once it is complete.
+ * The batch is never changed afterwards, so every subscriber shares the
+ * same lines without copying them and without any lock.
+ *
+ * The lines are kept as the UTF-8 bytes written to the log file, one
+ * buffer per batch, followed by the logging category of each line;
+ * line(), lineString(), message() and category() convert on demand.
+ *
+ * @date 18-Oct-2026
+ * @author Gangadhar Thalange
+ */
+
+#include <QByteArray>
+#include <QString>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+class LogBatch
+{
+public:
+    /**
+     * @brief Position of one line in the batch buffer.
+     */
+    struct Line {
+        qint64 utcMs;               ///< Time of the message, ms since epoch (UTC)
+        QtMsgType type;             ///< Message level
+        uint32_t offset;            ///< Start of the formatted line
+        uint32_t length;            ///< Bytes of the line, without newline
+        uint32_t messageOffset;     ///< Bytes from the line start to the message text
+        uint32_t categoryOffset;    ///< Start of the logging category name
+        uint32_t categoryLength;    ///< Bytes of the category name
+    };
+
+    /**
+     * @brief Number of lines.
+     */
+    int size() const { return int(m_lines.size()); }
+
+    bool isEmpty() const { return m_lines.empty(); }
+
+    /**
+     * @brief Sequence number of the first line; consecutive batches continue it.
+     *
+     * A subscriber that sees a gap knows that lines were written while it
+     * was not subscribed.
+     */
+    quint64 firstSequence() const { return m_firstSequence; }
+
+    const Line &at(int index) const { return m_lines[size_t(index)]; }
+
+    /**
+     * @brief Returns line @p index as written to the log file (UTF-8).
+     *
+     * The bytes are not copied; the result is valid while the batch is.
+     */
+    QByteArray line(int index) const
+    {
+        const Line &entry = at(index);
+        return QByteArray::fromRawData(m_text.data() + entry.offset, int(entry.length));
+    }
+
+    /**
+     * @brief Returns line @p index as a QString.
+     */
+    QString lineString(int index) const
+    {
+        const Line &entry = at(index);
+        return QString::fromUtf8(m_text.data() + entry.offset, int(entry.length));
+    }
+
+    /**
+     * @brief Returns the message text of line @p index, without time stamp and level.
+     */
+    QString message(int index) const
+    {
+        const Line &entry = at(index);
+        return QString::fromUtf8(m_text.data() + entry.offset + entry.messageOffset,
+                                 int(entry.length - entry.messageOffset));
+    }
+
+    /**
+     * @brief Returns the logging category of line @p index ("default" for
+     *        plain qDebug()). Not copied, like line().
+     */
+    QByteArray category(int index) const
+    {
+        const Line &entry = at(index);
+        return QByteArray::fromRawData(m_text.data() + entry.categoryOffset, int(entry.categoryLength));
+    }
+
+    /**
+     * @brief Builder used by cLogger; adds one line.
+     */
+    void append(qint64 utcMs, QtMsgType type, const char *line, size_t length, size_t messageOffset,
+                const char *category, size_t categoryLength)
+    {
+        if (m_lines.empty())
+            m_text.reserve(length * 16);
+        const uint32_t offset = uint32_t(m_text.size());
+        m_lines.push_back({ utcMs, type, offset, uint32_t(length), uint32_t(messageOffset),
+                            offset + uint32_t(length), uint32_t(categoryLength) });
+        m_text.append(line, length);
+        m_text.append(category, categoryLength);
+    }
+
+    /**
+     * @brief Builder used by cLogger; sets firstSequence().
+     */
+    void setFirstSequence(quint64 sequence) { m_firstSequence = sequence; }
+
+private:
+    std::string m_text;
+    std::vector<Line> m_lines;
+    quint64 m_firstSequence = 0;
+};
+
+/**
+ * @brief A complete batch, shared by all subscribers.
+ */
+using LogBatchPtr = std::shared_ptr<const LogBatch>;
+
+#endif // LOGBATCH_H
@@ -0,0 +1,69 @@
+#ifndef LOGCATEGORIES_H
+#define LOGCATEGORIES_H
+/**
+ * @file logcategories.h
+ * @brief Declaration of the LogCategoryFilter per-module log levels.
+ *
+ * Minimum log levels are kept per module, where a module is a logging
+ * category name prefix ("qml", "alarm", "ngapp.ingest", ...), plus a
+ * global level for everything else. The levels are compiled into a flat,
+ * immutable table that is swapped atomically when a level changes.
+ *
+ * The table is applied through QLoggingCategory::installFilter(), which
+ * stores the result in each category's enabled flags. A disabled
+ * qCDebug(category) therefore costs a single branch at the call site and
+ * never builds its message; a disabled plain qDebug() is dropped by Qt
+ * before the cLogger message handler runs.
+ *
+ * @date 18-Oct-2026
+ * @author Gangadhar Thalange
+ */
+
+#include <QString>
+#include <QtGlobal>
+
+class LogCategoryFilter
+{
+public:
+    /**
+     * @brief Installs the category filter. Safe to call more than once.
+     *
+     * The previously installed filter (Qt's logging rules) still runs
+     * first; this filter can only disable further message types.
+     */
+    static void install();
+
+    /**
+     * @brief Sets the minimum level of a module and updates all categories.
+     *
+     * An empty @p module sets the global level and resets every module
+     * to it. Takes effect immediately for existing categories.
+     *
+     * @param module Category name prefix, empty for global.
+     * @param minLevel Least severe message type still logged.
+     */
+    static void setLevel(const QString &module, QtMsgType minLevel);
+
+    /**
+     * @brief Returns the level that applies to @p category.
+     *
+     * The longest module matching the category name (the name itself or
+     * a prefix followed by '.') wins, otherwise the global level applies.
+     */
+    static QtMsgType level(const char *category);
+
+    /**
+     * @brief Returns whether @p type passes the level of @p category.
+     */
+    static bool isEnabled(const char *category, QtMsgType type);
+
+    /**
+     * @brief Returns a rank that orders message types by severity.
+     *
+     * QtMsgType values are not ordered by severity (QtInfoMsg is 4), so
+     * levels are compared by rank: debug < info < warning < critical < fatal.
+     */
+    static int severity(QtMsgType type);
+};
+
+#endif // LOGCATEGORIES_H
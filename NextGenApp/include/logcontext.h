@@ -0,0 +1,76 @@
+#ifndef LOGCONTEXT_H
+#define LOGCONTEXT_H
+/**
+ * @file logcontext.h
+ * @brief Declaration of the LogContext value type.
+ *
+ * LogContext describes where a message came from (file, function, line,
+ * thread and module) in 24 bytes that are copied with memcpy. The strings
+ * are interned once per process: file and function are kept as pointers
+ * to interned copies, thread and module names as small IDs. Capturing a
+ * context on a hot path (alarms) therefore allocates nothing once the
+ * call site and thread have been seen.
+ *
+ * Interned strings live until the process exits, so only strings from a
+ * bounded set (source locations, thread and module names) should be
+ * interned.
+ *
+ * LogMessageContext, the QObject form used by QML and by
+ * cLogger::postAlarmMessage, is built from a LogContext only where it is
+ * needed.
+ *
+ * @date 18-Oct-2026
+ * @author Gangadhar Thalange
+ */
+
+#include <QMetaType>
+#include <QString>
+#include <type_traits>
+#include "commonlib_global.h"
+
+struct COMMONSHARED_EXPORT LogContext
+{
+    const char *file = "";          ///< Interned source file, never null
+    const char *function = "";      ///< Interned function name, never null
+    qint32 line = 0;                ///< Source line
+    quint16 threadId = 0;           ///< Interned thread name, see name()
+    quint16 moduleId = 0;           ///< Interned module name, see name()
+
+    /**
+     * @brief Captures a context for the calling thread.
+     *
+     * @param file Source file, may be a temporary (it is interned).
+     * @param function Function name, may be a temporary.
+     * @param line Source line.
+     * @param module Module name ("App", "QML").
+     */
+    static LogContext capture(const char *file, const char *function, int line, const char *module);
+
+    /**
+     * @brief Returns a process-lifetime copy of @p text.
+     *
+     * Equal strings give the same pointer; null gives "".
+     */
+    static const char *intern(const char *text);
+
+    /**
+     * @brief Returns the ID of @p name, adding it if new. 0 is the empty name.
+     */
+    static quint16 internName(const QString &name);
+
+    /**
+     * @brief Returns the name of @p id, empty if unknown.
+     */
+    static QString name(quint16 id);
+
+    QString threadName() const { return name(threadId); }
+    QString moduleName() const { return name(moduleId); }
+    QString fileName() const { return QString::fromUtf8(file); }
+    QString functionName() const { return QString::fromUtf8(function); }
+};
+
+static_assert(std::is_trivially_copyable<LogContext>::value, "LogContext must stay a plain value");
+
+Q_DECLARE_METATYPE(LogContext)
+
+#endif // LOGCONTEXT_H
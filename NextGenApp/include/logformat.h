@@ -0,0 +1,192 @@
+#ifndef LOGFORMAT_H
+#define LOGFORMAT_H
+/**
+ * @file logformat.h
+ * @brief Reusable UTF-8 line buffer used by cLogger to format messages.
+ *
+ * cLogger formats every line once into a LogLineFormatter and hands the
+ * same bytes to the log file, stdout and the in-memory ring. The buffer
+ * keeps its capacity between lines, so formatting a line does not
+ * allocate once the buffer has grown to the longest line seen.
+ *
+ * The "[yyyy/MM/dd HH:mm:ss." part of the time stamp is computed once per
+ * second and cached; other lines in the same second only append the
+ * milliseconds. Time stamps are UTC, as written by cLogger.
+ *
+ * A formatter is not thread-safe; cLogger uses one under its log mutex.
+ *
+ * @date 18-Oct-2026
+ * @author Gangadhar Thalange
+ */
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+
+class LogLineFormatter
+{
+public:
+    /// Length of "[yyyy/MM/dd HH:mm:ss.zzz]"
+    static constexpr size_t TIMESTAMP_SIZE = 25;
+
+    /**
+     * @brief Constructs a formatter with @p reserve bytes preallocated.
+     */
+    explicit LogLineFormatter(size_t reserve = 1024)
+    {
+        m_line.reserve(reserve);
+    }
+
+    /**
+     * @brief Starts a new line, keeping the buffer capacity.
+     */
+    void clear() { m_line.clear(); }
+
+    const char *data() const { return m_line.data(); }
+    size_t size() const { return m_line.size(); }
+
+    void append(char c) { m_line.push_back(c); }
+    void append(const char *text, size_t length) { m_line.append(text, length); }
+    void append(const char *text) { m_line.append(text, strlen(text)); }
+
+    /**
+     * @brief Appends a decimal integer.
+     */
+    void appendNumber(int64_t value)
+    {
+        char digits[24];
+        char *end = digits + sizeof(digits);
+        char *p = end;
+        uint64_t magnitude = value < 0 ? 0 - uint64_t(value) : uint64_t(value);
+        do {
+            *--p = char('0' + magnitude % 10);
+            magnitude /= 10;
+        } while (magnitude != 0);
+        if (value < 0)
+            *--p = '-';
+        m_line.append(p, size_t(end - p));
+    }
+
+    /**
+     * @brief Appends UTF-16 text (e.g. QString::utf16()) converted to UTF-8.
+     *
+     * Unpaired surrogates are replaced by U+FFFD, as QString::toUtf8() does.
+     */
+    void appendUtf16(const char16_t *text, size_t length)
+    {
+        for (size_t i = 0; i < length; ++i) {
+            uint32_t c = text[i];
+            if (c < 0x80) {
+                m_line.push_back(char(c));
+                continue;
+            }
+            if (c >= 0xD800 && c <= 0xDFFF) {
+                if (c <= 0xDBFF && i + 1 < length && text[i + 1] >= 0xDC00 && text[i + 1] <= 0xDFFF) {
+                    c = 0x10000 + ((c - 0xD800) << 10) + (uint32_t(text[i + 1]) - 0xDC00);
+                    ++i;
+                } else {
+                    c = 0xFFFD;
+                }
+            }
+            char bytes[4];
+            size_t count;
+            if (c < 0x800) {
+                bytes[0] = char(0xC0 | (c >> 6));
+                count = 1;
+            } else if (c < 0x10000) {
+                bytes[0] = char(0xE0 | (c >> 12));
+                bytes[1] = char(0x80 | ((c >> 6) & 0x3F));
+                count = 2;
+            } else {
+                bytes[0] = char(0xF0 | (c >> 18));
+                bytes[1] = char(0x80 | ((c >> 12) & 0x3F));
+                bytes[2] = char(0x80 | ((c >> 6) & 0x3F));
+                count = 3;
+            }
+            bytes[count] = char(0x80 | (c & 0x3F));
+            m_line.append(bytes, count + 1);
+        }
+    }
+
+    /**
+     * @brief Appends "[yyyy/MM/dd HH:mm:ss.zzz]" for @p utcMs (ms since epoch, UTC).
+     */
+    void appendTimestamp(int64_t utcMs)
+    {
+        // Floor division, so times before 1970 still map to the right second
+        int64_t second = utcMs / 1000;
+        int64_t millis = utcMs % 1000;
+        if (millis < 0) {
+            millis += 1000;
+            --second;
+        }
+        if (second != m_cachedSecond || !m_cacheValid) {
+            formatSecond(second);
+            m_cachedSecond = second;
+            m_cacheValid = true;
+        }
+        char stamp[TIMESTAMP_SIZE];
+        memcpy(stamp, m_secondPrefix, SECOND_PREFIX_SIZE);
+        stamp[21] = char('0' + millis / 100);
+        stamp[22] = char('0' + millis / 10 % 10);
+        stamp[23] = char('0' + millis % 10);
+        stamp[24] = ']';
+        m_line.append(stamp, TIMESTAMP_SIZE);
+    }
+
+private:
+    /// Length of "[yyyy/MM/dd HH:mm:ss."
+    static constexpr size_t SECOND_PREFIX_SIZE = 21;
+
+    static void putDigits(char *out, int64_t value, int width)
+    {
+        for (int i = width - 1; i >= 0; --i) {
+            out[i] = char('0' + value % 10);
+            value /= 10;
+        }
+    }
+
+    void formatSecond(int64_t second)
+    {
+        int64_t days = second / 86400;
+        int64_t secondOfDay = second % 86400;
+        if (secondOfDay < 0) {
+            secondOfDay += 86400;
+            --days;
+        }
+
+        // Civil date from days since 1970-01-01 (proleptic Gregorian)
+        const int64_t z = days + 719468;
+        const int64_t era = (z >= 0 ? z : z - 146096) / 146097;
+        const int64_t dayOfEra = z - era * 146097;
+        const int64_t yearOfEra = (dayOfEra - dayOfEra / 1460 + dayOfEra / 36524 - dayOfEra / 146096) / 365;
+        const int64_t dayOfYear = dayOfEra - (365 * yearOfEra + yearOfEra / 4 - yearOfEra / 100);
+        const int64_t mp = (5 * dayOfYear + 2) / 153;
+        const int64_t day = dayOfYear - (153 * mp + 2) / 5 + 1;
+        const int64_t month = mp < 10 ? mp + 3 : mp - 9;
+        const int64_t year = yearOfEra + era * 400 + (month <= 2 ? 1 : 0);
+
+        char *p = m_secondPrefix;
+        p[0] = '[';
+        putDigits(p + 1, year, 4);
+        p[5] = '/';
+        putDigits(p + 6, month, 2);
+        p[8] = '/';
+        putDigits(p + 9, day, 2);
+        p[11] = ' ';
+        putDigits(p + 12, secondOfDay / 3600, 2);
+        p[14] = ':';
+        putDigits(p + 15, secondOfDay / 60 % 60, 2);
+        p[17] = ':';
+        putDigits(p + 18, secondOfDay % 60, 2);
+        p[20] = '.';
+    }
+
+    std::string m_line;
+    int64_t m_cachedSecond = 0;
+    bool m_cacheValid = false;
+    char m_secondPrefix[SECOND_PREFIX_SIZE];
+};
+
+#endif // LOGFORMAT_H
@@ -0,0 +1,242 @@
+#ifndef LOGRATELIMITER_H
+#define LOGRATELIMITER_H
+/**
+ * @file logratelimiter.h
+ * @brief Per-call-site duplicate suppression and rate limiting for log messages.
+ *
+ * cLogger asks the limiter about every message before copying it, so a
+ * message storm from one call site (file:line and category) is cut off
+ * before it reaches the queue or the disk. Per call site:
+ *
+ * - a message identical to the last one admitted from the same site
+ *   within the duplicate window is suppressed, even when other threads or
+ *   sites log in between;
+ * - other messages pass a token bucket of @c burst messages refilled at
+ *   @c messagesPerSecond, implemented as GCRA (one atomic per site).
+ *
+ * Suppressed messages are counted per site and reported by
+ * takeSummaries(); summaryDue() tells the caller when to do so.
+ *
+ * Sites live in a fixed open-addressing table that is never resized or
+ * cleared, so admit() never allocates and never locks. When the table is
+ * full, messages of new sites are admitted unlimited.
+ *
+ * @date 18-Oct-2026
+ * @author Gangadhar Thalange
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+
+class LogRateLimiter
+{
+public:
+    static constexpr size_t SLOT_COUNT = 1024;
+    static constexpr size_t SITE_SIZE = 62;
+
+    LogRateLimiter()
+        : m_slots(new Slot[SLOT_COUNT])
+    {
+    }
+
+    LogRateLimiter(const LogRateLimiter &) = delete;
+    LogRateLimiter &operator=(const LogRateLimiter &) = delete;
+
+    /**
+     * @brief Sets the limits; @p messagesPerSecond <= 0 disables the limiter.
+     *
+     * @param messagesPerSecond Sustained messages per second per site.
+     * @param burst Messages a quiet site may log at once (at least 1).
+     * @param windowMs Duplicate window and least time between summaries.
+     */
+    void configure(int messagesPerSecond, int burst, int windowMs)
+    {
+        if (messagesPerSecond <= 0) {
+            m_intervalUs.store(0, std::memory_order_relaxed);
+            return;
+        }
+        const int64_t interval = std::max<int64_t>(1, 1000000 / messagesPerSecond);
+        m_toleranceUs.store(interval * (std::max(1, burst) - 1), std::memory_order_relaxed);
+        m_windowUs.store(int64_t(std::max(1, windowMs)) * 1000, std::memory_order_relaxed);
+        m_intervalUs.store(interval, std::memory_order_release);
+    }
+
+    bool isEnabled() const { return m_intervalUs.load(std::memory_order_relaxed) > 0; }
+
+    /**
+     * @brief Returns a key for a call site, hashed over its contents.
+     *
+     * The strings are hashed, not their addresses, because QML passes
+     * temporary buffers for file names.
+     */
+    static uint64_t siteKey(const char *file, int line, const char *category)
+    {
+        uint64_t hash = 14695981039346656037ULL;    // FNV-1a
+        const auto mix = [&hash](const char *text) {
+            for (; text && *text; ++text)
+                hash = (hash ^ uint8_t(*text)) * 1099511628211ULL;
+            hash = (hash ^ 0xFF) * 1099511628211ULL;
+        };
+        mix(file);
+        mix(category);
+        hash = (hash ^ uint32_t(line)) * 1099511628211ULL;
+        return hash;
+    }
+
+    /**
+     * @brief Monotonic time in microseconds, as expected by admit().
+     */
+    static int64_t now()
+    {
+        return std::chrono::duration_cast<std::chrono::microseconds>(
+                    std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+
+    /**
+     * @brief Decides whether a message is logged. Thread-safe.
+     *
+     * @param key siteKey() of the call site.
+     * @param file File name of the site, kept for summaries (may be null).
+     * @param line Line number of the site.
+     * @param messageHash Hash of the message text.
+     * @param nowUs now() or a test clock.
+     * @return true if the message should be logged.
+     */
+    bool admit(uint64_t key, const char *file, int line, uint64_t messageHash, int64_t nowUs)
+    {
+        const int64_t interval = m_intervalUs.load(std::memory_order_acquire);
+        if (interval <= 0)
+            return true;
+        Slot *slot = findSlot(normalize(key), file, line);
+        if (!slot)
+            return true;
+
+        if (slot->lastHash.load(std::memory_order_relaxed) == messageHash
+                && nowUs - slot->lastAdmitUs.load(std::memory_order_relaxed) < m_windowUs.load(std::memory_order_relaxed))
+            return suppress(*slot);
+
+        // GCRA: admit if the theoretical arrival time is at most the burst
+        // tolerance ahead of now, then move it on by one interval
+        const int64_t tolerance = m_toleranceUs.load(std::memory_order_relaxed);
+        int64_t tat = slot->tat.load(std::memory_order_relaxed);
+        int64_t next;
+        do {
+            const int64_t base = std::max(tat, nowUs);
+            if (base - nowUs > tolerance)
+                return suppress(*slot);
+            next = base + interval;
+        } while (!slot->tat.compare_exchange_weak(tat, next, std::memory_order_relaxed));
+
+        slot->lastHash.store(messageHash, std::memory_order_relaxed);
+        slot->lastAdmitUs.store(nowUs, std::memory_order_relaxed);
+        return true;
+    }
+
+    /**
+     * @brief Returns true (to one caller) when summaries should be taken.
+     *
+     * That is when messages were suppressed and the last summary is at
+     * least one window ago.
+     */
+    bool summaryDue(int64_t nowUs)
+    {
+        if (m_unreported.load(std::memory_order_relaxed) == 0)
+            return false;
+        int64_t next = m_nextSummaryUs.load(std::memory_order_relaxed);
+        if (nowUs < next)
+            return false;
+        return m_nextSummaryUs.compare_exchange_strong(next, nowUs + m_windowUs.load(std::memory_order_relaxed),
+                                                       std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Calls @p report(site, siteLength, count) for each site with
+     *        suppressed messages and resets its count.
+     *
+     * The site is "file:line" with the directory part of the file removed.
+     */
+    template <typename Report>
+    void takeSummaries(Report report)
+    {
+        for (size_t i = 0; i < SLOT_COUNT; ++i) {
+            Slot &slot = m_slots[i];
+            const uint64_t key = slot.key.load(std::memory_order_acquire);
+            if (key == 0 || key == BUSY)
+                continue;
+            const uint64_t count = slot.suppressed.exchange(0, std::memory_order_relaxed);
+            if (count == 0)
+                continue;
+            m_unreported.fetch_sub(count, std::memory_order_relaxed);
+            report(slot.site, size_t(slot.siteLength), count);
+        }
+    }
+
+    /**
+     * @brief Returns the number of messages suppressed since construction.
+     */
+    uint64_t suppressedCount() const { return m_suppressed.load(std::memory_order_relaxed); }
+
+private:
+    static constexpr uint64_t BUSY = ~uint64_t(0);
+    static constexpr size_t MAX_PROBES = 16;
+
+    struct alignas(64) Slot {
+        std::atomic<uint64_t> key{0};       ///< 0 = free, BUSY while being claimed
+        std::atomic<int64_t> tat{0};        ///< GCRA theoretical arrival time, us
+        std::atomic<uint64_t> lastHash{0};
+        std::atomic<int64_t> lastAdmitUs{0};
+        std::atomic<uint64_t> suppressed{0};
+        uint8_t siteLength = 0;
+        char site[SITE_SIZE];               ///< Written before key is published
+    };
+
+    static uint64_t normalize(uint64_t key)
+    {
+        return key == 0 || key == BUSY ? 1 : key;
+    }
+
+    Slot *findSlot(uint64_t key, const char *file, int line)
+    {
+        for (size_t probe = 0; probe < MAX_PROBES; ++probe) {
+            Slot &slot = m_slots[(key + probe) % SLOT_COUNT];
+            uint64_t current = slot.key.load(std::memory_order_acquire);
+            if (current == key)
+                return &slot;
+            if (current == 0 && slot.key.compare_exchange_strong(current, BUSY, std::memory_order_acquire)) {
+                const char *base = file ? strrchr(file, '/') : nullptr;
+                base = base ? base + 1 : (file ? file : "?");
+                const int length = snprintf(slot.site, SITE_SIZE, "%s:%d", base, line);
+                slot.siteLength = uint8_t(std::min<int>(std::max(length, 0), int(SITE_SIZE) - 1));
+                slot.key.store(key, std::memory_order_release);
+                return &slot;
+            }
+            if (current == key)
+                return &slot;
+        }
+        return nullptr;
+    }
+
+    bool suppress(Slot &slot)
+    {
+        slot.suppressed.fetch_add(1, std::memory_order_relaxed);
+        m_unreported.fetch_add(1, std::memory_order_relaxed);
+        m_suppressed.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+
+    std::unique_ptr<Slot[]> m_slots;
+    std::atomic<int64_t> m_intervalUs{0};
+    std::atomic<int64_t> m_toleranceUs{0};
+    std::atomic<int64_t> m_windowUs{1000000};
+    std::atomic<int64_t> m_nextSummaryUs{0};
+    std::atomic<uint64_t> m_unreported{0};
+    std::atomic<uint64_t> m_suppressed{0};
+};
+
+#endif // LOGRATELIMITER_H
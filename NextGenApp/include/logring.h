@@ -0,0 +1,151 @@
+#ifndef LOGRING_H
+#define LOGRING_H
+/**
+ * @file logring.h
+ * @brief Fixed-capacity ring of recent log records with lock-free readers.
+ *
+ * cLogger pushes every written message into a LogRing so that service
+ * screens can show the latest messages without reading the log file.
+ * Records are fixed-size (long texts are truncated), so the ring never
+ * allocates after construction.
+ *
+ * There is one writer at a time (cLogger writes under its log mutex).
+ * Each slot carries a sequence number that is odd while the slot is being
+ * written and 2 * (index + 1) once record @c index is complete; a reader
+ * copies the slot and keeps the copy only if the sequence number was the
+ * expected one before and after copying (seqlock). Readers never block
+ * the writer, and a record overwritten during the copy is skipped.
+ *
+ * @date 18-Oct-2026
+ * @author Gangadhar Thalange
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+
+class LogRing
+{
+public:
+    static constexpr size_t MODULE_SIZE = 8;
+    static constexpr size_t THREAD_SIZE = 32;
+    static constexpr size_t TEXT_SIZE = 200;
+
+    /**
+     * @brief One log message. Strings are UTF-8 and not null-terminated.
+     */
+    struct Record {
+        int64_t utcMs;          ///< Time of the message, ms since epoch (UTC)
+        int32_t type;           ///< QtMsgType
+        uint16_t textLength;
+        uint8_t moduleLength;
+        uint8_t threadLength;
+        char module[MODULE_SIZE];
+        char thread[THREAD_SIZE];
+        char text[TEXT_SIZE];
+    };
+
+    /**
+     * @brief Constructs a ring holding the last @p capacity records.
+     */
+    explicit LogRing(size_t capacity)
+        : m_slots(new Slot[capacity > 0 ? capacity : 1])
+        , m_capacity(capacity > 0 ? capacity : 1)
+    {
+    }
+
+    LogRing(const LogRing &) = delete;
+    LogRing &operator=(const LogRing &) = delete;
+
+    /**
+     * @brief Appends a record, overwriting the oldest one. Single writer only.
+     *
+     * Strings longer than their field are cut at a UTF-8 character boundary.
+     */
+    void push(int64_t utcMs, int type,
+              const char *module, size_t moduleLength,
+              const char *thread, size_t threadLength,
+              const char *text, size_t textLength)
+    {
+        const uint64_t index = m_head.load(std::memory_order_relaxed);
+        Slot &slot = m_slots[index % m_capacity];
+
+        slot.sequence.store(2 * index + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+
+        Record &record = slot.record;
+        record.utcMs = utcMs;
+        record.type = type;
+        record.moduleLength = uint8_t(copyField(record.module, MODULE_SIZE, module, moduleLength));
+        record.threadLength = uint8_t(copyField(record.thread, THREAD_SIZE, thread, threadLength));
+        record.textLength = uint16_t(copyField(record.text, TEXT_SIZE, text, textLength));
+
+        slot.sequence.store(2 * index + 2, std::memory_order_release);
+        m_head.store(index + 1, std::memory_order_release);
+    }
+
+    /**
+     * @brief Copies up to @p max of the most recent records, oldest first.
+     *
+     * Safe to call from any thread concurrently with push().
+     *
+     * @return Number of records written to @p out.
+     */
+    size_t snapshot(Record *out, size_t max) const
+    {
+        const uint64_t head = m_head.load(std::memory_order_acquire);
+        const uint64_t count = std::min<uint64_t>({ uint64_t(max), head, uint64_t(m_capacity) });
+        size_t copied = 0;
+        for (uint64_t index = head - count; index < head; ++index) {
+            const Slot &slot = m_slots[index % m_capacity];
+            const uint64_t expected = 2 * index + 2;
+            if (slot.sequence.load(std::memory_order_acquire) != expected)
+                continue;
+            // The copy may race with a writer reusing the slot; it is
+            // discarded below if so.
+            memcpy(&out[copied], &slot.record, sizeof(Record));
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (slot.sequence.load(std::memory_order_relaxed) == expected)
+                ++copied;
+        }
+        return copied;
+    }
+
+    /**
+     * @brief Returns the number of records that fit into the ring.
+     */
+    size_t capacity() const { return m_capacity; }
+
+    /**
+     * @brief Returns the number of records pushed since construction.
+     */
+    uint64_t pushedCount() const { return m_head.load(std::memory_order_acquire); }
+
+private:
+    struct alignas(64) Slot {
+        std::atomic<uint64_t> sequence{0};
+        Record record;
+    };
+
+    static size_t copyField(char *field, size_t size, const char *value, size_t length)
+    {
+        if (length > size) {
+            length = size;
+            // Do not split a multi-byte character
+            while (length > 0 && (uint8_t(value[length]) & 0xC0) == 0x80)
+                --length;
+        }
+        if (length > 0)
+            memcpy(field, value, length);
+        return length;
+    }
+
+    std::unique_ptr<Slot[]> m_slots;
+    size_t m_capacity;
+    std::atomic<uint64_t> m_head{0};
+};
+
+#endif // LOGRING_H
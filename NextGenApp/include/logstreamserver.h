@@ -0,0 +1,115 @@
+#ifndef LOGSTREAMSERVER_H
+#define LOGSTREAMSERVER_H
+/**
+ * @file logstreamserver.h
+ * @brief Declaration of the LogStreamServer class.
+ *
+ * LogStreamServer serves the live log lines on a local Unix-domain socket,
+ * so they can be watched on the target without tailing the log file. It
+ * is a cLogger subscriber (see cLogger::subscribe()): the lines come from
+ * the in-memory batches, never from the file.
+ *
+ * Protocol, one text line per message in both directions:
+ *
+ * @code
+ * client -> server   filter <level> [module ...]
+ * server -> client   <log line>
+ * server -> client   -- <N> lines dropped --
+ * @endcode
+ *
+ * A new client receives every line. The filter command sets the least
+ * severe level (debug, info, warning, critical, fatal) and optionally the
+ * modules, where a module is a logging category name prefix as in
+ * cLogger::setLoggerLevel() ("qml" covers "qml" and "qml.*"). It can be
+ * sent again at any time.
+ *
+ * Each client has its own bounded output buffer. Lines that do not fit
+ * are dropped for that client only and counted; the count is sent in
+ * the stream before the next line that fits. A slow or stopped client
+ * therefore never blocks the application or other clients.
+ *
+ * All socket work runs on the server's own thread. Unix only; start()
+ * fails elsewhere.
+ *
+ * @date 18-Oct-2026
+ * @author Gangadhar Thalange
+ */
+
+#include <QString>
+#include <QThread>
+#include <atomic>
+
+class LogStreamServer
+{
+public:
+    static constexpr int DEFAULT_CLIENT_BUFFER = 256 * 1024;
+    static constexpr int MAX_CLIENTS = 8;
+
+    LogStreamServer();
+
+    /**
+     * @brief Destructor. Stops the server.
+     */
+    ~LogStreamServer();
+
+    LogStreamServer(const LogStreamServer &) = delete;
+    LogStreamServer &operator=(const LogStreamServer &) = delete;
+
+    /**
+     * @brief Listens on @p path and starts streaming log lines.
+     *
+     * A stale socket file at @p path is replaced.
+     *
+     * @param path Socket path (at most 107 bytes).
+     * @param clientBufferBytes Output buffer of each client.
+     * @return false if the socket cannot be created.
+     */
+    bool start(const QString &path, int clientBufferBytes = DEFAULT_CLIENT_BUFFER);
+
+    /**
+     * @brief Disconnects all clients, stops the thread and removes the socket file.
+     */
+    void stop();
+
+    bool isRunning() const { return m_thread.isRunning(); }
+
+    /**
+     * @brief Returns the socket path, empty if the server is stopped.
+     */
+    QString path() const { return m_path; }
+
+    /**
+     * @brief Returns the number of connected clients.
+     */
+    int clientCount() const { return m_clientCount.load(); }
+
+    /**
+     * @brief Returns the lines dropped for slow clients since start().
+     */
+    quint64 droppedLines() const { return m_droppedLines.load(); }
+
+private:
+    class Worker;
+
+    QString m_path;
+
+    /**
+     * @brief Thread running the socket event loop.
+     */
+    QThread m_thread;
+
+    /**
+     * @brief Lives on #m_thread, deleted when it finishes.
+     */
+    Worker *m_worker = nullptr;
+
+    /**
+     * @brief cLogger subscription id.
+     */
+    int m_subscription = 0;
+
+    std::atomic<int> m_clientCount{0};
+    std::atomic<quint64> m_droppedLines{0};
+};
+
+#endif // LOGSTREAMSERVER_H
@@ -0,0 +1,99 @@
+#ifndef LOGTRACE_H
+#define LOGTRACE_H
+/**
+ * @file logtrace.h
+ * @brief Trace macros with a compile-time minimum level.
+ *
+ * NG_DEBUG(), NG_INFO() and NG_WARNING() take a logging category and are
+ * used like qCDebug(), as a stream or with a printf format:
+ *
+ * @code
+ * NG_DEBUG(lcFrames) << "value:" << m_popup;
+ * NG_DEBUG(lcFrames, "popup %d", m_popup);
+ * @endcode
+ *
+ * Levels below NG_LOG_MIN_LEVEL are compiled out: the statement becomes
+ * a while (false) loop and its arguments are never evaluated. Levels that
+ * are compiled in check the category first, so a disabled message costs
+ * one branch and, as with qCDebug(), its arguments are not evaluated
+ * either. Plain qDebug() evaluates and streams everything before Qt
+ * drops the message.
+ *
+ * NG_LOG_MIN_LEVEL defaults to NG_LOG_LEVEL_DEBUG (everything compiled
+ * in); the application sets it for non-Debug builds in CMakeLists.txt.
+ * Critical messages and alarms are never compiled out. NG_BINLOG() (see
+ * binlog.h) follows the same minimum level.
+ *
+ * @date 18-Oct-2026
+ * @author Gangadhar Thalange
+ */
+
+#include <QLoggingCategory>
+#include <QtGlobal>
+
+#define NG_LOG_LEVEL_DEBUG      0
+#define NG_LOG_LEVEL_INFO       1
+#define NG_LOG_LEVEL_WARNING    2
+#define NG_LOG_LEVEL_CRITICAL   3
+
+#ifndef NG_LOG_MIN_LEVEL
+#define NG_LOG_MIN_LEVEL NG_LOG_LEVEL_DEBUG
+#endif
+
+namespace NgLog {
+
+/**
+ * @brief Severity rank of @p type, comparable with NG_LOG_MIN_LEVEL.
+ */
+constexpr int level(QtMsgType type)
+{
+    return type == QtDebugMsg ? NG_LOG_LEVEL_DEBUG
+         : type == QtInfoMsg ? NG_LOG_LEVEL_INFO
+         : type == QtWarningMsg ? NG_LOG_LEVEL_WARNING
+         : NG_LOG_LEVEL_CRITICAL;
+}
+
+/**
+ * @brief Returns whether messages of @p type are compiled in.
+ */
+constexpr bool compiledIn(QtMsgType type)
+{
+    return level(type) >= NG_LOG_MIN_LEVEL || level(type) >= NG_LOG_LEVEL_CRITICAL;
+}
+
+} // namespace NgLog
+
+/**
+ * @brief Logs to @p category if @p type is enabled, evaluating the
+ *        message only then.
+ */
+#define NG_LOG_IF_ENABLED(category, type, method, ...) \
+    for (bool ngLogEnabled_ = category().isEnabled(type); ngLogEnabled_; ngLogEnabled_ = false) \
+        QMessageLogger(QT_MESSAGELOG_FILE, QT_MESSAGELOG_LINE, QT_MESSAGELOG_FUNC, \
+                       category().categoryName()).method(__VA_ARGS__)
+
+/**
+ * @brief Swallows a compiled-out message without evaluating it.
+ */
+#define NG_LOG_DISCARD(...) \
+    while (false) QMessageLogger().noDebug(__VA_ARGS__)
+
+#if NG_LOG_MIN_LEVEL <= NG_LOG_LEVEL_DEBUG
+#define NG_DEBUG(category, ...) NG_LOG_IF_ENABLED(category, QtDebugMsg, debug, __VA_ARGS__)
+#else
+#define NG_DEBUG(category, ...) NG_LOG_DISCARD(__VA_ARGS__)
+#endif
+
+#if NG_LOG_MIN_LEVEL <= NG_LOG_LEVEL_INFO
+#define NG_INFO(category, ...) NG_LOG_IF_ENABLED(category, QtInfoMsg, info, __VA_ARGS__)
+#else
+#define NG_INFO(category, ...) NG_LOG_DISCARD(__VA_ARGS__)
+#endif
+
+#if NG_LOG_MIN_LEVEL <= NG_LOG_LEVEL_WARNING
+#define NG_WARNING(category, ...) NG_LOG_IF_ENABLED(category, QtWarningMsg, warning, __VA_ARGS__)
+#else
+#define NG_WARNING(category, ...) NG_LOG_DISCARD(__VA_ARGS__)
+#endif
+
+#endif // LOGTRACE_H
@@ -0,0 +1,115 @@
+#ifndef MPSCQUEUE_H
+#define MPSCQUEUE_H
+/**
+ * @file mpscqueue.h
+ * @brief Bounded lock-free multi-producer / single-consumer queue.
+ *
+ * Array-based queue after D. Vyukov's bounded MPMC design: every cell
+ * carries a sequence number that tells producers whether the cell is free
+ * and the consumer whether it is filled. Producers claim a cell with one
+ * CAS on the enqueue position; there is no lock and no allocation after
+ * construction. A full queue is reported to the producer, which decides
+ * what to do (drop or retry).
+ *
+ * @date 18-Oct-2026
+ * @author Gangadhar Thalange
+ */
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <utility>
+
+template <typename T>
+class MpscQueue
+{
+public:
+    /**
+     * @brief Constructs a queue holding at least @p capacity elements.
+     *
+     * The capacity is rounded up to a power of two.
+     *
+     * @param capacity Minimum number of elements.
+     */
+    explicit MpscQueue(size_t capacity)
+    {
+        size_t size = 2;
+        while (size < capacity)
+            size <<= 1;
+        m_mask = size - 1;
+        m_cells.reset(new Cell[size]);
+        for (size_t i = 0; i < size; ++i)
+            m_cells[i].sequence.store(i, std::memory_order_relaxed);
+    }
+
+    MpscQueue(const MpscQueue &) = delete;
+    MpscQueue &operator=(const MpscQueue &) = delete;
+
+    /**
+     * @brief Appends an element. Safe to call from any number of threads.
+     *
+     * @p value is only moved from if the call succeeds, so a caller may
+     * retry with the same object after a failure.
+     *
+     * @return false if the queue is full.
+     */
+    bool tryPush(T &&value)
+    {
+        Cell *cell;
+        size_t pos = m_enqueuePos.load(std::memory_order_relaxed);
+        for (;;) {
+            cell = &m_cells[pos & m_mask];
+            const size_t sequence = cell->sequence.load(std::memory_order_acquire);
+            const intptr_t diff = intptr_t(sequence) - intptr_t(pos);
+            if (diff == 0) {
+                if (m_enqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                    break;
+            } else if (diff < 0) {
+                return false;
+            } else {
+                pos = m_enqueuePos.load(std::memory_order_relaxed);
+            }
+        }
+        cell->value = std::move(value);
+        cell->sequence.store(pos + 1, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * @brief Removes the oldest element. Single consumer thread only.
+     * @return false if the queue is empty.
+     */
+    bool tryPop(T &value)
+    {
+        Cell *cell = &m_cells[m_dequeuePos & m_mask];
+        const size_t sequence = cell->sequence.load(std::memory_order_acquire);
+        if (intptr_t(sequence) - intptr_t(m_dequeuePos + 1) < 0)
+            return false;
+        value = std::move(cell->value);
+        cell->sequence.store(m_dequeuePos + m_mask + 1, std::memory_order_release);
+        ++m_dequeuePos;
+        return true;
+    }
+
+    /**
+     * @brief Returns the number of cells.
+     */
+    size_t capacity() const { return m_mask + 1; }
+
+private:
+    struct Cell {
+        std::atomic<size_t> sequence;
+        T value;
+    };
+
+    std::unique_ptr<Cell[]> m_cells;
+    size_t m_mask = 0;
+
+    // Producers contend on the enqueue position; keep the consumer's
+    // position on its own cache line.
+    alignas(64) std::atomic<size_t> m_enqueuePos{0};
+    alignas(64) size_t m_dequeuePos = 0;
+};
+
+#endif // MPSCQUEUE_H
@@ -0,0 +1,164 @@
+#ifndef REPLAYFRAMESOURCE_H
+#define REPLAYFRAMESOURCE_H
+/**
+ * @file replayframesource.h
+ * @brief Declaration of the ReplayFrameSource class.
+ *
+ * ReplayFrameSource feeds the frames of a capture file to a frame handler
+ * from its own thread, reproducing the recorded inter-frame timing. The
+ * timing can be scaled (N times faster) or dropped entirely to push frames
+ * as fast as the consumer accepts them, which measures the maximum decode
+ * throughput. Replay can start at any point in the capture and loop for
+ * soak tests.
+ *
+ * Only messages the live receiver would have passed on (id plus at least
+ * 8 payload bytes) are delivered; longer ones with their first 8 payload
+ * bytes, as recorded.
+ *
+ * @date 18-Oct-2026
+ * @author Gangadhar Thalange
+ */
+
+#include <QThread>
+#include <QString>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include "framesource.h"
+#include "capturereader.h"
+
+class ReplayFrameSource : public FrameSource
+{
+    Q_OBJECT
+public:
+    /**
+     * @brief Constructs a replay of the given capture file.
+     *
+     * The file is opened by start().
+     *
+     * @param path Capture file path.
+     * @param parent Optional QObject parent.
+     */
+    explicit ReplayFrameSource(const QString &path, QObject *parent = nullptr);
+
+    /**
+     * @brief Destructor. Stops the replay thread.
+     */
+    ~ReplayFrameSource() override;
+
+    /**
+     * @brief Sets the replay speed factor.
+     *
+     * 1.0 reproduces the original timing, 10.0 replays ten times faster,
+     * 0 delivers frames as fast as possible. Must be called before start().
+     *
+     * @param speed Speed factor (>= 0).
+     */
+    void setSpeed(double speed) { m_speed = speed < 0 ? 0 : speed; }
+
+    /**
+     * @brief Returns the replay speed factor.
+     */
+    double speed() const { return m_speed; }
+
+    /**
+     * @brief Restarts from the start position after the last frame.
+     *
+     * @param loop True to loop until stop().
+     */
+    void setLoop(bool loop) { m_loop = loop; }
+
+    /**
+     * @brief Returns whether the replay loops.
+     */
+    bool loop() const { return m_loop; }
+
+    /**
+     * @brief Sets the position in the capture where replay begins.
+     *
+     * @param offsetMs Time since capture start in ms.
+     */
+    void setStartOffsetMs(qint64 offsetMs) { m_startOffsetMs = qMax<qint64>(0, offsetMs); }
+
+    /**
+     * @brief Opens the capture file and starts the replay thread.
+     * @return false if already running or the file cannot be opened.
+     */
+    bool start() override;
+
+    /**
+     * @brief Stops the replay and joins its thread, also while it waits
+     *        for the next frame.
+     */
+    void stop() override;
+
+    /**
+     * @brief Returns whether the replay thread is running.
+     */
+    bool isRunning() const override { return m_thread.isRunning(); }
+
+    /**
+     * @brief Returns the capture file path.
+     */
+    QString path() const { return m_path; }
+
+    /**
+     * @brief Returns the reason start() failed.
+     */
+    QString errorString() const { return m_error; }
+
+    /**
+     * @brief Returns the number of frames delivered since start().
+     */
+    quint64 framesDelivered() const { return m_delivered.load(std::memory_order_relaxed); }
+
+    /**
+     * @brief Returns the number of completed passes over the capture.
+     */
+    int passesCompleted() const { return m_passes.load(std::memory_order_relaxed); }
+
+signals:
+    /**
+     * @brief Emitted from the replay thread after the last frame of a
+     *        non-looping replay.
+     */
+    void finished();
+
+private:
+    /**
+     * @brief Replay loop executed on the replay thread.
+     */
+    void run();
+
+    /**
+     * @brief Sleeps until @p deadline unless stop() is called.
+     * @return false if the replay was stopped.
+     */
+    bool waitUntil(std::chrono::steady_clock::time_point deadline);
+
+    QString m_path;
+    QString m_error;
+    CaptureReader m_reader;
+    double m_speed = 1.0;
+    bool m_loop = false;
+    qint64 m_startOffsetMs = 0;
+
+    std::atomic<quint64> m_delivered{0};
+    std::atomic<int> m_passes{0};
+
+    /**
+     * @brief Stop flag; set under m_waitMutex so a waiting replay thread
+     *        cannot miss it.
+     */
+    std::atomic<bool> m_stopRequested{false};
+    std::mutex m_waitMutex;
+    std::condition_variable m_waitCondition;
+
+    /**
+     * @brief Replay thread.
+     */
+    QThread m_thread;
+};
+
+#endif // REPLAYFRAMESOURCE_H
@@ -0,0 +1,151 @@
+#ifndef ROLLINGAVERAGE_H
+#define ROLLINGAVERAGE_H
+/**
+ * @file rollingaverage.h
+ * @brief Time-weighted average over a sliding time window in O(1).
+ *
+ * Signals arrive at irregular intervals, so the average weights every
+ * value with the time it was held instead of counting samples. The window
+ * is divided into a fixed ring of buckets, each holding the weighted sum
+ * and the covered time of its slice; running totals over all buckets make
+ * average() O(1), and add() touches only the buckets its interval spans
+ * (usually one). When time moves past a bucket, its contribution is
+ * subtracted from the totals and the bucket is reused.
+ *
+ * The window is exact to one bucket: average() covers between
+ * (buckets - 1) and buckets bucket lengths of history.
+ *
+ * Not thread-safe; TripComputer calls it under its mutex.
+ *
+ * @date 18-Oct-2026
+ * @author Gangadhar Thalange
+ */
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+class RollingAverage
+{
+public:
+    static constexpr int DEFAULT_BUCKETS = 60;
+
+    /**
+     * @brief Constructs an empty average over @p windowNs.
+     *
+     * @param windowNs Window length in nanoseconds (at least one per bucket).
+     * @param buckets Window resolution.
+     */
+    explicit RollingAverage(int64_t windowNs = 60000000000LL, int buckets = DEFAULT_BUCKETS)
+    {
+        setWindow(windowNs, buckets);
+    }
+
+    /**
+     * @brief Changes the window and drops all history.
+     */
+    void setWindow(int64_t windowNs, int buckets = DEFAULT_BUCKETS)
+    {
+        buckets = std::max(1, buckets);
+        m_bucketNs = std::max<int64_t>(1, windowNs / buckets);
+        m_buckets.assign(size_t(buckets), Bucket());
+        reset();
+    }
+
+    int64_t windowNs() const { return m_bucketNs * int64_t(m_buckets.size()); }
+
+    /**
+     * @brief Drops all history.
+     */
+    void reset()
+    {
+        std::fill(m_buckets.begin(), m_buckets.end(), Bucket());
+        m_current = 0;
+        m_started = false;
+        m_weighted = 0.0;
+        m_covered = 0;
+    }
+
+    /**
+     * @brief Adds @p value as held from @p fromNs to @p toNs.
+     *
+     * Intervals are expected in time order; parts older than the window
+     * are ignored.
+     */
+    void add(double value, int64_t fromNs, int64_t toNs)
+    {
+        const int64_t count = int64_t(m_buckets.size());
+        fromNs = std::max(fromNs, toNs - m_bucketNs * (count + 1));
+        int64_t t = fromNs;
+        while (t < toNs) {
+            const int64_t bucket = t / m_bucketNs;
+            const int64_t end = std::min(toNs, (bucket + 1) * m_bucketNs);
+            advanceTo(bucket);
+            if (bucket > m_current - count) {
+                Bucket &slot = m_buckets[size_t(bucket % count)];
+                const double weighted = value * double(end - t);
+                slot.weighted += weighted;
+                slot.covered += end - t;
+                m_weighted += weighted;
+                m_covered += end - t;
+            }
+            t = end;
+        }
+    }
+
+    /**
+     * @brief Returns the average over the window, 0 if nothing was added.
+     */
+    double average() const
+    {
+        return m_covered > 0 ? m_weighted / double(m_covered) : 0.0;
+    }
+
+    bool isEmpty() const { return m_covered == 0; }
+
+    /**
+     * @brief Returns how much of the window has values.
+     */
+    int64_t coveredNs() const { return m_covered; }
+
+private:
+    struct Bucket {
+        double weighted = 0.0;      /**< Sum of value * held time */
+        int64_t covered = 0;        /**< Held time in the bucket */
+    };
+
+    /**
+     * @brief Makes @p bucket the newest bucket, expiring older ones.
+     */
+    void advanceTo(int64_t bucket)
+    {
+        const int64_t count = int64_t(m_buckets.size());
+        if (!m_started || bucket - m_current >= count) {
+            std::fill(m_buckets.begin(), m_buckets.end(), Bucket());
+            m_weighted = 0.0;
+            m_covered = 0;
+            m_current = bucket;
+            m_started = true;
+            return;
+        }
+        while (m_current < bucket) {
+            ++m_current;
+            Bucket &slot = m_buckets[size_t(m_current % count)];
+            m_weighted -= slot.weighted;
+            m_covered -= slot.covered;
+            slot = Bucket();
+        }
+        // Keep rounding errors of the subtractions from piling up
+        if (m_covered == 0)
+            m_weighted = 0.0;
+    }
+
+    std::vector<Bucket> m_buckets;
+    int64_t m_bucketNs = 1;
+    int64_t m_current = 0;          ///< Newest bucket number (time / bucket length)
+    bool m_started = false;
+    double m_weighted = 0.0;        ///< Sum over all buckets
+    int64_t m_covered = 0;          ///< Sum over all buckets
+};
+
+#endif // ROLLINGAVERAGE_H
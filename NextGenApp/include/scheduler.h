@@ -0,0 +1,191 @@
+#ifndef SCHEDULER_H
+#define SCHEDULER_H
+/**
+ * @file scheduler.h
+ * @brief Declaration of the Scheduler class.
+ *
+ * Scheduler is a single-timer deadline service for the UI thread. Instead of
+ * every component owning its own periodic QTimer, tasks register a deadline
+ * with the scheduler, which keeps exactly one single-shot timer armed for the
+ * earliest pending deadline. Tasks that fall due within each other's
+ * tolerance window are run on the same wakeup, and when nothing is
+ * registered no timer is armed at all.
+ *
+ * Typical users are the wall-clock display (minute aligned), signal
+ * staleness watchdogs, cyclic transmit and persistence flushes.
+ *
+ * @note All methods must be called from the thread the scheduler lives in
+ *       (normally the UI thread). Other threads should post work to it with
+ *       QMetaObject::invokeMethod().
+ *
+ * @date 18-Oct-2026
+ * @author Gangadhar Thalange
+ */
+
+#include <QObject>
+#include <QTimer>
+#include <QElapsedTimer>
+#include <QVector>
+#include <functional>
+
+class Scheduler : public QObject
+{
+    Q_OBJECT
+public:
+    /**
+     * @brief Identifier returned for every registered task.
+     *
+     * Identifiers are never reused during the lifetime of a scheduler;
+     * 0 is never a valid identifier.
+     */
+    using TaskId = quint32;
+
+    /**
+     * @brief Callback type invoked when a task falls due.
+     */
+    using Task = std::function<void()>;
+
+    /**
+     * @brief Returns the process-wide scheduler living in the UI thread.
+     *
+     * Created on first use, so the first call must happen in the UI thread.
+     *
+     * @return Reference to the shared scheduler instance.
+     */
+    static Scheduler &instance();
+
+    /**
+     * @brief Constructs an empty scheduler. No timer is armed.
+     * @param parent Optional QObject parent.
+     */
+    explicit Scheduler(QObject *parent = nullptr);
+
+    /**
+     * @brief Destructor. Pending tasks are dropped without being run.
+     */
+    ~Scheduler();
+
+    /**
+     * @brief Registers a task that runs every @p intervalMs milliseconds.
+     *
+     * @param intervalMs Period in milliseconds (must be > 0).
+     * @param task Callback to run.
+     * @param toleranceMs How early the task may be run so that it can share
+     *        a wakeup with another task. 0 means never early.
+     * @return Task identifier, or 0 if @p intervalMs is invalid.
+     */
+    TaskId schedulePeriodic(qint64 intervalMs, Task task, qint64 toleranceMs = 0);
+
+    /**
+     * @brief Registers a task that runs once after @p delayMs milliseconds.
+     *
+     * The task is removed after it has run. Use restart() to push the
+     * deadline out again (e.g. staleness watchdogs, debounced flushes).
+     *
+     * @param delayMs Delay in milliseconds (>= 0).
+     * @param task Callback to run.
+     * @param toleranceMs How early the task may be run, see schedulePeriodic().
+     * @return Task identifier.
+     */
+    TaskId scheduleOnce(qint64 delayMs, Task task, qint64 toleranceMs = 0);
+
+    /**
+     * @brief Registers a task aligned to wall-clock period boundaries.
+     *
+     * The task runs when the local wall clock crosses a multiple of
+     * @p periodMs (e.g. 60000 for every full minute). The next boundary is
+     * recomputed from the wall clock each time, so clock adjustments are
+     * picked up on the following period.
+     *
+     * @param periodMs Wall-clock period in milliseconds (must be > 0).
+     * @param task Callback to run.
+     * @return Task identifier, or 0 if @p periodMs is invalid.
+     */
+    TaskId scheduleWallClockAligned(qint64 periodMs, Task task);
+
+    /**
+     * @brief Pushes the deadline of a task to now + its interval.
+     *
+     * Cheap enough to call on every received frame: the armed timer is
+     * not touched when the deadline moves later.
+     *
+     * @param id Task to restart.
+     * @return false if the task does not exist.
+     */
+    bool restart(TaskId id);
+
+    /**
+     * @brief Removes a task. Safe to call from inside a running task.
+     * @param id Task to cancel.
+     * @return false if the task did not exist.
+     */
+    bool cancel(TaskId id);
+
+    /**
+     * @brief Returns whether a task is currently registered.
+     */
+    bool isScheduled(TaskId id) const;
+
+    /**
+     * @brief Returns the number of registered tasks.
+     */
+    int taskCount() const { return m_tasks.size(); }
+
+    /**
+     * @brief Returns milliseconds until the armed timer fires, -1 if idle.
+     */
+    qint64 msecsToNextWakeup() const;
+
+    /**
+     * @brief Returns how many times the scheduler timer has fired.
+     *
+     * Used by diagnostics to report wakeups per second.
+     */
+    quint64 wakeupCount() const { return m_wakeups; }
+
+private:
+    /**
+     * @brief Internal bookkeeping for a registered task.
+     */
+    struct Entry {
+        TaskId id = 0;            /**< Task identifier */
+        qint64 deadline = 0;      /**< Due time on the monotonic clock (ms) */
+        qint64 interval = 0;      /**< Period / delay in ms */
+        qint64 tolerance = 0;     /**< Allowed early run in ms */
+        bool periodic = false;    /**< Re-arm after running */
+        bool wallAligned = false; /**< Deadline derived from the wall clock */
+        Task task;                /**< Callback */
+    };
+
+    /**
+     * @brief Runs every task whose deadline (minus tolerance) has passed.
+     */
+    void onTimeout();
+
+    /**
+     * @brief Arms the single timer for the earliest deadline, or stops it.
+     */
+    void rearm();
+
+    /**
+     * @brief Inserts a task and rearms the timer if it is the new earliest.
+     */
+    TaskId add(Entry entry);
+
+    /**
+     * @brief Milliseconds from now to the next multiple of @p periodMs
+     *        on the local wall clock.
+     */
+    static qint64 msecsToWallBoundary(qint64 periodMs);
+
+    int indexOf(TaskId id) const;
+
+    QTimer m_timer;            /**< The only timer owned by the scheduler */
+    QElapsedTimer m_clock;     /**< Monotonic time base for deadlines */
+    QVector<Entry> m_tasks;    /**< Registered tasks (small, scanned linearly) */
+    TaskId m_nextId = 1;       /**< Next identifier to hand out */
+    qint64 m_armedFor = -1;    /**< Deadline the timer is armed for, -1 if idle */
+    quint64 m_wakeups = 0;     /**< Number of timer expirations */
+};
+
+#endif // SCHEDULER_H
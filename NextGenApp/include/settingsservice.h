@@ -0,0 +1,161 @@
+#ifndef SETTINGSSERVICE_H
+#define SETTINGSSERVICE_H
+/**
+ * @file settingsservice.h
+ * @brief Declaration of the SettingsService cached settings store.
+ *
+ * Constructing a QSettings reads and parses the settings file, and every
+ * setValue() through it ends in a write on its destruction. The
+ * SettingsService loads the settings of an organization/application once
+ * and serves value() from an immutable in-memory snapshot:
+ *
+ * - Reads use a per-thread copy of the snapshot and take no lock unless
+ *   a write happened since the thread's last read.
+ * - setValue() and remove() publish a new snapshot and mark the key
+ *   dirty; they never touch the file.
+ * - A worker thread writes the dirty keys once no change has arrived
+ *   for the debounce time (or after at most ten debounce periods under
+ *   a steady stream of changes), in one QSettings::sync().
+ * - flush() writes the dirty keys on the calling thread; call it on
+ *   shutdown. The destructor flushes as well.
+ *
+ * Changes made to the settings file by other processes after the load
+ * are not seen. Use instance() for the application settings
+ * (ORG_NAME/APP_NAME).
+ *
+ * @date 18-Oct-2026
+ * @author Gangadhar Thalange
+ */
+
+#include <QHash>
+#include <QSettings>
+#include <QString>
+#include <QThread>
+#include <QVariant>
+#include <atomic>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include "commonlib_global.h"
+
+class COMMONSHARED_EXPORT SettingsService
+{
+public:
+    static constexpr int DEFAULT_DEBOUNCE_MS = 500;
+
+    /**
+     * @brief Loads the settings of @p organization / @p application.
+     */
+    SettingsService(const QString &organization, const QString &application);
+
+    /**
+     * @brief Destructor. Stops the worker and writes pending changes.
+     */
+    ~SettingsService();
+
+    SettingsService(const SettingsService &) = delete;
+    SettingsService &operator=(const SettingsService &) = delete;
+
+    /**
+     * @brief Returns the application settings (ORG_NAME/APP_NAME).
+     */
+    static SettingsService &instance();
+
+    /**
+     * @brief Returns the value of @p key, or @p defaultValue. Safe from any thread.
+     */
+    QVariant value(const QString &key, const QVariant &defaultValue = QVariant()) const;
+
+    /**
+     * @brief Returns whether @p key has a value.
+     */
+    bool contains(const QString &key) const;
+
+    /**
+     * @brief Sets @p key; visible to value() at once, written later.
+     *
+     * An invalid @p value removes the key.
+     */
+    void setValue(const QString &key, const QVariant &value);
+
+    /**
+     * @brief Removes @p key; written later.
+     */
+    void remove(const QString &key);
+
+    /**
+     * @brief Writes the pending changes now, on the calling thread.
+     */
+    void flush();
+
+    /**
+     * @brief Sets the quiet time before pending changes are written.
+     */
+    void setDebounceMs(int milliseconds);
+
+    /**
+     * @brief Returns the number of changes not yet written.
+     */
+    int pendingCount() const;
+
+    /**
+     * @brief Returns the number of writes to the settings file so far.
+     */
+    quint64 syncCount() const { return m_syncs.load(); }
+
+private:
+    using Snapshot = std::shared_ptr<const QHash<QString, QVariant>>;
+
+    /**
+     * @brief Returns the current values from the calling thread's cache.
+     *
+     * Valid until the same thread calls it again.
+     */
+    const QHash<QString, QVariant> &values() const;
+
+    /**
+     * @brief Publishes a snapshot with @p key changed and queues the write.
+     */
+    void update(const QString &key, const QVariant &value, bool removed);
+
+    /**
+     * @brief Worker loop: writes pending changes after the debounce time.
+     */
+    void run();
+
+    /**
+     * @brief Writes the pending changes (caller holds m_storeMutex).
+     */
+    void writePending();
+
+    const QString m_organization;
+    const QString m_application;
+
+    /**
+     * @brief Current values and pending changes (protected by m_mutex).
+     */
+    mutable std::mutex m_mutex;
+    Snapshot m_values;
+    QHash<QString, QVariant> m_pending;     ///< Invalid QVariant: key removed
+    qint64 m_firstChangeMs = 0;
+    qint64 m_lastChangeMs = 0;
+    int m_debounceMs = DEFAULT_DEBOUNCE_MS;
+    bool m_stop = false;
+    std::condition_variable m_changed;
+
+    /**
+     * @brief Snapshot version; readers compare it with their cached copy.
+     */
+    std::atomic<quint64> m_generation{0};
+
+    /**
+     * @brief Serializes writes to the settings file.
+     */
+    std::mutex m_storeMutex;
+    std::unique_ptr<QSettings> m_store;     ///< Created on first write
+
+    QThread m_thread;
+    std::atomic<quint64> m_syncs{0};
+};
+
+#endif // SETTINGSSERVICE_H
@@ -0,0 +1,136 @@
+#ifndef SIGNALGRAPH_H
+#define SIGNALGRAPH_H
+/**
+ * @file signalgraph.h
+ * @brief Incremental recomputation of derived signals.
+ *
+ * Readouts such as trip hours are functions of decoded inputs. Instead of
+ * recomputing them by hand wherever an input changes, each derived signal
+ * declares its inputs once:
+ *
+ * @code
+ * const SignalGraph::SignalId engine = graph.addInput();
+ * const SignalGraph::SignalId reset = graph.addInput();
+ * graph.addDerived({ engine, reset },
+ *                  [&]() { return graph.value(engine) - graph.value(reset); },
+ *                  [](double hours) { ... });
+ * @endcode
+ *
+ * set() stores an input and marks only its direct dependents dirty; it
+ * never computes. update() ends an update cycle: it recomputes the dirty
+ * signals once each, in dependency order, and marks the dependents of a
+ * signal only if its value actually changed. Then the notify callbacks
+ * of all signals whose value changed in the cycle run, each once, in
+ * dependency order.
+ *
+ * A signal can only depend on signals added before it, so the order of
+ * the ids is a topological order and cycles cannot be built; update() is
+ * a single forward pass starting at the first dirty signal.
+ *
+ * value() returns the state of the last update() for derived signals.
+ * set() called from a notify callback takes effect in the next update().
+ *
+ * Not thread-safe; AppInterface uses it on the UI thread.
+ *
+ * @date 18-Oct-2026
+ * @author Gangadhar Thalange
+ */
+
+#include <QVector>
+#include <functional>
+#include <initializer_list>
+
+class SignalGraph
+{
+public:
+    using SignalId = int;
+
+    /**
+     * @brief Computes a derived value from value() of its inputs.
+     */
+    using Compute = std::function<double()>;
+
+    /**
+     * @brief Called with the new value after it changed.
+     */
+    using Notify = std::function<void(double)>;
+
+    SignalGraph() = default;
+
+    SignalGraph(const SignalGraph &) = delete;
+    SignalGraph &operator=(const SignalGraph &) = delete;
+
+    /**
+     * @brief Adds an input with the value @p initial.
+     */
+    SignalId addInput(double initial = 0.0, Notify notify = Notify());
+
+    /**
+     * @brief Adds a signal computed from @p inputs.
+     *
+     * The value is computed at once; @p notify is not called for it.
+     *
+     * @param inputs Signals @p compute reads; all must exist already.
+     * @return Signal id, or -1 if an input does not exist.
+     */
+    SignalId addDerived(std::initializer_list<SignalId> inputs, Compute compute,
+                        Notify notify = Notify());
+
+    /**
+     * @brief Sets an input; marks its dependents dirty if the value changed.
+     */
+    void set(SignalId input, double value);
+
+    /**
+     * @brief Returns the value of @p id as of the last update() (or set()
+     *        for inputs), 0 if it does not exist.
+     */
+    double value(SignalId id) const;
+
+    /**
+     * @brief Recomputes the dirty signals and notifies the changed ones.
+     *
+     * @return Number of signals whose value changed in the cycle.
+     */
+    int update();
+
+    /**
+     * @brief Returns whether update() has work to do.
+     */
+    bool isDirty() const { return m_firstDirty < m_nodes.size(); }
+
+    /**
+     * @brief Returns how many times a derived value was computed.
+     */
+    quint64 computeCount() const { return m_computes; }
+
+    int size() const { return m_nodes.size(); }
+
+private:
+    struct Node {
+        double value = 0.0;
+        Compute compute;            /**< Empty for inputs */
+        Notify notify;
+        QVector<SignalId> dependents;
+        bool dirty = false;         /**< Needs compute() */
+        bool changed = false;       /**< Value changed this cycle */
+    };
+
+    bool contains(SignalId id) const { return id >= 0 && id < m_nodes.size(); }
+
+    /**
+     * @brief Marks the dependents of @p id dirty.
+     */
+    void markDependents(SignalId id);
+
+    /**
+     * @brief Lowers the start of the next update() pass to @p id.
+     */
+    void touch(SignalId id);
+
+    QVector<Node> m_nodes;
+    int m_firstDirty = 0;           ///< First node update() must visit
+    quint64 m_computes = 0;
+};
+
+#endif // SIGNALGRAPH_H
@@ -0,0 +1,109 @@
+#ifndef SPSCRING_H
+#define SPSCRING_H
+/**
+ * @file spscring.h
+ * @brief Bounded single-producer / single-consumer ring buffer.
+ *
+ * Lock-free hand-off between exactly one producer thread and one consumer
+ * thread. Storage is allocated once in the constructor; tryPush() and
+ * tryPop() never allocate, lock or block, so the ring can be fed from a
+ * latency-sensitive thread such as the ZMQ ingest loop.
+ *
+ * @date 18-Oct-2026
+ * @author Gangadhar Thalange
+ */
+
+#include <atomic>
+#include <cstddef>
+#include <type_traits>
+#include <vector>
+
+template <typename T>
+class SpscRing
+{
+    static_assert(std::is_trivially_copyable<T>::value,
+                  "SpscRing elements are copied with plain assignment");
+
+public:
+    /**
+     * @brief Constructs a ring holding at least @p capacity elements.
+     *
+     * The capacity is rounded up to a power of two so that indices can be
+     * masked instead of divided.
+     *
+     * @param capacity Minimum number of elements.
+     */
+    explicit SpscRing(size_t capacity)
+    {
+        size_t size = 2;
+        while (size < capacity)
+            size <<= 1;
+        m_buffer.resize(size);
+        m_mask = size - 1;
+    }
+
+    SpscRing(const SpscRing &) = delete;
+    SpscRing &operator=(const SpscRing &) = delete;
+
+    /**
+     * @brief Appends an element. Producer thread only.
+     * @return false if the ring is full; the element is not stored.
+     */
+    bool tryPush(const T &value)
+    {
+        const size_t head = m_head.load(std::memory_order_relaxed);
+        if (head - m_cachedTail > m_mask) {
+            m_cachedTail = m_tail.load(std::memory_order_acquire);
+            if (head - m_cachedTail > m_mask)
+                return false;
+        }
+        m_buffer[head & m_mask] = value;
+        m_head.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * @brief Removes the oldest element. Consumer thread only.
+     * @return false if the ring is empty.
+     */
+    bool tryPop(T &value)
+    {
+        const size_t tail = m_tail.load(std::memory_order_relaxed);
+        if (tail == m_cachedHead) {
+            m_cachedHead = m_head.load(std::memory_order_acquire);
+            if (tail == m_cachedHead)
+                return false;
+        }
+        value = m_buffer[tail & m_mask];
+        m_tail.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * @brief Returns the number of slots.
+     */
+    size_t capacity() const { return m_mask + 1; }
+
+    /**
+     * @brief Returns the approximate number of queued elements.
+     */
+    size_t size() const
+    {
+        return m_head.load(std::memory_order_acquire)
+             - m_tail.load(std::memory_order_acquire);
+    }
+
+private:
+    std::vector<T> m_buffer;
+    size_t m_mask = 0;
+
+    // Producer and consumer indices live on separate cache lines; each
+    // side keeps a cached copy of the other's index to avoid touching
+    // the shared line on every operation.
+    alignas(64) std::atomic<size_t> m_head{0};
+    size_t m_cachedTail = 0;
+    alignas(64) std::atomic<size_t> m_tail{0};
+    size_t m_cachedHead = 0;
+};
+
+#endif // SPSCRING_H
@@ -0,0 +1,121 @@
+#ifndef THREADCONFIG_H
+#define THREADCONFIG_H
+/**
+ * @file threadconfig.h
+ * @brief Declaration of the ThreadConfig real-time thread settings.
+ *
+ * ThreadConfig describes how a worker thread (ingest, decode) should be
+ * scheduled: the CPU it is pinned to, the scheduling policy and priority
+ * (SCHED_FIFO / SCHED_RR) and whether process memory is locked with
+ * mlockall(). The settings are applied from inside the thread itself and
+ * every step falls back gracefully: a missing permission leaves the thread
+ * at its default scheduling and is reported in the effective result
+ * instead of failing the thread.
+ *
+ * Settings are read from the SettingsService (ORG_NAME/APP_NAME):
+ * @code
+ * [Threads]
+ * ingest\cpu=2            ; -1 = no pinning
+ * ingest\policy=fifo      ; other | fifo | rr
+ * ingest\priority=50      ; 1..99 for fifo/rr
+ * ingest\lockMemory=true
+ * @endcode
+ *
+ * @date 18-Oct-2026
+ * @author Gangadhar Thalange
+ */
+
+#include <QString>
+#include <QStringList>
+#include <QVariantMap>
+
+class ThreadConfig
+{
+public:
+    /**
+     * @enum Policy
+     * @brief Scheduling policy requested for the thread.
+     */
+    enum Policy {
+        PolicyDefault = 0,  /**< SCHED_OTHER, no change */
+        PolicyFifo,         /**< SCHED_FIFO real-time */
+        PolicyRoundRobin    /**< SCHED_RR real-time */
+    };
+
+    /**
+     * @struct Effective
+     * @brief Settings actually in force after apply(), for diagnostics.
+     */
+    struct Effective {
+        bool applied = false;       /**< apply() has run on the thread */
+        int cpu = -1;               /**< Pinned CPU, -1 if not pinned to one core */
+        Policy policy = PolicyDefault; /**< Policy in force */
+        int priority = 0;           /**< Real-time priority in force */
+        bool memoryLocked = false;  /**< mlockall() succeeded */
+        QStringList errors;         /**< Reasons a requested setting was not applied */
+
+        /**
+         * @brief Converts the result to a map for QML/diagnostics.
+         */
+        QVariantMap toVariantMap() const;
+    };
+
+    /**
+     * @brief CPU index to pin the thread to, -1 for no pinning.
+     */
+    int cpu = -1;
+
+    /**
+     * @brief Requested scheduling policy.
+     */
+    Policy policy = PolicyDefault;
+
+    /**
+     * @brief Requested real-time priority (1..99, FIFO/RR only).
+     */
+    int priority = 0;
+
+    /**
+     * @brief Lock current and future process memory with mlockall().
+     *
+     * mlockall() is process-wide; the first thread requesting it locks
+     * memory for the whole application.
+     */
+    bool lockMemory = false;
+
+    /**
+     * @brief Reads the settings of a named thread from the SettingsService.
+     *
+     * @param name Thread name used as key prefix (e.g. "ingest", "decode").
+     * @return Configuration; defaults when nothing is configured.
+     */
+    static ThreadConfig fromSettings(const QString &name);
+
+    /**
+     * @brief Returns true if no setting differs from the defaults.
+     */
+    bool isDefault() const;
+
+    /**
+     * @brief Applies the configuration to the calling thread.
+     *
+     * Each step is attempted independently; failures (EPERM, invalid CPU,
+     * unsupported platform) are collected in Effective::errors and leave
+     * the corresponding setting at its default.
+     *
+     * @return Effective settings as queried back from the system.
+     */
+    Effective apply() const;
+
+    /**
+     * @brief Returns the lower-case name of a policy ("other", "fifo", "rr").
+     */
+    static QString policyName(Policy policy);
+
+    /**
+     * @brief Parses a policy name; unknown names map to PolicyDefault.
+     */
+    static Policy policyFromName(const QString &name);
+};
+
+#endif // THREADCONFIG_H
@@ -0,0 +1,156 @@
+#ifndef TRIPCOMPUTER_H
+#define TRIPCOMPUTER_H
+/**
+ * @file tripcomputer.h
+ * @brief Time-based integration of the trip counters.
+ *
+ * TripComputer is fed every frame on the frame source's thread (ingest or
+ * replay) and decodes only the rate frames it needs:
+ *
+ * - fuel rate (CAN_ID_FUELRATE, 0.05 L/h per bit) is integrated into
+ *   fuel usage
+ * - DEF rate (CAN_ID_DEFRATE, per hour) is integrated into DEF usage
+ * - engine load (CAN_ID_ENGINELOAD, %) and fuel rate are averaged over
+ *   configurable sliding windows (RollingAverage)
+ *
+ * Integration uses the trapezoidal rule over the monotonic times of
+ * consecutive frames, so the result depends on elapsed time and not on
+ * how often frames arrive or whether the value changed. Live frames are
+ * timed on arrival; replayed frames carry their recorded time, so the
+ * replay speed does not change the result. An interval longer than the
+ * maximum gap (source stopped, cable pulled) is not integrated: the rate
+ * during it is unknown. The rate signals are assumed to be broadcast
+ * periodically whether they change or not, as a J1939 ECU does every
+ * 100 ms (and HMITestApp does); the default gap of 2 s tolerates a few
+ * lost frames, and TripComputer/maxGapMs raises it for slower sources.
+ * A time before the previous frame means the clock
+ * restarted (a looping replay, another source): the samples and averages
+ * start over.
+ *
+ * results() is read by the UI thread at a low fixed rate; the setters
+ * seed the counters after a trip reset or restore. All methods are
+ * thread-safe.
+ *
+ * @date 18-Oct-2026
+ * @author Gangadhar Thalange
+ */
+
+#include <QByteArray>
+#include <QVariantMap>
+#include <cstdint>
+#include <mutex>
+#include "rollingaverage.h"
+
+class TripComputer
+{
+public:
+    static constexpr qint64 DEFAULT_ENGINE_LOAD_WINDOW_MS = 10 * 60 * 1000;
+    static constexpr qint64 DEFAULT_FUEL_RATE_WINDOW_MS = 60 * 1000;
+    static constexpr qint64 DEFAULT_MAX_GAP_MS = 2000;
+
+    /**
+     * @struct Results
+     * @brief Counters and averages as of the latest frame.
+     */
+    struct Results {
+        double fuelUsage = 0.0;         /**< Litres since the trip reset */
+        double defUsage = 0.0;          /**< DEF used since the trip reset */
+        double avgEngineLoad = 0.0;     /**< Percent over the engine load window */
+        double avgFuelRate = 0.0;       /**< L/h over the fuel rate window */
+        bool hasEngineLoad = false;     /**< avgEngineLoad covers any time */
+        quint64 frames = 0;             /**< Rate frames seen */
+        quint64 gaps = 0;               /**< Intervals not integrated */
+
+        /**
+         * @brief Returns the results as a map for diagnostics.
+         */
+        QVariantMap toVariantMap() const;
+    };
+
+    TripComputer();
+
+    TripComputer(const TripComputer &) = delete;
+    TripComputer &operator=(const TripComputer &) = delete;
+
+    /**
+     * @brief Processes a frame received now. Ignores unrelated frames.
+     */
+    void onFrame(uint32_t id, const QByteArray &payload);
+
+    /**
+     * @brief Processes a frame of time @p nowNs on a monotonic clock.
+     */
+    void onFrame(uint32_t id, const QByteArray &payload, qint64 nowNs);
+
+    /**
+     * @brief Returns the counters and averages.
+     */
+    Results results() const;
+
+    /**
+     * @brief Sets the fuel usage, e.g. 0 on a trip reset.
+     */
+    void setFuelUsage(double litres);
+
+    /**
+     * @brief Sets the DEF usage, e.g. 0 on a trip reset.
+     */
+    void setDefUsage(double usage);
+
+    /**
+     * @brief Drops the engine load history.
+     */
+    void resetEngineLoad();
+
+    /**
+     * @brief Sets the engine load averaging window; drops its history.
+     */
+    void setEngineLoadWindowMs(qint64 milliseconds);
+
+    /**
+     * @brief Sets the fuel rate averaging window; drops its history.
+     */
+    void setFuelRateWindowMs(qint64 milliseconds);
+
+    /**
+     * @brief Sets the longest interval between two frames that is integrated.
+     */
+    void setMaxGapMs(qint64 milliseconds);
+
+private:
+    /**
+     * @brief Last sample of one rate signal.
+     */
+    struct Sample {
+        double value = 0.0;
+        qint64 timeNs = 0;
+        bool valid = false;
+    };
+
+    /**
+     * @brief Stores @p value as the latest sample of @p sample.
+     *
+     * @return Length of the interval since the previous sample, 0 if it
+     *         must not be integrated.
+     */
+    qint64 advance(Sample &sample, double value, qint64 nowNs);
+
+    /**
+     * @brief Starts the samples and averages over if @p nowNs lies before
+     *        the previous frame (caller holds m_mutex).
+     */
+    void checkClock(qint64 nowNs);
+
+    mutable std::mutex m_mutex;
+    Sample m_fuelRate;
+    Sample m_defRate;
+    Sample m_engineLoad;
+    RollingAverage m_fuelRateAverage;
+    RollingAverage m_engineLoadAverage;
+    Results m_results;
+    qint64 m_lastNs = 0;            ///< Time of the latest rate frame
+    bool m_hasLast = false;
+    qint64 m_maxGapNs = DEFAULT_MAX_GAP_MS * 1000000;
+};
+
+#endif // TRIPCOMPUTER_H
@@ -0,0 +1,227 @@
+#ifndef TRIPJOURNAL_H
+#define TRIPJOURNAL_H
+/**
+ * @file tripjournal.h
+ * @brief Crash-safe journal of the trip and usage counters.
+ *
+ * TripJournal keeps a small fixed-size file (`trip.journal`) mapped shared
+ * and appends one fixed-size Record per saved State: the last trip reset
+ * (engine hours and date), fuel usage and DEF usage. Every record holds
+ * the complete state, so the newest valid record is all a restart needs;
+ * older records are only kept as fallback for a record torn by a crash or
+ * power loss. Once the data area is full, appending continues at the first
+ * slot, so the file never grows and needs no separate compaction.
+ *
+ * File layout:
+ *
+ * @code
+ * Header      HEADER_SIZE bytes: magic, version, record size, slot count
+ * Data area   slots * sizeof(Record) bytes, written round robin
+ * @endcode
+ *
+ * Records carry a sequence number and a checksum; open() scans the data
+ * area once (64 KiB with the default slot count, a few microseconds) and
+ * keeps the valid record with the highest sequence for restore().
+ *
+ * record() only stores the state for a worker thread and returns; the
+ * worker writes at most one record per minimum interval, however often
+ * the counters change, and syncs the page to disk. flush() and close()
+ * write the last state at once.
+ *
+ * @date 18-Oct-2026
+ * @author Gangadhar Thalange
+ */
+
+#include <QFile>
+#include <QString>
+#include <QThread>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+
+class TripJournal
+{
+public:
+    static constexpr char MAGIC[8] = { 'N', 'G', 'T', 'R', 'I', 'P', 'J', '\0' };
+    static constexpr uint32_t VERSION = 1;
+    static constexpr uint32_t RECORD_MAGIC = 0x4A52544E;   // "NTRJ"
+    static constexpr qint64 HEADER_SIZE = 4096;
+    static constexpr int MIN_SLOTS = 16;
+    static constexpr int DEFAULT_SLOTS = 1024;
+
+    /**
+     * @brief Default minimum time between two records.
+     *
+     * Bounds both the disk writes and the counter changes a crash can lose.
+     */
+    static constexpr int DEFAULT_MIN_INTERVAL_MS = 5000;
+
+    /**
+     * @struct State
+     * @brief The persisted trip and usage counters.
+     */
+    struct State {
+        float lastTripHours = 0.0f; /**< Engine hours at the last trip reset */
+        float fuelUsage = 0.0f;     /**< Fuel used since the reset */
+        float defUsage = 0.0f;      /**< DEF used since the reset */
+        QString lastResetDate;      /**< Date of the last trip reset */
+
+        bool operator==(const State &other) const
+        {
+            return lastTripHours == other.lastTripHours && fuelUsage == other.fuelUsage
+                    && defUsage == other.defUsage && lastResetDate == other.lastResetDate;
+        }
+        bool operator!=(const State &other) const { return !(*this == other); }
+    };
+
+    /**
+     * @struct Header
+     * @brief Start of the journal file.
+     */
+    struct Header {
+        char magic[8];              /**< MAGIC */
+        uint32_t version;           /**< VERSION */
+        uint32_t headerSize;        /**< HEADER_SIZE */
+        uint32_t recordSize;        /**< sizeof(Record) */
+        uint32_t slots;             /**< Records in the data area */
+    };
+
+    /**
+     * @struct Record
+     * @brief One saved State in the data area.
+     */
+    struct Record {
+        uint32_t magic;             /**< RECORD_MAGIC, written last */
+        uint32_t checksum;          /**< FNV-1a of the bytes after this field */
+        uint64_t sequence;          /**< Increases by one per record */
+        int64_t savedUtcMs;         /**< Wall-clock time of the write */
+        float lastTripHours;
+        float fuelUsage;
+        float defUsage;
+        uint32_t reserved;          /**< Zero */
+        char lastResetDate[24];     /**< UTF-8, zero padded */
+    };
+
+    TripJournal();
+    ~TripJournal();
+
+    TripJournal(const TripJournal &) = delete;
+    TripJournal &operator=(const TripJournal &) = delete;
+
+    /**
+     * @brief Maps @p path, creating it with @p slots records if needed,
+     *        and finds the latest saved state.
+     *
+     * A file with another slot count or an unknown layout is recreated;
+     * its latest state, if readable, is carried over.
+     *
+     * @return false if the file cannot be created or mapped.
+     */
+    bool open(const QString &path, int slots = DEFAULT_SLOTS);
+
+    /**
+     * @brief Writes the pending state, stops the worker and unmaps the file.
+     */
+    void close();
+
+    bool isOpen() const { return m_header != nullptr; }
+
+    /**
+     * @brief Returns the path of the open journal, empty if none.
+     */
+    QString path() const { return isOpen() ? m_file.fileName() : QString(); }
+
+    /**
+     * @brief Returns the latest state found by open().
+     *
+     * @return false if the journal held no valid record.
+     */
+    bool restore(State *state) const;
+
+    /**
+     * @brief Returns how long open() took to find the latest state.
+     */
+    qint64 restoreNsecs() const { return m_restoreNs; }
+
+    /**
+     * @brief Queues @p state for the worker. Never blocks on I/O.
+     *
+     * An unchanged state is ignored. Only the last state queued within
+     * one minimum interval is written.
+     */
+    void record(const State &state);
+
+    /**
+     * @brief Writes the queued state now, on the calling thread.
+     */
+    void flush();
+
+    /**
+     * @brief Sets the minimum time between two records.
+     */
+    void setMinIntervalMs(int milliseconds);
+
+    /**
+     * @brief Returns the number of records written since open().
+     */
+    quint64 writeCount() const { return m_writes.load(); }
+
+    /**
+     * @brief Returns the latest state saved in the journal @p path.
+     *
+     * @param path Journal file, also while another process has it open.
+     * @param state Set to the latest valid state.
+     * @param errorString Set to the reason if no state can be read.
+     */
+    static bool read(const QString &path, State *state, QString *errorString = nullptr);
+
+    /**
+     * @brief Returns the checksum stored with a record.
+     */
+    static uint32_t checksum(const Record &record);
+
+private:
+    /**
+     * @brief Worker loop: writes queued states at most once per interval.
+     */
+    void run();
+
+    /**
+     * @brief Appends @p state (caller holds m_writeMutex).
+     */
+    void writeRecord(const State &state);
+
+    QFile m_file;
+    Header *m_header = nullptr;
+    Record *m_records = nullptr;
+    int m_slots = 0;
+
+    /**
+     * @brief Serializes writes to the mapping.
+     */
+    std::mutex m_writeMutex;
+    int m_nextSlot = 0;
+    uint64_t m_sequence = 0;        ///< Sequence of the latest record
+
+    /**
+     * @brief Queued state and worker control (protected by m_mutex).
+     */
+    std::mutex m_mutex;
+    State m_pending;                ///< Latest state passed to record()
+    bool m_dirty = false;           ///< m_pending is not written yet
+    bool m_idle = false;            ///< Worker waits for a change
+    bool m_stop = false;
+    int m_minIntervalMs = DEFAULT_MIN_INTERVAL_MS;
+    qint64 m_lastWriteMs = 0;
+    std::condition_variable m_changed;
+
+    bool m_restored = false;
+    State m_restoredState;
+    qint64 m_restoreNs = 0;
+
+    QThread m_thread;
+    std::atomic<quint64> m_writes{0};
+};
+
+#endif // TRIPJOURNAL_H
@@ -0,0 +1,163 @@
+#ifndef ZMQRECEIVER_H
+#define ZMQRECEIVER_H
+/**
+ * @file zmqreceiver.h
+ * @brief Declaration of the ZmqReceiver class.
+ *
+ * ZmqReceiver is the live FrameSource. It owns the ingest thread that receives CAN-like frames from the
+ * backend publisher over a ZMQ SUB socket. The receive loop waits in
+ * zmq::poll() on both the SUB socket and an inproc control socket, so a stop
+ * request wakes it immediately and the thread exits without
+ * QThread::terminate(). The thread can be pinned to a CPU and given a
+ * real-time policy through ThreadConfig. A CaptureRecorder can tap every
+ * received message before it is decoded.
+ *
+ * @date 18-Oct-2026
+ * @author Gangadhar Thalange
+ */
+
+#include <QThread>
+#include <QMutex>
+#include <QString>
+#include <zmq.hpp>
+#include "framesource.h"
+#include "threadconfig.h"
+
+class CaptureRecorder;
+
+class ZmqReceiver : public FrameSource
+{
+    Q_OBJECT
+public:
+    /**
+     * @brief Constructs a receiver for the given publisher endpoint.
+     *
+     * The ingest thread is not started until start() is called.
+     *
+     * @param endpoint ZMQ endpoint to connect to (e.g. "tcp://127.0.0.1:5555").
+     * @param parent Optional QObject parent.
+     */
+    explicit ZmqReceiver(const QString &endpoint, QObject *parent = nullptr);
+
+    /**
+     * @brief Destructor. Stops the ingest thread if it is running.
+     */
+    ~ZmqReceiver() override;
+
+    /**
+     * @brief Sets CPU affinity, scheduling and memory locking for the
+     *        ingest thread.
+     *
+     * Applied by the ingest thread itself when it starts, so it must be
+     * called before start().
+     *
+     * @param config Requested thread settings.
+     */
+    void setThreadConfig(const ThreadConfig &config);
+
+    /**
+     * @brief Returns the thread settings in force on the ingest thread.
+     *
+     * Effective::applied is false until the thread has started.
+     */
+    ThreadConfig::Effective effectiveThreadConfig() const;
+
+    /**
+     * @brief Sets the recorder receiving every message right after recv.
+     *
+     * The recorder is called on the ingest thread and must outlive the
+     * receiver's thread. Must be called before start().
+     *
+     * @param recorder Capture recorder, or nullptr to disable the tap.
+     */
+    void setRecorder(CaptureRecorder *recorder) { m_recorder = recorder; }
+
+    /**
+     * @brief Starts the ingest thread.
+     * @return false if the receiver is already running.
+     */
+    bool start() override;
+
+    /**
+     * @brief Stops the ingest thread and waits for it to exit.
+     *
+     * Sends a stop message over the inproc control socket, which wakes the
+     * poll in the receive loop. If the message cannot be delivered the ZMQ
+     * context is shut down instead, which also aborts the poll; the context
+     * is then recreated so the receiver can be started again. Never
+     * terminates the thread.
+     */
+    void stop() override;
+
+    /**
+     * @brief Returns whether the ingest thread is running.
+     */
+    bool isRunning() const override { return m_thread.isRunning(); }
+
+    /**
+     * @brief Returns the publisher endpoint this receiver connects to.
+     */
+    QString endpoint() const { return m_endpoint; }
+
+private:
+    /**
+     * @brief Receive loop executed on the ingest thread.
+     */
+    void run();
+
+    /**
+     * @brief Publisher endpoint.
+     */
+    QString m_endpoint;
+
+    /**
+     * @brief Per-run inproc endpoint of the control socket pair.
+     */
+    std::string m_controlEndpoint;
+
+    /**
+     * @brief Number of start() calls, used to make the endpoint unique.
+     */
+    quint64 m_generation = 0;
+
+    /**
+     * @brief Optional capture tap, not owned.
+     */
+    CaptureRecorder *m_recorder = nullptr;
+
+    /**
+     * @brief Requested ingest thread settings.
+     */
+    ThreadConfig m_threadConfig;
+
+    /**
+     * @brief Settings reported by the ingest thread after applying them.
+     */
+    ThreadConfig::Effective m_effectiveConfig;
+
+    /**
+     * @brief Protects m_effectiveConfig.
+     */
+    mutable QMutex m_configMutex;
+
+    /**
+     * @brief ZMQ context shared by the SUB socket and the control pair.
+     *
+     * inproc transport requires both control sockets to share a context.
+     */
+    zmq::context_t m_context{1};
+
+    /**
+     * @brief Sending end of the control pair, used from the owner thread.
+     *
+     * Created by every start().
+     */
+    zmq::socket_t m_control;
+
+    /**
+     * @brief Dedicated ingest thread.
+     */
+    QThread m_thread;
+};
+
+#endif // ZMQRECEIVER_H
@@ -6,6 +6,7 @@
  *  - configures Qt application attributes,
  *  - initializes the logging subsystem,
  *  - creates and configures the application interface and QML engine,
+ *  - optionally replaces the live ZMQ stream by a capture replay,
  *  - exposes context properties and singletons to QML,
  *  - loads the main QML file and enters the Qt event loop.
  *
@@ -20,8 +21,13 @@
 #include <QGuiApplication>
 #include <QQmlApplicationEngine>
 #include <QQmlContext>
+#include <QCommandLineParser>
+#include <QDir>
+#include <QStandardPaths>
 #include "./include/clogger.h"
 #include "./include/appinterface.h"
+#include "./include/replayframesource.h"
+#include "./include/settingsservice.h"
 
 
 
@@ -41,7 +47,11 @@
  *  3. Initialize cLogger singleton and set default logging levels for "NextGenApp".
  *     If logger initialization fails, a qCritical message is emitted but the
  *     application continues (logging may be limited).
- *  4. Instantiate AppInterface and QQmlApplicationEngine.
+ *  4. Instantiate AppInterface and QQmlApplicationEngine. With --replay the
+ *     frames come from a capture file instead of the ZMQ publisher
+ *     (--replay-speed, --replay-loop, --replay-start control the replay)
+ *     and the trip journal is not opened; otherwise the trip counters are
+ *     restored from it.
  *  5. Expose the following context properties to QML:
  *     - isPortrait : boolean determined by compile-time ORIENTATION macro.
  *     - appInterface: pointer to the AppInterface instance.
@@ -64,8 +74,28 @@ int main(int argc, char *argv[])
     // Construct the Qt GUI application instance
     QGuiApplication app(argc, argv);
 
+    // Application defaults of the logging options; a unit's settings
+    // (logAsync, logRateLimit, ...) override each of them
+    QVariantMap logDefaults;
+    // Format and write log lines on the logger's own thread so the
+    // GUI and ingest threads never wait on file I/O
+    logDefaults.insert("logAsync", true);
+    // A CAN storm must not turn into a disk-write storm
+    logDefaults.insert("logRateLimit", 20);
+    logDefaults.insert("logRateBurst", 50);
+    // Per-frame messages go to <log>.bin unformatted (tools/binlog_decode)
+    logDefaults.insert("logBinaryCategories", QStringList{ "ngapp.frames" });
+    // The last 1 MiB of lines survives a crash in <log>.ring, so the
+    // log file is no longer flushed after every line
+    logDefaults.insert("logFlightRecorderBytes", 1024 * 1024);
+    // Live lines for service tools (tools/logstream_tail), without
+    // tailing the log file
+    const QString runtimeDir = QStandardPaths::writableLocation(QStandardPaths::RuntimeLocation);
+    if (!runtimeDir.isEmpty())
+        logDefaults.insert("logStreamSocket", runtimeDir + "/NextGenApp.log.sock");
+
     // Initialize logger first to capture any startup errors
-    if (!cLogger::instance().init("NextGenApp_LOG")) {
+    if (!cLogger::instance().init("NextGenApp_LOG", logDefaults)) {
         // If initialization fails, emit a critical message and continue.
         qCritical() << "Failed to initialize logger. Application may not log properly.";
         // Continue execution but logging may be limited
@@ -73,10 +103,50 @@ int main(int argc, char *argv[])
         // Configure logger levels for the "NextGenApp" logger category.
         cLogger::instance().setLoggerLevel(QtDebugMsg,"NextGenApp");
         cLogger::instance().setLoggerLevel(QtWarningMsg,"NextGenApp");
+        QObject::connect(&app, &QCoreApplication::aboutToQuit,
+                         &cLogger::instance(), &cLogger::flush);
     }
 
+    // Settings changes are written in the background; write the rest on exit
+    QObject::connect(&app, &QCoreApplication::aboutToQuit,
+                     []() { SettingsService::instance().flush(); });
+
+    // Command line: optional replay of a capture file
+    QCommandLineParser parser;
+    parser.addHelpOption();
+    const QCommandLineOption replayOption("replay",
+        "Decode frames from capture <file> instead of the ZMQ publisher.", "file");
+    const QCommandLineOption speedOption("replay-speed",
+        "Replay speed factor, 0 = as fast as possible (default 1).", "factor", "1");
+    const QCommandLineOption loopOption("replay-loop",
+        "Restart the replay after the last frame.");
+    const QCommandLineOption startOption("replay-start",
+        "Start the replay <seconds> into the capture.", "seconds", "0");
+    parser.addOptions({ replayOption, speedOption, loopOption, startOption });
+    parser.process(app);
+
     // Create the application interface that will be exposed to QML
     AppInterface appIf;
+
+    if (!parser.isSet(replayOption)) {
+        // Trip and usage counters survive restarts and power loss
+        const QString dataDir = QStandardPaths::writableLocation(QStandardPaths::AppDataLocation);
+        if (dataDir.isEmpty() || !QDir().mkpath(dataDir) || !appIf.openTripJournal(dataDir + "/trip.journal"))
+            qWarning() << "Trip counters are not saved: no trip journal in" << dataDir;
+    } else {
+        // Counters integrated from a capture must not replace the vehicle's
+        // saved ones, so replay runs without a trip journal.
+
+        // Owned by appIf, which stops it before destruction
+        ReplayFrameSource *replay = new ReplayFrameSource(parser.value(replayOption), &appIf);
+        replay->setSpeed(parser.value(speedOption).toDouble());
+        replay->setLoop(parser.isSet(loopOption));
+        replay->setStartOffsetMs(qint64(parser.value(startOption).toDouble() * 1000.0));
+        if (!appIf.setFrameSource(replay)) {
+            qCritical() << "Cannot replay" << parser.value(replayOption) << ":" << replay->errorString();
+            return -1;
+        }
+    }
     // Create the QML application engine responsible for loading QML UI
     QQmlApplicationEngine engine;
     const QUrl url(QStringLiteral("qrc:/main.qml"));
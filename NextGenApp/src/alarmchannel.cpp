@@ -0,0 +1,184 @@
+/**
+ * @file src/alarmchannel.cpp
+ * @brief Implementation of the AlarmChannel class.
+ *
+ * Producers push into the MpscQueue and only take the wake mutex when
+ * the worker is asleep, the same hand-over the cLogger writer uses.
+ *
+ * @date 18-Oct-2026
+ * @author Gangadhar Thalange
+ */
+
+#include "../include/alarmchannel.h"
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+
+// The worker also wakes up on its own, so a lost notification only
+// delays an alarm by this much
+static const int workerIdleTimeoutMs = 100;
+
+QVariantMap AlarmChannel::Stats::toVariantMap() const
+{
+    QVariantMap map;
+    map.insert("posted", posted);
+    map.insert("delivered", delivered);
+    map.insert("dropped", dropped);
+    map.insert("deadlineMisses", deadlineMisses);
+    map.insert("deadlineUs", deadlineUs);
+    map.insert("p50Us", p50Us);
+    map.insert("p99Us", p99Us);
+    map.insert("maxUs", maxUs);
+    return map;
+}
+
+AlarmChannel::AlarmChannel(int capacity)
+    : m_queue(size_t(qMax(2, capacity)))
+{
+    m_thread.setObjectName("AlarmChannel");
+    QObject::connect(&m_thread, &QThread::started, [this]() { run(); });
+    m_latencies.reserve(LATENCY_WINDOW);
+}
+
+AlarmChannel::~AlarmChannel()
+{
+    stop();
+}
+
+void AlarmChannel::setConsumer(Consumer consumer)
+{
+    m_consumer = std::move(consumer);
+}
+
+void AlarmChannel::setDeadlineUs(qint64 deadlineUs)
+{
+    m_deadlineUs.store(qMax<qint64>(1, deadlineUs));
+}
+
+void AlarmChannel::start()
+{
+    if (m_thread.isRunning())
+        return;
+    m_stop.store(false);
+    m_thread.start(QThread::TimeCriticalPriority);
+}
+
+void AlarmChannel::stop()
+{
+    if (!m_thread.isRunning())
+        return;
+    m_stop.store(true);
+    wake();
+    m_thread.wait();
+}
+
+qint64 AlarmChannel::now()
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+bool AlarmChannel::post(Alarm &&alarm)
+{
+    alarm.postedNs = now();
+    if (!m_thread.isRunning()) {
+        m_posted.fetch_add(1, std::memory_order_relaxed);
+        std::lock_guard<std::mutex> lock(m_deliverMutex);
+        deliver(alarm);
+        return true;
+    }
+    if (!m_queue.tryPush(std::move(alarm))) {
+        m_dropped.fetch_add(1, std::memory_order_relaxed);
+        std::cerr << "AlarmChannel: Queue full, alarm dropped: "
+                  << alarm.message.toLocal8Bit().constData() << std::endl;
+        return false;
+    }
+    m_posted.fetch_add(1, std::memory_order_relaxed);
+    // Pairs with the fence in run(). The push is only a release store, so
+    // without a full fence m_sleeping could be read before the alarm is
+    // visible, and the worker would sleep for workerIdleTimeoutMs.
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    // Only pay for the mutex/notify when the worker is actually waiting
+    if (m_sleeping.load(std::memory_order_relaxed))
+        wake();
+    return true;
+}
+
+void AlarmChannel::wake()
+{
+    std::lock_guard<std::mutex> lock(m_wakeMutex);
+    m_wakeCondition.notify_one();
+}
+
+void AlarmChannel::run()
+{
+    Alarm alarm;
+    for (;;) {
+        bool delivered = false;
+        while (m_queue.tryPop(alarm)) {
+            deliver(alarm);
+            delivered = true;
+        }
+        if (delivered)
+            continue;
+        if (m_stop.load())
+            break;
+
+        // Producers check m_sleeping after pushing, and both sides fence
+        // between their store and their load, so either they see it set or
+        // the second tryPop() sees their alarm.
+        std::unique_lock<std::mutex> lock(m_wakeMutex);
+        m_sleeping.store(true, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (m_queue.tryPop(alarm)) {
+            m_sleeping.store(false);
+            lock.unlock();
+            deliver(alarm);
+            continue;
+        }
+        if (!m_stop.load())
+            m_wakeCondition.wait_for(lock, std::chrono::milliseconds(workerIdleTimeoutMs));
+        m_sleeping.store(false);
+    }
+}
+
+void AlarmChannel::deliver(const Alarm &alarm)
+{
+    if (m_consumer)
+        m_consumer(alarm);
+    const qint64 latencyUs = (now() - alarm.postedNs) / 1000;
+    m_delivered.fetch_add(1, std::memory_order_relaxed);
+    if (latencyUs > m_deadlineUs.load(std::memory_order_relaxed))
+        m_deadlineMisses.fetch_add(1, std::memory_order_relaxed);
+
+    std::lock_guard<std::mutex> lock(m_statsMutex);
+    if (m_latencies.size() < size_t(LATENCY_WINDOW))
+        m_latencies.push_back(latencyUs);
+    else
+        m_latencies[m_latencyNext] = latencyUs;
+    m_latencyNext = (m_latencyNext + 1) % size_t(LATENCY_WINDOW);
+    m_maxUs = qMax(m_maxUs, latencyUs);
+}
+
+AlarmChannel::Stats AlarmChannel::stats() const
+{
+    Stats stats;
+    stats.posted = m_posted.load();
+    stats.delivered = m_delivered.load();
+    stats.dropped = m_dropped.load();
+    stats.deadlineMisses = m_deadlineMisses.load();
+    stats.deadlineUs = m_deadlineUs.load();
+
+    std::vector<qint64> latencies;
+    {
+        std::lock_guard<std::mutex> lock(m_statsMutex);
+        latencies = m_latencies;
+        stats.maxUs = m_maxUs;
+    }
+    if (!latencies.empty()) {
+        std::sort(latencies.begin(), latencies.end());
+        stats.p50Us = latencies[latencies.size() / 2];
+        stats.p99Us = latencies[std::min(latencies.size() - 1, latencies.size() * 99 / 100)];
+    }
+    return stats;
+}
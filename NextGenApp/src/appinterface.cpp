@@ -19,7 +19,15 @@
 #include <QByteArray>
 #include <QDebug>
 #include "../include/constants.h"
+#include "../include/clogger.h"
+#include "../include/binlog.h"
+#include "../include/logtrace.h"
+#include "../include/settingsservice.h"
 
+// Per-frame messages; logged in binary form while selected (see main.cpp)
+Q_LOGGING_CATEGORY(lcFrames, "ngapp.frames")
+// Button frames published to the controller
+Q_LOGGING_CATEGORY(lcButtons, "ngapp.buttons")
 
 /**
  * @brief Constructs an AppInterface instance.
@@ -82,6 +90,7 @@ static float percentToLiters(int percent)
  */
 AppInterface::AppInterface(QObject *parent)
     : QObject(parent)
+    , m_receiver(LOCAL_HOST_IP)
 {
     #ifndef UNIT_TEST
         m_buttonPublisher.bind("tcp://*:5556");
@@ -89,137 +98,170 @@ AppInterface::AppInterface(QObject *parent)
     #else
         // Skip ZMQ socket setup in unit tests
     #endif
+    initSignals();
     setLastResetDate(LAST_RESET_DATE);
     setLastTripHours(0.0f);
+
+    // ================= TRIP COMPUTER =================
+    // Usage is integrated on every rate frame off the UI thread; the
+    // properties follow at a fixed low rate.
+    m_tripComputer.setEngineLoadWindowMs(SettingsService::instance().value(
+        "TripComputer/engineLoadWindowMs", TripComputer::DEFAULT_ENGINE_LOAD_WINDOW_MS).toLongLong());
+    m_tripComputer.setFuelRateWindowMs(SettingsService::instance().value(
+        "TripComputer/fuelRateWindowMs", TripComputer::DEFAULT_FUEL_RATE_WINDOW_MS).toLongLong());
+    m_tripComputer.setMaxGapMs(SettingsService::instance().value(
+        "TripComputer/maxGapMs", TripComputer::DEFAULT_MAX_GAP_MS).toLongLong());
+    m_tripTask = Scheduler::instance().schedulePeriodic(
+        TRIP_PUBLISH_INTERVAL_MS, [this]() { publishTripResults(); }, TRIP_PUBLISH_INTERVAL_MS / 10);
+
     // ================= TIME SERVICE =================
-    m_timeTimer = new QTimer(this);
+    // "hh:mm AP" only changes on minute boundaries, so refresh exactly there
+    // instead of reformatting the time every second.
+    m_clockTask = Scheduler::instance().scheduleWallClockAligned(
+        60 * 1000, [this]() { updateCurrentTime(); });
 
-    connect(m_timeTimer, &QTimer::timeout, this, [this]() {
-        QString newTime = QDateTime::currentDateTime().toString("hh:mm AP");
+    // Set immediately (no wait for the first boundary)
+    updateCurrentTime();
+}
 
-        if (newTime != m_currentTime) {
-            m_currentTime = newTime;
-            emit currentTimeChanged();
-        }
-    });
+/**
+ * @brief Declares the derived values and their inputs.
+ *
+ * tripHours = max(0, engineHours - lastTripHours)
+ */
+void AppInterface::initSignals()
+{
+    m_engineHoursSignal = m_signals.addInput(m_engineHours);
+    m_lastTripHoursSignal = m_signals.addInput(m_lastTripHours);
+    m_tripHoursSignal = m_signals.addDerived(
+        { m_engineHoursSignal, m_lastTripHoursSignal },
+        [this]() {
+            return qMax(0.0, m_signals.value(m_engineHoursSignal) - m_signals.value(m_lastTripHoursSignal));
+        },
+        [this](double hours) {
+            m_tripHours = float(hours);
+            emit tripHoursChanged();
+        });
+}
 
-    m_timeTimer->start(1000);
+/**
+ * @brief Refreshes the displayed wall-clock time.
+ *
+ * Emits currentTimeChanged() only if the formatted text changed.
+ */
+void AppInterface::updateCurrentTime()
+{
+    QString newTime = QDateTime::currentDateTime().toString("hh:mm AP");
 
-    // Set immediately (no 1s delay)
-    m_currentTime = QDateTime::currentDateTime().toString("hh:mm AP");
-    emit currentTimeChanged();
+    if (newTime != m_currentTime) {
+        m_currentTime = newTime;
+        emit currentTimeChanged();
+    }
 }
 
 /**
  * @brief Initializes ZMQ communication infrastructure.
  *
- * Sets up the ZMQ subscriber thread and frame processing timer.
- * The subscriber thread will handle blocking ZMQ operations,
- * while the timer processes queued frames in the UI thread.
+ * Starts the ZmqReceiver ingest thread, which connects to the backend
+ * publisher (LOCAL_HOST_IP) and hands every valid frame to
+ * enqueueFrame(). The UI thread is only woken when frames are pending,
+ * so no polling timer is needed.
  *
- * @note Timer interval is set to 5ms for responsive frame processing.
- * @note ZMQ thread uses DirectConnection for signal/slot communication.
- * @note Timer is parented to this object for automatic cleanup.
+ * CPU affinity and real-time scheduling of the ingest thread are read
+ * from the "Threads/ingest" settings group.
  */
 void AppInterface::initZmq()
 {
+    m_receiver.setThreadConfig(ThreadConfig::fromSettings("ingest"));
+    m_receiver.setRecorder(&m_capture);
+    setFrameSource(&m_receiver);
+}
 
-    connect(&m_zmqThread, &QThread::started,
-            this, &AppInterface::startZmqSubscriber,
-            Qt::DirectConnection);
-
+/**
+ * @brief Switches the frame source.
+ *
+ * The previous source is stopped first, so frames of both sources never
+ * interleave in the queue.
+ *
+ * @param source New frame source; nullptr selects the live receiver.
+ * @return True if the new source started.
+ */
+bool AppInterface::setFrameSource(FrameSource *source)
+{
+    if (!source)
+        source = &m_receiver;
 
-    m_queueTimer = new QTimer(this);
-    connect(m_queueTimer, &QTimer::timeout,
-            this, &AppInterface::processQueue);
-    m_queueTimer->start(5);
+    if (m_source)
+        m_source->stop();
 
-    m_zmqThread.start();
+    m_source = source;
+    m_source->setTimedFrameHandler([this](uint32_t id, const QByteArray &payload, qint64 timeNs) {
+        enqueueFrame(id, payload, timeNs);
+    });
+    return m_source->start();
 }
 
-
-
 /**
- * @brief Entry point for ZMQ subscriber thread.
+ * @brief Queues a received frame for decoding on the UI thread.
  *
- * Creates a ZMQ context and SUB socket, connects to the backend
- * publisher, and continuously receives CAN-like frames. Each received
- * frame is validated and enqueued for processing by the UI thread.
+ * Runs on the frame source's thread (ingest or replay). Rate frames are
+ * integrated by the trip computer here, at the source's time stamp or,
+ * for live frames, at their arrival time.
  *
- * This function runs in a dedicated thread to prevent blocking the UI.
- * It continues until the thread receives an interruption request.
+ * @param id Frame identifier (CAN/ZMQ ID).
+ * @param payload Raw 8-byte CAN payload data.
+ * @param timeNs Frame time from the source, or FrameSource::NO_TIMESTAMP.
  *
- * @note Connects to LOCAL_HOST_IP (localhost).
- * @note Subscribes to all messages (empty filter).
- * @note Minimum message size is 12 bytes (4-byte ID + 8-byte payload).
  * @note Thread-safe enqueueing using m_queueMutex.
+ * @note processQueue() is posted only when the queue turns non-empty,
+ *       so a burst of frames costs a single UI-thread wakeup.
  */
-void AppInterface::startZmqSubscriber()
+void AppInterface::enqueueFrame(uint32_t id, const QByteArray &payload, qint64 timeNs)
 {
-    zmq::context_t context(1);
-    zmq::socket_t subscriber(context, zmq::socket_type::sub);
+    if (timeNs == FrameSource::NO_TIMESTAMP)
+        m_tripComputer.onFrame(id, payload);
+    else
+        m_tripComputer.onFrame(id, payload, timeNs);
 
-
-    try {
-        subscriber.connect(LOCAL_HOST_IP); //localhost IP
-        subscriber.set(zmq::sockopt::subscribe, "");
-    } catch (const zmq::error_t& e) {
-        qCritical("ZMQ connection failed: %s", e.what());
-        return;
+    bool wasEmpty;
+    {
+        QMutexLocker locker(&m_queueMutex);
+        wasEmpty = m_frameQueue.isEmpty();
+        m_frameQueue.enqueue({id, payload});
     }
 
-    while (!QThread::currentThread()->isInterruptionRequested()) {
-
-        zmq::message_t msg;
-        if (!subscriber.recv(msg, zmq::recv_flags::none))
-            continue;
-
-        if (msg.size() < 12) {
-            qWarning("Received ZMQ message too small: %zu bytes", msg.size());
-            continue;
-        }
-
-        uint32_t id;
-        memcpy(&id, msg.data(), 4);
-
-        QByteArray payload(
-            static_cast<char*>(msg.data()) + 4, 8);
-
-        {
-            QMutexLocker locker(&m_queueMutex);
-            m_frameQueue.enqueue({id, payload});
-        }
-    }
+    if (wasEmpty)
+        QMetaObject::invokeMethod(this, &AppInterface::processQueue, Qt::QueuedConnection);
 }
 
 
 
 
 /**
- * @brief Processes queued frames periodically.
+ * @brief Processes all queued frames.
  *
- * Called by the QTimer every 5ms. Dequeues one frame from the
- * thread-safe queue and forwards it to processFrame() for decoding.
- * This ensures frame processing happens in the UI thread, allowing
- * safe property updates and signal emissions.
+ * Posted by the ZMQ thread when the queue turns non-empty. Takes the
+ * whole queue in one swap and forwards each frame to processFrame()
+ * for decoding. This ensures frame processing happens in the UI thread,
+ * allowing safe property updates and signal emissions.
  *
  * @note This method runs in the main/UI thread.
- * @note Uses QMutexLocker for thread-safe queue access.
- * @note Returns immediately if queue is empty.
+ * @note The mutex is held only for the swap, not while decoding.
+ * @note Derived values are recomputed once per batch, after all frames.
  */
 void AppInterface::processQueue()
 {
-    QPair<uint32_t, QByteArray> frame;
+    QQueue<QPair<uint32_t, QByteArray>> frames;
 
     {
         QMutexLocker locker(&m_queueMutex);
-        if (m_frameQueue.isEmpty())
-            return;
-
-        frame = m_frameQueue.dequeue();
+        frames.swap(m_frameQueue);
     }
 
-    processFrame(frame.first, frame.second);
+    for (const auto &frame : std::as_const(frames))
+        processFrame(frame.first, frame.second);
+
+    m_signals.update();
 }
 
 /**
@@ -246,7 +288,7 @@ void AppInterface::processFrame(uint32_t id, const QByteArray &payload)
         return;
 
     if (payload.isNull() || payload.isEmpty()) {
-        qWarning("Null or empty payload");
+        NG_WARNING(lcFrames, "Null or empty payload");
         return;
     }
 
@@ -270,7 +312,7 @@ void AppInterface::processFrame(uint32_t id, const QByteArray &payload)
         int index = id - CAN_ID_TELLTALES;
 
         if (index < 0 || index >= TelltaleCount) {
-            qWarning("Invalid telltale index") ;
+            NG_WARNING(lcFrames, "Invalid telltale index");
             return;
         }
 
@@ -287,10 +329,10 @@ void AppInterface::processFrame(uint32_t id, const QByteArray &payload)
 
         if (rawPopup != m_popup) {
             m_popup = rawPopup;
-            qDebug("popTriggred recieved");
+            NG_DEBUG(lcFrames, "popTriggred recieved");
             emit popupTriggred();
             emit popupChanged();
-            qDebug()<<"value: "<< m_popup;
+            NG_DEBUG(lcFrames) << "value: " << m_popup;
 
         }
         return;
@@ -349,11 +391,8 @@ void AppInterface::processFrame(uint32_t id, const QByteArray &payload)
             m_engineHours = hours;
             emit engineHoursChanged();
 
-            // Recalculate trip hours
-            m_tripHours = m_engineHours - m_lastTripHours;
-            if (m_tripHours < 0) m_tripHours = 0;
-
-            emit tripHoursChanged();
+            // Trip hours follow in processQueue()
+            m_signals.set(m_engineHoursSignal, m_engineHours);
         }
         return;
     }
@@ -364,7 +403,8 @@ void AppInterface::processFrame(uint32_t id, const QByteArray &payload)
         int index = id - CAN_ID_BTN_BASE;
         bool pressed = buf[7] & 0x01;
 
-        qDebug()<<"[MAIN] Safety Button Index:"<<index <<"State:" << pressed;
+        NG_BINLOG(lcFrames, QtDebugMsg, "[MAIN] Safety Button Index: %d State: %s",
+                  index, pressed ? "true" : "false");
 
         switch (index) {
 
@@ -383,7 +423,7 @@ void AppInterface::processFrame(uint32_t id, const QByteArray &payload)
             break;
 
         default:
-            qWarning()<<"[MAIN] Unknown Safety Button index:" <<index;
+            NG_WARNING(lcFrames) << "[MAIN] Unknown Safety Button index:" << index;
             break;
         }
 
@@ -394,12 +434,10 @@ void AppInterface::processFrame(uint32_t id, const QByteArray &payload)
         int fuelRate = (buf[6] << 8) | buf[7];
 
 
+        // Fuel usage is integrated by the trip computer
         if (fuelRate != m_fuelRate) {
             m_fuelRate = fuelRate;
-            actualFuelRate = m_fuelRate / 20;
-            m_fuelUsage += actualFuelRate * (60 / 3600.0);
             emit fuelRateChanged();
-            emit fuelUsageChanged();
         }
 
         return;
@@ -409,26 +447,18 @@ void AppInterface::processFrame(uint32_t id, const QByteArray &payload)
         int defRate = (buf[6] << 8) | buf[7];
 
 
+        // DEF usage is integrated by the trip computer
         if (defRate != m_defRate) {
             m_defRate = defRate;
-            m_defUsage = m_defRate * m_tripHours;
-
             emit defRateChanged();
-            emit defUsageChanged();
         }
         return;
     }
 
 
-    if (id == CAN_ID_ENGINELOAD) {
-        int engineLoad = (buf[6] << 8) | buf[7];
-
-        if (engineLoad != m_avgEngineLoad) {
-            m_avgEngineLoad = engineLoad ;
-            emit avgEngineLoadChanged();
-        }
+    // The average engine load comes from the trip computer
+    if (id == CAN_ID_ENGINELOAD)
         return;
-    }
 
 }
 
@@ -462,7 +492,7 @@ void AppInterface::publishButtonStatus(int buttonIndex, bool pressed)
 
     m_buttonPublisher.send(msg, zmq::send_flags::none);
 
-    qDebug()<<"[MAIN] Published Button Status. Index:"<< buttonIndex << "State:" << pressed;
+    NG_DEBUG(lcButtons) << "[MAIN] Published Button Status. Index:" << buttonIndex << "State:" << pressed;
 }
 
 void AppInterface:: setFuelRate(float val){
@@ -480,8 +510,10 @@ void AppInterface:: setFuelUsage(float val){
     } else {
         m_fuelUsage = val;
     }
+    m_tripComputer.setFuelUsage(m_fuelUsage);
 
     emit fuelUsageChanged();
+    journalTripState();
 }
 
 /**
@@ -505,21 +537,184 @@ void AppInterface::setCreepActive(bool active)
     emit creepActiveChanged();
 }
 
+/**
+ * @brief Returns runtime diagnostics.
+ *
+ * @return Map with the effective ingest thread settings and the
+ *         capture state.
+ */
+QVariantMap AppInterface::diagnostics() const
+{
+    QVariantMap capture;
+    capture.insert("active", m_capture.isActive());
+    capture.insert("path", m_capture.path());
+    capture.insert("records", m_capture.recordedCount());
+    capture.insert("dropped", m_capture.droppedCount());
+
+    QVariantMap log;
+    log.insert("async", cLogger::instance().isAsync());
+    log.insert("dropped", cLogger::instance().droppedMessageCount());
+    log.insert("rotations", cLogger::instance().rotationCount());
+    log.insert("suppressed", cLogger::instance().suppressedMessageCount());
+    log.insert("alarms", cLogger::instance().alarmStats().toVariantMap());
+
+    QVariantMap tripJournal;
+    tripJournal.insert("open", m_tripJournal.isOpen());
+    tripJournal.insert("path", m_tripJournal.path());
+    tripJournal.insert("writes", m_tripJournal.writeCount());
+    tripJournal.insert("restoreUs", m_tripJournal.restoreNsecs() / 1000);
+
+    QVariantMap map;
+    map.insert("ingestThread", m_receiver.effectiveThreadConfig().toVariantMap());
+    map.insert("tripComputer", m_tripComputer.results().toVariantMap());
+    map.insert("capture", capture);
+    map.insert("log", log);
+    map.insert("tripJournal", tripJournal);
+    return map;
+}
+
+QVariantList AppInterface::recentLogEntries(int maxEntries) const
+{
+    static const char *const levelNames[] = { "debug", "warning", "critical", "fatal", "info" };
+
+    QVariantList list;
+    const QList<cLogger::LogEntry> entries = cLogger::instance().recentEntries(maxEntries);
+    list.reserve(entries.size());
+    for (const cLogger::LogEntry &entry : entries) {
+        QVariantMap item;
+        item.insert("time", QDateTime::fromMSecsSinceEpoch(entry.utcMs, Qt::UTC));
+        item.insert("level", (entry.type >= 0 && entry.type <= QtInfoMsg)
+                    ? QString(levelNames[entry.type]) : QString("unknown"));
+        item.insert("module", entry.module);
+        item.insert("thread", entry.thread);
+        item.insert("message", entry.message);
+        list.append(item);
+    }
+    return list;
+}
+
+/**
+ * @brief Starts a capture of the ingest stream.
+ *
+ * The recorder is always attached to the receiver; starting it only
+ * enables the tap.
+ *
+ * @param path Capture file path.
+ * @return True if recording started.
+ */
+bool AppInterface::startCapture(const QString &path)
+{
+    if (!m_capture.start(path))
+        return false;
+    qInfo("Capture started: %s", qPrintable(path));
+    return true;
+}
+
+/**
+ * @brief Stops the capture and reports how many frames were written.
+ */
+void AppInterface::stopCapture()
+{
+    if (!m_capture.isActive())
+        return;
+    m_capture.stop();
+    qInfo("Capture stopped: %llu records, %llu dropped",
+          static_cast<unsigned long long>(m_capture.recordedCount()),
+          static_cast<unsigned long long>(m_capture.droppedCount()));
+}
+
+/**
+ * @brief Opens the trip journal and applies the counters saved in it.
+ *
+ * @param path Journal file path.
+ * @return True if the journal is open.
+ */
+bool AppInterface::openTripJournal(const QString &path)
+{
+    if (!m_tripJournal.open(path))
+        return false;
+
+    TripJournal::State state;
+    if (m_tripJournal.restore(&state)) {
+        // The intermediate states must not reach the journal
+        m_restoringTrip = true;
+        setLastResetDate(state.lastResetDate);
+        setLastTripHours(state.lastTripHours);
+        setFuelUsage(state.fuelUsage);
+        setDefUsage(state.defUsage);
+        m_restoringTrip = false;
+        qInfo("Trip counters restored from %s in %lld us", qPrintable(path),
+              static_cast<long long>(m_tripJournal.restoreNsecs() / 1000));
+    }
+    journalTripState();
+    return true;
+}
+
+/**
+ * @brief Publishes the trip computer results to the trip properties.
+ */
+void AppInterface::publishTripResults()
+{
+    const TripComputer::Results results = m_tripComputer.results();
+    bool changed = false;
+
+    const float fuelUsage = qBound(0.0f, float(results.fuelUsage), FUEL_USAGE);
+    if (fuelUsage != m_fuelUsage) {
+        m_fuelUsage = fuelUsage;
+        emit fuelUsageChanged();
+        changed = true;
+    }
+
+    const float defUsage = float(results.defUsage);
+    if (defUsage != m_defUsage) {
+        m_defUsage = defUsage;
+        emit defUsageChanged();
+        changed = true;
+    }
+
+    // Keep the value set by a trip reset until the first load frames
+    if (results.hasEngineLoad) {
+        const int avgEngineLoad = qRound(results.avgEngineLoad);
+        if (avgEngineLoad != m_avgEngineLoad) {
+            m_avgEngineLoad = avgEngineLoad;
+            emit avgEngineLoadChanged();
+        }
+    }
+
+    if (changed)
+        journalTripState();
+}
+
+void AppInterface::journalTripState()
+{
+    if (m_restoringTrip || !m_tripJournal.isOpen())
+        return;
+
+    TripJournal::State state;
+    state.lastTripHours = m_lastTripHours;
+    state.fuelUsage = m_fuelUsage;
+    state.defUsage = m_defUsage;
+    state.lastResetDate = m_lastResetDate;
+    m_tripJournal.record(state);
+}
+
 
 /**
  * @brief Destructor for AppInterface.
  *
  * Performs graceful shutdown of ZMQ resources:
- * 1. Requests thread interruption
- * 2. Waits up to 5 seconds for thread to exit
- * 3. Force terminates if thread is still running
+ * 1. Cancels the clock and trip tasks registered with the Scheduler
+ * 2. Stops the active frame source (live receiver or replay)
+ * 3. Stops the ZmqReceiver, which wakes its poll through an inproc
+ *    control socket and joins the ingest thread
+ * 4. Closes a running capture
+ * 5. Writes the last trip counters to the trip journal
  *
  * Also closes ZMQ sockets and cleans up resources.
- * The QTimer and other Qt objects are automatically cleaned up
- * via Qt's parent-child ownership mechanism.
+ * Qt objects are automatically cleaned up via Qt's parent-child
+ * ownership mechanism.
  *
- * @note Thread cleanup is critical to prevent resource leaks.
- * @note Force termination is used as last resort if graceful shutdown fails.
+ * @note Shutdown completes in milliseconds; the thread is never terminated.
  */
 void AppInterface::setDefRate(float val)
 {
@@ -532,10 +727,9 @@ void AppInterface::setDefRate(float val)
 
 void AppInterface::setTripHours(float)
 {
-    // Trip hours is derived value
-    m_tripHours = m_engineHours - m_lastTripHours;
-    if (m_tripHours < 0) m_tripHours = 0;
-
+    // Trip hours is derived value: the write is dropped, and the signal
+    // makes QML read the derived value back
+    m_signals.update();
     emit tripHoursChanged();
 }
 
@@ -545,25 +739,28 @@ void AppInterface::setLastTripHours(float value)
     // value = engine hours at reset moment
     m_lastTripHours = value;
     emit lastTripHoursChanged();
+    journalTripState();
 
     // Recalculate trip
-    m_tripHours = m_engineHours - m_lastTripHours;
-    if (m_tripHours < 0) m_tripHours = 0;
-
-    emit tripHoursChanged();
+    m_signals.set(m_lastTripHoursSignal, m_lastTripHours);
+    m_signals.update();
 }
 
 void AppInterface :: setDefUsage(float value){
 
     m_defUsage = value;
+    m_tripComputer.setDefUsage(m_defUsage);
     qDebug()<<"m_defUsage"<<m_defUsage;
 
     emit defUsageChanged();
+    journalTripState();
 }
 
 void AppInterface :: setAvgEngineLoad(int value){
 
+    // A new trip starts a new average
     m_avgEngineLoad = value;
+    m_tripComputer.resetEngineLoad();
     emit avgEngineLoadChanged();
 }
 
@@ -574,18 +771,21 @@ void AppInterface::setLastResetDate(const QString &date)
 
     m_lastResetDate = date;
     emit lastResetDateChanged();
+    journalTripState();
 }
 
 
 AppInterface::~AppInterface() {
-    // Request thread interruption
-    m_zmqThread.requestInterruption();
-    m_zmqThread.quit();
-    m_zmqThread.wait(5000); // Wait up to 5 seconds
-    if (m_zmqThread.isRunning()) {
-        qWarning("ZMQ thread did not stop gracefully !!");
-        m_zmqThread.terminate();
-    }
+    Scheduler::instance().cancel(m_clockTask);
+    Scheduler::instance().cancel(m_tripTask);
+
+    // Wakes the receive poll through the control socket; returns once
+    // the ingest thread has exited, without terminate().
+    if (m_source)
+        m_source->stop();
+    m_receiver.stop();
+    m_capture.stop();
+    m_tripJournal.close();
 }
 
 
@@ -0,0 +1,301 @@
+/**
+ * @file src/binlog.cpp
+ * @brief Implementation of the BinLog binary log sink.
+ *
+ * Lock order: registry mutex, then a thread buffer mutex, then the file
+ * mutex. Threads append to their own buffer, so the buffer mutex is
+ * uncontended except while flush() drains it. The encoded format blocks
+ * are kept with the file, so a rotation under a buffer mutex can write
+ * them to the new file without the registry.
+ *
+ * @date 18-Oct-2026
+ * @author Gangadhar Thalange
+ */
+
+#include "../include/binlog.h"
+#include <QFile>
+#include <QThread>
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <memory>
+#include <vector>
+
+std::atomic<quint64> BinLog::s_records{0};
+
+namespace {
+
+/**
+ * @brief Sites, thread buffers and selected categories.
+ */
+struct Registry
+{
+    std::mutex mutex;
+    std::vector<BinLogSite *> sites;
+    std::vector<std::shared_ptr<BinLogBuffer>> buffers;
+    QList<QByteArray> binaryPrefixes;
+    bool fileOpen = false;
+};
+
+/**
+ * @brief The binary file and the format blocks of all sites.
+ */
+struct Sink
+{
+    std::mutex mutex;
+    QFile file;
+    std::string formats;
+    qint64 maxFileSize = 4 * 1024 * 1024;
+};
+
+Registry &registry()
+{
+    static Registry instance;
+    return instance;
+}
+
+Sink &sink()
+{
+    static Sink instance;
+    return instance;
+}
+
+/**
+ * @brief Returns whether @p category is one of the prefixes or inside one.
+ */
+bool matchesPrefix(const QList<QByteArray> &prefixes, const char *category)
+{
+    const QByteArray name(category);
+    for (const QByteArray &prefix : prefixes) {
+        if (name == prefix || (name.startsWith(prefix) && name.at(prefix.size()) == '.'))
+            return true;
+    }
+    return false;
+}
+
+/**
+ * @brief Updates the binary flag of every site.
+ * @note Caller must hold the registry mutex.
+ */
+void updateSites(Registry &reg)
+{
+    for (BinLogSite *site : reg.sites)
+        site->binary.store(reg.fileOpen && matchesPrefix(reg.binaryPrefixes, site->category),
+                           std::memory_order_relaxed);
+}
+
+void appendBlock(std::string &out, uint32_t tag, const std::string &payload)
+{
+    const BinLogFormat::BlockHeader header = { tag, uint32_t(payload.size()) };
+    BinLogFormat::putFixed(out, &header, sizeof(header));
+    out += payload;
+}
+
+void appendFormatBlock(std::string &out, const BinLogSite &site)
+{
+    std::string payload;
+    const uint32_t id = site.id;
+    const uint8_t type = uint8_t(site.type);
+    const uint32_t line = uint32_t(site.line);
+    BinLogFormat::putFixed(payload, &id, sizeof(id));
+    BinLogFormat::putFixed(payload, &type, sizeof(type));
+    BinLogFormat::putFixed(payload, &line, sizeof(line));
+    for (const char *text : { site.category, site.file, site.function, site.format, site.signature }) {
+        text = text ? text : "";
+        BinLogFormat::putString(payload, text, strlen(text));
+    }
+    appendBlock(out, BinLogFormat::TAG_FORMAT, payload);
+}
+
+/**
+ * @brief Opens the file for appending and writes the file header (new
+ *        files), a session block and all formats.
+ * @note Caller must hold the file mutex.
+ */
+bool openFile(Sink &out, const QString &path)
+{
+    out.file.setFileName(path);
+    if (!out.file.open(QIODevice::WriteOnly | QIODevice::Append)) {
+        std::cerr << "BinLog: Cannot write file " << out.file.errorString().toLocal8Bit().constData() << std::endl;
+        return false;
+    }
+    out.file.setPermissions(QFile::ReadOwner | QFile::WriteOwner | QFile::ReadGroup | QFile::ReadOther);
+
+    std::string preamble;
+    if (out.file.size() == 0) {
+        BinLogFormat::FileHeader header = {};
+        memcpy(header.magic, BinLogFormat::MAGIC, sizeof(header.magic));
+        header.version = BinLogFormat::VERSION;
+        BinLogFormat::putFixed(preamble, &header, sizeof(header));
+    }
+    appendBlock(preamble, BinLogFormat::TAG_SESSION, std::string());
+    preamble += out.formats;
+    out.file.write(preamble.data(), qint64(preamble.size()));
+    out.file.flush();
+    return true;
+}
+
+/**
+ * @brief Owns the calling thread's buffer; flushes and drops it at thread exit.
+ */
+struct ThreadBufferHolder
+{
+    std::shared_ptr<BinLogBuffer> buffer;
+
+    ~ThreadBufferHolder()
+    {
+        if (!buffer)
+            return;
+        BinLog::flush();
+        Registry &reg = registry();
+        std::lock_guard<std::mutex> lock(reg.mutex);
+        reg.buffers.erase(std::remove(reg.buffers.begin(), reg.buffers.end(), buffer), reg.buffers.end());
+    }
+};
+
+thread_local ThreadBufferHolder t_buffer;
+
+} // namespace
+
+void BinLogSite::registerSite()
+{
+    Registry &reg = registry();
+    std::lock_guard<std::mutex> lock(reg.mutex);
+    id = uint32_t(reg.sites.size());
+    reg.sites.push_back(this);
+    binary.store(reg.fileOpen && matchesPrefix(reg.binaryPrefixes, category), std::memory_order_relaxed);
+
+    std::string block;
+    appendFormatBlock(block, *this);
+    Sink &out = sink();
+    std::lock_guard<std::mutex> fileLock(out.mutex);
+    out.formats += block;
+    if (out.file.isOpen())
+        out.file.write(block.data(), qint64(block.size()));
+}
+
+void BinLog::setPath(const QString &path)
+{
+    // Chunks still buffered belong to the old file
+    flush();
+
+    Registry &reg = registry();
+    std::lock_guard<std::mutex> lock(reg.mutex);
+    Sink &out = sink();
+    {
+        std::lock_guard<std::mutex> fileLock(out.mutex);
+        if (out.file.isOpen())
+            out.file.close();
+        reg.fileOpen = !path.isEmpty() && openFile(out, path);
+    }
+    updateSites(reg);
+}
+
+QString BinLog::path()
+{
+    Sink &out = sink();
+    std::lock_guard<std::mutex> fileLock(out.mutex);
+    return out.file.isOpen() ? out.file.fileName() : QString();
+}
+
+void BinLog::setBinary(const QString &categoryPrefix, bool binary)
+{
+    Registry &reg = registry();
+    std::lock_guard<std::mutex> lock(reg.mutex);
+    const QByteArray prefix = categoryPrefix.toUtf8();
+    reg.binaryPrefixes.removeAll(prefix);
+    if (binary && !prefix.isEmpty())
+        reg.binaryPrefixes.append(prefix);
+    updateSites(reg);
+}
+
+void BinLog::setBinaryCategories(const QStringList &categoryPrefixes)
+{
+    Registry &reg = registry();
+    std::lock_guard<std::mutex> lock(reg.mutex);
+    reg.binaryPrefixes.clear();
+    for (const QString &prefix : categoryPrefixes) {
+        if (!prefix.isEmpty())
+            reg.binaryPrefixes.append(prefix.toUtf8());
+    }
+    updateSites(reg);
+}
+
+void BinLog::setMaxFileSize(qint64 bytes)
+{
+    Sink &out = sink();
+    std::lock_guard<std::mutex> fileLock(out.mutex);
+    out.maxFileSize = qMax<qint64>(64 * 1024, bytes);
+}
+
+void BinLog::flush()
+{
+    std::vector<std::shared_ptr<BinLogBuffer>> buffers;
+    {
+        Registry &reg = registry();
+        std::lock_guard<std::mutex> lock(reg.mutex);
+        buffers = reg.buffers;
+    }
+    for (const std::shared_ptr<BinLogBuffer> &buffer : buffers) {
+        std::lock_guard<std::mutex> lock(buffer->mutex);
+        if (!buffer->data.empty())
+            writeChunk(*buffer);
+    }
+    Sink &out = sink();
+    std::lock_guard<std::mutex> fileLock(out.mutex);
+    if (out.file.isOpen())
+        out.file.flush();
+}
+
+quint64 BinLog::recordCount()
+{
+    return s_records.load(std::memory_order_relaxed);
+}
+
+BinLogBuffer &BinLog::threadBuffer()
+{
+    if (!t_buffer.buffer) {
+        auto buffer = std::make_shared<BinLogBuffer>();
+        buffer->data.reserve(BinLogFormat::CHUNK_BYTES + 1024);
+        QThread *thread = QThread::currentThread();
+        buffer->threadName = thread ? thread->objectName().toStdString() : std::string();
+        Registry &reg = registry();
+        std::lock_guard<std::mutex> lock(reg.mutex);
+        reg.buffers.push_back(buffer);
+        t_buffer.buffer = std::move(buffer);
+    }
+    return *t_buffer.buffer;
+}
+
+int64_t BinLog::currentTimeUs()
+{
+    return std::chrono::duration_cast<std::chrono::microseconds>(
+                std::chrono::system_clock::now().time_since_epoch()).count();
+}
+
+void BinLog::writeChunk(BinLogBuffer &buffer)
+{
+    std::string payload;
+    payload.reserve(buffer.data.size() + buffer.threadName.size() + 16);
+    BinLogFormat::putFixed(payload, &buffer.baseUs, sizeof(buffer.baseUs));
+    BinLogFormat::putString(payload, buffer.threadName.data(), buffer.threadName.size());
+    payload += buffer.data;
+    buffer.data.clear();
+    std::string block;
+    appendBlock(block, BinLogFormat::TAG_CHUNK, payload);
+
+    Sink &out = sink();
+    std::lock_guard<std::mutex> fileLock(out.mutex);
+    if (!out.file.isOpen())
+        return;
+    out.file.write(block.data(), qint64(block.size()));
+    if (out.file.size() < out.maxFileSize)
+        return;
+
+    // Keep one previous generation; the new file starts with all formats
+    const QString path = out.file.fileName();
+    out.file.close();
+    QFile::remove(path + ".1");
+    QFile::rename(path, path + ".1");
+    openFile(out, path);
+}
@@ -0,0 +1,368 @@
+/**
+ * @file src/binlogreader.cpp
+ * @brief Implementation of BinLogReader.
+ *
+ * @date 18-Oct-2026
+ * @author Gangadhar Thalange
+ */
+
+#include "../include/binlogreader.h"
+#include "../include/binlogformat.h"
+#include <QFile>
+#include <QHash>
+#include <algorithm>
+#include <cstdarg>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+namespace {
+
+/// Level names as written by cLogger, indexed by QtMsgType
+const char *const g_levelNames[] = {"DEB","WAR","CRI","FAT","INF"};
+
+/**
+ * @brief A TAG_FORMAT block.
+ */
+struct Format
+{
+    QtMsgType type = QtDebugMsg;
+    int line = 0;
+    QByteArray category;
+    QByteArray file;
+    QByteArray function;
+    QByteArray format;
+    QByteArray signature;
+};
+
+/**
+ * @brief One decoded argument.
+ */
+struct Arg
+{
+    char code = 'u';
+    uint64_t number = 0;
+    double real = 0;
+    QByteArray text;
+};
+
+template <typename T>
+bool getFixed(const uint8_t *&pos, const uint8_t *end, T &value)
+{
+    if (end - pos < qint64(sizeof(T)))
+        return false;
+    memcpy(&value, pos, sizeof(T));
+    pos += sizeof(T);
+    return true;
+}
+
+bool getString(const uint8_t *&pos, const uint8_t *end, QByteArray &value)
+{
+    uint64_t length = 0;
+    if (!BinLogFormat::getVarint(pos, end, length) || uint64_t(end - pos) < length)
+        return false;
+    value = QByteArray(reinterpret_cast<const char *>(pos), int(length));
+    pos += length;
+    return true;
+}
+
+bool getArg(char code, const uint8_t *&pos, const uint8_t *end, Arg &arg)
+{
+    arg.code = code;
+    switch (code) {
+    case 'd':
+        return getFixed(pos, end, arg.real);
+    case 's':
+        return getString(pos, end, arg.text);
+    default:
+        return BinLogFormat::getVarint(pos, end, arg.number);
+    }
+}
+
+bool isQmlFile(const QByteArray &file)
+{
+    const int last = file.size() - 4;
+    for (int i = 0; i <= last; ++i) {
+        if (file.at(i) == '.' && qstrnicmp(file.constData() + i + 1, "qml", 3) == 0)
+            return true;
+    }
+    return false;
+}
+
+/**
+ * @brief Returns the next argument as an integer, for '*' and integer conversions.
+ */
+long long intArg(const std::vector<Arg> &args, size_t &next)
+{
+    if (next >= args.size())
+        return 0;
+    const Arg &arg = args[next++];
+    switch (arg.code) {
+    case 'i': return BinLogFormat::unzigzag(arg.number);
+    case 'd': return (long long)(arg.real);
+    default:  return (long long)(arg.number);
+    }
+}
+
+void appendFormatted(QByteArray &out, const char *spec, ...)
+{
+    char buffer[128];
+    va_list args;
+    va_start(args, spec);
+    va_list copy;
+    va_copy(copy, args);
+    const int length = vsnprintf(buffer, sizeof(buffer), spec, args);
+    va_end(args);
+    if (length < 0) {
+        va_end(copy);
+        return;
+    }
+    if (size_t(length) < sizeof(buffer)) {
+        out.append(buffer, length);
+    } else {
+        std::string large(size_t(length) + 1, '\0');
+        vsnprintf(&large[0], large.size(), spec, copy);
+        out.append(large.data(), length);
+    }
+    va_end(copy);
+}
+
+} // namespace
+
+bool BinLogReader::formatMessage(const char *format, const char *signature,
+                                 const uint8_t *&pos, const uint8_t *end, QByteArray &out)
+{
+    std::vector<Arg> args(strlen(signature));
+    for (size_t i = 0; i < args.size(); ++i) {
+        if (!getArg(signature[i], pos, end, args[i]))
+            return false;
+    }
+
+    // Without arguments the format is the message, as in BinLog::writeText()
+    if (args.empty()) {
+        out.append(format);
+        return true;
+    }
+
+    size_t next = 0;
+    for (const char *p = format; *p; ++p) {
+        if (*p != '%') {
+            out.append(*p);
+            continue;
+        }
+        if (p[1] == '%') {
+            out.append('%');
+            ++p;
+            continue;
+        }
+
+        // Rebuild the conversion without length modifiers; the encoded
+        // arguments are 64 bits wide and get "ll" or double as needed
+        std::string spec = "%";
+        const char *q = p + 1;
+        while (*q && strchr("-+ #0'", *q))
+            spec += *q++;
+        if (*q == '*') {
+            spec += std::to_string(intArg(args, next));
+            ++q;
+        }
+        while (*q >= '0' && *q <= '9')
+            spec += *q++;
+        if (*q == '.') {
+            spec += *q++;
+            if (*q == '*') {
+                spec += std::to_string(intArg(args, next));
+                ++q;
+            }
+            while (*q >= '0' && *q <= '9')
+                spec += *q++;
+        }
+        while (*q && strchr("hlLqjzt", *q))
+            ++q;
+        const char conversion = *q;
+        if (!conversion)
+            break;
+        p = q;
+
+        switch (conversion) {
+        case 'd': case 'i': case 'u': case 'x': case 'X': case 'o': case 'c':
+            spec += conversion == 'c' ? "c" : std::string("ll") + conversion;
+            if (conversion == 'c')
+                appendFormatted(out, spec.c_str(), int(intArg(args, next)));
+            else
+                appendFormatted(out, spec.c_str(), intArg(args, next));
+            break;
+        case 'f': case 'F': case 'e': case 'E': case 'g': case 'G': case 'a': case 'A': {
+            spec += conversion;
+            double value = 0;
+            if (next < args.size()) {
+                const Arg &arg = args[next++];
+                value = arg.code == 'd' ? arg.real
+                      : arg.code == 'i' ? double(BinLogFormat::unzigzag(arg.number)) : double(arg.number);
+            }
+            appendFormatted(out, spec.c_str(), value);
+            break;
+        }
+        case 's': {
+            spec += 's';
+            QByteArray text;
+            if (next < args.size()) {
+                const Arg &arg = args[next++];
+                text = arg.code == 's' ? arg.text : QByteArray::number(qulonglong(arg.number));
+            }
+            appendFormatted(out, spec.c_str(), text.constData());
+            break;
+        }
+        case 'p':
+            spec += 'p';
+            appendFormatted(out, spec.c_str(), next < args.size() ? reinterpret_cast<void *>(uintptr_t(args[next++].number))
+                                                           : nullptr);
+            break;
+        default:
+            // %n and unknown conversions print nothing
+            break;
+        }
+    }
+    return true;
+}
+
+bool BinLogReader::read(const QString &path)
+{
+    m_errorString.clear();
+    m_truncated = false;
+
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly)) {
+        m_errorString = file.errorString();
+        return false;
+    }
+    const QByteArray data = file.readAll();
+    const uint8_t *pos = reinterpret_cast<const uint8_t *>(data.constData());
+    const uint8_t *const end = pos + data.size();
+
+    BinLogFormat::FileHeader header;
+    if (!getFixed(pos, end, header) || memcmp(header.magic, BinLogFormat::MAGIC, sizeof(header.magic)) != 0) {
+        m_errorString = QStringLiteral("Not a binary log file");
+        return false;
+    }
+    if (header.version != BinLogFormat::VERSION) {
+        m_errorString = QStringLiteral("Unsupported binary log version %1").arg(header.version);
+        return false;
+    }
+
+    const int firstEntry = m_entries.size();
+    QHash<uint32_t, Format> formats;
+    BinLogFormat::BlockHeader block;
+    while (pos < end) {
+        if (!getFixed(pos, end, block) || uint64_t(end - pos) < block.length) {
+            m_truncated = true;
+            break;
+        }
+        const uint8_t *payload = pos;
+        const uint8_t *const payloadEnd = pos + block.length;
+        pos = payloadEnd;
+
+        switch (block.tag) {
+        case BinLogFormat::TAG_SESSION:
+            formats.clear();
+            break;
+        case BinLogFormat::TAG_FORMAT: {
+            uint32_t id = 0;
+            uint8_t type = 0;
+            uint32_t line = 0;
+            Format format;
+            if (!getFixed(payload, payloadEnd, id) || !getFixed(payload, payloadEnd, type)
+                    || !getFixed(payload, payloadEnd, line)
+                    || !getString(payload, payloadEnd, format.category)
+                    || !getString(payload, payloadEnd, format.file)
+                    || !getString(payload, payloadEnd, format.function)
+                    || !getString(payload, payloadEnd, format.format)
+                    || !getString(payload, payloadEnd, format.signature)) {
+                m_errorString = QStringLiteral("Corrupt format block");
+                return false;
+            }
+            format.type = QtMsgType(type);
+            format.line = int(line);
+            formats.insert(id, format);
+            break;
+        }
+        case BinLogFormat::TAG_CHUNK: {
+            int64_t timeUs = 0;
+            QByteArray threadName;
+            if (!getFixed(payload, payloadEnd, timeUs) || !getString(payload, payloadEnd, threadName)) {
+                m_errorString = QStringLiteral("Corrupt chunk block");
+                return false;
+            }
+            while (payload < payloadEnd) {
+                uint64_t id = 0;
+                uint64_t delta = 0;
+                if (!BinLogFormat::getVarint(payload, payloadEnd, id)
+                        || !BinLogFormat::getVarint(payload, payloadEnd, delta)) {
+                    m_errorString = QStringLiteral("Corrupt record");
+                    return false;
+                }
+                const auto format = formats.constFind(uint32_t(id));
+                if (format == formats.constEnd()) {
+                    m_errorString = QStringLiteral("Unknown format ID %1").arg(id);
+                    return false;
+                }
+                timeUs += BinLogFormat::unzigzag(delta);
+
+                Entry entry;
+                entry.utcUs = timeUs;
+                entry.type = format->type;
+                entry.category = format->category;
+                entry.file = format->file;
+                entry.line = format->line;
+                entry.function = format->function;
+                entry.threadName = threadName;
+                if (!formatMessage(format->format.constData(), format->signature.constData(),
+                                   payload, payloadEnd, entry.message)) {
+                    m_errorString = QStringLiteral("Corrupt record arguments");
+                    return false;
+                }
+                m_entries.append(entry);
+            }
+            break;
+        }
+        default:
+            // Unknown blocks are skipped, so newer writers stay readable
+            break;
+        }
+    }
+
+    // Chunks are per thread; merge them into time order
+    std::stable_sort(m_entries.begin() + firstEntry, m_entries.end(),
+                     [](const Entry &a, const Entry &b) { return a.utcUs < b.utcUs; });
+    if (firstEntry > 0)
+        std::inplace_merge(m_entries.begin(), m_entries.begin() + firstEntry, m_entries.end(),
+                           [](const Entry &a, const Entry &b) { return a.utcUs < b.utcUs; });
+    return true;
+}
+
+QByteArray BinLogReader::formatLine(const Entry &entry)
+{
+    m_line.clear();
+    m_line.appendTimestamp(entry.utcUs / 1000 - (entry.utcUs % 1000 < 0 ? 1 : 0));
+    m_line.append(" [");
+    const int type = int(entry.type);
+    m_line.append(type >= 0 && type < int(sizeof(g_levelNames) / sizeof(g_levelNames[0])) ? g_levelNames[type] : "UNK");
+    m_line.append(' ');
+    m_line.append(isQmlFile(entry.file) ? "QML" : "App");
+    m_line.append(' ');
+    if (entry.threadName.isEmpty())
+        m_line.append("NoThread");
+    else
+        m_line.append(entry.threadName.constData(), size_t(entry.threadName.size()));
+    m_line.append("] ");
+    m_line.append(entry.message.constData(), size_t(entry.message.size()));
+    if (entry.type == QtFatalMsg || entry.type == QtCriticalMsg || entry.type == QtWarningMsg) {
+        m_line.append(" in ");
+        m_line.append(entry.function.constData(), size_t(entry.function.size()));
+        m_line.append("at: ");
+        m_line.append(entry.file.constData(), size_t(entry.file.size()));
+        m_line.append(", line ");
+        m_line.appendNumber(entry.line);
+    }
+    return QByteArray(m_line.data(), int(m_line.size()));
+}
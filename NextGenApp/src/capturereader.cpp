@@ -0,0 +1,110 @@
+/**
+ * @file src/capturereader.cpp
+ * @brief Implementation of the CaptureReader class.
+ *
+ * @date 18-Oct-2026
+ * @author Gangadhar Thalange
+ */
+
+#include "../include/capturereader.h"
+#include <algorithm>
+#include <atomic>
+
+using Capture::CaptureHeader;
+using Capture::CaptureRecord;
+
+CaptureReader::~CaptureReader()
+{
+    close();
+}
+
+/**
+ * @brief Maps the whole file read-only and validates the header.
+ *
+ * The record count is limited to the records actually present in the
+ * file, so a truncated capture never reads past the mapping.
+ */
+bool CaptureReader::open(const QString &path)
+{
+    close();
+
+    m_file.setFileName(path);
+    if (!m_file.open(QIODevice::ReadOnly)) {
+        m_error = m_file.errorString();
+        return false;
+    }
+
+    const qint64 size = m_file.size();
+    if (size < qint64(Capture::CAPTURE_HEADER_SIZE)) {
+        m_error = QString("%1 is too small for a capture file").arg(path);
+        m_file.close();
+        return false;
+    }
+
+    m_data = m_file.map(0, size);
+    if (!m_data) {
+        m_error = m_file.errorString();
+        m_file.close();
+        return false;
+    }
+
+    const CaptureHeader *header = reinterpret_cast<const CaptureHeader *>(m_data);
+    if (!Capture::isValidHeader(*header)) {
+        m_error = QString("%1 is not a supported capture file").arg(path);
+        close();
+        return false;
+    }
+
+    const quint64 present = quint64(size - Capture::CAPTURE_HEADER_SIZE) / sizeof(CaptureRecord);
+    m_header = header;
+    m_records = reinterpret_cast<const CaptureRecord *>(m_data + Capture::CAPTURE_HEADER_SIZE);
+    m_count = std::min<quint64>(header->recordCount, present);
+    // Pairs with the release fence of the recorder publishing the count
+    std::atomic_thread_fence(std::memory_order_acquire);
+    m_error.clear();
+    return true;
+}
+
+void CaptureReader::close()
+{
+    if (m_data)
+        m_file.unmap(m_data);
+    m_file.close();
+    m_data = nullptr;
+    m_header = nullptr;
+    m_records = nullptr;
+    m_count = 0;
+}
+
+/**
+ * @brief Binary search over the segment index, then within the segment.
+ *
+ * Falls back to a search over all records if the index is empty.
+ */
+quint64 CaptureReader::indexAtTime(quint64 tNs) const
+{
+    if (!m_count)
+        return 0;
+
+    const auto byTime = [](const CaptureRecord &record, quint64 t) { return record.tNs < t; };
+
+    quint64 first = 0;
+    quint64 last = m_count;
+
+    const quint32 segments = m_header->segmentCount;
+    if (segments > 0) {
+        const quint64 *index = m_header->segmentFirstNs;
+        // Last segment starting at or before tNs
+        const quint64 *it = std::upper_bound(index, index + segments, tNs);
+        if (it == index)
+            return 0;
+        const quint64 segment = quint64(it - index) - 1;
+        first = segment * m_header->segmentRecords;
+        last = std::min<quint64>(first + m_header->segmentRecords, m_count);
+        if (first >= m_count)
+            return m_count;
+    }
+
+    const CaptureRecord *found = std::lower_bound(m_records + first, m_records + last, tNs, byTime);
+    return quint64(found - m_records);
+}
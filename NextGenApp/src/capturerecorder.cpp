@@ -0,0 +1,309 @@
+/**
+ * @file src/capturerecorder.cpp
+ * @brief Implementation of the CaptureRecorder class.
+ *
+ * The file grows one preallocated segment at a time. Each segment is
+ * reserved on disk (posix_fallocate on Linux, so a full disk is detected
+ * when the segment is opened and not as SIGBUS on a later write) and then
+ * mapped; records are copied straight into the mapping.
+ *
+ * @date 18-Oct-2026
+ * @author Gangadhar Thalange
+ */
+
+#include "../include/capturerecorder.h"
+#include <QDateTime>
+#include <QDebug>
+#include <chrono>
+#include <cstring>
+
+#ifdef Q_OS_LINUX
+#include <fcntl.h>
+#endif
+
+using Capture::CaptureHeader;
+using Capture::CaptureRecord;
+
+/**
+ * @brief Longest wait of the idle writer thread, in ms.
+ *
+ * record() wakes the writer; the timeout only bounds the wait should a
+ * wakeup ever be missed.
+ */
+static constexpr int WRITER_IDLE_TIMEOUT_MS = 100;
+
+static qint64 monotonicNs()
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+               std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+CaptureRecorder::CaptureRecorder(quint32 ringCapacity, quint32 segmentRecords, QObject *parent)
+    : QObject(parent)
+    , m_ring(ringCapacity)
+    , m_segmentRecords(qMax<quint32>(1, segmentRecords))
+{
+    m_thread.setObjectName("CaptureWriter");
+    connect(&m_thread, &QThread::started,
+            this, &CaptureRecorder::run,
+            Qt::DirectConnection);
+}
+
+CaptureRecorder::~CaptureRecorder()
+{
+    stop();
+}
+
+/**
+ * @brief Creates the capture file, maps the first segment and starts the
+ *        writer thread.
+ *
+ * @param path Capture file path.
+ * @return false if already recording or the file cannot be prepared.
+ */
+bool CaptureRecorder::start(const QString &path)
+{
+    if (m_thread.isRunning())
+        return false;
+
+    // Records pushed after the previous stop() belong to no capture. The
+    // counters are reset before anything can fail, as closeFile() sizes the
+    // file and fills the header from them.
+    CaptureRecord stale;
+    while (m_ring.tryPop(stale)) {
+    }
+    m_recorded = 0;
+    m_dropped = 0;
+
+    m_file.setFileName(path);
+    if (!m_file.open(QIODevice::ReadWrite | QIODevice::Truncate)) {
+        qWarning("Cannot create capture file %s: %s",
+                 qPrintable(path), qPrintable(m_file.errorString()));
+        return false;
+    }
+
+    uchar *header = nullptr;
+    if (m_file.resize(Capture::CAPTURE_HEADER_SIZE))
+        header = m_file.map(0, Capture::CAPTURE_HEADER_SIZE);
+    if (!header) {
+        qWarning("Cannot map capture header of %s", qPrintable(path));
+        m_file.close();
+        return false;
+    }
+
+    m_header = reinterpret_cast<CaptureHeader *>(header);
+    memset(m_header, 0, sizeof(CaptureHeader));
+    memcpy(m_header->magic, Capture::MAGIC, sizeof(Capture::MAGIC));
+    m_header->version = Capture::VERSION;
+    m_header->headerSize = Capture::CAPTURE_HEADER_SIZE;
+    m_header->recordSize = sizeof(CaptureRecord);
+    m_header->segmentRecords = m_segmentRecords;
+    m_header->startWallMs = QDateTime::currentMSecsSinceEpoch();
+
+    m_segment = nullptr;
+    m_full = false;
+    if (!openSegment(0)) {
+        closeFile();
+        return false;
+    }
+
+    {
+        QMutexLocker locker(&m_pathMutex);
+        m_path = path;
+    }
+    m_startNs.store(monotonicNs(), std::memory_order_relaxed);
+    m_active.store(true, std::memory_order_release);
+
+    m_thread.start();
+    return true;
+}
+
+/**
+ * @brief Stops accepting frames, lets the writer flush and closes the file.
+ */
+void CaptureRecorder::stop()
+{
+    if (!m_thread.isRunning())
+        return;
+
+    m_active.store(false, std::memory_order_release);
+    m_thread.requestInterruption();
+    wakeWriter();
+    m_thread.wait();
+    closeFile();
+}
+
+/**
+ * @brief Timestamps a message and queues it for the writer.
+ *
+ * Runs on the ingest thread. The only shared state touched is the ring
+ * and the drop counter.
+ */
+void CaptureRecorder::record(const void *data, size_t size)
+{
+    if (!m_active.load(std::memory_order_acquire))
+        return;
+
+    CaptureRecord record;
+    record.tNs = quint64(monotonicNs() - m_startNs.load(std::memory_order_relaxed));
+    record.id = 0;
+    record.flags = 0;
+    record.reserved = 0;
+    memset(record.payload, 0, sizeof(record.payload));
+
+    const uchar *bytes = static_cast<const uchar *>(data);
+    memcpy(&record.id, bytes, qMin<size_t>(size, sizeof(record.id)));
+    const size_t payloadBytes = size > sizeof(record.id) ? size - sizeof(record.id) : 0;
+    record.length = quint8(qMin<size_t>(payloadBytes, Capture::PAYLOAD_SIZE));
+    memcpy(record.payload, bytes + sizeof(record.id), record.length);
+
+    if (payloadBytes < Capture::PAYLOAD_SIZE)
+        record.flags |= Capture::FlagShort;
+    else if (payloadBytes > Capture::PAYLOAD_SIZE)
+        record.flags |= Capture::FlagTruncated;
+
+    if (!m_ring.tryPush(record)) {
+        m_dropped.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+
+    // Pairs with the fence in run(): either the writer sees the record or
+    // this thread sees it sleeping. Without a full fence the flag could be
+    // read before the push is visible, and both sides miss each other.
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (m_writerSleeping.load(std::memory_order_relaxed))
+        wakeWriter();
+}
+
+void CaptureRecorder::wakeWriter()
+{
+    std::lock_guard<std::mutex> lock(m_wakeMutex);
+    m_wakeCondition.notify_one();
+}
+
+QString CaptureRecorder::path() const
+{
+    QMutexLocker locker(&m_pathMutex);
+    return m_path;
+}
+
+/**
+ * @brief Writer loop: drains the ring until stop() is requested, then
+ *        writes whatever is still queued.
+ *
+ * Waits on m_wakeCondition while the ring is empty; record() and stop()
+ * wake it.
+ */
+void CaptureRecorder::run()
+{
+    QThread *thread = QThread::currentThread();
+    while (!thread->isInterruptionRequested()) {
+        if (drain() != 0)
+            continue;
+
+        std::unique_lock<std::mutex> lock(m_wakeMutex);
+        m_writerSleeping.store(true, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (m_ring.size() == 0 && !thread->isInterruptionRequested())
+            m_wakeCondition.wait_for(lock, std::chrono::milliseconds(WRITER_IDLE_TIMEOUT_MS));
+        m_writerSleeping.store(false, std::memory_order_relaxed);
+    }
+    drain();
+}
+
+quint64 CaptureRecorder::drain()
+{
+    quint64 written = 0;
+    quint64 lost = 0;
+    CaptureRecord record;
+
+    while (m_ring.tryPop(record)) {
+        if (!m_full && m_segmentFill == m_segmentRecords
+                && !openSegment(m_segmentIndex + 1))
+            m_full = true;
+
+        if (m_full) {
+            ++lost;
+            continue;
+        }
+
+        if (m_segmentFill == 0) {
+            m_header->segmentFirstNs[m_segmentIndex] = record.tNs;
+            m_header->segmentCount = m_segmentIndex + 1;
+        }
+        m_segment[m_segmentFill++] = record;
+        ++written;
+    }
+
+    if (lost)
+        m_dropped.fetch_add(lost, std::memory_order_relaxed);
+    if (written)
+        m_recorded.fetch_add(written, std::memory_order_relaxed);
+
+    // Commit after the records themselves are in place; the release fence
+    // keeps a concurrent reader from seeing the count before the records.
+    std::atomic_thread_fence(std::memory_order_release);
+    m_header->recordCount = m_recorded.load(std::memory_order_relaxed);
+    m_header->droppedCount = m_dropped.load(std::memory_order_relaxed);
+    return written;
+}
+
+bool CaptureRecorder::openSegment(quint32 index)
+{
+    if (index >= Capture::MAX_SEGMENTS) {
+        qWarning("Capture file %s is full (%u segments)",
+                 qPrintable(m_file.fileName()), Capture::MAX_SEGMENTS);
+        return false;
+    }
+
+    const qint64 segmentBytes = qint64(m_segmentRecords) * qint64(sizeof(CaptureRecord));
+    const qint64 offset = Capture::CAPTURE_HEADER_SIZE + qint64(index) * segmentBytes;
+
+    if (!m_file.resize(offset + segmentBytes)) {
+        qWarning("Cannot extend capture file %s: %s",
+                 qPrintable(m_file.fileName()), qPrintable(m_file.errorString()));
+        return false;
+    }
+
+#ifdef Q_OS_LINUX
+    const int rc = posix_fallocate(m_file.handle(), offset, segmentBytes);
+    if (rc != 0) {
+        qWarning("Cannot reserve capture segment in %s: %s",
+                 qPrintable(m_file.fileName()), strerror(rc));
+        return false;
+    }
+#endif
+
+    uchar *segment = m_file.map(offset, segmentBytes);
+    if (!segment) {
+        qWarning("Cannot map capture segment of %s", qPrintable(m_file.fileName()));
+        return false;
+    }
+
+    if (m_segment)
+        m_file.unmap(reinterpret_cast<uchar *>(m_segment));
+    m_segment = reinterpret_cast<CaptureRecord *>(segment);
+    m_segmentIndex = index;
+    m_segmentFill = 0;
+    return true;
+}
+
+void CaptureRecorder::closeFile()
+{
+    const quint64 records = m_recorded.load(std::memory_order_relaxed);
+
+    if (m_segment) {
+        m_file.unmap(reinterpret_cast<uchar *>(m_segment));
+        m_segment = nullptr;
+    }
+    if (m_header) {
+        m_header->recordCount = records;
+        m_header->droppedCount = m_dropped.load(std::memory_order_relaxed);
+        m_file.unmap(reinterpret_cast<uchar *>(m_header));
+        m_header = nullptr;
+    }
+
+    // Drop the preallocated tail so the file ends at the last record.
+    m_file.resize(Capture::CAPTURE_HEADER_SIZE + qint64(records) * qint64(sizeof(CaptureRecord)));
+    m_file.close();
+}
@@ -9,6 +9,13 @@
  * context details about a log message (thread, module, file, function,
  * and line number).
  *
+ * The message handler is split into a cheap front end that runs on the
+ * logging thread (type filter, record capture) and writeRecord(), which
+ * formats each line once into a reused UTF-8 buffer (LogLineFormatter)
+ * and writes the same bytes to every sink. In asynchronous mode the front end pushes the
+ * record into an MpscQueue and the "LogWriter" thread calls
+ * writeRecord() in batches; otherwise the front end calls it directly.
+ *
  * @date 08-Dec-2025
  * @author Gangadhar Thalange
  */
@@ -22,12 +29,30 @@
 #include <QTextStream>
 #include <QMutex>
 #include <iostream>
-#include <QSettings>
 #include <QCoreApplication>
 #include <QDir>
 #include <QStandardPaths>
 #include <QRegularExpression>
+#include <QVector>
+#include <QMetaMethod>
+#include <QPointer>
+#include <QTimer>
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstring>
+#include <memory>
+#include <mutex>
 #include "../include/clogger.h"
+#include "../include/mpscqueue.h"
+#include "../include/logring.h"
+#include "../include/logcategories.h"
+#include "../include/logformat.h"
+#include "../include/logratelimiter.h"
+#include "../include/binlog.h"
+#include "../include/flightrecorder.h"
+#include "../include/logstreamserver.h"
+#include "../include/settingsservice.h"
 
 #ifdef DISPLAY_TIME_FOR_PROFILING
 //Defined in main.cpp:main()
@@ -37,15 +62,247 @@ extern qint64 g_startTime;
 // log critical messages only for ALARM category
 Q_LOGGING_CATEGORY(_alarm_, "alarm.global", QtMsgType::QtCriticalMsg)
 
+/**
+ * @brief A log message captured by the message handler.
+ *
+ * Holds copies of everything writeRecord() needs, so the message can be
+ * formatted later on another thread. The context strings are borrowed
+ * while the record is written synchronously and copied before it is
+ * queued, because QML passes temporary buffers in QMessageLogContext.
+ */
+struct LogRecord
+{
+    QtMsgType type = QtDebugMsg;
+    qint64 utcMs = 0;           ///< Time of the call, ms since epoch (UTC)
+    int line = 0;
+    QByteArray file;
+    QByteArray function;
+    QByteArray category;
+    QString threadName;
+    QString message;
+};
+
+/**
+ * @brief Entry of the sparse time index kept next to the log file.
+ *
+ * The sidecar file `<log>.idx` is a plain array of these entries, one per
+ * indexInterval lines, each pointing at the start of a line.
+ */
+struct LogIndexEntry
+{
+    qint64 utcMs;       ///< Time stamp of the line, ms since epoch (UTC)
+    qint64 offset;      ///< Byte offset of the line in the log file
+};
+static_assert(sizeof(LogIndexEntry) == 16, "index entries are stored as 16 bytes");
+
+/**
+ * @brief Wraps a context string without copying it.
+ */
+static QByteArray rawBytes(const char *text)
+{
+    return text ? QByteArray::fromRawData(text, int(strlen(text))) : QByteArray();
+}
+
+/**
+ * @brief Returns whether a message comes from a QML file.
+ */
+static bool isQmlFile(const QByteArray &file)
+{
+    const int last = file.size() - 4;
+    for (int i = 0; i <= last; ++i) {
+        if (file.at(i) == '.' && qstrnicmp(file.constData() + i + 1, "qml", 3) == 0)
+            return true;
+    }
+    return false;
+}
+
+/**
+ * @brief Set while the current thread is inside the logger.
+ *
+ * Messages produced from within the logger (e.g. by a failing sink) go
+ * to stderr instead of recursing into the handler.
+ */
+static thread_local bool t_inLogger = false;
+
+/**
+ * @brief Marks the current thread as inside the logger for a scope.
+ */
+struct LoggerScope
+{
+    LoggerScope() { t_inLogger = true; }
+    ~LoggerScope() { t_inLogger = false; }
+};
+
 /**
  * @brief Private data for cLogger (PIMPL pattern).
  *
  * This struct stores internal state for the logger implementation:
  * file handle, echo settings, timestamping, per-module log levels,
- * buffered messages, and synchronization primitives.
+ * buffered messages, the asynchronous queue with its writer thread,
+ * and synchronization primitives.
  */
 struct cLogger::cLoggerPrivate
 {
+    cLoggerPrivate();
+
+    /**
+     * @brief Formats and writes one record to all sinks.
+     * @note Caller must hold logMutex. Does not flush the file.
+     */
+    void writeRecord(const LogRecord &record);
+
+    /**
+     * @brief Starts a line in #line with time stamp, level, module and thread.
+     *
+     * Records the field positions in #layout; the caller appends the text.
+     */
+    void beginLine(qint64 utcMs, const char *levelString, const char *moduleName,
+                   const QString &threadName);
+
+    /**
+     * @brief Hands the line in #line to the file, stdout and the ring.
+     * @note Caller must hold logMutex.
+     */
+    void writeLine(qint64 utcMs, QtMsgType type, const QByteArray &category);
+
+    /**
+     * @brief Writes a record now or queues it, depending on the mode.
+     * @note Caller must not hold logMutex.
+     */
+    void dispatch(LogRecord &&record);
+
+    /**
+     * @brief Logs one "N messages suppressed" line per limited call site.
+     * @note Caller must not hold logMutex.
+     */
+    void writeSuppressionSummaries();
+
+    /**
+     * @brief Recomputes enabledTypeMask from logTypes.
+     */
+    void updateTypeMask();
+
+    /**
+     * @brief Queues a record for the writer thread, applying the overflow policy.
+     * @return false if the record was dropped.
+     */
+    bool enqueue(LogRecord &&record);
+
+    /**
+     * @brief Wakes the writer thread if it is waiting for messages.
+     */
+    void wakeWriter();
+
+    /**
+     * @brief Writer thread loop.
+     */
+    void runWriter();
+
+    /**
+     * @brief Allocates the queue (first call only) and starts the writer.
+     */
+    void startWriter();
+
+    /**
+     * @brief Drains the queue and joins the writer thread.
+     */
+    void stopWriter();
+
+    /**
+     * @brief Wakes the rotator thread, starting it on first use.
+     * @note Caller must hold logMutex.
+     */
+    void requestRotation();
+
+    /**
+     * @brief Rotator thread loop.
+     */
+    void runRotator();
+
+    /**
+     * @brief Shifts and compresses the generations and reopens the live file.
+     */
+    void rotateFiles();
+
+    /**
+     * @brief Deletes the oldest generations until the budget is met.
+     */
+    void enforceDiskBudget(const QString &liveName);
+
+    /**
+     * @brief Joins the rotator thread.
+     */
+    void stopRotator();
+
+    /**
+     * @brief Opens the sidecar index of the live file and loads it.
+     *
+     * An index that does not match the log file is discarded; lines
+     * written before the first entry are then found by scanning.
+     * @note Caller must hold logMutex.
+     */
+    void openIndex();
+
+    /**
+     * @brief Points BinLog at `<log>.bin` while binary categories are selected.
+     * @note Caller must hold logMutex.
+     */
+    void updateBinaryLog();
+
+    /**
+     * @brief Maps `<log>.ring` while a flight recorder size is set.
+     * @note Caller must hold logMutex.
+     */
+    void updateFlightRecorder();
+
+    /**
+     * @brief Flushes the log file, at most once per fileFlushIntervalMs
+     *        while the flight recorder keeps the latest lines.
+     * @note Caller must hold logMutex.
+     */
+    void flushLogFile(bool force);
+
+    /**
+     * @brief Returns whether lines are collected into batches (subscribers
+     *        or newLogMessages receivers exist).
+     */
+    bool collectBatches() const;
+
+    /**
+     * @brief Returns the pending batch if it is complete (or, with
+     *        @p force, not empty) and starts a new one.
+     * @note Caller must hold logMutex.
+     */
+    LogBatchPtr takeBatch(bool force);
+
+    /**
+     * @brief Starts batchTimer for the pending batch unless it is running.
+     *
+     * Synchronous mode has no writer thread that goes idle, so the timer
+     * completes a batch no further line arrives for.
+     * @note Caller must hold logMutex.
+     */
+    void armBatchTimer();
+
+    /**
+     * @brief Hands out the pending batch once it is batchMaxAgeMs old.
+     * @note Runs on batchTimer's thread; caller must not hold logMutex.
+     */
+    void completeAgedBatch();
+
+    /**
+     * @brief Hands @p batch to the subscribers and emits newLogMessages.
+     * @note Caller must not hold logMutex.
+     */
+    void deliver(const LogBatchPtr &batch);
+
+    /**
+     * @brief Returns the file name of rotated generation @p generation.
+     *
+     * Generation 1 is kept as plain text, older ones are compressed.
+     */
+    QString generationName(const QString &liveName, int generation) const;
+
     /// Default log level used when no explicit setting exists
     const static QtMsgType defaultLogLevel;
     /// File used for persistent logging
@@ -59,6 +316,29 @@ struct cLogger::cLoggerPrivate
 
     // How big we let the log file get before we roll it over
     const static qint64 logFileRolloverSize;
+    const static int defaultLogGenerations;
+
+    // ---- Rotation (bytesWritten and rotationPending protected by logMutex) ----
+    qint64 rolloverBytes;
+    // Rotated files kept besides the live file
+    int logGenerations;
+    // Upper bound for live file plus generations in bytes (0 = unlimited)
+    qint64 diskBudgetBytes = 0;
+    // Size of the live file, counted as it is written instead of stat()ed
+    qint64 bytesWritten = 0;
+    bool rotationPending = false;
+    QThread rotator;
+    std::mutex rotateMutex;
+    std::condition_variable rotateCondition;
+    bool rotateRequested = false;   // protected by rotateMutex
+    bool rotatorStop = false;       // protected by rotateMutex
+    std::atomic<int> rotationCount{0};
+
+    // ---- Sparse time index of the live file (protected by logMutex) ----
+    const static int indexInterval;
+    QFile indexFile;
+    QVector<LogIndexEntry> index;
+    int linesSinceIndex = 0;
 
     // Table of log levels, by source (Test Manager, the application, etc.)
     QMap<QString, QtMsgType> logLevels;
@@ -66,19 +346,112 @@ struct cLogger::cLoggerPrivate
     // List of Log Types
     QList<QtMsgType> logTypes;
 
-    // Buffer of previous message, maintained so that the app can request them.
-    QQueue<QString> previousMessages;
+    // Lines written since the last batch was handed out (protected by logMutex)
+    std::unique_ptr<LogBatch> pendingBatch;
+    // Lines written so far, numbers the lines of batches
+    quint64 lineSequence = 0;
     int maxPreviousMessages;
     const static int defaultMaxPreviousMessages;
     // how many messages to store up before sending them to the app.
     int logNotificationThreshold;
     const static int defaultLogNotificationThreshold;
+    // Longest time a line waits in an incomplete batch (checked per line)
+    const static int batchMaxAgeMs;
+    // Completes aged batches in synchronous mode; lives in the thread that
+    // created the logger and needs its event loop
+    QTimer batchTimer;
+    std::atomic<bool> batchTimerArmed{false};
+
+    // ---- Batch subscribers ----
+    struct Subscriber {
+        int id;
+        QPointer<QObject> context;
+        cLogger::LogBatchHandler handler;
+    };
+    // Replaced, never modified, so delivery works on a snapshot without locking
+    std::shared_ptr<const std::vector<Subscriber>> subscribers;
+    std::mutex subscriberMutex;
+    std::atomic<int> subscriberCount{0};
+    int nextSubscriberId = 1;
+
+    // Most recent messages, readable without locking or file I/O
+    const static int recentCapacity;
+    LogRing recent;
 
     // Mutex to manage access from multiple threads
     QMutex logMutex;
 
+    // Line being written, shared by all sinks (protected by logMutex)
+    LogLineFormatter line;
+    // Byte ranges of the fields in line
+    struct {
+        size_t module = 0;
+        size_t moduleLength = 0;
+        size_t thread = 0;
+        size_t threadLength = 0;
+        size_t text = 0;
+    } layout;
+
     // Last logged message. Used to keep from spamming the same message over and over.
     QString prevMsg;
+    // How often prevMsg was suppressed since it was written (protected by logMutex)
+    int repeatedMessageCount = 0;
+
+    // logTypes as a bit mask (1 << QtMsgType), checked without locking
+    std::atomic<quint32> enabledTypeMask{0};
+
+    // ---- Per-call-site storm protection (off until setRateLimit()) ----
+    const static int defaultRateBurst;
+    // Duplicate window and least time between suppression summaries
+    const static int suppressionWindowMs;
+    LogRateLimiter rateLimiter;
+
+    // ---- Alarms: own queue and thread, no logMutex ----
+    AlarmChannel alarms;
+
+    // Categories logged by NG_BINLOG() in binary form (protected by logMutex)
+    QStringList binaryCategories;
+
+    // ---- Flight recorder (protected by logMutex) ----
+    // Copies every line into a mapped ring file that survives a crash,
+    // so the log file no longer needs a flush per line
+    FlightRecorder flightRecorder;
+    qint64 flightRecorderBytes = 0;
+    // Longest time lines stay in the QFile buffer while the recorder runs
+    const static int fileFlushIntervalMs;
+    qint64 lastFileFlushMs = 0;
+
+    // ---- Live stream (protected by streamMutex, not logMutex: stopping
+    // the server waits for its thread, which may log) ----
+    std::unique_ptr<LogStreamServer> streamServer;
+    std::mutex streamMutex;
+
+    // ---- Asynchronous backend ----
+    const static int defaultQueueCapacity;
+    // Most records written per logMutex acquisition by the writer
+    const static int writerBatchSize;
+    // Longest sleep of an idle writer in ms (wakeups are normally explicit)
+    const static int writerIdleTimeoutMs;
+
+    std::atomic<bool> async{false};
+    std::atomic<int> overflowPolicy{cLogger::OverflowDrop};
+    int queueCapacity;
+    // Allocated on first use and kept until ~cLogger(), which uninstalls
+    // the message handler first, so producers never see it freed
+    std::unique_ptr<MpscQueue<LogRecord>> queue;
+    QThread writer;
+    std::atomic<bool> writerStop{false};
+    std::atomic<bool> writerSleeping{false};
+    std::mutex wakeMutex;
+    std::condition_variable wakeCondition;
+
+    std::atomic<quint64> enqueued{0};   // records accepted by the queue
+    std::atomic<quint64> written{0};    // records taken out by the writer
+    std::atomic<quint64> dropped{0};    // records rejected under OverflowDrop
+
+    std::mutex flushMutex;
+    std::condition_variable flushCondition;
+    std::atomic<int> flushWaiters{0};
 };
 
 // Use Q_GLOBAL_STATIC for thread-safe singleton initialization
@@ -91,14 +464,24 @@ const QtMsgType cLogger::cLoggerPrivate::defaultLogLevel = QtWarningMsg;
 #endif
 
 const int cLogger::cLoggerPrivate::defaultMaxPreviousMessages = 1000;
-const int cLogger::cLoggerPrivate::defaultLogNotificationThreshold = 10;
+const int cLogger::cLoggerPrivate::defaultLogNotificationThreshold = 256;
+const int cLogger::cLoggerPrivate::batchMaxAgeMs = 50;
 const qint64 cLogger::cLoggerPrivate::logFileRolloverSize = 2097152;//1048576;
+const int cLogger::cLoggerPrivate::defaultLogGenerations = 5;
+const int cLogger::cLoggerPrivate::indexInterval = 64;
+const int cLogger::cLoggerPrivate::recentCapacity = 1024;
+const int cLogger::cLoggerPrivate::defaultQueueCapacity = 8192;
+const int cLogger::cLoggerPrivate::writerBatchSize = 256;
+const int cLogger::cLoggerPrivate::writerIdleTimeoutMs = 500;
+const int cLogger::cLoggerPrivate::defaultRateBurst = 50;
+const int cLogger::cLoggerPrivate::suppressionWindowMs = 1000;
+const int cLogger::cLoggerPrivate::fileFlushIntervalMs = 1000;
 
 const int levelFieldWidth = 10;
 const int moduleFieldWidth = 20;
 const int threadFieldWidth = 30;
 // Map QtMsgType enum values to string indices (QtDebugMsg=0, QtWarningMsg=1, QtCriticalMsg=2, QtFatalMsg=3, QtInfoMsg=4)
-const QStringList g_strLevelList = {"DEB","WAR","CRI","FAT","INF"};
+static const char *const g_levelNames[] = {"DEB","WAR","CRI","FAT","INF"};
 QString logFileName = "TestLogger";
 
 /**
@@ -118,13 +501,15 @@ cLogger &cLogger::instance()
  * @brief Initialize the logger.
  *
  * Validates the supplied filename and creates internal private data when
- * required. Reads logging preferences from QSettings (ORG_NAME/APP_NAME)
- * and installs the message handler.
+ * required. Reads logging preferences from the SettingsService (ORG_NAME/APP_NAME),
+ * falling back to @p settingDefaults and then to the library defaults, and
+ * installs the message handler.
  *
  * @param fileName Base name of the log file (no path separators allowed)
+ * @param settingDefaults Program defaults for settings keys that are not set
  * @return true on success, false on validation failure
  */
-bool cLogger::init(QString fileName)
+bool cLogger::init(QString fileName, const QVariantMap &settingDefaults)
 {
     // Validate filename to prevent path traversal and invalid characters
     if (fileName.isEmpty()) {
@@ -156,14 +541,17 @@ bool cLogger::init(QString fileName)
     
     bool status = true;
     logFileName = fileName;
-    QSettings settings(ORG_NAME, APP_NAME);
+    const SettingsService &settings = SettingsService::instance();
+    auto setting = [&](const QString &key, const QVariant &libraryDefault) {
+        return settings.value(key, settingDefaults.value(key, libraryDefault));
+    };
 
     d_ptr->echoToStdOut = true; // Making is flag true will display messages to output window
 
-    int logDebugType = settings.value("logDebugSettings", -1).toInt();
-    int logWarningType = settings.value("logWarningSettings", -1).toInt();
-    int logCriticalType = settings.value("logCriticalSettings", -1).toInt();
-    int logInfoType = settings.value("logInfoSettings", -1).toInt();
+    int logDebugType = setting("logDebugSettings", -1).toInt();
+    int logWarningType = setting("logWarningSettings", -1).toInt();
+    int logCriticalType = setting("logCriticalSettings", -1).toInt();
+    int logInfoType = setting("logInfoSettings", -1).toInt();
 
     d_ptr->enableTimeStamp = true;
     checkForLogFile();
@@ -186,65 +574,77 @@ bool cLogger::init(QString fileName)
     if(logInfoType == 4) {
         d_ptr->logTypes.insert(4,QtMsgType::QtInfoMsg);
     }
+    d_ptr->updateTypeMask();
     qInstallMessageHandler(&cLogger::messageHandler);
+    LogCategoryFilter::install();
+    d_ptr->alarms.start();
+    locker.unlock();
+
+    setLogRotation(setting("logRolloverBytes", cLoggerPrivate::logFileRolloverSize).toLongLong(),
+                   setting("logGenerations", cLoggerPrivate::defaultLogGenerations).toInt(),
+                   setting("logDiskBudgetBytes", 0).toLongLong());
+
+    setAsync(setting("logAsync", false).toBool());
+    setRateLimit(setting("logRateLimit", 0).toInt(),
+                 setting("logRateBurst", cLoggerPrivate::defaultRateBurst).toInt());
+    setBinaryCategories(setting("logBinaryCategories", QStringList()).toStringList());
+    setFlightRecorder(setting("logFlightRecorderBytes", 0).toLongLong());
+    setLogStreamSocket(setting("logStreamSocket", QString()).toString());
     return status;
 }
 
 /**
- * @brief Get the stored database version from QSettings.
+ * @brief Get the stored database version from the SettingsService.
  *
  * @return Stored database version or -1 if not set
  */
 int cLogger::getDbVersion()
 {
-    QSettings settings(ORG_NAME, APP_NAME);
-    return settings.value("dbVersion", -1).toInt();
+    return SettingsService::instance().value("dbVersion", -1).toInt();
 }
 
 /**
- * @brief Store the database version into QSettings.
+ * @brief Store the database version into the SettingsService.
  *
  * @param ver Database version to store
  */
 void cLogger::setDbVersion(int ver)
 {
-    QSettings settings(ORG_NAME, APP_NAME);
-    settings.setValue("dbVersion",ver);
+    SettingsService::instance().setValue("dbVersion", ver);
 }
 
 /**
- * @brief Get the stored probe database version from QSettings.
+ * @brief Get the stored probe database version from the SettingsService.
  *
  * @return Stored probe database version or -1 if not set
  */
 int cLogger::getProbeDbVersion()
 {
-    QSettings settings(ORG_NAME, APP_NAME);
-    return settings.value("probeDbVersion", -1).toInt();
+    return SettingsService::instance().value("probeDbVersion", -1).toInt();
 }
 
 /**
- * @brief Store the probe database version into QSettings.
+ * @brief Store the probe database version into the SettingsService.
  *
  * @param ver Probe database version to store
  */
 void cLogger::setProbeDbVersion(int ver)
 {
-    QSettings settings(ORG_NAME, APP_NAME);
-    settings.setValue("probeDbVersion",ver);
+    SettingsService::instance().setValue("probeDbVersion", ver);
 }
 
 /**
  * @brief Qt message handler that routes messages to the cLogger.
  *
- * This function is installed with qInstallMessageHandler. It performs:
- * - initialization checks,
- * - filtering by enabled log types,
- * - deduplication of consecutive identical messages,
- * - formatting messages with timestamp/module/thread,
- * - writing to the log file and stdout,
- * - buffering recent messages and emitting them when threshold is reached,
- * - log file rollover when the file exceeds configured size.
+ * This function is installed with qInstallMessageHandler. It performs
+ * only the work that must happen on the calling thread:
+ * - filtering by enabled log types (lock-free mask),
+ * - capturing the message and its context into a LogRecord,
+ * - queueing it for the writer thread (asynchronous mode) or writing it
+ *   directly via writeRecord() (synchronous mode).
+ *
+ * Fatal messages flush the queue and are written synchronously, so they
+ * are on disk before Qt aborts.
  *
  * @param type The Qt message type
  * @param context Contextual information (file, function, line, category)
@@ -252,24 +652,20 @@ void cLogger::setProbeDbVersion(int ver)
  */
 void cLogger::messageHandler(QtMsgType type, const QMessageLogContext &context, const QString &msg)
 {
-    // Ensure d_ptr is initialized (thread-safe check)
-    {
-        QMutexLocker initLocker(d_ptrMutex());
-        if (!d_ptr) {
-            // Fallback to standard output if logger not initialized
-            std::cerr << "[FALLBACK] " << msg.toLocal8Bit().constData() << std::endl;
-            return;
-        }
+    // d_ptr is created before the handler is installed; ~cLogger()
+    // uninstalls the handler before it deletes d_ptr, and a handler
+    // chained on top of this one finds d_ptr null afterwards
+    cLoggerPrivate *d = d_ptr;
+    if (!d || t_inLogger) {
+        // Fallback to standard output if logger not initialized or re-entered
+        std::cerr << "[FALLBACK] " << msg.toLocal8Bit().constData() << std::endl;
+        return;
     }
-    
+
     // Bail out if the log type is not available for the message
-    // Use mutex to safely check logTypes
-    {
-        QMutexLocker logMutexLocker(&d_ptr->logMutex);
-        if(!d_ptr->logTypes.contains(type)) {
-            return;
-        }
-    }
+    if (!(d->enabledTypeMask.load(std::memory_order_relaxed) & (1u << type)))
+        return;
+
 #ifdef PLAT_LINUX_IMX6
     const QString qstr = "PulseAudioService: pa_context_connect() failed";
 #else
@@ -277,98 +673,160 @@ void cLogger::messageHandler(QtMsgType type, const QMessageLogContext &context,
 #endif
     if (msg.compare(qstr)==0) //TODO: HAck borrowed from cMessageHandler
         return;
-#ifdef DISPLAY_TIME_FOR_PROFILING
-    QString timestamp = QString::number((QDateTime::currentMSecsSinceEpoch()-g_startTime)/1000.0,'g');
-#else
-    QString timestamp = d_ptr->enableTimeStamp ? QDateTime::currentDateTimeUtc().toString("[yyyy/MM/dd HH:mm:ss.zzz]") : "";
-#endif
 
-    QString logMessage;
-
-    // Try to figure out what module generated the message based on the filename
-    QString filename(context.file);
-    QString moduleName = "App";
-    if(filename.contains(".qml", Qt::CaseInsensitive)) {
-        // special case - QML files are always the app
-        moduleName = "QML";
-    } else {
-        //TODO:Module wise logs
-//        foreach(const QString &k, d_ptr->logLevels.keys()) {
-//            QString filenameSearchText = k.simplified();
-//            filenameSearchText.replace(" ", "");
-//            if(filename.contains(filenameSearchText, Qt::CaseInsensitive)) {
-//                moduleName = k;
-//                break;
-//            }
-//        }
-    }
-//Module TODO
-//    // Bail out if the log level for the module that generated this message is
-//    // above that of the message itself.
-//    if(d_ptr->logLevels.keys().contains(moduleName)) {
-//        if(type < d_ptr->logLevels[moduleName]) {
-//            return;
-//        }
-//    }
-
-//    moduleName = QString("[%1]").arg(moduleName).leftJustified(moduleFieldWidth, ' ');
-    QString threadName = QThread::currentThread()->objectName();
+    LoggerScope scope;
 
+    // Alarms take their own queue and thread; they must not wait behind
+    // the log queue or logMutex
+    const bool alarm = type == QtCriticalMsg && qstrcmp(context.category, "alarm.global") == 0;
+    if (alarm) {
+        AlarmChannel::Alarm entry;
+        entry.utcMs = QDateTime::currentMSecsSinceEpoch();
+        entry.context = LogContext::capture(context.file, context.function, context.line,
+                                            isQmlFile(rawBytes(context.file)) ? "QML" : "App");
+        entry.message = msg;
+        d->alarms.post(std::move(entry));
 #ifdef PLAT_LINUX_IMX6
-    if(type == QtCriticalMsg) {
-        if(QString(context.category).compare("alarm.global")==0) {
-            // send alarm to cloud but DO NOT log in to Mozart.log
-            QString file = QString(context.file);
-            QString function = QString(context.function);
-            qint32 line = context.line;
-            LogMessageContext msgContext(threadName, moduleName, file, function, line);
-            emit cLogger::instance().postAlarmMessage(msg, msgContext);
+        // send alarm to cloud but DO NOT log in to Mozart.log
+        return;
+#endif
+    }
+
+    // Storm protection per call site, before anything is copied. Fatal
+    // messages and alarms always pass.
+    if (d->rateLimiter.isEnabled() && type != QtFatalMsg && !alarm) {
+        const qint64 nowUs = LogRateLimiter::now();
+        const bool admitted = d->rateLimiter.admit(
+                    LogRateLimiter::siteKey(context.file, context.line, context.category),
+                    context.file, context.line, quint64(qHash(msg)), nowUs);
+        if (d->rateLimiter.summaryDue(nowUs))
+            d->writeSuppressionSummaries();
+        if (!admitted)
             return;
+    }
+
+    LogRecord record;
+    record.type = type;
+    record.utcMs = QDateTime::currentMSecsSinceEpoch();
+    record.line = context.line;
+    // Borrowed until the record is queued; copied only in asynchronous mode
+    record.file = rawBytes(context.file);
+    record.function = rawBytes(context.function);
+    record.category = rawBytes(context.category);
+    record.threadName = QThread::currentThread()->objectName();
+    record.message = msg;
+
+    if (type == QtFatalMsg) {
+        cLogger::instance().flush();
+        LogBatchPtr batch;
+        {
+            QMutexLocker logMutexLocker(&d->logMutex);
+            d->writeRecord(record);
+            d->logFile.flush();
+            batch = d->takeBatch(true);
         }
+        d->deliver(batch);
+        return;
     }
-#endif
 
-    // Safely get level string with bounds checking
-    QString levelString = "UNK";
-    if (type >= 0 && type < g_strLevelList.size()) {
-        levelString = g_strLevelList.at(type);
-    } else {
-        qWarning() << "cLogger::messageHandler: Invalid message type:" << type;
+    d->dispatch(std::move(record));
+}
+
+void cLogger::cLoggerPrivate::dispatch(LogRecord &&record)
+{
+    if (async.load(std::memory_order_acquire) && QThread::currentThread() != &writer) {
+        record.file = QByteArray(record.file.constData(), record.file.size());
+        record.function = QByteArray(record.function.constData(), record.function.size());
+        record.category = QByteArray(record.category.constData(), record.category.size());
+        enqueue(std::move(record));
+        return;
     }
-    // Get the thread name, if one is set
-    if(threadName == "")
-        threadName = "NoThread";
-//    threadName = QString("[%1]").arg(threadName).leftJustified(threadFieldWidth);
 
-    // Use thread-local storage for repeated message count to ensure thread safety
-    static thread_local int repeatedMessageCount = 0;
-    QString repeatedMessageString = "";
-    
-    // Lock mutex for the rest of the function to safely access d_ptr
-    QMutexLocker logMutexLocker(&d_ptr->logMutex);
-    
+    LogBatchPtr batch;
+    {
+        QMutexLocker logMutexLocker(&logMutex);
+        writeRecord(record);
+        flushLogFile(false);
+        batch = takeBatch(false);
+        if (!batch && pendingBatch && !pendingBatch->isEmpty())
+            armBatchTimer();
+    }
+    deliver(batch);
+}
+
+void cLogger::cLoggerPrivate::writeSuppressionSummaries()
+{
+    const qint64 utcMs = QDateTime::currentMSecsSinceEpoch();
+    const QString threadName = QThread::currentThread()->objectName();
+    rateLimiter.takeSummaries([&](const char *site, size_t siteLength, quint64 count) {
+        LogRecord record;
+        record.type = QtInfoMsg;
+        record.utcMs = utcMs;
+        record.threadName = threadName;
+        record.message = QString("(%1 messages suppressed from %2)")
+                .arg(count).arg(QString::fromUtf8(site, int(siteLength)));
+        dispatch(std::move(record));
+    });
+}
+
+cLogger::cLoggerPrivate::cLoggerPrivate()
+    : rolloverBytes(logFileRolloverSize)
+    , logGenerations(defaultLogGenerations)
+    , maxPreviousMessages(defaultMaxPreviousMessages)
+    , logNotificationThreshold(defaultLogNotificationThreshold)
+    , recent(size_t(recentCapacity))
+    , queueCapacity(defaultQueueCapacity)
+{
+    writer.setObjectName("LogWriter");
+    QObject::connect(&writer, &QThread::started, [this]() { runWriter(); });
+    rotator.setObjectName("LogRotator");
+    QObject::connect(&rotator, &QThread::started, [this]() { runRotator(); });
+    batchTimer.setSingleShot(true);
+    QObject::connect(&batchTimer, &QTimer::timeout, [this]() { completeAgedBatch(); });
+    // postAlarmMessage is emitted on the alarm thread; receivers elsewhere
+    // get it through a queued connection
+    qRegisterMetaType<LogMessageContext>("LogMessageContext");
+    qRegisterMetaType<LogContext>("LogContext");
+    alarms.setConsumer([](const AlarmChannel::Alarm &alarm) {
+        cLogger &logger = cLogger::instance();
+        emit logger.alarmRaised(alarm.message, alarm.context);
+        // The QObject context is only built for QML receivers
+        static const QMetaMethod postAlarmSignal = QMetaMethod::fromSignal(&cLogger::postAlarmMessage);
+        if (logger.isSignalConnected(postAlarmSignal)) {
+            LogMessageContext msgContext(alarm.context);
+            emit logger.postAlarmMessage(alarm.message, msgContext);
+        }
+    });
+}
+
+/**
+ * @brief Formats a record and writes it to the log file, stdout and the
+ *        in-memory ring.
+ *
+ * Each line is formatted once into the reused UTF-8 buffer #line and the
+ * same bytes go to every sink, so writing a line does not allocate.
+ * Performs deduplication of consecutive identical messages and requests
+ * a rotation when the bytes written to the file exceed the configured
+ * size.
+ *
+ * @param record Captured message.
+ */
+void cLogger::cLoggerPrivate::writeRecord(const LogRecord &record)
+{
+    const QtMsgType type = record.type;
+    const QString &msg = record.message;
+
     // Check to see if the new log message is the same as the previous one. If so, we don't
     // want to log it again.
-    if(msg == d_ptr->prevMsg) {
+    if(msg == prevMsg) {
         repeatedMessageCount++;
         return;
-    } else {
-        if(repeatedMessageCount > 0) {
-            repeatedMessageString = QString("%1 [%2 %3 %4] %5").arg(timestamp).arg(levelString).arg(moduleName)
-                    .arg(threadName).arg(QString("(previous message repeats %1 times)").arg(repeatedMessageCount));
-        }
-        repeatedMessageCount = 0;
-        d_ptr->prevMsg = msg;
     }
+    const int repeats = repeatedMessageCount;
+    repeatedMessageCount = 0;
+    prevMsg = msg;
 
-    logMessage = QString("%1 [%2 %3 %4] %5").arg(timestamp).arg(levelString).arg(moduleName)
-            .arg(threadName).arg(msg);
-    if(type == QtFatalMsg || type == QtCriticalMsg || type == QtWarningMsg) {
-        logMessage += QString(" in %1at: %2, line %3").arg(
-                    QString(context.function)).arg(QString(context.file)).arg(
-                    context.line);
-    }
-    if(!d_ptr->logFile.isOpen()) {
+    if(!logFile.isOpen()) {
         // Create log fileif not open
         QString strSysDir;
 #ifdef PLAT_LINUX_IMX6
@@ -383,52 +841,544 @@ void cLogger::messageHandler(QtMsgType type, const QMessageLogContext &context,
 #else
         QString strFilename = strSysDir + QDir::separator() + logFileName+".log";
 #endif
-        d_ptr->logFile.setFileName(strFilename);
-        if(!d_ptr->logFile.open(QIODevice::WriteOnly| QIODevice::Append)) {
-            std::cerr << "Error: Cannot write file " << d_ptr->logFile.errorString().toLocal8Bit().constData() << std::endl;
+        logFile.setFileName(strFilename);
+        if(!logFile.open(QIODevice::WriteOnly| QIODevice::Append)) {
+            std::cerr << "Error: Cannot write file " << logFile.errorString().toLocal8Bit().constData() << std::endl;
             return;
         }
         // Set file permissions: owner read/write, group read, others read
-        d_ptr->logFile.setPermissions(QFile::ReadOwner | QFile::WriteOwner | QFile::ReadGroup | QFile::ReadOther);
+        logFile.setPermissions(QFile::ReadOwner | QFile::WriteOwner | QFile::ReadGroup | QFile::ReadOther);
+        bytesWritten = logFile.size();
+        openIndex();
+        updateBinaryLog();
+        updateFlightRecorder();
     }
-    if(d_ptr->logFile.isOpen()) {
-        QTextStream logFileStream(&d_ptr->logFile);
-        if(!repeatedMessageString.isEmpty())
-#ifdef SUPPORT_QT6
-            logFileStream << repeatedMessageString << Qt::endl;
-        logFileStream << logMessage << Qt::endl;
+
+    // Try to figure out what module generated the message based on the filename
+    // (QML files are always the app). Module levels are applied per logging
+    // category by LogCategoryFilter, before the message reaches the handler.
+    const char *moduleName = isQmlFile(record.file) ? "QML" : "App";
+
+    // Safely get level string with bounds checking
+    const char *levelString = "UNK";
+    if (type >= 0 && type < int(sizeof(g_levelNames) / sizeof(g_levelNames[0]))) {
+        levelString = g_levelNames[type];
+    } else {
+        std::cerr << "cLogger::writeRecord: Invalid message type: " << type << std::endl;
+    }
+
+    if(repeats > 0) {
+        beginLine(record.utcMs, levelString, moduleName, record.threadName);
+        line.append("(previous message repeats ");
+        line.appendNumber(repeats);
+        line.append(" times)");
+        writeLine(record.utcMs, type, record.category);
+    }
+
+    beginLine(record.utcMs, levelString, moduleName, record.threadName);
+    line.appendUtf16(reinterpret_cast<const char16_t *>(msg.utf16()), size_t(msg.size()));
+    if(type == QtFatalMsg || type == QtCriticalMsg || type == QtWarningMsg) {
+        line.append(" in ");
+        line.append(record.function.constData(), size_t(record.function.size()));
+        line.append("at: ");
+        line.append(record.file.constData(), size_t(record.file.size()));
+        line.append(", line ");
+        line.appendNumber(record.line);
+    }
+    writeLine(record.utcMs, type, record.category);
+
+    // Roll over the log file, if necessary. The rotator thread does the
+    // renaming and compression; this message only hands it the request.
+    if(bytesWritten > rolloverBytes && !rotationPending) {
+        rotationPending = true;
+        requestRotation();
+    }
+}
+
+void cLogger::cLoggerPrivate::beginLine(qint64 utcMs, const char *levelString,
+                                        const char *moduleName, const QString &threadName)
+{
+    line.clear();
+#ifdef DISPLAY_TIME_FOR_PROFILING
+    line.append(QByteArray::number((utcMs-g_startTime)/1000.0,'g').constData());
 #else
-            logFileStream << repeatedMessageString << Qt::endl;
-        logFileStream << logMessage << Qt::endl;
+    if(enableTimeStamp)
+        line.appendTimestamp(utcMs);
 #endif
-        d_ptr->logFile.flush();
+    line.append(" [");
+    line.append(levelString);
+    line.append(' ');
+    layout.module = line.size();
+    line.append(moduleName);
+    layout.moduleLength = line.size() - layout.module;
+    line.append(' ');
+    layout.thread = line.size();
+    // Get the thread name, if one is set
+    if(threadName.isEmpty())
+        line.append("NoThread");
+    else
+        line.appendUtf16(reinterpret_cast<const char16_t *>(threadName.utf16()), size_t(threadName.size()));
+    layout.threadLength = line.size() - layout.thread;
+    line.append("] ");
+    layout.text = line.size();
+}
+
+void cLogger::cLoggerPrivate::writeLine(qint64 utcMs, QtMsgType type, const QByteArray &category)
+{
+    const size_t textEnd = line.size();
+    line.append('\n');
+
+    if(logFile.isOpen()) {
+        if(linesSinceIndex == 0) {
+            const LogIndexEntry entry = { utcMs, bytesWritten };
+            index.append(entry);
+            if(indexFile.isOpen()) {
+                indexFile.write(reinterpret_cast<const char *>(&entry), sizeof(entry));
+                indexFile.flush();
+            }
+        }
+        linesSinceIndex = (linesSinceIndex + 1) >= indexInterval ? 0 : linesSinceIndex + 1;
+        const qint64 count = logFile.write(line.data(), qint64(line.size()));
+        if(count > 0)
+            bytesWritten += count;
+    }
+    if(echoToStdOut) {
+        std::cout.write(line.data(), std::streamsize(line.size()));
+        std::cout.flush();
     }
-    if(d_ptr->echoToStdOut) {
-        if(!repeatedMessageString.isEmpty())
-            std::cout << repeatedMessageString.toLocal8Bit().constData() << std::endl;
-        std::cout << logMessage.toLocal8Bit().constData() << std::endl;
+
+    if(flightRecorder.isOpen())
+        flightRecorder.append(line.data(), textEnd);
+
+    const char *data = line.data();
+    recent.push(utcMs, type, data + layout.module, layout.moduleLength,
+                data + layout.thread, layout.threadLength,
+                data + layout.text, textEnd - layout.text);
+
+    // Batches are only built when someone listens; they are handed out
+    // by the caller after logMutex is released (takeBatch(), deliver())
+    ++lineSequence;
+    if(!collectBatches()) {
+        pendingBatch.reset();
+        return;
     }
-    if(!repeatedMessageString.isEmpty())
-        d_ptr->previousMessages.enqueue(repeatedMessageString);
-    d_ptr->previousMessages.enqueue(logMessage);
-    if(d_ptr->previousMessages.size() >= d_ptr->logNotificationThreshold) {
-        emit cLogger::instance().newLogMessages(d_ptr->previousMessages);
-        d_ptr->previousMessages.clear();
+    if(!pendingBatch) {
+        pendingBatch.reset(new LogBatch);
+        pendingBatch->setFirstSequence(lineSequence);
     }
+    static const char defaultCategory[] = "default";
+    if(category.isEmpty())
+        pendingBatch->append(utcMs, type, data, textEnd, layout.text, defaultCategory, sizeof(defaultCategory) - 1);
+    else
+        pendingBatch->append(utcMs, type, data, textEnd, layout.text, category.constData(), size_t(category.size()));
+}
+
+bool cLogger::cLoggerPrivate::collectBatches() const
+{
+    static const QMetaMethod newLogMessagesSignal = QMetaMethod::fromSignal(&cLogger::newLogMessages);
+    return subscriberCount.load(std::memory_order_relaxed) > 0
+            || cLogger::instance().isSignalConnected(newLogMessagesSignal);
+}
 
-    // Roll over the log file, if necessary
-    QFileInfo fileInfo(d_ptr->logFile);
-    if(fileInfo.size() > d_ptr->logFileRolloverSize)
+LogBatchPtr cLogger::cLoggerPrivate::takeBatch(bool force)
+{
+    if(!pendingBatch || pendingBatch->isEmpty())
+        return LogBatchPtr();
+    if(!force && pendingBatch->size() < logNotificationThreshold
+            && QDateTime::currentMSecsSinceEpoch() - pendingBatch->at(0).utcMs < batchMaxAgeMs)
+        return LogBatchPtr();
+    return LogBatchPtr(pendingBatch.release());
+}
+
+void cLogger::cLoggerPrivate::armBatchTimer()
+{
+    if(batchTimerArmed.exchange(true))
+        return;
+    const qint64 ageMs = QDateTime::currentMSecsSinceEpoch() - pendingBatch->at(0).utcMs;
+    const int delayMs = int(qBound<qint64>(0, batchMaxAgeMs - ageMs, batchMaxAgeMs));
+    // QTimer may only be started from its own thread
+    QMetaObject::invokeMethod(&batchTimer, [this, delayMs]() { batchTimer.start(delayMs); },
+                              Qt::QueuedConnection);
+}
+
+void cLogger::cLoggerPrivate::completeAgedBatch()
+{
+    LogBatchPtr batch;
     {
-        QFile rolloverFile(d_ptr->logFile.fileName() + ".old");
-        if(rolloverFile.exists())
-            rolloverFile.remove();
-        d_ptr->logFile.close();
-        QString fileName = d_ptr->logFile.fileName();   // to revert later
-        d_ptr->logFile.rename(rolloverFile.fileName());
-        d_ptr->logFile.setFileName(fileName);
-        d_ptr->logFile.open(QIODevice::Append);
+        QMutexLocker logMutexLocker(&logMutex);
+        batchTimerArmed.store(false);
+        batch = takeBatch(false);
+        // A younger batch was started since the timer was armed
+        if(!batch && pendingBatch && !pendingBatch->isEmpty())
+            armBatchTimer();
+    }
+    deliver(batch);
+}
+
+void cLogger::cLoggerPrivate::deliver(const LogBatchPtr &batch)
+{
+    if(!batch)
+        return;
+
+    std::shared_ptr<const std::vector<Subscriber>> current;
+    {
+        std::lock_guard<std::mutex> lock(subscriberMutex);
+        current = subscribers;
+    }
+    if(current) {
+        for(const Subscriber &subscriber : *current) {
+            QObject *context = subscriber.context.data();
+            if(!context)
+                continue;
+            const cLogger::LogBatchHandler handler = subscriber.handler;
+            QMetaObject::invokeMethod(context, [handler, batch]() { handler(batch); }, Qt::QueuedConnection);
+        }
+    }
+
+    static const QMetaMethod newLogMessagesSignal = QMetaMethod::fromSignal(&cLogger::newLogMessages);
+    if(cLogger::instance().isSignalConnected(newLogMessagesSignal)) {
+        QList<QString> lines;
+        lines.reserve(batch->size());
+        for(int i = 0; i < batch->size(); ++i)
+            lines.append(batch->lineString(i));
+        emit cLogger::instance().newLogMessages(lines);
+    }
+}
+
+void cLogger::cLoggerPrivate::updateTypeMask()
+{
+    quint32 mask = 0;
+    for (QtMsgType type : logTypes)
+        mask |= 1u << type;
+    enabledTypeMask.store(mask, std::memory_order_relaxed);
+}
+
+bool cLogger::cLoggerPrivate::enqueue(LogRecord &&record)
+{
+    // tryPush() leaves the record untouched when the queue is full, so it
+    // can be offered again under OverflowBlock.
+    while (!queue->tryPush(std::move(record))) {
+        if (overflowPolicy.load(std::memory_order_relaxed) == cLogger::OverflowDrop) {
+            dropped.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+        wakeWriter();
+        QThread::yieldCurrentThread();
     }
+    enqueued.fetch_add(1);
+
+    // Only pay for the mutex/notify when the writer is actually waiting
+    if (writerSleeping.load())
+        wakeWriter();
+    return true;
+}
+
+void cLogger::cLoggerPrivate::wakeWriter()
+{
+    std::lock_guard<std::mutex> lock(wakeMutex);
+    wakeCondition.notify_one();
+}
+
+/**
+ * @brief Writes queued records in batches until stopWriter() is called.
+ *
+ * Each batch is written under a single logMutex acquisition and followed
+ * by one file flush. When the queue is empty the thread sleeps until a
+ * producer wakes it.
+ */
+void cLogger::cLoggerPrivate::runWriter()
+{
+    LoggerScope scope;
+    LogRecord record;
+
+    for (;;) {
+        int count = 0;
+        LogBatchPtr batch;
+        {
+            QMutexLocker logMutexLocker(&logMutex);
+            while (count < writerBatchSize && queue->tryPop(record)) {
+                writeRecord(record);
+                ++count;
+            }
+            if (count > 0)
+                flushLogFile(false);
+            // Subscribers get an incomplete batch once the queue is empty
+            batch = takeBatch(count == 0);
+        }
+        deliver(batch);
+
+        if (count > 0) {
+            written.fetch_add(quint64(count));
+            if (flushWaiters.load()) {
+                std::lock_guard<std::mutex> lock(flushMutex);
+                flushCondition.notify_all();
+            }
+            continue;
+        }
+
+        if (writerStop.load())
+            break;
+
+        // Producers check writerSleeping after publishing, so either they
+        // see it set or this check sees their record.
+        std::unique_lock<std::mutex> lock(wakeMutex);
+        writerSleeping.store(true);
+        if (enqueued.load() == written.load() && !writerStop.load())
+            wakeCondition.wait_for(lock, std::chrono::milliseconds(writerIdleTimeoutMs));
+        writerSleeping.store(false);
+        lock.unlock();
+
+        // Lines held back by flushLogFile() reach the file once logging pauses
+        QMutexLocker logMutexLocker(&logMutex);
+        flushLogFile(false);
+    }
+}
+
+void cLogger::cLoggerPrivate::startWriter()
+{
+    if (!queue)
+        queue.reset(new MpscQueue<LogRecord>(size_t(qMax(2, queueCapacity))));
+    if (!writer.isRunning()) {
+        writerStop.store(false);
+        writer.start();
+    }
+}
+
+void cLogger::cLoggerPrivate::stopWriter()
+{
+    if (!writer.isRunning())
+        return;
+    writerStop.store(true);
+    wakeWriter();
+    writer.wait();
+
+    std::lock_guard<std::mutex> lock(flushMutex);
+    flushCondition.notify_all();
+}
+
+void cLogger::cLoggerPrivate::requestRotation()
+{
+    {
+        std::lock_guard<std::mutex> lock(rotateMutex);
+        rotateRequested = true;
+    }
+    if (!rotator.isRunning())
+        rotator.start(QThread::LowPriority);
+    else
+        rotateCondition.notify_one();
+}
+
+void cLogger::cLoggerPrivate::runRotator()
+{
+    LoggerScope scope;
+    for (;;) {
+        {
+            std::unique_lock<std::mutex> lock(rotateMutex);
+            rotateCondition.wait(lock, [this]() { return rotateRequested || rotatorStop; });
+            if (rotatorStop)
+                return;
+            rotateRequested = false;
+        }
+        rotateFiles();
+    }
+}
+
+void cLogger::cLoggerPrivate::updateBinaryLog()
+{
+    const QString path = binaryCategories.isEmpty() || !logFile.isOpen()
+            ? QString() : logFile.fileName() + ".bin";
+    if (path != BinLog::path())
+        BinLog::setPath(path);
+    BinLog::setBinaryCategories(binaryCategories);
+}
+
+void cLogger::cLoggerPrivate::updateFlightRecorder()
+{
+    const QString path = flightRecorderBytes > 0 && logFile.isOpen()
+            ? logFile.fileName() + ".ring" : QString();
+    if (path.isEmpty())
+        flightRecorder.close();
+    else if (path != flightRecorder.path())
+        flightRecorder.open(path, flightRecorderBytes);
+}
+
+void cLogger::cLoggerPrivate::flushLogFile(bool force)
+{
+    if (!logFile.isOpen())
+        return;
+    const qint64 nowMs = QDateTime::currentMSecsSinceEpoch();
+    if (!force && flightRecorder.isOpen() && nowMs - lastFileFlushMs < fileFlushIntervalMs)
+        return;
+    logFile.flush();
+    lastFileFlushMs = nowMs;
+}
+
+void cLogger::cLoggerPrivate::openIndex()
+{
+    indexFile.close();
+    index.clear();
+    linesSinceIndex = 0;
+
+    indexFile.setFileName(logFile.fileName() + ".idx");
+    if (!indexFile.open(QIODevice::ReadWrite)) {
+        std::cerr << "cLogger: Cannot open index " << indexFile.fileName().toLocal8Bit().constData() << std::endl;
+        return;
+    }
+
+    const QByteArray data = indexFile.readAll();
+    const int count = data.size() / int(sizeof(LogIndexEntry));
+    index.resize(count);
+    if (count > 0)
+        memcpy(index.data(), data.constData(), size_t(count) * sizeof(LogIndexEntry));
+
+    // Offsets must increase and lie within the log file, otherwise the
+    // index belongs to another file (e.g. one truncated by hand)
+    bool valid = data.size() % int(sizeof(LogIndexEntry)) == 0;
+    for (int i = 0; valid && i < count; ++i) {
+        valid = index.at(i).offset < bytesWritten
+                && (i == 0 || index.at(i).offset > index.at(i - 1).offset);
+    }
+    if (!valid) {
+        index.clear();
+        indexFile.resize(0);
+    }
+    indexFile.seek(indexFile.size());
+}
+
+QString cLogger::cLoggerPrivate::generationName(const QString &liveName, int generation) const
+{
+    if (generation == 1)
+        return liveName + ".1";
+    return liveName + QString(".%1.z").arg(generation);
+}
+
+/**
+ * @brief Compresses @p source into @p target with qCompress().
+ *
+ * The data is written to a temporary file first so a crash never leaves
+ * a truncated generation behind. Read it back with qUncompress().
+ */
+static bool compressLogFile(const QString &source, const QString &target)
+{
+    QFile in(source);
+    if (!in.open(QIODevice::ReadOnly))
+        return false;
+    const QByteArray compressed = qCompress(in.readAll());
+    in.close();
+
+    const QString temp = target + ".tmp";
+    QFile out(temp);
+    if (!out.open(QIODevice::WriteOnly | QIODevice::Truncate))
+        return false;
+    const bool ok = out.write(compressed) == compressed.size();
+    out.close();
+    QFile::remove(target);
+    if (!ok || !QFile::rename(temp, target)) {
+        QFile::remove(temp);
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Performs one rotation on the rotator thread.
+ *
+ * Older generations are shifted and compressed without holding logMutex.
+ * On POSIX systems the live file is renamed while it stays open, so
+ * logging continues into generation 1 until the handle is swapped; only
+ * the close/reopen of the live file happens under the lock.
+ */
+void cLogger::cLoggerPrivate::rotateFiles()
+{
+    QString liveName;
+    int generations;
+    {
+        QMutexLocker logMutexLocker(&logMutex);
+        liveName = logFile.fileName();
+        generations = qMax(1, logGenerations);
+    }
+
+    // Make room: drop the oldest generation and shift the rest up by one
+    QFile::remove(generationName(liveName, generations));
+    for (int generation = generations - 1; generation >= 2; --generation) {
+        const QString name = generationName(liveName, generation);
+        if (QFile::exists(name))
+            QFile::rename(name, generationName(liveName, generation + 1));
+    }
+    const QString first = generationName(liveName, 1);
+    if (QFile::exists(first)) {
+        if (generations >= 2 && !compressLogFile(first, generationName(liveName, 2)))
+            std::cerr << "cLogger: Cannot compress " << first.toLocal8Bit().constData() << std::endl;
+        QFile::remove(first);
+    }
+
+    bool renamed = false;
+#ifdef Q_OS_UNIX
+    renamed = QFile::rename(liveName, first);
+#endif
+    {
+        QMutexLocker logMutexLocker(&logMutex);
+        rotationPending = false;
+        if (logFile.fileName() != liveName) {
+            // setLogFilePath() switched files meanwhile
+            return;
+        }
+        logFile.close();
+#ifndef Q_OS_UNIX
+        renamed = QFile::rename(liveName, first);
+#endif
+        logFile.setFileName(liveName);
+        if (!logFile.open(QIODevice::WriteOnly | QIODevice::Append)) {
+            std::cerr << "Error: Cannot write file " << logFile.errorString().toLocal8Bit().constData() << std::endl;
+            return;
+        }
+        logFile.setPermissions(QFile::ReadOwner | QFile::WriteOwner | QFile::ReadGroup | QFile::ReadOther);
+        bytesWritten = logFile.size();
+        // The index described the file that is now generation 1
+        indexFile.close();
+        QFile::remove(liveName + ".idx");
+        openIndex();
+    }
+    if (!renamed)
+        std::cerr << "cLogger: Cannot rotate " << liveName.toLocal8Bit().constData() << std::endl;
+
+    enforceDiskBudget(liveName);
+    rotationCount.fetch_add(1);
+}
+
+void cLogger::cLoggerPrivate::enforceDiskBudget(const QString &liveName)
+{
+    qint64 budget;
+    int generations;
+    {
+        QMutexLocker logMutexLocker(&logMutex);
+        budget = diskBudgetBytes;
+        generations = qMax(1, logGenerations);
+    }
+    if (budget <= 0)
+        return;
+
+    qint64 total = QFileInfo(liveName).size();
+    for (int generation = 1; generation <= generations; ++generation)
+        total += QFileInfo(generationName(liveName, generation)).size();
+
+    // Oldest first; the live file and generation 1 are always kept
+    for (int generation = generations; generation >= 2 && total > budget; --generation) {
+        const QString name = generationName(liveName, generation);
+        const qint64 size = QFileInfo(name).size();
+        if (size > 0 && QFile::remove(name))
+            total -= size;
+    }
+}
+
+void cLogger::cLoggerPrivate::stopRotator()
+{
+    {
+        std::lock_guard<std::mutex> lock(rotateMutex);
+        rotatorStop = true;
+    }
+    rotateCondition.notify_one();
+    rotator.wait();
 }
 
 /**
@@ -436,6 +1386,9 @@ void cLogger::messageHandler(QtMsgType type, const QMessageLogContext &context,
  *
  * If module is empty, all existing modules' levels are set to minLevel.
  * The specified level is also appended to the list of explicit log types.
+ * Modules are logging category prefixes; the level is applied through
+ * LogCategoryFilter at once, so disabled qCDebug() calls in the module
+ * stop building their messages.
  *
  * @param minLevel Minimum QtMsgType level to enable
  * @param module Module name (empty for global)
@@ -450,6 +1403,8 @@ void cLogger::setLoggerLevel(QtMsgType minLevel, const QString &module)
     }
     d_ptr->logLevels[module] = minLevel;
     d_ptr->logTypes.append(minLevel);
+    d_ptr->updateTypeMask();
+    LogCategoryFilter::setLevel(module, minLevel);
 }
 
 /**
@@ -473,78 +1428,254 @@ QString cLogger::logFilePath() const
 }
 
 /**
- * @brief Read the entire log file and return its lines.
+ * @brief Return the most recent log lines.
  *
- * This function acquires the log mutex, opens the file for reading,
- * reads all lines into a list, then re-opens the file for append mode.
+ * The lines are read with tail(), so they are complete and exactly as
+ * written to the log file.
  *
- * @return List of log lines (trimmed)
+ * @return List of log lines, oldest first
  */
 QList<QString> cLogger::previousMessages() const
 {
-    QMutexLocker logMutexLocker(&d_ptr->logMutex);
-    static QList<QString> prevMsgs;
-    prevMsgs.clear();
-    d_ptr->logFile.close();
-    d_ptr->logFile.open(QIODevice::ReadOnly);
-    QString line;
-    do {
-        line = d_ptr->logFile.readLine();
-        prevMsgs.append(line.trimmed());
-    } while(!line.isEmpty());
-    d_ptr->logFile.close();
-    d_ptr->logFile.open(QIODevice::Append);
-    return prevMsgs;
+    return tail(d_ptr->maxPreviousMessages);
+}
+
+/**
+ * @brief Return up to @p maxEntries of the most recent messages.
+ *
+ * Takes a snapshot of the in-memory ring without blocking the threads
+ * that log; messages overwritten while the snapshot is taken are left out.
+ *
+ * @param maxEntries Maximum number of entries
+ * @return Entries, oldest first
+ */
+QList<cLogger::LogEntry> cLogger::recentEntries(int maxEntries) const
+{
+    QList<LogEntry> entries;
+    const size_t max = size_t(qBound(0, maxEntries, cLoggerPrivate::recentCapacity));
+    if (max == 0)
+        return entries;
+
+    std::unique_ptr<LogRing::Record[]> records(new LogRing::Record[max]);
+    const size_t count = d_ptr->recent.snapshot(records.get(), max);
+    entries.reserve(int(count));
+    for (size_t i = 0; i < count; ++i) {
+        const LogRing::Record &record = records[i];
+        LogEntry entry;
+        entry.utcMs = record.utcMs;
+        entry.type = static_cast<QtMsgType>(record.type);
+        entry.module = QString::fromUtf8(record.module, record.moduleLength);
+        entry.thread = QString::fromUtf8(record.thread, record.threadLength);
+        entry.message = QString::fromUtf8(record.text, record.textLength);
+        entries.append(entry);
+    }
+    return entries;
+}
+
+/**
+ * @brief Prepend up to @p maxLines lines ending before @p end to @p lines.
+ *
+ * Scans backwards for newlines, so the cost depends on the number of
+ * lines returned, not on the size of the file.
+ *
+ * @param data Mapped file contents
+ * @param end Offset just past the last line to return (a line start or the file size)
+ * @param maxLines Maximum number of non-empty lines to add
+ * @param lines Receives the lines in file order
+ */
+static void prependLinesBefore(const char *data, qint64 end, int maxLines, QList<QString> &lines)
+{
+    int added = 0;
+    while (end > 0 && added < maxLines) {
+        qint64 pos = end - 1;
+        while (pos > 0 && data[pos - 1] != '\n')
+            --pos;
+        const QString line = QString::fromUtf8(data + pos, int(end - pos)).trimmed();
+        if (!line.isEmpty()) {
+            lines.prepend(line);
+            ++added;
+        }
+        end = pos;
+    }
+}
+
+/**
+ * @brief Return the last @p count log lines.
+ *
+ * The live file, and generation 1 if the live file holds fewer lines,
+ * are opened read-only under logMutex and scanned backwards through a
+ * mapping after the lock is released. The writer's file handle is only
+ * flushed, never closed or repositioned.
+ *
+ * @param count Number of lines to return
+ * @return List of log lines (trimmed), oldest first
+ */
+QList<QString> cLogger::tail(int count) const
+{
+    QList<QString> lines;
+    if (count <= 0)
+        return lines;
+
+    QFile live;
+    QFile previous;
+    qint64 liveSize = 0;
+    {
+        QMutexLocker logMutexLocker(&d_ptr->logMutex);
+        if (!d_ptr->logFile.isOpen())
+            return lines;
+        d_ptr->logFile.flush();
+        liveSize = d_ptr->bytesWritten;
+        // Both are opened under the lock so a rotation cannot move them first
+        live.setFileName(d_ptr->logFile.fileName());
+        live.open(QIODevice::ReadOnly);
+        previous.setFileName(d_ptr->generationName(d_ptr->logFile.fileName(), 1));
+        previous.open(QIODevice::ReadOnly);
+    }
+
+    liveSize = qMin(liveSize, live.size());
+    if (live.isOpen() && liveSize > 0) {
+        if (const uchar *data = live.map(0, liveSize)) {
+            prependLinesBefore(reinterpret_cast<const char *>(data), liveSize, count, lines);
+            live.unmap(const_cast<uchar *>(data));
+        }
+    }
+
+    const qint64 previousSize = previous.size();
+    if (lines.size() < count && previous.isOpen() && previousSize > 0) {
+        if (const uchar *data = previous.map(0, previousSize)) {
+            QList<QString> older;
+            prependLinesBefore(reinterpret_cast<const char *>(data), previousSize, count - lines.size(), older);
+            previous.unmap(const_cast<uchar *>(data));
+            lines = older + lines;
+        }
+    }
+    return lines;
+}
+
+/**
+ * @brief Parse the "[yyyy/MM/dd HH:mm:ss.zzz]" time stamp at the start of a line.
+ *
+ * @param line Start of the line
+ * @param length Length of the line in bytes
+ * @return Milliseconds since epoch (UTC), or -1 if the line has no time stamp
+ */
+static qint64 lineTimestampMs(const char *line, qint64 length)
+{
+    // [2026/10/18 12:34:56.789]
+    static const char pattern[] = "[0000/00/00 00:00:00.000]";
+    const int patternLength = int(sizeof(pattern)) - 1;
+    if (length < patternLength)
+        return -1;
+
+    int fields[7] = {};
+    int field = 0;
+    for (int i = 0; i < patternLength; ++i) {
+        const char c = line[i];
+        if (pattern[i] == '0') {
+            if (c < '0' || c > '9')
+                return -1;
+            fields[field] = fields[field] * 10 + (c - '0');
+        } else if (c != pattern[i]) {
+            return -1;
+        } else if (i > 0) {
+            ++field;
+        }
+    }
+
+    const QDate date(fields[0], fields[1], fields[2]);
+    if (!date.isValid())
+        return -1;
+    const qint64 days = date.toJulianDay() - QDate(1970, 1, 1).toJulianDay();
+    return days * 86400000LL
+            + ((fields[3] * 60LL + fields[4]) * 60LL + fields[5]) * 1000LL + fields[6];
 }
 
 /**
  * @brief Read log file entries starting from a given timestamp.
  *
- * This function returns up to maxMessages either in chronological order
- * or reverse (most recent first) depending on the reverse flag. Timestamps
- * are parsed from the file's formatted lines.
+ * The sparse index of the live file narrows the search to the lines
+ * between two index entries; only that range and the returned lines are
+ * read, through a read-only mapping of the file. The live file handle
+ * stays open and logMutex is held only to look up the index.
+ *
+ * Lines without a time stamp (continuations of multi-line messages)
+ * belong to the line before them.
  *
  * @param start Return messages after this QDateTime (UTC)
  * @param maxMessages Maximum messages to return
- * @param reverse If true, return messages in reverse order (most recent first)
- * @return List/queue of message strings matching criteria
+ * @param reverse If true, return the last maxMessages lines at or before
+ *        start instead of the first ones after it (chronological order)
+ * @return List of message strings matching criteria
  */
 QList<QString> cLogger::previousMessages(const QDateTime &start, int maxMessages, bool reverse) const
 {
-    QMutexLocker logMutexLocker(&d_ptr->logMutex);
-    static QQueue<QString> prevMsgs;
-    prevMsgs.clear();
-    d_ptr->logFile.close();
-    d_ptr->logFile.open(QIODevice::ReadOnly);
-    QString line;
-    bool foundStart = false;
-    do {
-        line = d_ptr->logFile.readLine();
-        QStringList token = line.split("]")[0].split("[");
-        QString timestampStr;
-        if(token.size() >= 2)
-            timestampStr = token[1];
-        else
+    QList<QString> prevMsgs;
+    if (maxMessages <= 0)
+        return prevMsgs;
+    const qint64 startMs = start.toMSecsSinceEpoch();
+
+    QFile reader;
+    qint64 size = 0;
+    qint64 from = 0;
+    qint64 to = 0;
+    {
+        QMutexLocker logMutexLocker(&d_ptr->logMutex);
+        if (!d_ptr->logFile.isOpen())
+            return prevMsgs;
+        d_ptr->logFile.flush();
+        size = d_ptr->bytesWritten;
+
+        // The first line after start lies between the last entry at or
+        // before start and the first entry after it
+        const QVector<LogIndexEntry> &index = d_ptr->index;
+        const auto after = std::upper_bound(index.constBegin(), index.constEnd(), startMs,
+                                            [](qint64 t, const LogIndexEntry &entry) { return t < entry.utcMs; });
+        from = after == index.constBegin() ? 0 : (after - 1)->offset;
+        to = after == index.constEnd() ? size : after->offset;
+
+        // Opened under the lock so a rotation cannot rename the file first
+        reader.setFileName(d_ptr->logFile.fileName());
+        if (!reader.open(QIODevice::ReadOnly))
+            return prevMsgs;
+    }
+
+    size = qMin(size, reader.size());
+    if (size <= 0)
+        return prevMsgs;
+    const char *data = reinterpret_cast<const char *>(reader.map(0, size));
+    if (!data)
+        return prevMsgs;
+    to = qMin(to, size);
+
+    const auto lineEnd = [data, size](qint64 pos) {
+        const void *newline = memchr(data + pos, '\n', size_t(size - pos));
+        return newline ? qint64(static_cast<const char *>(newline) - data) : size;
+    };
+
+    // Offset of the first line with a time stamp after start
+    qint64 boundary = to;
+    for (qint64 pos = from; pos < to; ) {
+        const qint64 end = lineEnd(pos);
+        if (lineTimestampMs(data + pos, end - pos) > startMs) {
+            boundary = pos;
             break;
-        QDateTime timestamp = QDateTime::fromString(timestampStr, "yyyy/MM/dd HH:mm:ss.zzz");
-        timestamp.setTimeZone(QTimeZone::UTC);
-        foundStart = timestamp > start;
-        if(reverse && !foundStart) {
-            prevMsgs.append(line.trimmed());
-            if(prevMsgs.size() > maxMessages)
-                prevMsgs.dequeue();
         }
-    } while(!foundStart && !d_ptr->logFile.atEnd());
-    if(!reverse) {
-        prevMsgs.append(line.trimmed());
-        while(!d_ptr->logFile.atEnd() && prevMsgs.size() < maxMessages) {
-            // append the previous line first before we overwrite it
-            line = d_ptr->logFile.readLine();
-            prevMsgs.append(line.trimmed());
+        pos = end + 1;
+    }
+
+    if (!reverse) {
+        for (qint64 pos = boundary; pos < size && prevMsgs.size() < maxMessages; ) {
+            const qint64 end = lineEnd(pos);
+            const QString line = QString::fromUtf8(data + pos, int(end - pos)).trimmed();
+            if (!line.isEmpty())
+                prevMsgs.append(line);
+            pos = end + 1;
         }
+    } else {
+        prependLinesBefore(data, boundary, maxMessages, prevMsgs);
     }
-    d_ptr->logFile.close();
-    d_ptr->logFile.open(QIODevice::Append);
+
+    reader.unmap(reinterpret_cast<uchar *>(const_cast<char *>(data)));
     return prevMsgs;
 }
 
@@ -620,6 +1751,7 @@ void cLogger::checkForLogFile()
 void cLogger::clearLogTypes()
 {
     d_ptr->logTypes.clear();
+    d_ptr->updateTypeMask();
 }
 
 /**
@@ -659,6 +1791,283 @@ void cLogger::setLogFilePath(QString arg)
     }
     // Set file permissions: owner read/write, group read, others read
     d_ptr->logFile.setPermissions(QFile::ReadOwner | QFile::WriteOwner | QFile::ReadGroup | QFile::ReadOther);
+    d_ptr->bytesWritten = d_ptr->logFile.size();
+    d_ptr->openIndex();
+    d_ptr->updateBinaryLog();
+    d_ptr->updateFlightRecorder();
+}
+
+/**
+ * @brief Configure log file rotation.
+ *
+ * @param rolloverBytes Size at which the live file is rotated
+ * @param generations Number of rotated files to keep (at least 1)
+ * @param diskBudgetBytes Total size limit for all log files, 0 for none
+ */
+void cLogger::setLogRotation(qint64 rolloverBytes, int generations, qint64 diskBudgetBytes)
+{
+    QMutexLocker locker(&d_ptr->logMutex);
+    d_ptr->rolloverBytes = rolloverBytes > 0 ? rolloverBytes : cLoggerPrivate::logFileRolloverSize;
+    d_ptr->logGenerations = qMax(1, generations);
+    d_ptr->diskBudgetBytes = qMax<qint64>(0, diskBudgetBytes);
+}
+
+/**
+ * @brief Return the number of rotations completed since start-up.
+ */
+int cLogger::rotationCount() const
+{
+    return d_ptr->rotationCount.load();
+}
+
+/**
+ * @brief Enable or disable the asynchronous backend.
+ *
+ * @param enabled true to queue messages for the writer thread
+ */
+void cLogger::setAsync(bool enabled)
+{
+    if (enabled) {
+        if (d_ptr->async.load())
+            return;
+        d_ptr->startWriter();
+        d_ptr->async.store(true, std::memory_order_release);
+    } else {
+        if (!d_ptr->async.load())
+            return;
+        d_ptr->async.store(false, std::memory_order_release);
+        // Records pushed just before the switch are still written by the
+        // writer, which drains the queue before it exits.
+        d_ptr->stopWriter();
+    }
+}
+
+/**
+ * @brief Return whether the asynchronous backend is active.
+ */
+bool cLogger::isAsync() const
+{
+    return d_ptr->async.load();
+}
+
+/**
+ * @brief Set what happens when the queue is full.
+ *
+ * @param policy OverflowDrop or OverflowBlock
+ */
+void cLogger::setOverflowPolicy(OverflowPolicy policy)
+{
+    d_ptr->overflowPolicy.store(policy);
+}
+
+/**
+ * @brief Return the queue overflow policy.
+ */
+cLogger::OverflowPolicy cLogger::overflowPolicy() const
+{
+    return static_cast<OverflowPolicy>(d_ptr->overflowPolicy.load());
+}
+
+/**
+ * @brief Set the queue capacity used when the queue is first created.
+ *
+ * @param capacity Number of messages (rounded up to a power of two)
+ */
+void cLogger::setQueueCapacity(int capacity)
+{
+    if (d_ptr->queue) {
+        qWarning() << "cLogger::setQueueCapacity: queue already created, capacity unchanged";
+        return;
+    }
+    d_ptr->queueCapacity = qMax(2, capacity);
+}
+
+/**
+ * @brief Return the number of messages dropped under OverflowDrop.
+ */
+quint64 cLogger::droppedMessageCount() const
+{
+    return d_ptr->dropped.load();
+}
+
+/**
+ * @brief Limit the messages logged per call site.
+ *
+ * @param messagesPerSecond Sustained rate per call site, 0 to disable
+ * @param burst Messages a quiet call site may log at once
+ */
+void cLogger::setRateLimit(int messagesPerSecond, int burst)
+{
+    d_ptr->rateLimiter.configure(messagesPerSecond, burst, cLoggerPrivate::suppressionWindowMs);
+}
+
+/**
+ * @brief Return the number of messages suppressed by the rate limiter.
+ */
+quint64 cLogger::suppressedMessageCount() const
+{
+    return d_ptr->rateLimiter.suppressedCount();
+}
+
+/**
+ * @brief Set the alarm delivery time counted as a deadline miss.
+ *
+ * @param microseconds Deadline from posting to delivery
+ */
+void cLogger::setAlarmDeadline(qint64 microseconds)
+{
+    d_ptr->alarms.setDeadlineUs(microseconds);
+}
+
+/**
+ * @brief Return the counters and delivery latency of the alarm channel.
+ */
+AlarmChannel::Stats cLogger::alarmStats() const
+{
+    return d_ptr->alarms.stats();
+}
+
+/**
+ * @brief Select the categories whose NG_BINLOG() messages are logged in binary form.
+ *
+ * @param categoryPrefixes Category names or prefixes; empty for none
+ */
+void cLogger::setBinaryCategories(const QStringList &categoryPrefixes)
+{
+    QMutexLocker locker(&d_ptr->logMutex);
+    d_ptr->binaryCategories = categoryPrefixes;
+    d_ptr->updateBinaryLog();
+}
+
+/**
+ * @brief Deliver batches of the lines written from now on to @p handler.
+ *
+ * @param context Object whose thread's event loop calls @p handler
+ * @param handler Called with each completed batch
+ * @return Subscription id, 0 if @p context or @p handler is missing
+ */
+int cLogger::subscribe(QObject *context, LogBatchHandler handler)
+{
+    if (!context || !handler)
+        return 0;
+    cLoggerPrivate *d = d_ptr;
+    int id = 0;
+    {
+        std::lock_guard<std::mutex> lock(d->subscriberMutex);
+        auto next = d->subscribers ? std::make_shared<std::vector<cLoggerPrivate::Subscriber>>(*d->subscribers)
+                                   : std::make_shared<std::vector<cLoggerPrivate::Subscriber>>();
+        id = d->nextSubscriberId++;
+        next->push_back({ id, context, std::move(handler) });
+        d->subscriberCount.store(int(next->size()), std::memory_order_relaxed);
+        d->subscribers = std::move(next);
+    }
+    // The subscription ends with its context
+    connect(context, &QObject::destroyed, this, [this, id]() { unsubscribe(id); }, Qt::DirectConnection);
+    return id;
+}
+
+/**
+ * @brief End a subscription made with subscribe().
+ *
+ * @param id Subscription id
+ */
+void cLogger::unsubscribe(int id)
+{
+    cLoggerPrivate *d = d_ptr;
+    std::lock_guard<std::mutex> lock(d->subscriberMutex);
+    if (!d->subscribers)
+        return;
+    auto next = std::make_shared<std::vector<cLoggerPrivate::Subscriber>>();
+    for (const cLoggerPrivate::Subscriber &subscriber : *d->subscribers) {
+        if (subscriber.id != id)
+            next->push_back(subscriber);
+    }
+    d->subscriberCount.store(int(next->size()), std::memory_order_relaxed);
+    d->subscribers = std::move(next);
+}
+
+/**
+ * @brief Copy every line into a memory-mapped ring file next to the log.
+ *
+ * @param capacityBytes Size of the ring; 0 closes it and restores the
+ *        flush after every line
+ */
+void cLogger::setFlightRecorder(qint64 capacityBytes)
+{
+    QMutexLocker locker(&d_ptr->logMutex);
+    if (capacityBytes != d_ptr->flightRecorderBytes)
+        d_ptr->flightRecorder.close();
+    d_ptr->flightRecorderBytes = qMax<qint64>(0, capacityBytes);
+    d_ptr->updateFlightRecorder();
+    d_ptr->flushLogFile(true);
+}
+
+/**
+ * @brief Serve the live log lines on a local Unix-domain socket.
+ *
+ * @param path Socket path; empty stops the server
+ * @return false if the socket cannot be created
+ */
+bool cLogger::setLogStreamSocket(const QString &path)
+{
+    cLoggerPrivate *d = d_ptr;
+    std::lock_guard<std::mutex> lock(d->streamMutex);
+    if (path.isEmpty()) {
+        d->streamServer.reset();
+        return true;
+    }
+    if (d->streamServer && d->streamServer->path() == path)
+        return true;
+    if (!d->streamServer)
+        d->streamServer.reset(new LogStreamServer);
+    if (!d->streamServer->start(path)) {
+        d->streamServer.reset();
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Returns the path of the live log socket, empty if not serving.
+ */
+QString cLogger::logStreamSocket() const
+{
+    cLoggerPrivate *d = d_ptr;
+    std::lock_guard<std::mutex> lock(d->streamMutex);
+    return d->streamServer ? d->streamServer->path() : QString();
+}
+
+/**
+ * @brief Write all queued messages and flush the log file.
+ *
+ * Waits for the records queued before the call; messages logged by other
+ * threads while waiting are not waited for.
+ */
+void cLogger::flush()
+{
+    cLoggerPrivate *d = d_ptr;
+    if (d->rateLimiter.isEnabled())
+        d->writeSuppressionSummaries();
+    if (d->writer.isRunning() && QThread::currentThread() != &d->writer) {
+        const quint64 target = d->enqueued.load();
+        d->flushWaiters.fetch_add(1);
+        {
+            std::unique_lock<std::mutex> lock(d->flushMutex);
+            while (d->written.load() < target && d->writer.isRunning()) {
+                d->wakeWriter();
+                d->flushCondition.wait_for(lock, std::chrono::milliseconds(10));
+            }
+        }
+        d->flushWaiters.fetch_sub(1);
+    }
+
+    QMutexLocker logMutexLocker(&d->logMutex);
+    if (d->logFile.isOpen())
+        d->logFile.flush();
+    const LogBatchPtr batch = d->takeBatch(true);
+    logMutexLocker.unlock();
+    d->deliver(batch);
+    BinLog::flush();
 }
 
 /**
@@ -683,16 +2092,33 @@ cLogger::cLogger(QObject *parent) : QObject(parent)
 /**
  * @brief cLogger destructor.
  *
- * Closes the log file and releases private data.
+ * Uninstalls the message handler, stops the writer thread after it has
+ * written the queued messages, stops the rotator thread, closes the log
+ * file and releases private data.
  */
 cLogger::~cLogger()
 {
     if (d_ptr) {
+        // The destructor runs during static destruction; messages logged
+        // from then on go to Qt's default handler instead of reaching
+        // messageHandler() while d_ptr is torn down. A handler installed
+        // on top of this one stays in place.
+        const QtMessageHandler installed = qInstallMessageHandler(nullptr);
+        if (installed != &cLogger::messageHandler)
+            qInstallMessageHandler(installed);
+
+        // The server unsubscribes, which needs d_ptr
+        d_ptr->streamServer.reset();
+        d_ptr->alarms.stop();
+        d_ptr->async.store(false);
+        d_ptr->stopWriter();
+        d_ptr->stopRotator();
         if (d_ptr->logFile.isOpen()) {
             d_ptr->logFile.close();
         }
-        delete d_ptr;
+        cLoggerPrivate *d = d_ptr;
         d_ptr = nullptr;
+        delete d;
     }
 }
 
@@ -732,6 +2158,22 @@ LogMessageContext::LogMessageContext(QString thread, QString module, QString fil
     _lineNumber = line;
 }
 
+/**
+ * @brief Constructs a LogMessageContext from a LogContext.
+ *
+ * @param context Source context
+ * @param parent QObject parent (unused)
+ */
+LogMessageContext::LogMessageContext(const LogContext &context, QObject *parent)
+{
+    Q_UNUSED(parent)
+    _threadName = context.threadName();
+    _moduleName = context.moduleName();
+    _fileName = context.fileName();
+    _functionName = context.functionName();
+    _lineNumber = context.line;
+}
+
 /**
  * @brief Copy constructor for LogMessageContext.
  *
@@ -0,0 +1,197 @@
+/**
+ * @file src/flightrecorder.cpp
+ * @brief Implementation of the FlightRecorder class.
+ *
+ * The ring file is reserved on disk when it is created (posix_fallocate on
+ * Linux, so a full disk is detected by open() and not as SIGBUS on a later
+ * store) and then mapped once; append() is a memcpy and a few stores.
+ *
+ * @date 18-Oct-2026
+ * @author Gangadhar Thalange
+ */
+
+#include "../include/flightrecorder.h"
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <iostream>
+#include <vector>
+
+#ifdef Q_OS_LINUX
+#include <fcntl.h>
+#endif
+
+static_assert(sizeof(FlightRecorder::Header) <= size_t(FlightRecorder::HEADER_SIZE),
+              "Header must fit into its page");
+static_assert(sizeof(FlightRecorder::RecordHeader) == 24 && sizeof(FlightRecorder::RecordHeader) % 8 == 0,
+              "RecordHeader layout is part of the file format");
+
+static uint64_t recordBytes(size_t length)
+{
+    return (sizeof(FlightRecorder::RecordHeader) + length + 7) & ~uint64_t(7);
+}
+
+FlightRecorder::~FlightRecorder()
+{
+    close();
+}
+
+bool FlightRecorder::open(const QString &path, qint64 capacityBytes)
+{
+    close();
+
+    const uint64_t capacity = uint64_t(qMax(MIN_CAPACITY, capacityBytes) + 7) & ~uint64_t(7);
+    const qint64 total = HEADER_SIZE + qint64(capacity);
+
+    m_file.setFileName(path);
+    if (!m_file.open(QIODevice::ReadWrite)) {
+        std::cerr << "FlightRecorder: Cannot open " << qPrintable(path) << ": "
+                  << qPrintable(m_file.errorString()) << std::endl;
+        return false;
+    }
+    m_file.setPermissions(QFile::ReadOwner | QFile::WriteOwner | QFile::ReadGroup | QFile::ReadOther);
+
+    const bool sameSize = m_file.size() == total;
+    if (!sameSize) {
+        bool reserved = m_file.resize(total);
+#ifdef Q_OS_LINUX
+        reserved = reserved && posix_fallocate(m_file.handle(), 0, total) == 0;
+#endif
+        if (!reserved) {
+            std::cerr << "FlightRecorder: Cannot reserve " << total << " bytes for "
+                      << qPrintable(path) << std::endl;
+            m_file.close();
+            return false;
+        }
+    }
+
+    uchar *map = m_file.map(0, total);
+    if (!map) {
+        std::cerr << "FlightRecorder: Cannot map " << qPrintable(path) << std::endl;
+        m_file.close();
+        return false;
+    }
+    m_header = reinterpret_cast<Header *>(map);
+    m_data = map + HEADER_SIZE;
+    m_capacity = capacity;
+
+    // Continue a ring written before (e.g. by the process that crashed)
+    const bool valid = sameSize
+            && memcmp(m_header->magic, MAGIC, sizeof(MAGIC)) == 0
+            && m_header->version == VERSION
+            && m_header->headerSize == uint32_t(HEADER_SIZE)
+            && m_header->capacity == capacity
+            && m_header->head < capacity && m_header->head % 8 == 0;
+    if (!valid) {
+        // Old records must not outlive the reset: their sequence numbers
+        // would sort them after the new ones
+        memset(map, 0, size_t(total));
+        memcpy(m_header->magic, MAGIC, sizeof(MAGIC));
+        m_header->version = VERSION;
+        m_header->headerSize = uint32_t(HEADER_SIZE);
+        m_header->capacity = capacity;
+        m_header->head = 0;
+        m_header->nextSequence = 1;
+    }
+    return true;
+}
+
+void FlightRecorder::close()
+{
+    if (m_header) {
+        m_file.unmap(reinterpret_cast<uchar *>(m_header));
+        m_header = nullptr;
+        m_data = nullptr;
+    }
+    if (m_file.isOpen())
+        m_file.close();
+}
+
+uint32_t FlightRecorder::checksum(const char *data, size_t length)
+{
+    uint32_t hash = 2166136261u;    // FNV-1a
+    for (size_t i = 0; i < length; ++i)
+        hash = (hash ^ uint8_t(data[i])) * 16777619u;
+    return hash;
+}
+
+void FlightRecorder::append(const char *data, size_t length)
+{
+    if (!m_header)
+        return;
+    length = std::min<size_t>(length, size_t(m_capacity / 4));
+    const uint64_t bytes = recordBytes(length);
+
+    uint64_t position = m_header->head;
+    if (position + bytes > m_capacity) {
+        // Records of older laps may still sit in the unused end; they
+        // would be read back between the current lines
+        memset(m_data + position, 0, size_t(m_capacity - position));
+        position = 0;
+    }
+    RecordHeader *record = reinterpret_cast<RecordHeader *>(m_data + position);
+
+    // The stores must reach memory in this order if the process dies in
+    // between; the kernel keeps whatever was stored
+    record->magic = 0;
+    std::atomic_signal_fence(std::memory_order_seq_cst);
+    memcpy(record + 1, data, length);
+    record->length = uint32_t(length);
+    record->sequence = m_header->nextSequence;
+    record->checksum = checksum(data, length);
+    record->reserved = 0;
+    std::atomic_signal_fence(std::memory_order_seq_cst);
+    record->magic = RECORD_MAGIC;
+
+    m_header->nextSequence = record->sequence + 1;
+    m_header->head = (position + bytes) % m_capacity;
+}
+
+QByteArrayList FlightRecorder::read(const QString &path, QString *errorString)
+{
+    QByteArrayList lines;
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly)) {
+        if (errorString)
+            *errorString = file.errorString();
+        return lines;
+    }
+    const qint64 size = file.size();
+    const uchar *map = size >= HEADER_SIZE ? file.map(0, size) : nullptr;
+    Header header;
+    if (map)
+        memcpy(&header, map, sizeof(header));
+    if (!map || memcmp(header.magic, MAGIC, sizeof(MAGIC)) != 0 || header.version != VERSION
+            || header.headerSize < sizeof(Header) || header.headerSize > uint64_t(size)) {
+        if (errorString)
+            *errorString = QStringLiteral("Not a flight recorder file");
+        return lines;
+    }
+    const uchar *data = map + header.headerSize;
+    const uint64_t capacity = std::min<uint64_t>(header.capacity, uint64_t(size) - header.headerSize);
+
+    struct Found { uint64_t sequence; uint64_t offset; uint32_t length; };
+    std::vector<Found> found;
+    uint64_t offset = 0;
+    while (offset + sizeof(RecordHeader) <= capacity) {
+        RecordHeader record;
+        memcpy(&record, data + offset, sizeof(record));
+        const bool valid = record.magic == RECORD_MAGIC
+                && record.length <= capacity - offset - sizeof(RecordHeader)
+                && record.checksum == checksum(reinterpret_cast<const char *>(data + offset + sizeof(RecordHeader)),
+                                               record.length);
+        if (!valid) {
+            offset += 8;
+            continue;
+        }
+        found.push_back({ record.sequence, offset + sizeof(RecordHeader), record.length });
+        offset += recordBytes(record.length);
+    }
+
+    std::sort(found.begin(), found.end(),
+              [](const Found &a, const Found &b) { return a.sequence < b.sequence; });
+    lines.reserve(int(found.size()));
+    for (const Found &record : found)
+        lines.append(QByteArray(reinterpret_cast<const char *>(data + record.offset), int(record.length)));
+    return lines;
+}
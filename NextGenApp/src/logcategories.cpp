@@ -0,0 +1,147 @@
+/**
+ * @file src/logcategories.cpp
+ * @brief Implementation of the LogCategoryFilter class.
+ *
+ * The level table is immutable once published: setLevel() builds a new
+ * table under a mutex and publishes it with an atomic shared_ptr store,
+ * so the filter, which Qt calls with its registry lock held, only does an
+ * atomic load and never waits for a writer.
+ *
+ * @date 18-Oct-2026
+ * @author Gangadhar Thalange
+ */
+
+#include "../include/logcategories.h"
+#include <QByteArray>
+#include <QLoggingCategory>
+#include <QMutex>
+#include <QVector>
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <memory>
+
+namespace {
+
+/**
+ * @brief Flat lookup table of minimum severities by category prefix.
+ */
+struct LevelTable
+{
+    struct Entry {
+        QByteArray prefix;
+        int rank;
+    };
+
+    int globalRank = 0;
+    QVector<Entry> entries;     ///< Longest prefix first
+
+    int rankFor(const char *category) const
+    {
+        const int length = category ? int(strlen(category)) : 0;
+        for (const Entry &entry : entries) {
+            const int prefixLength = entry.prefix.size();
+            if (length >= prefixLength
+                    && memcmp(category, entry.prefix.constData(), size_t(prefixLength)) == 0
+                    && (length == prefixLength || category[prefixLength] == '.'))
+                return entry.rank;
+        }
+        return globalRank;
+    }
+};
+
+QMutex s_writeMutex;
+std::shared_ptr<const LevelTable> s_table = std::make_shared<LevelTable>();
+std::atomic<QLoggingCategory::CategoryFilter> s_previousFilter{nullptr};
+
+const QtMsgType s_filteredTypes[] = { QtDebugMsg, QtInfoMsg, QtWarningMsg, QtCriticalMsg };
+
+/**
+ * @brief Category filter installed with QLoggingCategory::installFilter().
+ *
+ * Runs the previous filter (Qt's logging rules) and then disables the
+ * types below the level of the category. Fatal messages are never
+ * disabled.
+ */
+void categoryFilter(QLoggingCategory *category)
+{
+    const QLoggingCategory::CategoryFilter previous = s_previousFilter.load();
+    if (previous)
+        previous(category);
+
+    const std::shared_ptr<const LevelTable> table = std::atomic_load(&s_table);
+    const int rank = table->rankFor(category->categoryName());
+    for (QtMsgType type : s_filteredTypes) {
+        // The previous filter has reset the flags from Qt's rules; without
+        // it (first pass of install()) nothing is enabled that was not before
+        const bool allowed = LogCategoryFilter::severity(type) >= rank;
+        category->setEnabled(type, category->isEnabled(type) && allowed);
+    }
+}
+
+} // namespace
+
+void LogCategoryFilter::install()
+{
+    const QLoggingCategory::CategoryFilter old = QLoggingCategory::installFilter(categoryFilter);
+    if (old != categoryFilter) {
+        // The first pass above ran without Qt's rules; run again with them
+        s_previousFilter.store(old);
+        QLoggingCategory::installFilter(categoryFilter);
+    }
+}
+
+void LogCategoryFilter::setLevel(const QString &module, QtMsgType minLevel)
+{
+    {
+        QMutexLocker locker(&s_writeMutex);
+        std::shared_ptr<LevelTable> table = std::make_shared<LevelTable>(*std::atomic_load(&s_table));
+        const int rank = severity(minLevel);
+        if (module.isEmpty()) {
+            table->globalRank = rank;
+            for (LevelTable::Entry &entry : table->entries)
+                entry.rank = rank;
+        } else {
+            const QByteArray prefix = module.toUtf8();
+            auto it = std::find_if(table->entries.begin(), table->entries.end(),
+                                   [&prefix](const LevelTable::Entry &entry) { return entry.prefix == prefix; });
+            if (it != table->entries.end()) {
+                it->rank = rank;
+            } else {
+                table->entries.append({ prefix, rank });
+                std::stable_sort(table->entries.begin(), table->entries.end(),
+                                 [](const LevelTable::Entry &a, const LevelTable::Entry &b) {
+                                     return a.prefix.size() > b.prefix.size();
+                                 });
+            }
+        }
+        std::atomic_store(&s_table, std::shared_ptr<const LevelTable>(std::move(table)));
+    }
+
+    // Re-applies the filter to every registered category
+    install();
+}
+
+QtMsgType LogCategoryFilter::level(const char *category)
+{
+    static const QtMsgType byRank[] = { QtDebugMsg, QtInfoMsg, QtWarningMsg, QtCriticalMsg, QtFatalMsg };
+    const int rank = std::atomic_load(&s_table)->rankFor(category);
+    return byRank[qBound(0, rank, 4)];
+}
+
+bool LogCategoryFilter::isEnabled(const char *category, QtMsgType type)
+{
+    return type == QtFatalMsg || severity(type) >= std::atomic_load(&s_table)->rankFor(category);
+}
+
+int LogCategoryFilter::severity(QtMsgType type)
+{
+    switch (type) {
+    case QtDebugMsg:    return 0;
+    case QtInfoMsg:     return 1;
+    case QtWarningMsg:  return 2;
+    case QtCriticalMsg: return 3;
+    case QtFatalMsg:    return 4;
+    }
+    return 0;
+}
@@ -0,0 +1,148 @@
+/**
+ * @file src/logcontext.cpp
+ * @brief Implementation of the LogContext interning.
+ *
+ * The intern tables are shared and locked; per-thread caches answer the
+ * common case (the same call site, thread or module again) with a
+ * pointer compare and a strcmp, without the lock.
+ *
+ * @date 18-Oct-2026
+ * @author Gangadhar Thalange
+ */
+
+#include "../include/logcontext.h"
+#include <QHash>
+#include <QThread>
+#include <cstring>
+#include <mutex>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+namespace {
+
+struct InternTable
+{
+    std::mutex mutex;
+    // Node-based: pointers to the strings stay valid as the set grows
+    std::unordered_set<std::string> strings;
+    std::vector<QString> names{ QString() };
+    QHash<QString, quint16> ids;
+};
+
+InternTable &internTable()
+{
+    static InternTable table;
+    return table;
+}
+
+/**
+ * @brief Per-thread map from caller pointers to interned strings.
+ *
+ * Keyed by the caller's pointer, checked by content, so a temporary
+ * buffer reused for another string is looked up again.
+ */
+struct InternCache
+{
+    struct Entry {
+        const char *key = nullptr;
+        const char *interned = nullptr;
+    };
+    Entry entries[64];
+
+    Entry &slot(const char *text) { return entries[(quintptr(text) >> 3) & 63]; }
+};
+
+struct ModuleCacheEntry
+{
+    const char *name = nullptr;
+    quint16 id = 0;
+};
+
+} // namespace
+
+const char *LogContext::intern(const char *text)
+{
+    if (!text || !*text)
+        return "";
+    static thread_local InternCache cache;
+    InternCache::Entry &entry = cache.slot(text);
+    if (entry.key == text && strcmp(entry.interned, text) == 0)
+        return entry.interned;
+
+    InternTable &table = internTable();
+    const char *interned;
+    {
+        std::lock_guard<std::mutex> lock(table.mutex);
+        interned = table.strings.insert(std::string(text)).first->c_str();
+    }
+    entry.key = text;
+    entry.interned = interned;
+    return interned;
+}
+
+quint16 LogContext::internName(const QString &name)
+{
+    if (name.isEmpty())
+        return 0;
+    InternTable &table = internTable();
+    std::lock_guard<std::mutex> lock(table.mutex);
+    const auto it = table.ids.constFind(name);
+    if (it != table.ids.constEnd())
+        return it.value();
+    // IDs are 16 bits; names beyond that are reported as empty
+    if (table.names.size() > 0xFFFF)
+        return 0;
+    const quint16 id = quint16(table.names.size());
+    table.names.push_back(name);
+    table.ids.insert(name, id);
+    return id;
+}
+
+QString LogContext::name(quint16 id)
+{
+    InternTable &table = internTable();
+    std::lock_guard<std::mutex> lock(table.mutex);
+    return id < table.names.size() ? table.names[id] : QString();
+}
+
+LogContext LogContext::capture(const char *file, const char *function, int line, const char *module)
+{
+    // Thread names rarely change; compare instead of looking them up
+    static thread_local QString cachedThreadName;
+    static thread_local quint16 cachedThreadId = 0;
+    const QString threadName = QThread::currentThread()->objectName();
+    if (threadName != cachedThreadName) {
+        cachedThreadId = internName(threadName);
+        cachedThreadName = threadName;
+    }
+
+    // Modules are a handful of literals
+    static thread_local ModuleCacheEntry moduleCache[4];
+    static thread_local int moduleCacheNext = 0;
+    const char *moduleName = intern(module);
+    quint16 moduleId = 0;
+    bool found = false;
+    for (const ModuleCacheEntry &entry : moduleCache) {
+        if (entry.name == moduleName) {
+            moduleId = entry.id;
+            found = true;
+            break;
+        }
+    }
+    if (!found) {
+        moduleId = internName(QString::fromUtf8(moduleName));
+        ModuleCacheEntry &entry = moduleCache[moduleCacheNext];
+        moduleCacheNext = (moduleCacheNext + 1) % 4;
+        entry.name = moduleName;
+        entry.id = moduleId;
+    }
+
+    LogContext context;
+    context.file = intern(file);
+    context.function = intern(function);
+    context.line = line;
+    context.threadId = cachedThreadId;
+    context.moduleId = moduleId;
+    return context;
+}
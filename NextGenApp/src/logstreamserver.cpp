@@ -0,0 +1,356 @@
+/**
+ * @file src/logstreamserver.cpp
+ * @brief Implementation of the LogStreamServer class.
+ *
+ * The server thread runs a Qt event loop. QSocketNotifiers watch the
+ * listening socket and the clients, and the cLogger subscription delivers
+ * batches to the same thread, so no client state is shared between
+ * threads. Sockets are non-blocking; a batch is copied into the output
+ * buffer of each client it passes the filter of and sent as far as the
+ * socket accepts, the rest goes out when the socket becomes writable.
+ *
+ * @date 18-Oct-2026
+ * @author Gangadhar Thalange
+ */
+
+#include "../include/logstreamserver.h"
+#include "../include/clogger.h"
+#include "../include/logcategories.h"
+#include <QFile>
+#include <QList>
+#include <QSocketNotifier>
+#include <cstring>
+#include <iostream>
+#include <memory>
+#include <vector>
+
+#ifdef Q_OS_UNIX
+#include <cerrno>
+#include <fcntl.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+#endif
+
+#ifdef Q_OS_UNIX
+
+#ifndef MSG_NOSIGNAL
+#define MSG_NOSIGNAL 0
+#endif
+
+static bool setNonBlocking(int fd)
+{
+    const int flags = fcntl(fd, F_GETFL, 0);
+    return flags >= 0 && fcntl(fd, F_SETFL, flags | O_NONBLOCK) == 0
+            && fcntl(fd, F_SETFD, FD_CLOEXEC) == 0;
+}
+
+/**
+ * @brief Returns whether @p category is @p module or below it.
+ */
+static bool inModule(const QByteArray &category, const QByteArray &module)
+{
+    return category.startsWith(module)
+            && (category.size() == module.size() || category.at(module.size()) == '.');
+}
+
+/**
+ * @brief Owns the sockets; lives on the server thread.
+ *
+ * Not a Q_OBJECT: it only serves as context for the subscription and
+ * the notifier connections.
+ */
+class LogStreamServer::Worker : public QObject
+{
+public:
+    Worker(int listenFd, int bufferBytes, std::atomic<int> *clientCount, std::atomic<quint64> *droppedLines)
+        : m_listenFd(listenFd)
+        , m_bufferBytes(bufferBytes)
+        , m_clientCount(clientCount)
+        , m_droppedLines(droppedLines)
+    {
+    }
+
+    ~Worker() override
+    {
+        while (!m_clients.empty())
+            closeClient(m_clients.back().get());
+        ::close(m_listenFd);
+    }
+
+    /**
+     * @brief Creates the notifiers; runs on the server thread.
+     */
+    void setup()
+    {
+        QSocketNotifier *notifier = new QSocketNotifier(m_listenFd, QSocketNotifier::Read, this);
+        QObject::connect(notifier, &QSocketNotifier::activated, this, [this]() { acceptClients(); });
+    }
+
+    /**
+     * @brief Queues the lines of @p batch for every client that wants them.
+     */
+    void onBatch(const LogBatchPtr &batch)
+    {
+        for (const std::unique_ptr<Client> &client : m_clients) {
+            for (int i = 0; i < batch->size(); ++i) {
+                if (!client->wants(batch->at(i).type, batch->category(i)))
+                    continue;
+                const QByteArray line = batch->line(i);
+                enqueue(client.get(), line.constData(), line.size());
+            }
+        }
+        // Sent after queueing, closing a client changes m_clients
+        for (size_t i = m_clients.size(); i-- > 0;)
+            writeClient(m_clients[i].get());
+    }
+
+private:
+    struct Client {
+        int fd = -1;
+        QSocketNotifier *readNotifier = nullptr;
+        QSocketNotifier *writeNotifier = nullptr;
+        QByteArray out;             ///< Output buffer
+        int sent = 0;               ///< Bytes of out already sent
+        QByteArray in;              ///< Incomplete command line
+        int minSeverity = 0;        ///< LogCategoryFilter::severity() of the filter level
+        QList<QByteArray> modules;  ///< Empty for all
+        quint64 dropped = 0;        ///< Dropped lines not yet reported
+
+        bool wants(QtMsgType type, const QByteArray &category) const
+        {
+            if (type != QtFatalMsg && LogCategoryFilter::severity(type) < minSeverity)
+                return false;
+            if (modules.isEmpty())
+                return true;
+            for (const QByteArray &module : modules) {
+                if (inModule(category, module))
+                    return true;
+            }
+            return false;
+        }
+    };
+
+    void acceptClients()
+    {
+        for (;;) {
+            const int fd = ::accept(m_listenFd, nullptr, nullptr);
+            if (fd < 0)
+                return;
+            if (!setNonBlocking(fd) || int(m_clients.size()) >= MAX_CLIENTS) {
+                static const char busy[] = "-- too many clients --\n";
+                ::send(fd, busy, sizeof(busy) - 1, MSG_NOSIGNAL);
+                ::close(fd);
+                continue;
+            }
+            std::unique_ptr<Client> client(new Client);
+            Client *c = client.get();
+            c->fd = fd;
+            c->minSeverity = LogCategoryFilter::severity(QtDebugMsg);
+            c->readNotifier = new QSocketNotifier(fd, QSocketNotifier::Read, this);
+            QObject::connect(c->readNotifier, &QSocketNotifier::activated, this, [this, c]() { readClient(c); });
+            c->writeNotifier = new QSocketNotifier(fd, QSocketNotifier::Write, this);
+            c->writeNotifier->setEnabled(false);
+            QObject::connect(c->writeNotifier, &QSocketNotifier::activated, this, [this, c]() { writeClient(c); });
+            m_clients.push_back(std::move(client));
+            m_clientCount->store(int(m_clients.size()));
+        }
+    }
+
+    void readClient(Client *c)
+    {
+        char buffer[512];
+        const ssize_t count = ::recv(c->fd, buffer, sizeof(buffer), 0);
+        if (count == 0 || (count < 0 && errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR)) {
+            closeClient(c);
+            return;
+        }
+        if (count < 0)
+            return;
+        c->in.append(buffer, int(count));
+        int end;
+        while ((end = c->in.indexOf('\n')) >= 0) {
+            const QByteArray command = c->in.left(end).trimmed();
+            c->in.remove(0, end + 1);
+            applyCommand(c, command);
+        }
+        // A client that sends no line breaks is not given unbounded memory
+        if (c->in.size() > 4096)
+            closeClient(c);
+        else if (c->sent < c->out.size())
+            writeClient(c);
+    }
+
+    void applyCommand(Client *c, const QByteArray &command)
+    {
+        const QList<QByteArray> words = command.simplified().split(' ');
+        if (words.isEmpty() || words.first().isEmpty())
+            return;
+        static const struct { const char *name; QtMsgType type; } levels[] = {
+            { "debug", QtDebugMsg }, { "info", QtInfoMsg }, { "warning", QtWarningMsg },
+            { "critical", QtCriticalMsg }, { "fatal", QtFatalMsg },
+        };
+        if (words.first() == "filter" && words.size() >= 2) {
+            for (const auto &level : levels) {
+                if (words.at(1) == level.name) {
+                    c->minSeverity = LogCategoryFilter::severity(level.type);
+                    c->modules = words.mid(2);
+                    return;
+                }
+            }
+        }
+        const QByteArray error = "-- unknown command: " + command + " --";
+        enqueue(c, error.constData(), error.size());
+    }
+
+    /**
+     * @brief Appends one line to the client's buffer, or counts it as dropped.
+     */
+    void enqueue(Client *c, const char *line, int length)
+    {
+        const int pending = c->out.size() - c->sent;
+        QByteArray notice;
+        if (c->dropped > 0)
+            notice = "-- " + QByteArray::number(c->dropped) + " lines dropped --\n";
+        if (pending + notice.size() + length + 1 > m_bufferBytes) {
+            ++c->dropped;
+            m_droppedLines->fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+        if (c->sent > 0 && c->sent >= c->out.size() / 2) {
+            c->out.remove(0, c->sent);
+            c->sent = 0;
+        }
+        c->out.append(notice);
+        c->out.append(line, length);
+        c->out.append('\n');
+        c->dropped = 0;
+    }
+
+    void writeClient(Client *c)
+    {
+        while (c->sent < c->out.size()) {
+            const ssize_t count = ::send(c->fd, c->out.constData() + c->sent,
+                                         size_t(c->out.size() - c->sent), MSG_NOSIGNAL);
+            if (count > 0) {
+                c->sent += int(count);
+                continue;
+            }
+            if (count < 0 && errno == EINTR)
+                continue;
+            if (count < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+                c->writeNotifier->setEnabled(true);
+                return;
+            }
+            closeClient(c);
+            return;
+        }
+        c->out.resize(0);
+        c->sent = 0;
+        c->writeNotifier->setEnabled(false);
+    }
+
+    void closeClient(Client *c)
+    {
+        c->readNotifier->setEnabled(false);
+        c->writeNotifier->setEnabled(false);
+        // The notifier may be the sender of the running slot
+        c->readNotifier->deleteLater();
+        c->writeNotifier->deleteLater();
+        ::close(c->fd);
+        for (auto it = m_clients.begin(); it != m_clients.end(); ++it) {
+            if (it->get() == c) {
+                m_clients.erase(it);
+                break;
+            }
+        }
+        m_clientCount->store(int(m_clients.size()));
+    }
+
+    const int m_listenFd;
+    const int m_bufferBytes;
+    std::atomic<int> *m_clientCount;
+    std::atomic<quint64> *m_droppedLines;
+    std::vector<std::unique_ptr<Client>> m_clients;
+};
+
+#endif // Q_OS_UNIX
+
+LogStreamServer::LogStreamServer()
+{
+    m_thread.setObjectName("LogStream");
+}
+
+LogStreamServer::~LogStreamServer()
+{
+    stop();
+}
+
+bool LogStreamServer::start(const QString &path, int clientBufferBytes)
+{
+    stop();
+#ifdef Q_OS_UNIX
+    const QByteArray nativePath = QFile::encodeName(path);
+    sockaddr_un address;
+    memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+    if (nativePath.isEmpty() || size_t(nativePath.size()) >= sizeof(address.sun_path)) {
+        std::cerr << "LogStreamServer: Invalid socket path " << nativePath.constData() << std::endl;
+        return false;
+    }
+    memcpy(address.sun_path, nativePath.constData(), size_t(nativePath.size()));
+
+    // A socket left behind by a previous run would make bind() fail
+    struct stat info;
+    if (lstat(nativePath.constData(), &info) == 0 && S_ISSOCK(info.st_mode))
+        ::unlink(nativePath.constData());
+
+    const int fd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd < 0 || !setNonBlocking(fd)
+            || ::bind(fd, reinterpret_cast<const sockaddr *>(&address), sizeof(address)) != 0
+            || ::listen(fd, MAX_CLIENTS) != 0) {
+        std::cerr << "LogStreamServer: Cannot listen on " << nativePath.constData() << ": "
+                  << strerror(errno) << std::endl;
+        if (fd >= 0)
+            ::close(fd);
+        return false;
+    }
+
+    m_path = path;
+    m_droppedLines.store(0);
+    m_worker = new Worker(fd, qMax(4096, clientBufferBytes), &m_clientCount, &m_droppedLines);
+    m_worker->moveToThread(&m_thread);
+    QObject::connect(&m_thread, &QThread::finished, m_worker, &QObject::deleteLater);
+    m_thread.start();
+
+    Worker *worker = m_worker;
+    QMetaObject::invokeMethod(worker, [worker]() { worker->setup(); }, Qt::QueuedConnection);
+    m_subscription = cLogger::instance().subscribe(worker, [worker](const LogBatchPtr &batch) {
+        worker->onBatch(batch);
+    });
+    return true;
+#else
+    Q_UNUSED(clientBufferBytes)
+    std::cerr << "LogStreamServer: Unix-domain sockets are not supported, not serving "
+              << qPrintable(path) << std::endl;
+    return false;
+#endif
+}
+
+void LogStreamServer::stop()
+{
+#ifdef Q_OS_UNIX
+    if (!m_worker)
+        return;
+    cLogger::instance().unsubscribe(m_subscription);
+    m_subscription = 0;
+    // The worker closes the sockets when it is deleted at the thread's end
+    m_thread.quit();
+    m_thread.wait();
+    m_worker = nullptr;
+    ::unlink(QFile::encodeName(m_path).constData());
+    m_path.clear();
+    m_clientCount.store(0);
+#endif
+}
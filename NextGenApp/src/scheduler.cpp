@@ -0,0 +1,234 @@
+/**
+ * @file src/scheduler.cpp
+ * @brief Implementation of the Scheduler class.
+ *
+ * The scheduler keeps one single-shot QTimer armed for the earliest
+ * registered deadline. On expiry it runs every task that is due (or due
+ * within its tolerance), recomputes their next deadlines and arms the
+ * timer again. With no tasks registered the timer is stopped, so an idle
+ * application does not wake up.
+ *
+ * @date 18-Oct-2026
+ * @author Gangadhar Thalange
+ */
+
+#include "../include/scheduler.h"
+#include <QDateTime>
+#include <limits>
+
+/**
+ * @brief Margin added after a wall-clock boundary.
+ *
+ * Guarantees that a task aligned to e.g. the full minute observes the new
+ * minute even if the timer expires a little early.
+ */
+static constexpr qint64 WALL_CLOCK_GUARD_MS = 20;
+
+/**
+ * @brief Returns the process-wide scheduler instance.
+ *
+ * @return Reference to the scheduler living in the thread of the first caller.
+ */
+Scheduler &Scheduler::instance()
+{
+    static Scheduler theInstance;
+    return theInstance;
+}
+
+/**
+ * @brief Constructs the scheduler and starts its monotonic time base.
+ *
+ * @param parent Optional QObject parent.
+ */
+Scheduler::Scheduler(QObject *parent)
+    : QObject(parent)
+{
+    m_clock.start();
+    m_timer.setSingleShot(true);
+    m_timer.setTimerType(Qt::PreciseTimer);
+    connect(&m_timer, &QTimer::timeout, this, &Scheduler::onTimeout);
+}
+
+/**
+ * @brief Destructor. Stops the timer; pending tasks are discarded.
+ */
+Scheduler::~Scheduler()
+{
+    m_timer.stop();
+}
+
+Scheduler::TaskId Scheduler::schedulePeriodic(qint64 intervalMs, Task task, qint64 toleranceMs)
+{
+    if (intervalMs <= 0 || !task)
+        return 0;
+
+    Entry entry;
+    entry.interval = intervalMs;
+    entry.deadline = m_clock.elapsed() + intervalMs;
+    entry.tolerance = qBound<qint64>(0, toleranceMs, intervalMs);
+    entry.periodic = true;
+    entry.task = std::move(task);
+    return add(std::move(entry));
+}
+
+Scheduler::TaskId Scheduler::scheduleOnce(qint64 delayMs, Task task, qint64 toleranceMs)
+{
+    if (!task)
+        return 0;
+
+    Entry entry;
+    entry.interval = qMax<qint64>(0, delayMs);
+    entry.deadline = m_clock.elapsed() + entry.interval;
+    entry.tolerance = qMax<qint64>(0, toleranceMs);
+    entry.task = std::move(task);
+    return add(std::move(entry));
+}
+
+Scheduler::TaskId Scheduler::scheduleWallClockAligned(qint64 periodMs, Task task)
+{
+    if (periodMs <= 0 || !task)
+        return 0;
+
+    Entry entry;
+    entry.interval = periodMs;
+    entry.deadline = m_clock.elapsed() + msecsToWallBoundary(periodMs) + WALL_CLOCK_GUARD_MS;
+    entry.periodic = true;
+    entry.wallAligned = true;
+    entry.task = std::move(task);
+    return add(std::move(entry));
+}
+
+bool Scheduler::restart(TaskId id)
+{
+    const int index = indexOf(id);
+    if (index < 0)
+        return false;
+
+    Entry &entry = m_tasks[index];
+    entry.deadline = m_clock.elapsed()
+            + (entry.wallAligned ? msecsToWallBoundary(entry.interval) + WALL_CLOCK_GUARD_MS
+                                 : entry.interval);
+
+    // Moving a deadline later never requires touching the timer: if it
+    // expires first it simply finds nothing due and rearms.
+    if (m_armedFor < 0 || entry.deadline < m_armedFor)
+        rearm();
+    return true;
+}
+
+bool Scheduler::cancel(TaskId id)
+{
+    const int index = indexOf(id);
+    if (index < 0)
+        return false;
+
+    m_tasks.remove(index);
+    if (m_tasks.isEmpty())
+        rearm();
+    return true;
+}
+
+bool Scheduler::isScheduled(TaskId id) const
+{
+    return indexOf(id) >= 0;
+}
+
+qint64 Scheduler::msecsToNextWakeup() const
+{
+    if (m_armedFor < 0)
+        return -1;
+    return qMax<qint64>(0, m_armedFor - m_clock.elapsed());
+}
+
+/**
+ * @brief Timer expiry: runs due tasks and rearms for the next deadline.
+ *
+ * Due task identifiers are collected first and looked up again before each
+ * call, so tasks may freely schedule or cancel tasks (including themselves).
+ */
+void Scheduler::onTimeout()
+{
+    ++m_wakeups;
+    m_armedFor = -1;
+
+    const qint64 now = m_clock.elapsed();
+    QVector<TaskId> due;
+    for (const Entry &entry : std::as_const(m_tasks)) {
+        if (entry.deadline - entry.tolerance <= now)
+            due.append(entry.id);
+    }
+
+    for (TaskId id : std::as_const(due)) {
+        const int index = indexOf(id);
+        if (index < 0)
+            continue;
+
+        Task task;
+        Entry &entry = m_tasks[index];
+        if (entry.periodic) {
+            if (entry.wallAligned) {
+                entry.deadline = now + msecsToWallBoundary(entry.interval) + WALL_CLOCK_GUARD_MS;
+            } else {
+                entry.deadline += entry.interval;
+                // Skip missed periods instead of firing a burst.
+                if (entry.deadline <= now)
+                    entry.deadline = now + entry.interval;
+            }
+            task = entry.task;
+        } else {
+            task = std::move(entry.task);
+            m_tasks.remove(index);
+        }
+        task();
+    }
+
+    rearm();
+}
+
+void Scheduler::rearm()
+{
+    qint64 earliest = std::numeric_limits<qint64>::max();
+    for (const Entry &entry : std::as_const(m_tasks))
+        earliest = qMin(earliest, entry.deadline);
+
+    if (m_tasks.isEmpty()) {
+        m_timer.stop();
+        m_armedFor = -1;
+        return;
+    }
+
+    if (m_timer.isActive() && earliest == m_armedFor)
+        return;
+
+    m_armedFor = earliest;
+    const qint64 delay = qMax<qint64>(0, earliest - m_clock.elapsed());
+    m_timer.start(static_cast<int>(qMin<qint64>(delay, std::numeric_limits<int>::max())));
+}
+
+Scheduler::TaskId Scheduler::add(Entry entry)
+{
+    entry.id = m_nextId++;
+    const TaskId id = entry.id;
+    const qint64 deadline = entry.deadline;
+    m_tasks.append(std::move(entry));
+
+    if (m_armedFor < 0 || deadline < m_armedFor)
+        rearm();
+    return id;
+}
+
+qint64 Scheduler::msecsToWallBoundary(qint64 periodMs)
+{
+    const QDateTime now = QDateTime::currentDateTime();
+    const qint64 localMs = now.toMSecsSinceEpoch() + qint64(now.offsetFromUtc()) * 1000;
+    return periodMs - (localMs % periodMs);
+}
+
+int Scheduler::indexOf(TaskId id) const
+{
+    for (int i = 0; i < m_tasks.size(); ++i) {
+        if (m_tasks.at(i).id == id)
+            return i;
+    }
+    return -1;
+}
@@ -0,0 +1,216 @@
+/**
+ * @file src/settingsservice.cpp
+ * @brief Implementation of the SettingsService class.
+ *
+ * Snapshots are immutable and replaced as a whole on every change, the
+ * same copy-on-write scheme as the cLogger subscriber list. Each
+ * snapshot gets a process-wide unique generation number, so a reader's
+ * cached copy is valid exactly while the generation still matches.
+ *
+ * @date 18-Oct-2026
+ * @author Gangadhar Thalange
+ */
+
+#include "../include/settingsservice.h"
+#include <QStringList>
+#include <chrono>
+
+namespace {
+
+std::atomic<quint64> s_nextGeneration{1};
+
+// Under a steady stream of changes, write at least this many debounce
+// periods after the first unwritten one
+const int maxDebouncePeriods = 10;
+
+qint64 nowMs()
+{
+    return std::chrono::duration_cast<std::chrono::milliseconds>(
+                std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+} // namespace
+
+SettingsService::SettingsService(const QString &organization, const QString &application)
+    : m_organization(organization)
+    , m_application(application)
+{
+    QSettings settings(organization, application);
+    auto values = std::make_shared<QHash<QString, QVariant>>();
+    const QStringList keys = settings.allKeys();
+    for (const QString &key : keys)
+        values->insert(key, settings.value(key));
+    m_values = values;
+    m_generation.store(s_nextGeneration.fetch_add(1));
+
+    m_thread.setObjectName("Settings");
+    QObject::connect(&m_thread, &QThread::started, [this]() { run(); });
+}
+
+SettingsService::~SettingsService()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stop = true;
+    }
+    m_changed.notify_one();
+    m_thread.wait();
+    flush();
+}
+
+SettingsService &SettingsService::instance()
+{
+    static SettingsService theInstance(ORG_NAME, APP_NAME);
+    return theInstance;
+}
+
+const QHash<QString, QVariant> &SettingsService::values() const
+{
+    struct CacheEntry {
+        const SettingsService *owner = nullptr;
+        quint64 generation = 0;
+        Snapshot values;
+    };
+    static thread_local CacheEntry cache[4];
+    static thread_local int next = 0;
+
+    const quint64 generation = m_generation.load(std::memory_order_acquire);
+    for (const CacheEntry &entry : cache) {
+        if (entry.owner == this && entry.generation == generation)
+            return *entry.values;
+    }
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    CacheEntry *entry = nullptr;
+    for (CacheEntry &candidate : cache) {
+        if (candidate.owner == this)
+            entry = &candidate;
+    }
+    if (!entry) {
+        entry = &cache[next];
+        next = (next + 1) % 4;
+    }
+    entry->owner = this;
+    entry->generation = m_generation.load(std::memory_order_relaxed);
+    entry->values = m_values;
+    return *entry->values;
+}
+
+QVariant SettingsService::value(const QString &key, const QVariant &defaultValue) const
+{
+    const QHash<QString, QVariant> &current = values();
+    const auto it = current.constFind(key);
+    return it != current.constEnd() ? it.value() : defaultValue;
+}
+
+bool SettingsService::contains(const QString &key) const
+{
+    return values().contains(key);
+}
+
+void SettingsService::setValue(const QString &key, const QVariant &value)
+{
+    update(key, value, false);
+}
+
+void SettingsService::remove(const QString &key)
+{
+    update(key, QVariant(), true);
+}
+
+void SettingsService::update(const QString &key, const QVariant &value, bool removed)
+{
+    removed = removed || !value.isValid();
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        const auto current = m_values->constFind(key);
+        const bool present = current != m_values->constEnd();
+        if (removed ? !present : (present && current.value() == value))
+            return;
+
+        auto values = std::make_shared<QHash<QString, QVariant>>(*m_values);
+        if (removed)
+            values->remove(key);
+        else
+            values->insert(key, value);
+        m_values = values;
+        m_generation.store(s_nextGeneration.fetch_add(1), std::memory_order_release);
+
+        const qint64 now = nowMs();
+        if (m_pending.isEmpty())
+            m_firstChangeMs = now;
+        m_lastChangeMs = now;
+        m_pending.insert(key, removed ? QVariant() : value);
+        if (!m_thread.isRunning() && !m_stop)
+            m_thread.start(QThread::LowPriority);
+    }
+    m_changed.notify_one();
+}
+
+void SettingsService::flush()
+{
+    std::lock_guard<std::mutex> store(m_storeMutex);
+    writePending();
+}
+
+void SettingsService::setDebounceMs(int milliseconds)
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_debounceMs = qMax(0, milliseconds);
+    }
+    m_changed.notify_one();
+}
+
+int SettingsService::pendingCount() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_pending.size();
+}
+
+void SettingsService::run()
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+    while (!m_stop) {
+        if (m_pending.isEmpty()) {
+            m_changed.wait(lock);
+            continue;
+        }
+        const qint64 due = qMin(m_lastChangeMs + m_debounceMs,
+                                m_firstChangeMs + qint64(m_debounceMs) * maxDebouncePeriods);
+        const qint64 now = nowMs();
+        if (now < due) {
+            m_changed.wait_for(lock, std::chrono::milliseconds(due - now));
+            continue;
+        }
+        lock.unlock();
+        flush();
+        lock.lock();
+    }
+}
+
+void SettingsService::writePending()
+{
+    QHash<QString, QVariant> pending;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        pending.swap(m_pending);
+    }
+    if (pending.isEmpty())
+        return;
+
+    if (!m_store) {
+        m_store.reset(new QSettings(m_organization, m_application));
+        // Used from whichever thread flushes; keep Qt from syncing it
+        // through events on the creating thread
+        m_store->moveToThread(nullptr);
+    }
+    for (auto it = pending.constBegin(); it != pending.constEnd(); ++it) {
+        if (it.value().isValid())
+            m_store->setValue(it.key(), it.value());
+        else
+            m_store->remove(it.key());
+    }
+    m_store->sync();
+    m_syncs.fetch_add(1);
+}
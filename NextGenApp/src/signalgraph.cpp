@@ -0,0 +1,126 @@
+/**
+ * @file src/signalgraph.cpp
+ * @brief Implementation of the SignalGraph class.
+ *
+ * @date 18-Oct-2026
+ * @author Gangadhar Thalange
+ */
+
+#include "../include/signalgraph.h"
+#include <cmath>
+
+namespace {
+
+// NaN never compares equal; a signal stuck at NaN must not notify forever
+bool sameValue(double a, double b)
+{
+    return a == b || (std::isnan(a) && std::isnan(b));
+}
+
+} // namespace
+
+SignalGraph::SignalId SignalGraph::addInput(double initial, Notify notify)
+{
+    Node node;
+    node.value = initial;
+    node.notify = std::move(notify);
+    m_nodes.append(node);
+    // Nothing is pending for the new node
+    if (m_firstDirty == m_nodes.size() - 1)
+        m_firstDirty = m_nodes.size();
+    return m_nodes.size() - 1;
+}
+
+SignalGraph::SignalId SignalGraph::addDerived(std::initializer_list<SignalId> inputs, Compute compute,
+                                              Notify notify)
+{
+    for (SignalId input : inputs) {
+        if (!contains(input))
+            return -1;
+    }
+    const SignalId id = m_nodes.size();
+    for (SignalId input : inputs)
+        m_nodes[input].dependents.append(id);
+
+    Node node;
+    node.compute = std::move(compute);
+    node.notify = std::move(notify);
+    node.value = node.compute();
+    ++m_computes;
+    m_nodes.append(node);
+    if (m_firstDirty == id)
+        m_firstDirty = m_nodes.size();
+    return id;
+}
+
+void SignalGraph::set(SignalId input, double value)
+{
+    if (!contains(input) || m_nodes[input].compute)
+        return;
+    Node &node = m_nodes[input];
+    if (sameValue(node.value, value))
+        return;
+    node.value = value;
+    node.changed = true;
+    touch(input);
+    markDependents(input);
+}
+
+double SignalGraph::value(SignalId id) const
+{
+    return contains(id) ? m_nodes[id].value : 0.0;
+}
+
+int SignalGraph::update()
+{
+    if (!isDirty())
+        return 0;
+
+    // Dependents always have higher ids, so one forward pass sees every
+    // signal after all of its inputs
+    const int first = m_firstDirty;
+    for (int id = first; id < m_nodes.size(); ++id) {
+        Node &node = m_nodes[id];
+        if (!node.dirty)
+            continue;
+        node.dirty = false;
+        const double value = node.compute();
+        ++m_computes;
+        if (sameValue(node.value, value))
+            continue;
+        node.value = value;
+        node.changed = true;
+        markDependents(id);
+    }
+    m_firstDirty = m_nodes.size();
+
+    // Notify after all values are consistent; callbacks may read any signal
+    QVector<SignalId> changed;
+    for (int id = first; id < m_nodes.size(); ++id) {
+        if (m_nodes[id].changed) {
+            m_nodes[id].changed = false;
+            changed.append(id);
+        }
+    }
+    for (SignalId id : changed) {
+        // A copy: the callback may add signals and reallocate m_nodes
+        const Notify notify = m_nodes[id].notify;
+        if (notify)
+            notify(m_nodes[id].value);
+    }
+    return changed.size();
+}
+
+void SignalGraph::markDependents(SignalId id)
+{
+    for (SignalId dependent : m_nodes[id].dependents) {
+        m_nodes[dependent].dirty = true;
+        touch(dependent);
+    }
+}
+
+void SignalGraph::touch(SignalId id)
+{
+    if (id < m_firstDirty)
+        m_firstDirty = id;
+}
@@ -0,0 +1,151 @@
+/**
+ * @file src/threadconfig.cpp
+ * @brief Implementation of ThreadConfig.
+ *
+ * Uses the pthread affinity/scheduling API and mlockall() on Linux. On
+ * other platforms apply() only reports that the settings are unsupported.
+ *
+ * @date 18-Oct-2026
+ * @author Gangadhar Thalange
+ */
+
+#include "../include/threadconfig.h"
+#include "../include/settingsservice.h"
+#include <QThread>
+#include <cstring>
+
+#ifdef Q_OS_LINUX
+#include <pthread.h>
+#include <sched.h>
+#include <sys/mman.h>
+#include <cerrno>
+#endif
+
+QVariantMap ThreadConfig::Effective::toVariantMap() const
+{
+    QVariantMap map;
+    map.insert("applied", applied);
+    map.insert("cpu", cpu);
+    map.insert("policy", ThreadConfig::policyName(policy));
+    map.insert("priority", priority);
+    map.insert("memoryLocked", memoryLocked);
+    map.insert("errors", errors);
+    return map;
+}
+
+ThreadConfig ThreadConfig::fromSettings(const QString &name)
+{
+    const SettingsService &settings = SettingsService::instance();
+    const QString group = "Threads/" + name;
+
+    ThreadConfig config;
+    config.cpu = settings.value(group + "/cpu", -1).toInt();
+    config.policy = policyFromName(settings.value(group + "/policy", "other").toString());
+    config.priority = settings.value(group + "/priority", 0).toInt();
+    config.lockMemory = settings.value(group + "/lockMemory", false).toBool();
+    return config;
+}
+
+bool ThreadConfig::isDefault() const
+{
+    return cpu < 0 && policy == PolicyDefault && !lockMemory;
+}
+
+QString ThreadConfig::policyName(Policy policy)
+{
+    switch (policy) {
+    case PolicyFifo:
+        return "fifo";
+    case PolicyRoundRobin:
+        return "rr";
+    default:
+        return "other";
+    }
+}
+
+ThreadConfig::Policy ThreadConfig::policyFromName(const QString &name)
+{
+    const QString key = name.trimmed().toLower();
+    if (key == "fifo")
+        return PolicyFifo;
+    if (key == "rr")
+        return PolicyRoundRobin;
+    return PolicyDefault;
+}
+
+/**
+ * @brief Applies affinity, scheduling and memory locking to this thread.
+ *
+ * Order matters: memory is locked first so later page faults of the
+ * real-time thread are avoided, then the thread is pinned, then its
+ * policy is raised.
+ *
+ * @return Effective settings read back from the system.
+ */
+ThreadConfig::Effective ThreadConfig::apply() const
+{
+    Effective effective;
+    effective.applied = true;
+
+#ifdef Q_OS_LINUX
+    if (lockMemory) {
+        if (mlockall(MCL_CURRENT | MCL_FUTURE) == 0)
+            effective.memoryLocked = true;
+        else
+            effective.errors << QString("mlockall: %1").arg(QString::fromLocal8Bit(strerror(errno)));
+    }
+
+    if (cpu >= 0) {
+        if (cpu >= CPU_SETSIZE || cpu >= QThread::idealThreadCount()) {
+            effective.errors << QString("affinity: cpu %1 does not exist").arg(cpu);
+        } else {
+            cpu_set_t set;
+            CPU_ZERO(&set);
+            CPU_SET(cpu, &set);
+            const int rc = pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+            if (rc != 0)
+                effective.errors << QString("affinity: %1").arg(QString::fromLocal8Bit(strerror(rc)));
+        }
+    }
+
+    if (policy != PolicyDefault) {
+        const int native = policy == PolicyFifo ? SCHED_FIFO : SCHED_RR;
+        sched_param param;
+        memset(&param, 0, sizeof(param));
+        param.sched_priority = qBound(sched_get_priority_min(native), priority,
+                                      sched_get_priority_max(native));
+        const int rc = pthread_setschedparam(pthread_self(), native, &param);
+        if (rc != 0)
+            effective.errors << QString("scheduler %1: %2")
+                                .arg(policyName(policy), QString::fromLocal8Bit(strerror(rc)));
+    }
+
+    // Read back what is really in force.
+    cpu_set_t current;
+    CPU_ZERO(&current);
+    if (pthread_getaffinity_np(pthread_self(), sizeof(current), &current) == 0
+            && CPU_COUNT(&current) == 1) {
+        for (int i = 0; i < CPU_SETSIZE; ++i) {
+            if (CPU_ISSET(i, &current)) {
+                effective.cpu = i;
+                break;
+            }
+        }
+    }
+
+    int native = SCHED_OTHER;
+    sched_param param;
+    memset(&param, 0, sizeof(param));
+    if (pthread_getschedparam(pthread_self(), &native, &param) == 0) {
+        effective.policy = native == SCHED_FIFO ? PolicyFifo
+                         : native == SCHED_RR ? PolicyRoundRobin
+                         : PolicyDefault;
+        effective.priority = param.sched_priority;
+    }
+#else
+    if (!isDefault())
+        effective.errors << QString("real-time thread settings are not supported on this platform");
+#endif
+
+    return effective;
+}
@@ -0,0 +1,165 @@
+/**
+ * @file src/tripcomputer.cpp
+ * @brief Implementation of the TripComputer class.
+ *
+ * The payload layout matches AppInterface::processFrame(): the raw value
+ * of every rate frame is the big-endian 16-bit word in bytes 6 and 7.
+ *
+ * @date 18-Oct-2026
+ * @author Gangadhar Thalange
+ */
+
+#include "../include/tripcomputer.h"
+#include "../include/constants.h"
+#include <chrono>
+
+namespace {
+
+constexpr double NS_PER_HOUR = 3600.0 * 1e9;
+
+// J1939 engine fuel rate resolution
+constexpr double FUEL_RATE_LITRES_PER_HOUR_PER_BIT = 0.05;
+
+qint64 nowNs()
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+} // namespace
+
+QVariantMap TripComputer::Results::toVariantMap() const
+{
+    QVariantMap map;
+    map.insert("fuelUsage", fuelUsage);
+    map.insert("defUsage", defUsage);
+    map.insert("avgEngineLoad", avgEngineLoad);
+    map.insert("avgFuelRate", avgFuelRate);
+    map.insert("frames", frames);
+    map.insert("gaps", gaps);
+    return map;
+}
+
+TripComputer::TripComputer()
+    : m_fuelRateAverage(DEFAULT_FUEL_RATE_WINDOW_MS * 1000000)
+    , m_engineLoadAverage(DEFAULT_ENGINE_LOAD_WINDOW_MS * 1000000)
+{
+}
+
+void TripComputer::onFrame(uint32_t id, const QByteArray &payload)
+{
+    if (id != CAN_ID_FUELRATE && id != CAN_ID_DEFRATE && id != CAN_ID_ENGINELOAD)
+        return;
+    onFrame(id, payload, nowNs());
+}
+
+void TripComputer::onFrame(uint32_t id, const QByteArray &payload, qint64 nowNs)
+{
+    if (id != CAN_ID_FUELRATE && id != CAN_ID_DEFRATE && id != CAN_ID_ENGINELOAD)
+        return;
+    if (payload.size() < 8)
+        return;
+    const uchar *buf = reinterpret_cast<const uchar *>(payload.constData());
+    const int raw = (buf[6] << 8) | buf[7];
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    checkClock(nowNs);
+    if (id == CAN_ID_FUELRATE) {
+        const double previous = m_fuelRate.value;
+        const double rate = raw * FUEL_RATE_LITRES_PER_HOUR_PER_BIT;
+        if (const qint64 dt = advance(m_fuelRate, rate, nowNs)) {
+            m_results.fuelUsage += (previous + rate) / 2.0 * (double(dt) / NS_PER_HOUR);
+            m_fuelRateAverage.add((previous + rate) / 2.0, nowNs - dt, nowNs);
+            m_results.avgFuelRate = m_fuelRateAverage.average();
+        }
+    } else if (id == CAN_ID_DEFRATE) {
+        const double previous = m_defRate.value;
+        if (const qint64 dt = advance(m_defRate, raw, nowNs))
+            m_results.defUsage += (previous + raw) / 2.0 * (double(dt) / NS_PER_HOUR);
+    } else if (id == CAN_ID_ENGINELOAD) {
+        const double previous = m_engineLoad.value;
+        if (const qint64 dt = advance(m_engineLoad, raw, nowNs)) {
+            m_engineLoadAverage.add((previous + raw) / 2.0, nowNs - dt, nowNs);
+            m_results.avgEngineLoad = m_engineLoadAverage.average();
+            m_results.hasEngineLoad = true;
+        }
+    }
+    ++m_results.frames;
+}
+
+void TripComputer::checkClock(qint64 nowNs)
+{
+    if (m_hasLast && nowNs < m_lastNs) {
+        m_fuelRate = Sample();
+        m_defRate = Sample();
+        m_engineLoad = Sample();
+        m_fuelRateAverage.reset();
+        m_engineLoadAverage.reset();
+        m_results.avgEngineLoad = 0.0;
+        m_results.hasEngineLoad = false;
+        ++m_results.gaps;
+    }
+    m_lastNs = nowNs;
+    m_hasLast = true;
+}
+
+qint64 TripComputer::advance(Sample &sample, double value, qint64 nowNs)
+{
+    const bool integrate = sample.valid && nowNs > sample.timeNs;
+    const qint64 dt = integrate ? nowNs - sample.timeNs : 0;
+    sample.value = value;
+    sample.timeNs = nowNs;
+    sample.valid = true;
+    if (dt > m_maxGapNs) {
+        ++m_results.gaps;
+        return 0;
+    }
+    return dt;
+}
+
+TripComputer::Results TripComputer::results() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_results;
+}
+
+void TripComputer::setFuelUsage(double litres)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_results.fuelUsage = litres;
+}
+
+void TripComputer::setDefUsage(double usage)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_results.defUsage = usage;
+}
+
+void TripComputer::resetEngineLoad()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_engineLoadAverage.reset();
+    m_results.avgEngineLoad = 0.0;
+    m_results.hasEngineLoad = false;
+}
+
+void TripComputer::setEngineLoadWindowMs(qint64 milliseconds)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_engineLoadAverage.setWindow(qMax<qint64>(1, milliseconds) * 1000000);
+    m_results.avgEngineLoad = 0.0;
+    m_results.hasEngineLoad = false;
+}
+
+void TripComputer::setFuelRateWindowMs(qint64 milliseconds)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_fuelRateAverage.setWindow(qMax<qint64>(1, milliseconds) * 1000000);
+    m_results.avgFuelRate = 0.0;
+}
+
+void TripComputer::setMaxGapMs(qint64 milliseconds)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_maxGapNs = qMax<qint64>(0, milliseconds) * 1000000;
+}
@@ -0,0 +1,349 @@
+/**
+ * @file src/tripjournal.cpp
+ * @brief Implementation of the TripJournal class.
+ *
+ * The file is reserved on disk when it is created (posix_fallocate on
+ * Linux, as for the flight recorder) and mapped once. A record is written
+ * with plain stores, its magic last, and its page is then synced with
+ * msync(), on the worker thread. The vehicle's ignition can cut the power
+ * at any time; the page cache alone would only survive a process crash.
+ *
+ * @date 18-Oct-2026
+ * @author Gangadhar Thalange
+ */
+
+#include "../include/tripjournal.h"
+#include <QDateTime>
+#include <QElapsedTimer>
+#include <chrono>
+#include <cstddef>
+#include <cstring>
+
+#ifdef Q_OS_UNIX
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+#ifdef Q_OS_LINUX
+#include <fcntl.h>
+#endif
+
+static_assert(sizeof(TripJournal::Header) <= size_t(TripJournal::HEADER_SIZE),
+              "Header must fit into its page");
+static_assert(sizeof(TripJournal::Record) == 64 && TripJournal::HEADER_SIZE % sizeof(TripJournal::Record) == 0,
+              "Record layout is part of the file format");
+
+namespace {
+
+qint64 nowMs()
+{
+    return std::chrono::duration_cast<std::chrono::milliseconds>(
+                std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+/**
+ * @brief Returns the slot of the valid record with the highest sequence, or -1.
+ *
+ * Records are copied before they are checked; another process may be
+ * writing them.
+ */
+int latestSlot(const TripJournal::Record *records, int slots, TripJournal::Record *latest)
+{
+    int found = -1;
+    for (int slot = 0; slot < slots; ++slot) {
+        TripJournal::Record record;
+        memcpy(&record, records + slot, sizeof(record));
+        if (record.magic != TripJournal::RECORD_MAGIC || record.checksum != TripJournal::checksum(record))
+            continue;
+        if (found < 0 || record.sequence > latest->sequence) {
+            *latest = record;
+            found = slot;
+        }
+    }
+    return found;
+}
+
+TripJournal::State stateOf(const TripJournal::Record &record)
+{
+    TripJournal::State state;
+    state.lastTripHours = record.lastTripHours;
+    state.fuelUsage = record.fuelUsage;
+    state.defUsage = record.defUsage;
+    state.lastResetDate = QString::fromUtf8(record.lastResetDate,
+                                            int(strnlen(record.lastResetDate, sizeof(record.lastResetDate))));
+    return state;
+}
+
+} // namespace
+
+TripJournal::TripJournal()
+{
+    m_thread.setObjectName("TripJournal");
+    QObject::connect(&m_thread, &QThread::started, [this]() { run(); });
+}
+
+TripJournal::~TripJournal()
+{
+    close();
+}
+
+bool TripJournal::open(const QString &path, int slots)
+{
+    close();
+
+    QElapsedTimer timer;
+    timer.start();
+    slots = qMax(MIN_SLOTS, slots);
+    const qint64 total = HEADER_SIZE + qint64(slots) * qint64(sizeof(Record));
+
+    m_file.setFileName(path);
+    if (!m_file.open(QIODevice::ReadWrite)) {
+        qWarning("Cannot open trip journal %s: %s",
+                 qPrintable(path), qPrintable(m_file.errorString()));
+        return false;
+    }
+
+    const bool sameSize = m_file.size() == total;
+    State carried;
+    bool hasCarried = false;
+    if (!sameSize) {
+        // Another slot count: keep the counters across the change
+        hasCarried = m_file.size() > 0 && read(path, &carried);
+        bool reserved = m_file.resize(total);
+#ifdef Q_OS_LINUX
+        reserved = reserved && posix_fallocate(m_file.handle(), 0, total) == 0;
+#endif
+        if (!reserved) {
+            qWarning("Cannot reserve %lld bytes for trip journal %s",
+                     static_cast<long long>(total), qPrintable(path));
+            m_file.close();
+            return false;
+        }
+    }
+
+    uchar *map = m_file.map(0, total);
+    if (!map) {
+        qWarning("Cannot map trip journal %s", qPrintable(path));
+        m_file.close();
+        return false;
+    }
+    Header *header = reinterpret_cast<Header *>(map);
+    const bool valid = sameSize
+            && memcmp(header->magic, MAGIC, sizeof(MAGIC)) == 0
+            && header->version == VERSION
+            && header->headerSize == uint32_t(HEADER_SIZE)
+            && header->recordSize == uint32_t(sizeof(Record))
+            && header->slots == uint32_t(slots);
+    if (!valid) {
+        memset(map, 0, size_t(total));
+        memcpy(header->magic, MAGIC, sizeof(MAGIC));
+        header->version = VERSION;
+        header->headerSize = uint32_t(HEADER_SIZE);
+        header->recordSize = uint32_t(sizeof(Record));
+        header->slots = uint32_t(slots);
+#ifdef Q_OS_UNIX
+        // The cleared slots and the new header reach the disk before any
+        // record does; otherwise a power cut could leave records behind a
+        // header the next open() rejects, and clears again
+        if (msync(map, size_t(total), MS_SYNC) != 0) {
+            qWarning("Cannot sync trip journal %s", qPrintable(path));
+            m_file.unmap(map);
+            m_file.close();
+            return false;
+        }
+#endif
+    }
+
+    std::lock_guard<std::mutex> write(m_writeMutex);
+    m_records = reinterpret_cast<Record *>(map + HEADER_SIZE);
+    m_slots = slots;
+
+    Record latest;
+    const int slot = latestSlot(m_records, m_slots, &latest);
+    m_restored = slot >= 0 || hasCarried;
+    m_restoredState = slot >= 0 ? stateOf(latest) : carried;
+    m_sequence = slot >= 0 ? latest.sequence : 0;
+    m_nextSlot = (slot + 1) % m_slots;
+    m_writes.store(0);
+    m_header = header;
+    m_restoreNs = timer.nsecsElapsed();
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_pending = m_restoredState;
+        m_dirty = false;
+        m_stop = false;
+        m_lastWriteMs = 0;
+    }
+    if (hasCarried)
+        writeRecord(carried);
+    m_thread.start(QThread::LowPriority);
+    return true;
+}
+
+void TripJournal::close()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stop = true;
+    }
+    m_changed.notify_one();
+    m_thread.wait();
+    flush();
+
+    std::lock_guard<std::mutex> write(m_writeMutex);
+    if (m_header) {
+        m_file.unmap(reinterpret_cast<uchar *>(m_header));
+        m_header = nullptr;
+        m_records = nullptr;
+    }
+    if (m_file.isOpen())
+        m_file.close();
+}
+
+bool TripJournal::restore(State *state) const
+{
+    if (!m_restored)
+        return false;
+    *state = m_restoredState;
+    return true;
+}
+
+void TripJournal::record(const State &state)
+{
+    bool wake = false;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (state == m_pending)
+            return;
+        m_pending = state;
+        m_dirty = true;
+        // While the worker waits out the interval it needs no wake-up
+        wake = m_idle;
+    }
+    if (wake)
+        m_changed.notify_one();
+}
+
+void TripJournal::flush()
+{
+    std::lock_guard<std::mutex> write(m_writeMutex);
+    if (!m_header)
+        return;
+    State state;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (!m_dirty)
+            return;
+        state = m_pending;
+        m_dirty = false;
+        m_lastWriteMs = nowMs();
+    }
+    writeRecord(state);
+}
+
+void TripJournal::setMinIntervalMs(int milliseconds)
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_minIntervalMs = qMax(0, milliseconds);
+    }
+    m_changed.notify_one();
+}
+
+uint32_t TripJournal::checksum(const Record &record)
+{
+    const size_t first = offsetof(Record, sequence);
+    const uint8_t *data = reinterpret_cast<const uint8_t *>(&record);
+    uint32_t hash = 2166136261u;    // FNV-1a
+    for (size_t i = first; i < sizeof(Record); ++i)
+        hash = (hash ^ data[i]) * 16777619u;
+    return hash;
+}
+
+void TripJournal::run()
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+    while (!m_stop) {
+        if (!m_dirty) {
+            m_idle = true;
+            m_changed.wait(lock);
+            m_idle = false;
+            continue;
+        }
+        const qint64 due = m_lastWriteMs + m_minIntervalMs;
+        const qint64 now = nowMs();
+        if (now < due) {
+            m_changed.wait_for(lock, std::chrono::milliseconds(due - now));
+            continue;
+        }
+        lock.unlock();
+        flush();
+        lock.lock();
+    }
+}
+
+void TripJournal::writeRecord(const State &state)
+{
+    Record *record = m_records + m_nextSlot;
+
+    // A record torn by a crash fails its checksum, and restore falls back
+    // to the one before; clearing the magic first keeps that so even if
+    // the old record in this slot had the same payload
+    record->magic = 0;
+    std::atomic_signal_fence(std::memory_order_seq_cst);
+    record->sequence = ++m_sequence;
+    record->savedUtcMs = QDateTime::currentMSecsSinceEpoch();
+    record->lastTripHours = state.lastTripHours;
+    record->fuelUsage = state.fuelUsage;
+    record->defUsage = state.defUsage;
+    record->reserved = 0;
+    memset(record->lastResetDate, 0, sizeof(record->lastResetDate));
+    const QByteArray date = state.lastResetDate.toUtf8().left(int(sizeof(record->lastResetDate)) - 1);
+    memcpy(record->lastResetDate, date.constData(), size_t(date.size()));
+    record->checksum = checksum(*record);
+    std::atomic_signal_fence(std::memory_order_seq_cst);
+    record->magic = RECORD_MAGIC;
+
+#ifdef Q_OS_UNIX
+    static const uintptr_t pageMask = ~uintptr_t(sysconf(_SC_PAGESIZE) - 1);
+    const uintptr_t page = reinterpret_cast<uintptr_t>(record) & pageMask;
+    if (msync(reinterpret_cast<void *>(page), reinterpret_cast<uintptr_t>(record + 1) - page, MS_SYNC) != 0)
+        qWarning("Cannot sync trip journal %s", qPrintable(m_file.fileName()));
+#endif
+
+    m_nextSlot = (m_nextSlot + 1) % m_slots;
+    m_writes.fetch_add(1);
+}
+
+bool TripJournal::read(const QString &path, State *state, QString *errorString)
+{
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly)) {
+        if (errorString)
+            *errorString = file.errorString();
+        return false;
+    }
+    const qint64 size = file.size();
+    const uchar *map = size >= HEADER_SIZE ? file.map(0, size) : nullptr;
+    Header header;
+    if (map)
+        memcpy(&header, map, sizeof(header));
+    if (!map || memcmp(header.magic, MAGIC, sizeof(MAGIC)) != 0 || header.version != VERSION
+            || header.headerSize < sizeof(Header) || header.headerSize > uint64_t(size)
+            || header.recordSize != sizeof(Record)) {
+        if (errorString)
+            *errorString = QStringLiteral("Not a trip journal file");
+        return false;
+    }
+    const qint64 fit = (size - qint64(header.headerSize)) / qint64(sizeof(Record));
+    const int slots = int(qMin<qint64>(header.slots, fit));
+
+    Record latest;
+    if (latestSlot(reinterpret_cast<const Record *>(map + header.headerSize), slots, &latest) < 0) {
+        if (errorString)
+            *errorString = QStringLiteral("No valid record");
+        return false;
+    }
+    *state = stateOf(latest);
+    return true;
+}
@@ -0,0 +1,199 @@
+/**
+ * @file src/zmqreceiver.cpp
+ * @brief Implementation of the ZmqReceiver class.
+ *
+ * The ingest thread polls the SUB socket together with the receiving end
+ * of an inproc PAIR socket. stop() writes to the other end of the pair,
+ * so the thread leaves the poll immediately instead of blocking in recv()
+ * until the next frame arrives.
+ *
+ * @date 18-Oct-2026
+ * @author Gangadhar Thalange
+ */
+
+#include "../include/zmqreceiver.h"
+#include "../include/capturerecorder.h"
+#include <QDebug>
+#include <chrono>
+#include <cstring>
+
+namespace {
+
+// Messages taken per wakeup before polling again, so a publisher that
+// outpaces the handler cannot keep the loop from seeing a stop request
+constexpr int MAX_DRAIN_BATCH = 256;
+
+} // namespace
+
+/**
+ * @brief Constructs the receiver. No thread or socket is started yet.
+ *
+ * @param endpoint Publisher endpoint.
+ * @param parent Optional QObject parent.
+ */
+ZmqReceiver::ZmqReceiver(const QString &endpoint, QObject *parent)
+    : FrameSource(parent)
+    , m_endpoint(endpoint)
+{
+    m_thread.setObjectName("ZmqIngest");
+    connect(&m_thread, &QThread::started,
+            this, &ZmqReceiver::run,
+            Qt::DirectConnection);
+}
+
+/**
+ * @brief Destructor. Stops the ingest thread before the context is closed.
+ */
+ZmqReceiver::~ZmqReceiver()
+{
+    stop();
+}
+
+void ZmqReceiver::setThreadConfig(const ThreadConfig &config)
+{
+    m_threadConfig = config;
+}
+
+ThreadConfig::Effective ZmqReceiver::effectiveThreadConfig() const
+{
+    QMutexLocker locker(&m_configMutex);
+    return m_effectiveConfig;
+}
+
+/**
+ * @brief Creates a fresh control pair and starts the ingest thread.
+ *
+ * The control socket connects before the ingest thread binds its end;
+ * inproc supports connect-before-bind, so stop() works immediately.
+ * Each run uses its own inproc endpoint name, as an inproc connection
+ * is not re-established once the bound peer has been closed.
+ *
+ * @return false if the receiver is already running.
+ */
+bool ZmqReceiver::start()
+{
+    if (m_thread.isRunning())
+        return false;
+
+    m_controlEndpoint = "inproc://zmqreceiver-control-"
+            + std::to_string(reinterpret_cast<quintptr>(this))
+            + "-" + std::to_string(++m_generation);
+    m_control = zmq::socket_t(m_context, zmq::socket_type::pair);
+    m_control.set(zmq::sockopt::linger, 0);
+    m_control.connect(m_controlEndpoint);
+
+    m_thread.start();
+    return true;
+}
+
+/**
+ * @brief Wakes the receive loop through the control socket and joins it.
+ *
+ * @note Falls back to zmq context shutdown if the stop message cannot be
+ *       queued; the poll then fails with ETERM and the loop exits. The
+ *       terminated context is replaced afterwards so start() works again.
+ */
+void ZmqReceiver::stop()
+{
+    if (!m_thread.isRunning())
+        return;
+
+    m_thread.requestInterruption();
+
+    bool sent = false;
+    try {
+        sent = m_control.send(zmq::str_buffer("stop"), zmq::send_flags::dontwait).has_value();
+    } catch (const zmq::error_t &e) {
+        qWarning("ZMQ control send failed: %s", e.what());
+    }
+    if (!sent)
+        m_context.shutdown();
+
+    m_thread.wait();
+
+    if (!sent) {
+        // A shut down context rejects new sockets; the control socket has
+        // to go first or closing the context blocks on it
+        m_control.close();
+        m_context = zmq::context_t(1);
+    }
+}
+
+/**
+ * @brief Receive loop executed on the ingest thread.
+ *
+ * Applies the thread configuration, then waits in zmq::poll() without
+ * timeout on the SUB socket and the control socket. Up to MAX_DRAIN_BATCH
+ * frames are drained per wakeup without blocking; if more are queued the
+ * next poll returns at once, and sees a pending stop request first. Every
+ * message is offered to the capture recorder, each valid frame is passed
+ * to the frame handler.
+ *
+ * @note Minimum message size is 12 bytes (4-byte ID + 8-byte payload).
+ * @note Thread settings that cannot be applied are logged and skipped.
+ */
+void ZmqReceiver::run()
+{
+    const ThreadConfig::Effective effective = m_threadConfig.apply();
+    {
+        QMutexLocker locker(&m_configMutex);
+        m_effectiveConfig = effective;
+    }
+    if (!m_threadConfig.isDefault()) {
+        qInfo("ZMQ ingest thread: cpu=%d policy=%s priority=%d memoryLocked=%d",
+              effective.cpu, qPrintable(ThreadConfig::policyName(effective.policy)),
+              effective.priority, effective.memoryLocked);
+        for (const QString &error : effective.errors)
+            qWarning("ZMQ ingest thread setting not applied: %s", qPrintable(error));
+    }
+
+    try {
+        zmq::socket_t control(m_context, zmq::socket_type::pair);
+        control.set(zmq::sockopt::linger, 0);
+        control.bind(m_controlEndpoint);
+
+        zmq::socket_t subscriber(m_context, zmq::socket_type::sub);
+        subscriber.set(zmq::sockopt::linger, 0);
+        subscriber.connect(m_endpoint.toStdString());
+        subscriber.set(zmq::sockopt::subscribe, "");
+
+        zmq::pollitem_t items[] = {
+            { subscriber.handle(), 0, ZMQ_POLLIN, 0 },
+            { control.handle(), 0, ZMQ_POLLIN, 0 }
+        };
+
+        while (!QThread::currentThread()->isInterruptionRequested()) {
+            zmq::poll(items, 2, std::chrono::milliseconds(-1));
+
+            if (items[1].revents & ZMQ_POLLIN)
+                break;
+
+            if (!(items[0].revents & ZMQ_POLLIN))
+                continue;
+
+            zmq::message_t msg;
+            for (int drained = 0; drained < MAX_DRAIN_BATCH
+                 && subscriber.recv(msg, zmq::recv_flags::dontwait); ++drained) {
+                if (m_recorder)
+                    m_recorder->record(msg.data(), msg.size());
+
+                if (msg.size() < 12) {
+                    qWarning("Received ZMQ message too small: %zu bytes", msg.size());
+                    continue;
+                }
+
+                uint32_t id;
+                memcpy(&id, msg.data(), 4);
+
+                QByteArray payload(
+                    static_cast<char*>(msg.data()) + 4, 8);
+
+                deliverFrame(id, payload);
+            }
+        }
+    } catch (const zmq::error_t &e) {
+        // ETERM is the expected way out after a context shutdown.
+        if (e.num() != ETERM)
+            qCritical("ZMQ receiver failed: %s", e.what());
+    }
+}
@@ -0,0 +1,198 @@
+/**
+ * @file bench_alarmcontext.cpp
+ * @brief Construction cost benchmark for alarm contexts.
+ *
+ * Global operator new is replaced to count heap allocations. Each run
+ * builds the context of an alarm raised from a fixed call site on a named
+ * thread, the way cLogger::messageHandler() and the alarm consumer do:
+ *
+ * - "qobject": the previous alarm path, QByteArray copies of file and
+ *   function plus the thread name, then a LogMessageContext built from
+ *   them for postAlarmMessage
+ * - "logcontext": LogContext::capture(), the context an alarm now carries
+ * - "logcontext_copy": copying a captured LogContext (queueing, signal
+ *   arguments)
+ * - "channel": AlarmChannel::post() with a LogContext on a running
+ *   channel whose consumer does nothing, posted in bursts the queue can
+ *   hold
+ *
+ * One JSON object is printed per run:
+ *
+ * @code
+ * {"run":"logcontext","alarms":200000,"ns_per_alarm":38.4,"allocs_per_alarm":0.00}
+ * @endcode
+ *
+ * Usage:
+ * @code
+ * ./bench_alarmcontext [--alarms N]
+ * @endcode
+ *
+ * @author Gangadhar Thalange
+ * @date 2026-10-18
+ */
+
+#include <QCoreApplication>
+#include <QDateTime>
+#include <QElapsedTimer>
+#include <QStringList>
+#include <QThread>
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+#include "clogger.h"
+#include "alarmchannel.h"
+#include "logcontext.h"
+
+static std::atomic<quint64> g_allocations{0};
+
+void *operator new(size_t size)
+{
+    g_allocations.fetch_add(1, std::memory_order_relaxed);
+    if (void *p = std::malloc(size ? size : 1))
+        return p;
+    throw std::bad_alloc();
+}
+
+void operator delete(void *p) noexcept
+{
+    std::free(p);
+}
+
+void operator delete(void *p, size_t) noexcept
+{
+    std::free(p);
+}
+
+static const char *const ALARM_FILE = "../src/hydraulics/pressuremonitor.cpp";
+static const char *const ALARM_FUNCTION = "void PressureMonitor::onSample(const Sample&)";
+static constexpr int ALARM_LINE = 214;
+
+static void printResult(const char *run, int alarms, qint64 ns, quint64 allocations)
+{
+    printf("{\"run\":\"%s\",\"alarms\":%d,\"ns_per_alarm\":%.1f,\"allocs_per_alarm\":%.2f}\n",
+           run, alarms, double(ns) / alarms, double(allocations) / alarms);
+    fflush(stdout);
+}
+
+/**
+ * @brief Previous path: owned strings in the alarm, QObject at delivery.
+ */
+static void runQObject(int alarms)
+{
+    qint64 lines = 0;
+    const quint64 before = g_allocations.load();
+    QElapsedTimer timer;
+    timer.start();
+    for (int i = 0; i < alarms; ++i) {
+        const QByteArray file(ALARM_FILE);
+        const QByteArray function(ALARM_FUNCTION);
+        const QString threadName = QThread::currentThread()->objectName();
+        const QString moduleName = file.contains(".qml") ? "QML" : "App";
+        LogMessageContext context(threadName, moduleName, QString(file), QString(function), ALARM_LINE);
+        lines += context.lineNumber();
+    }
+    const qint64 ns = timer.nsecsElapsed();
+    printResult("qobject", alarms, ns, g_allocations.load() - before);
+    if (lines == 0)
+        fprintf(stderr, "no output\n");
+}
+
+/**
+ * @brief LogContext::capture(), as in cLogger::messageHandler().
+ */
+static void runLogContext(int alarms)
+{
+    qint64 lines = 0;
+    const quint64 before = g_allocations.load();
+    QElapsedTimer timer;
+    timer.start();
+    for (int i = 0; i < alarms; ++i) {
+        const LogContext context = LogContext::capture(ALARM_FILE, ALARM_FUNCTION, ALARM_LINE, "App");
+        lines += context.line;
+    }
+    const qint64 ns = timer.nsecsElapsed();
+    printResult("logcontext", alarms, ns, g_allocations.load() - before);
+    if (lines == 0)
+        fprintf(stderr, "no output\n");
+}
+
+/**
+ * @brief Copies of a captured LogContext.
+ */
+static void runLogContextCopy(int alarms)
+{
+    const LogContext source = LogContext::capture(ALARM_FILE, ALARM_FUNCTION, ALARM_LINE, "App");
+    volatile qint32 sink = 0;
+    const quint64 before = g_allocations.load();
+    QElapsedTimer timer;
+    timer.start();
+    for (int i = 0; i < alarms; ++i) {
+        const LogContext copy = source;
+        sink = copy.line;
+    }
+    const qint64 ns = timer.nsecsElapsed();
+    printResult("logcontext_copy", alarms, ns, g_allocations.load() - before);
+    Q_UNUSED(sink)
+}
+
+/**
+ * @brief Capture and post to a running AlarmChannel.
+ */
+static void runChannel(int alarms)
+{
+    AlarmChannel channel;
+    std::atomic<quint64> consumed{0};
+    channel.setConsumer([&consumed](const AlarmChannel::Alarm &) { consumed.fetch_add(1); });
+    channel.start();
+    const QString message = "hydraulic pressure above limit";
+
+    const int burst = AlarmChannel::DEFAULT_CAPACITY / 2;
+    qint64 ns = 0;
+    quint64 allocations = 0;
+    for (int posted = 0; posted < alarms; posted += burst) {
+        const int count = qMin(burst, alarms - posted);
+        const quint64 before = g_allocations.load();
+        QElapsedTimer timer;
+        timer.start();
+        for (int i = 0; i < count; ++i) {
+            AlarmChannel::Alarm alarm;
+            alarm.utcMs = QDateTime::currentMSecsSinceEpoch();
+            alarm.context = LogContext::capture(ALARM_FILE, ALARM_FUNCTION, ALARM_LINE, "App");
+            alarm.message = message;
+            channel.post(std::move(alarm));
+        }
+        ns += timer.nsecsElapsed();
+        allocations += g_allocations.load() - before;
+        // Let the worker drain so the queue never overflows
+        while (consumed.load() < quint64(posted + count))
+            QThread::yieldCurrentThread();
+    }
+    channel.stop();
+    printResult("channel", alarms, ns, allocations);
+    if (channel.stats().dropped != 0)
+        fprintf(stderr, "%llu alarms dropped\n", static_cast<unsigned long long>(channel.stats().dropped));
+}
+
+int main(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+    QThread::currentThread()->setObjectName("PressureMonitor");
+
+    int count = 200000;
+    const QStringList args = app.arguments();
+    for (int i = 1; i < args.size(); ++i) {
+        if (args.at(i) == "--alarms" && i + 1 < args.size()) {
+            count = qMax(1, args.at(++i).toInt());
+        } else {
+            fprintf(stderr, "unknown argument: %s\n", qPrintable(args.at(i)));
+            return 2;
+        }
+    }
+
+    runQObject(count);
+    runLogContext(count);
+    runLogContextCopy(count);
+    runChannel(count);
+    return 0;
+}
@@ -0,0 +1,341 @@
+/**
+ * @file bench_clogger.cpp
+ * @brief Throughput and latency benchmark for the cLogger sinks.
+ *
+ * 1, 2, 4 and 8 producer threads log prebuilt messages as fast as they
+ * can. Every call is timed on its own (two steady_clock reads, about
+ * 20-40 ns of overhead included in the latencies). Global operator new
+ * is replaced to count heap allocations on all threads, the writer and
+ * rotator included. Sinks:
+ *
+ * - "sync": cLogger::messageHandler() in synchronous mode, the line is
+ *   written by the logging thread
+ * - "async": cLogger::messageHandler() in asynchronous mode with
+ *   OverflowBlock, so no message is dropped; the run ends after flush()
+ * - "binary": NG_BINLOG() into a category selected with
+ *   setBinaryCategories(), the raw arguments go to `<log>.bin`
+ *
+ * The text sinks run with time stamps on and off, echo to stdout on and
+ * off (stdout is sent to /dev/null meanwhile, results are still printed)
+ * and with rollover every 1 MB. One JSON object is printed per run:
+ *
+ * @code
+ * {"run":"async","threads":4,"timestamps":1,"echo":0,"rollover":0,"messages":200000,"msgs_per_s":2410000,"producer_msgs_per_s":3050000,"latency_p50_ns":210,"latency_p99_ns":1900,"latency_p999_ns":8100,"latency_max_ns":950000,"allocs_per_msg":0.02,"bytes_on_disk":14600000,"rotations":0,"dropped":0}
+ * @endcode
+ *
+ * msgs_per_s counts until everything is written (flush() included),
+ * producer_msgs_per_s until the last producer returned.
+ *
+ * Usage:
+ * @code
+ * ./bench_clogger [--messages N] [--threads 1,2,4,8] [--sinks sync,async,binary]
+ * @endcode
+ *
+ * @author Gangadhar Thalange
+ * @date 2026-10-18
+ */
+
+#include <QCoreApplication>
+#include <QDir>
+#include <QElapsedTimer>
+#include <QFileInfo>
+#include <QLoggingCategory>
+#include <QStringList>
+#include <QTemporaryDir>
+#include <QThread>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+#include <vector>
+#include "clogger.h"
+#include "binlog.h"
+#ifdef Q_OS_UNIX
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+Q_LOGGING_CATEGORY(lcBenchBinary, "ngbench.binary")
+
+static std::atomic<quint64> g_allocations{0};
+
+void *operator new(size_t size)
+{
+    g_allocations.fetch_add(1, std::memory_order_relaxed);
+    if (void *p = std::malloc(size ? size : 1))
+        return p;
+    throw std::bad_alloc();
+}
+
+void operator delete(void *p) noexcept
+{
+    std::free(p);
+}
+
+void operator delete(void *p, size_t) noexcept
+{
+    std::free(p);
+}
+
+static constexpr qint64 ROLLOVER_BYTES = 1024 * 1024;
+
+static qint64 nowNs()
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+/**
+ * @brief One benchmark configuration.
+ */
+struct RunConfig
+{
+    QString sink;
+    int threads = 1;
+    bool timestamps = true;
+    bool echo = false;
+    bool rollover = false;
+};
+
+/**
+ * @brief Sends stdout to /dev/null while cLogger echoes to it.
+ *
+ * Results are printed to a duplicate of the original stdout.
+ */
+class StdoutRedirect
+{
+public:
+    StdoutRedirect()
+    {
+#ifdef Q_OS_UNIX
+        const int fd = dup(STDOUT_FILENO);
+        if (fd >= 0)
+            m_results = fdopen(fd, "w");
+#endif
+        if (!m_results)
+            m_results = stdout;
+    }
+
+    FILE *results() const { return m_results; }
+
+    void silence(bool enabled)
+    {
+#ifdef Q_OS_UNIX
+        if (m_results == stdout)
+            return;
+        fflush(stdout);
+        if (enabled) {
+            const int null = open("/dev/null", O_WRONLY);
+            if (null >= 0) {
+                dup2(null, STDOUT_FILENO);
+                close(null);
+            }
+        } else {
+            dup2(fileno(m_results), STDOUT_FILENO);
+        }
+#else
+        Q_UNUSED(enabled)
+#endif
+    }
+
+private:
+    FILE *m_results = nullptr;
+};
+
+/**
+ * @brief Prebuilt message texts, so only the handler is measured.
+ */
+static std::vector<QString> makeMessages(int count)
+{
+    std::vector<QString> messages;
+    messages.reserve(size_t(count));
+    for (int i = 0; i < count; ++i)
+        messages.push_back(QString("frame 0x18FEF100 decoded, value %1").arg(i));
+    return messages;
+}
+
+static qint64 percentile(const std::vector<qint64> &sorted, double fraction)
+{
+    if (sorted.empty())
+        return 0;
+    const size_t index = std::min(sorted.size() - 1, size_t(double(sorted.size()) * fraction));
+    return sorted[index];
+}
+
+static qint64 bytesOnDisk(const QString &dir)
+{
+    qint64 bytes = 0;
+    const QFileInfoList files = QDir(dir).entryInfoList(QDir::Files);
+    for (const QFileInfo &file : files)
+        bytes += file.size();
+    return bytes;
+}
+
+/**
+ * @brief Runs one configuration and prints its result line.
+ */
+static void runBenchmark(const RunConfig &config, const std::vector<QString> &messages,
+                         const QString &dir, StdoutRedirect &redirect)
+{
+    cLogger &logger = cLogger::instance();
+    const bool binary = config.sink == "binary";
+    logger.setAsync(config.sink == "async");
+    logger.setEnableTimeStamp(config.timestamps);
+    logger.setEchoToStandardOut(config.echo);
+    // Without rollover the limit is out of reach, so the rotator stays idle
+    logger.setLogRotation(config.rollover ? ROLLOVER_BYTES : qint64(1) << 40, 3);
+    logger.setBinaryCategories(binary ? QStringList{ "ngbench.binary" } : QStringList());
+    QDir().mkpath(dir);
+    logger.setLogFilePath(dir + "/bench.log");
+    const int rotationsBefore = logger.rotationCount();
+    const quint64 droppedBefore = logger.droppedMessageCount();
+
+    const int total = int(messages.size());
+    const int perThread = total / config.threads;
+    std::vector<std::vector<qint64>> latencies(size_t(config.threads));
+    for (std::vector<qint64> &thread : latencies)
+        thread.resize(size_t(perThread));
+
+    std::atomic<int> ready{0};
+    std::atomic<bool> go{false};
+    std::vector<QThread *> producers;
+    for (int t = 0; t < config.threads; ++t) {
+        std::vector<qint64> *latency = &latencies[size_t(t)];
+        QThread *producer = QThread::create([&, t, latency]() {
+            const QMessageLogContext context(__FILE__, __LINE__, Q_FUNC_INFO, "default");
+            const int first = t * perThread;
+            ready.fetch_add(1);
+            while (!go.load())
+                QThread::yieldCurrentThread();
+            for (int i = 0; i < perThread; ++i) {
+                const qint64 start = nowNs();
+                if (binary)
+                    NG_BINLOG(lcBenchBinary, QtDebugMsg, "frame 0x%08x decoded, value %d", 0x18FEF100u, first + i);
+                else
+                    cLogger::messageHandler(QtDebugMsg, context, messages[size_t(first + i)]);
+                (*latency)[size_t(i)] = nowNs() - start;
+            }
+        });
+        producer->setObjectName(QString("Producer%1").arg(t));
+        producers.push_back(producer);
+    }
+
+    redirect.silence(config.echo);
+    for (QThread *producer : producers)
+        producer->start();
+    while (ready.load() < config.threads)
+        QThread::yieldCurrentThread();
+
+    const quint64 allocationsBefore = g_allocations.load();
+    QElapsedTimer timer;
+    timer.start();
+    go.store(true);
+    for (QThread *producer : producers)
+        producer->wait();
+    const qint64 producerNs = timer.nsecsElapsed();
+    logger.flush();
+    BinLog::flush();
+    const qint64 totalNs = timer.nsecsElapsed();
+    const quint64 allocations = g_allocations.load() - allocationsBefore;
+    redirect.silence(false);
+    qDeleteAll(producers);
+
+    std::vector<qint64> all;
+    all.reserve(size_t(perThread) * size_t(config.threads));
+    for (const std::vector<qint64> &thread : latencies)
+        all.insert(all.end(), thread.begin(), thread.end());
+    std::sort(all.begin(), all.end());
+    const int logged = int(all.size());
+
+    fprintf(redirect.results(),
+            "{\"run\":\"%s\",\"threads\":%d,\"timestamps\":%d,\"echo\":%d,\"rollover\":%d,"
+            "\"messages\":%d,\"msgs_per_s\":%.0f,\"producer_msgs_per_s\":%.0f,"
+            "\"latency_p50_ns\":%lld,\"latency_p99_ns\":%lld,\"latency_p999_ns\":%lld,\"latency_max_ns\":%lld,"
+            "\"allocs_per_msg\":%.2f,\"bytes_on_disk\":%lld,\"rotations\":%d,\"dropped\":%llu}\n",
+            qPrintable(config.sink), config.threads, int(config.timestamps), int(config.echo),
+            int(config.rollover), logged, logged * 1e9 / double(qMax<qint64>(1, totalNs)),
+            logged * 1e9 / double(qMax<qint64>(1, producerNs)),
+            static_cast<long long>(percentile(all, 0.50)), static_cast<long long>(percentile(all, 0.99)),
+            static_cast<long long>(percentile(all, 0.999)), static_cast<long long>(all.empty() ? 0 : all.back()),
+            double(allocations) / qMax(1, logged), static_cast<long long>(bytesOnDisk(dir)),
+            logger.rotationCount() - rotationsBefore,
+            static_cast<unsigned long long>(logger.droppedMessageCount() - droppedBefore));
+    fflush(redirect.results());
+}
+
+static QStringList splitList(const QString &value)
+{
+    QStringList parts;
+    for (const QString &part : value.split(',')) {
+        if (!part.trimmed().isEmpty())
+            parts.append(part.trimmed());
+    }
+    return parts;
+}
+
+int main(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+
+    int count = 200000;
+    QList<int> threadCounts = { 1, 2, 4, 8 };
+    QStringList sinks = { "sync", "async", "binary" };
+    const QStringList args = app.arguments();
+    for (int i = 1; i < args.size(); ++i) {
+        if (args.at(i) == "--messages" && i + 1 < args.size()) {
+            count = qMax(1, args.at(++i).toInt());
+        } else if (args.at(i) == "--threads" && i + 1 < args.size()) {
+            threadCounts.clear();
+            for (const QString &value : splitList(args.at(++i)))
+                threadCounts.append(qBound(1, value.toInt(), 64));
+        } else if (args.at(i) == "--sinks" && i + 1 < args.size()) {
+            sinks = splitList(args.at(++i));
+        } else {
+            fprintf(stderr, "unknown argument: %s\n", qPrintable(args.at(i)));
+            return 2;
+        }
+    }
+
+    QTemporaryDir dir;
+    if (!dir.isValid() || !cLogger::instance().init("BenchCLogger")) {
+        fprintf(stderr, "cannot initialise the logger\n");
+        return 1;
+    }
+    cLogger &logger = cLogger::instance();
+    logger.setLoggerLevel(QtDebugMsg, "NextGenApp");
+    logger.setQueueCapacity(65536);
+    logger.setOverflowPolicy(cLogger::OverflowBlock);
+
+    StdoutRedirect redirect;
+    const std::vector<QString> messages = makeMessages(count);
+    int run = 0;
+    for (const QString &sink : sinks) {
+        if (sink != "sync" && sink != "async" && sink != "binary") {
+            fprintf(stderr, "unknown sink: %s\n", qPrintable(sink));
+            return 2;
+        }
+        for (int threads : threadCounts) {
+            QList<RunConfig> configs;
+            RunConfig base;
+            base.sink = sink;
+            base.threads = threads;
+            configs.append(base);
+            // Binary records carry neither text time stamps nor echo
+            if (sink != "binary") {
+                RunConfig noTimestamps = base;
+                noTimestamps.timestamps = false;
+                RunConfig echo = base;
+                echo.echo = true;
+                RunConfig rollover = base;
+                rollover.rollover = true;
+                configs << noTimestamps << echo << rollover;
+            }
+            for (const RunConfig &config : configs)
+                runBenchmark(config, messages, dir.filePath(QString("run%1").arg(++run)), redirect);
+        }
+    }
+    logger.setAsync(false);
+    return 0;
+}
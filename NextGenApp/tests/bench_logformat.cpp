@@ -0,0 +1,187 @@
+/**
+ * @file bench_logformat.cpp
+ * @brief Formatting cost benchmark for cLogger lines.
+ *
+ * Global operator new is replaced to count heap allocations. Three runs
+ * format the same messages (a short text with a number, on a named
+ * thread, a new second every 1000 messages):
+ *
+ * - "qstring": the previous pipeline, QDateTime::toString() and
+ *   QString::arg() per field, then toUtf8() for the file and
+ *   toLocal8Bit() for stdout
+ * - "formatter": LogLineFormatter building the UTF-8 line once
+ * - "clogger": cLogger::messageHandler() writing to a file in a
+ *   temporary directory (synchronous mode, no stdout echo)
+ *
+ * One JSON object is printed per run:
+ *
+ * @code
+ * {"run":"formatter","messages":200000,"ns_per_msg":95.3,"allocs_per_msg":0.00}
+ * @endcode
+ *
+ * Usage:
+ * @code
+ * ./bench_logformat [--messages N]
+ * @endcode
+ *
+ * @author Gangadhar Thalange
+ * @date 2026-10-18
+ */
+
+#include <QCoreApplication>
+#include <QDateTime>
+#include <QElapsedTimer>
+#include <QStringList>
+#include <QTemporaryDir>
+#include <QThread>
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+#include <vector>
+#include "clogger.h"
+#include "logformat.h"
+
+static std::atomic<quint64> g_allocations{0};
+
+void *operator new(size_t size)
+{
+    g_allocations.fetch_add(1, std::memory_order_relaxed);
+    if (void *p = std::malloc(size ? size : 1))
+        return p;
+    throw std::bad_alloc();
+}
+
+void operator delete(void *p) noexcept
+{
+    std::free(p);
+}
+
+void operator delete(void *p, size_t) noexcept
+{
+    std::free(p);
+}
+
+static constexpr qint64 START_MS = 1792300000000LL;
+
+/**
+ * @brief Prebuilt message texts, so only formatting is measured.
+ */
+static std::vector<QString> makeMessages(int count)
+{
+    std::vector<QString> messages;
+    messages.reserve(size_t(count));
+    for (int i = 0; i < count; ++i)
+        messages.push_back(QString("frame 0x18FEF100 decoded, value %1").arg(i));
+    return messages;
+}
+
+static void printResult(const char *run, int messages, qint64 ns, quint64 allocations)
+{
+    printf("{\"run\":\"%s\",\"messages\":%d,\"ns_per_msg\":%.1f,\"allocs_per_msg\":%.2f}\n",
+           run, messages, double(ns) / messages, double(allocations) / messages);
+    fflush(stdout);
+}
+
+/**
+ * @brief Previous pipeline: QString fields, encoded once per sink.
+ */
+static void runQString(const std::vector<QString> &messages)
+{
+    const QString threadName = "Ingest";
+    qint64 bytes = 0;
+    const quint64 before = g_allocations.load();
+    QElapsedTimer timer;
+    timer.start();
+    for (size_t i = 0; i < messages.size(); ++i) {
+        const QString timestamp = QDateTime::fromMSecsSinceEpoch(START_MS + qint64(i), Qt::UTC)
+                .toString("[yyyy/MM/dd HH:mm:ss.zzz]");
+        const QString logMessage = QString("%1 [%2 %3 %4] %5").arg(timestamp).arg("DEB").arg("App")
+                .arg(threadName).arg(messages[i]);
+        bytes += logMessage.toUtf8().size() + logMessage.toLocal8Bit().size();
+    }
+    const qint64 ns = timer.nsecsElapsed();
+    printResult("qstring", int(messages.size()), ns, g_allocations.load() - before);
+    if (bytes == 0)
+        fprintf(stderr, "no output\n");
+}
+
+/**
+ * @brief LogLineFormatter, as used by cLogger::writeRecord().
+ */
+static void runFormatter(const std::vector<QString> &messages)
+{
+    const QString threadName = "Ingest";
+    LogLineFormatter line;
+    qint64 bytes = 0;
+    const quint64 before = g_allocations.load();
+    QElapsedTimer timer;
+    timer.start();
+    for (size_t i = 0; i < messages.size(); ++i) {
+        const QString &msg = messages[i];
+        line.clear();
+        line.appendTimestamp(START_MS + qint64(i));
+        line.append(" [DEB App ");
+        line.appendUtf16(reinterpret_cast<const char16_t *>(threadName.utf16()), size_t(threadName.size()));
+        line.append("] ");
+        line.appendUtf16(reinterpret_cast<const char16_t *>(msg.utf16()), size_t(msg.size()));
+        line.append('\n');
+        bytes += qint64(line.size());
+    }
+    const qint64 ns = timer.nsecsElapsed();
+    printResult("formatter", int(messages.size()), ns, g_allocations.load() - before);
+    if (bytes == 0)
+        fprintf(stderr, "no output\n");
+}
+
+/**
+ * @brief Full synchronous message handler writing to a log file.
+ */
+static void runLogger(const std::vector<QString> &messages, const QString &path)
+{
+    cLogger &logger = cLogger::instance();
+    logger.setLogFilePath(path);
+    const QMessageLogContext context(__FILE__, __LINE__, Q_FUNC_INFO, "default");
+
+    const quint64 before = g_allocations.load();
+    QElapsedTimer timer;
+    timer.start();
+    for (const QString &msg : messages)
+        cLogger::messageHandler(QtDebugMsg, context, msg);
+    const qint64 ns = timer.nsecsElapsed();
+    printResult("clogger", int(messages.size()), ns, g_allocations.load() - before);
+}
+
+int main(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+    QThread::currentThread()->setObjectName("Ingest");
+
+    int count = 200000;
+    const QStringList args = app.arguments();
+    for (int i = 1; i < args.size(); ++i) {
+        if (args.at(i) == "--messages" && i + 1 < args.size()) {
+            count = qMax(1, args.at(++i).toInt());
+        } else {
+            fprintf(stderr, "unknown argument: %s\n", qPrintable(args.at(i)));
+            return 2;
+        }
+    }
+
+    QTemporaryDir dir;
+    if (!dir.isValid() || !cLogger::instance().init("BenchLogFormat")) {
+        fprintf(stderr, "cannot initialise the logger\n");
+        return 1;
+    }
+    cLogger::instance().setEchoToStandardOut(false);
+    cLogger::instance().setAsync(false);
+    cLogger::instance().setLoggerLevel(QtDebugMsg, "NextGenApp");
+    // Keep the rotator (and its compression buffers) out of the measurement
+    cLogger::instance().setLogRotation(qint64(1) << 40, 1);
+
+    const std::vector<QString> messages = makeMessages(count);
+    runQString(messages);
+    runFormatter(messages);
+    runLogger(messages, dir.filePath("bench.log"));
+    return 0;
+}
@@ -0,0 +1,219 @@
+/**
+ * @file bench_logsubscribers.cpp
+ * @brief Delivery latency benchmark for cLogger log line consumers.
+ *
+ * Four threads log as fast as they can through the asynchronous cLogger
+ * while two consumers read every line. Each message carries the time it
+ * was logged; a consumer records the time from qDebug() to its handler.
+ * Two runs:
+ *
+ * - "signal": two slots connected to newLogMessages with
+ *   Qt::DirectConnection, the way consumers were attached before batches
+ *   existed (they run on the writer thread and get QStrings)
+ * - "subscribers": two cLogger::subscribe() handlers, each on its own
+ *   consumer QThread, sharing the immutable batches
+ *
+ * One JSON object is printed per run:
+ *
+ * @code
+ * {"run":"subscribers","threads":4,"subscribers":2,"messages":400000,"producer_ns_per_msg":310.2,"latency_p50_us":812.0,"latency_p99_us":6120.5,"latency_max_us":9950.1}
+ * @endcode
+ *
+ * For the numbers before batched delivery, build the "signal" run from the
+ * previous revision of clogger.cpp (per-line QStrings, signal emitted under
+ * the log lock every 10 lines).
+ *
+ * Usage:
+ * @code
+ * ./bench_logsubscribers [--messages N]
+ * @endcode
+ *
+ * @author Gangadhar Thalange
+ * @date 2026-10-18
+ */
+
+#include <QCoreApplication>
+#include <QElapsedTimer>
+#include <QMutex>
+#include <QStringList>
+#include <QTemporaryDir>
+#include <QThread>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <thread>
+#include <vector>
+#include "clogger.h"
+
+static constexpr int PRODUCERS = 4;
+static constexpr int CONSUMERS = 2;
+
+static qint64 nowNs()
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+/**
+ * @brief Latencies seen by one consumer.
+ */
+struct Consumer {
+    QMutex mutex;
+    std::vector<qint64> latenciesNs;
+    std::atomic<int> received{0};
+
+    /**
+     * @brief Records one line if it is a benchmark message.
+     */
+    void take(const QString &text, qint64 now)
+    {
+        const int at = text.indexOf(QLatin1String("bench-msg "));
+        if (at < 0)
+            return;
+        const qint64 sent = text.mid(at + 10).section(' ', 1, 1).toLongLong();
+        QMutexLocker locker(&mutex);
+        latenciesNs.push_back(now - sent);
+        received.fetch_add(1, std::memory_order_relaxed);
+    }
+};
+
+static double percentileUs(std::vector<qint64> &values, double fraction)
+{
+    if (values.empty())
+        return 0.0;
+    const size_t index = std::min(values.size() - 1, size_t(fraction * double(values.size())));
+    std::nth_element(values.begin(), values.begin() + long(index), values.end());
+    return double(values[index]) / 1000.0;
+}
+
+/**
+ * @brief Logs @p perThread messages from each producer thread and waits
+ *        until every consumer has seen all of them.
+ */
+static void runProducers(const char *run, int perThread, Consumer *consumers)
+{
+    QElapsedTimer timer;
+    timer.start();
+    std::vector<std::thread> producers;
+    for (int t = 0; t < PRODUCERS; ++t) {
+        producers.emplace_back([t, perThread]() {
+            for (int i = 0; i < perThread; ++i)
+                qDebug("bench-msg %d %lld %d", t, static_cast<long long>(nowNs()), i);
+        });
+    }
+    for (std::thread &producer : producers)
+        producer.join();
+    const qint64 producerNs = timer.nsecsElapsed();
+
+    cLogger::instance().flush();
+    const int total = PRODUCERS * perThread;
+    QElapsedTimer wait;
+    wait.start();
+    for (int c = 0; c < CONSUMERS; ++c) {
+        while (consumers[c].received.load() < total && wait.elapsed() < 30000) {
+            QCoreApplication::processEvents();
+            QThread::msleep(1);
+        }
+    }
+
+    std::vector<qint64> all;
+    for (int c = 0; c < CONSUMERS; ++c) {
+        QMutexLocker locker(&consumers[c].mutex);
+        all.insert(all.end(), consumers[c].latenciesNs.begin(), consumers[c].latenciesNs.end());
+    }
+    if (int(all.size()) != total * CONSUMERS)
+        fprintf(stderr, "%s: %d of %d lines delivered\n", run, int(all.size()), total * CONSUMERS);
+
+    const double p50 = percentileUs(all, 0.50);
+    const double p99 = percentileUs(all, 0.99);
+    const double max = all.empty() ? 0.0 : double(*std::max_element(all.begin(), all.end())) / 1000.0;
+    printf("{\"run\":\"%s\",\"threads\":%d,\"subscribers\":%d,\"messages\":%d,\"producer_ns_per_msg\":%.1f,"
+           "\"latency_p50_us\":%.1f,\"latency_p99_us\":%.1f,\"latency_max_us\":%.1f}\n",
+           run, PRODUCERS, CONSUMERS, total, double(producerNs) / total, p50, p99, max);
+    fflush(stdout);
+}
+
+/**
+ * @brief Consumers as direct-connected newLogMessages slots.
+ */
+static void runSignal(int perThread)
+{
+    Consumer consumers[CONSUMERS];
+    std::vector<QMetaObject::Connection> connections;
+    for (int c = 0; c < CONSUMERS; ++c) {
+        Consumer *consumer = &consumers[c];
+        connections.push_back(QObject::connect(&cLogger::instance(), &cLogger::newLogMessages,
+                [consumer](const QList<QString> &msgs) {
+                    const qint64 now = nowNs();
+                    for (const QString &msg : msgs)
+                        consumer->take(msg, now);
+                }));
+    }
+    runProducers("signal", perThread, consumers);
+    for (const QMetaObject::Connection &connection : connections)
+        QObject::disconnect(connection);
+}
+
+/**
+ * @brief Consumers as subscribe() handlers on their own threads.
+ */
+static void runSubscribers(int perThread)
+{
+    Consumer consumers[CONSUMERS];
+    QThread threads[CONSUMERS];
+    QObject *contexts[CONSUMERS];
+    int ids[CONSUMERS];
+    for (int c = 0; c < CONSUMERS; ++c) {
+        threads[c].start();
+        contexts[c] = new QObject;
+        contexts[c]->moveToThread(&threads[c]);
+        Consumer *consumer = &consumers[c];
+        ids[c] = cLogger::instance().subscribe(contexts[c], [consumer](const LogBatchPtr &batch) {
+            const qint64 now = nowNs();
+            for (int i = 0; i < batch->size(); ++i)
+                consumer->take(batch->message(i), now);
+        });
+    }
+    runProducers("subscribers", perThread, consumers);
+    for (int c = 0; c < CONSUMERS; ++c) {
+        cLogger::instance().unsubscribe(ids[c]);
+        QMetaObject::invokeMethod(contexts[c], &QObject::deleteLater);
+        threads[c].quit();
+        threads[c].wait();
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+
+    int count = 400000;
+    const QStringList args = app.arguments();
+    for (int i = 1; i < args.size(); ++i) {
+        if (args.at(i) == "--messages" && i + 1 < args.size()) {
+            count = qMax(PRODUCERS, args.at(++i).toInt());
+        } else {
+            fprintf(stderr, "unknown argument: %s\n", qPrintable(args.at(i)));
+            return 2;
+        }
+    }
+
+    QTemporaryDir dir;
+    if (!dir.isValid() || !cLogger::instance().init("BenchLogSubscribers")) {
+        fprintf(stderr, "cannot initialise the logger\n");
+        return 1;
+    }
+    cLogger::instance().setEchoToStandardOut(false);
+    cLogger::instance().setLoggerLevel(QtDebugMsg, "NextGenApp");
+    cLogger::instance().setLogRotation(qint64(1) << 40, 1);
+    cLogger::instance().setLogFilePath(dir.filePath("bench.log"));
+    cLogger::instance().setOverflowPolicy(cLogger::OverflowBlock);
+    cLogger::instance().setAsync(true);
+
+    runSignal(count / PRODUCERS);
+    runSubscribers(count / PRODUCERS);
+
+    cLogger::instance().setAsync(false);
+    return 0;
+}
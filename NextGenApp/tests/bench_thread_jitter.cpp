@@ -0,0 +1,176 @@
+/**
+ * @file bench_thread_jitter.cpp
+ * @brief Wakeup jitter benchmark for ThreadConfig.
+ *
+ * Runs a 1 ms periodic loop (clock_nanosleep with TIMER_ABSTIME, as a
+ * stand-in for the ingest thread) while CPU-bound hog threads load every
+ * core, once with default scheduling and once with the requested
+ * ThreadConfig. Lateness of each wakeup relative to its deadline is
+ * reported as one JSON object per run:
+ *
+ * @code
+ * {"run":"default","samples":5000,"min_us":3,"avg_us":61,"p99_us":840,"max_us":4120,...}
+ * @endcode
+ *
+ * Usage:
+ * @code
+ * ./bench_thread_jitter [--cpu N] [--policy fifo|rr|other] [--priority P]
+ *                       [--lock-memory] [--samples N] [--hogs N]
+ * @endcode
+ *
+ * Real-time policies need CAP_SYS_NICE (or an rtprio limit); without it
+ * the configured run falls back to default scheduling and lists the
+ * error in its output.
+ *
+ * @author Gangadhar Thalange
+ * @date 2026-10-18
+ */
+
+#include <QCoreApplication>
+#include <QStringList>
+#include <QThread>
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <thread>
+#include <vector>
+#include <time.h>
+#include "threadconfig.h"
+
+/**
+ * @brief Result of one measurement run, lateness in microseconds.
+ */
+struct JitterResult {
+    int samples = 0;
+    qint64 minUs = 0;
+    qint64 avgUs = 0;
+    qint64 p99Us = 0;
+    qint64 maxUs = 0;
+    ThreadConfig::Effective effective;
+};
+
+static qint64 toNs(const timespec &ts)
+{
+    return qint64(ts.tv_sec) * 1000000000LL + ts.tv_nsec;
+}
+
+static timespec fromNs(qint64 ns)
+{
+    timespec ts;
+    ts.tv_sec = time_t(ns / 1000000000LL);
+    ts.tv_nsec = long(ns % 1000000000LL);
+    return ts;
+}
+
+/**
+ * @brief Runs the periodic loop on a fresh thread with the given config.
+ */
+static JitterResult measure(const ThreadConfig &config, int samples, int hogs)
+{
+    std::atomic<bool> stopHogs{false};
+    std::vector<std::thread> hogThreads;
+    for (int i = 0; i < hogs; ++i) {
+        hogThreads.emplace_back([&stopHogs]() {
+            volatile quint64 sink = 0;
+            while (!stopHogs.load(std::memory_order_relaxed))
+                sink = sink + 1;
+        });
+    }
+
+    JitterResult result;
+    std::vector<qint64> lateness;
+    lateness.reserve(size_t(samples));
+
+    std::thread worker([&]() {
+        result.effective = config.apply();
+
+        constexpr qint64 PERIOD_NS = 1000000;
+        timespec now;
+        clock_gettime(CLOCK_MONOTONIC, &now);
+        qint64 deadline = toNs(now) + PERIOD_NS;
+
+        for (int i = 0; i < samples; ++i) {
+            const timespec target = fromNs(deadline);
+            clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &target, nullptr);
+            clock_gettime(CLOCK_MONOTONIC, &now);
+            lateness.push_back(toNs(now) - deadline);
+            deadline += PERIOD_NS;
+        }
+    });
+    worker.join();
+
+    stopHogs = true;
+    for (std::thread &t : hogThreads)
+        t.join();
+
+    std::sort(lateness.begin(), lateness.end());
+    qint64 sum = 0;
+    for (qint64 ns : lateness)
+        sum += ns;
+
+    result.samples = int(lateness.size());
+    if (!lateness.empty()) {
+        result.minUs = lateness.front() / 1000;
+        result.avgUs = sum / qint64(lateness.size()) / 1000;
+        result.p99Us = lateness[size_t(double(lateness.size() - 1) * 0.99)] / 1000;
+        result.maxUs = lateness.back() / 1000;
+    }
+    return result;
+}
+
+static void printResult(const char *run, const JitterResult &r)
+{
+    QString errors = r.effective.errors.join("; ");
+    errors.replace('"', '\'');
+    printf("{\"run\":\"%s\",\"samples\":%d,\"min_us\":%lld,\"avg_us\":%lld,"
+           "\"p99_us\":%lld,\"max_us\":%lld,\"cpu\":%d,\"policy\":\"%s\","
+           "\"priority\":%d,\"memory_locked\":%s,\"errors\":\"%s\"}\n",
+           run, r.samples, (long long)r.minUs, (long long)r.avgUs,
+           (long long)r.p99Us, (long long)r.maxUs, r.effective.cpu,
+           qPrintable(ThreadConfig::policyName(r.effective.policy)),
+           r.effective.priority, r.effective.memoryLocked ? "true" : "false",
+           qPrintable(errors));
+    fflush(stdout);
+}
+
+int main(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+
+    ThreadConfig config;
+    config.policy = ThreadConfig::PolicyFifo;
+    config.priority = 50;
+    int samples = 5000;
+    int hogs = std::max(1, QThread::idealThreadCount());
+
+    const QStringList args = app.arguments();
+    for (int i = 1; i < args.size(); ++i) {
+        const QString &arg = args.at(i);
+        const QString value = i + 1 < args.size() ? args.at(i + 1) : QString();
+        if (arg == "--cpu") {
+            config.cpu = value.toInt();
+            ++i;
+        } else if (arg == "--policy") {
+            config.policy = ThreadConfig::policyFromName(value);
+            ++i;
+        } else if (arg == "--priority") {
+            config.priority = value.toInt();
+            ++i;
+        } else if (arg == "--lock-memory") {
+            config.lockMemory = true;
+        } else if (arg == "--samples") {
+            samples = std::max(1, value.toInt());
+            ++i;
+        } else if (arg == "--hogs") {
+            hogs = std::max(0, value.toInt());
+            ++i;
+        } else {
+            fprintf(stderr, "unknown argument: %s\n", qPrintable(arg));
+            return 2;
+        }
+    }
+
+    printResult("default", measure(ThreadConfig(), samples, hogs));
+    printResult("configured", measure(config, samples, hogs));
+    return 0;
+}
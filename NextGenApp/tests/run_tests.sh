@@ -165,7 +165,14 @@ print_summary() {
     cd "$BUILD_DIR"
     
     echo "Test executables built:"
-    for test in test_appinterface test_clogger test_logmessagecontext test_helpers; do
+    for test in test_appinterface test_clogger test_cloggerasync test_cloggerrotation \
+                test_cloggerhistory test_logcategories test_logtrace test_logformat \
+                test_cloggerratelimit test_binlog test_flightrecorder \
+                test_cloggersubscribers test_logstreamserver test_alarmchannel \
+                test_logmessagecontext test_helpers test_settingsservice \
+                test_scheduler test_zmqreceiver test_capturerecorder \
+                test_replayframesource test_tripjournal test_tripcomputer \
+                test_signalgraph; do
         if [ -f "$test" ]; then
             print_success "  $test"
         else
@@ -0,0 +1,316 @@
+/**
+ * @file test_alarmchannel.cpp
+ * @brief Unit tests for the AlarmChannel alarm pipeline.
+ *
+ * A lambda stands in for the alarm consumer (the cloud uploader on the
+ * target). The tests cover:
+ * - Alarms are delivered in order on the channel's thread
+ * - A stopped channel delivers on the calling thread
+ * - A full queue drops and counts instead of blocking
+ * - Latency statistics and deadline misses
+ * - qCCritical(_alarm_) is delivered promptly while the normal log queue
+ *   is saturated and its producers are blocked
+ * - alarmRaised carries the origin of the alarm as a LogContext
+ *
+ * @author Gangadhar Thalange
+ * @date 2026-10-18
+ */
+
+#include <QtTest/QtTest>
+#include <QTemporaryDir>
+#include <QMutex>
+#include <QSemaphore>
+#include <atomic>
+#include <thread>
+#include <vector>
+#include "clogger.h"
+#include "alarmchannel.h"
+
+/**
+ * @class TestAlarmChannel
+ * @brief Test fixture for AlarmChannel and its use in cLogger.
+ */
+class TestAlarmChannel : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    /**
+     * @brief Installs the handler.
+     */
+    void initTestCase();
+
+    /**
+     * @brief Returns the logger to synchronous mode.
+     */
+    void cleanupTestCase();
+
+    /**
+     * @brief Verify alarms arrive in order on the channel thread.
+     */
+    void testDeliveryOrder();
+
+    /**
+     * @brief Verify a stopped channel delivers on the caller's thread.
+     */
+    void testStoppedChannel();
+
+    /**
+     * @brief Verify a full queue drops instead of blocking.
+     */
+    void testQueueFull();
+
+    /**
+     * @brief Verify latency percentiles and deadline misses.
+     */
+    void testStats();
+
+    /**
+     * @brief Verify alarms are not delayed by a saturated log queue.
+     */
+    void testAlarmWhileLogSaturated();
+
+    /**
+     * @brief Verify alarmRaised carries the alarm's origin.
+     */
+    void testAlarmContext();
+
+private:
+    static AlarmChannel::Alarm makeAlarm(const QString &message);
+
+    QTemporaryDir m_dir;
+};
+
+// =============================================================================
+// Helpers
+// =============================================================================
+
+AlarmChannel::Alarm TestAlarmChannel::makeAlarm(const QString &message)
+{
+    AlarmChannel::Alarm alarm;
+    alarm.utcMs = QDateTime::currentMSecsSinceEpoch();
+    alarm.context = LogContext::capture(__FILE__, Q_FUNC_INFO, __LINE__, "App");
+    alarm.message = message;
+    return alarm;
+}
+
+// =============================================================================
+// Setup / Teardown
+// =============================================================================
+
+void TestAlarmChannel::initTestCase()
+{
+    QVERIFY(m_dir.isValid());
+    QVERIFY(cLogger::instance().init("TestAlarmChannel"));
+    cLogger::instance().setEchoToStandardOut(false);
+    cLogger::instance().setLoggerLevel(QtDebugMsg, "NextGenApp");
+    cLogger::instance().setLogFilePath(m_dir.filePath("alarm.log"));
+}
+
+void TestAlarmChannel::cleanupTestCase()
+{
+    cLogger::instance().setAsync(false);
+}
+
+// =============================================================================
+// Tests
+// =============================================================================
+
+void TestAlarmChannel::testDeliveryOrder()
+{
+    AlarmChannel channel;
+    QMutex mutex;
+    QStringList received;
+    QThread *thread = nullptr;
+    channel.setConsumer([&](const AlarmChannel::Alarm &alarm) {
+        QMutexLocker locker(&mutex);
+        received.append(alarm.message);
+        thread = QThread::currentThread();
+    });
+    channel.start();
+    QVERIFY(channel.isRunning());
+
+    for (int i = 0; i < 100; ++i)
+        QVERIFY(channel.post(makeAlarm(QString("alarm %1").arg(i))));
+    QTRY_COMPARE(channel.stats().delivered, quint64(100));
+
+    QMutexLocker locker(&mutex);
+    QCOMPARE(received.size(), 100);
+    for (int i = 0; i < 100; ++i)
+        QCOMPARE(received.at(i), QString("alarm %1").arg(i));
+    QVERIFY(thread != QThread::currentThread());
+    locker.unlock();
+
+    channel.stop();
+    QVERIFY(!channel.isRunning());
+    QCOMPARE(channel.stats().posted, quint64(100));
+    QCOMPARE(channel.stats().dropped, quint64(0));
+}
+
+void TestAlarmChannel::testStoppedChannel()
+{
+    AlarmChannel channel;
+    QThread *thread = nullptr;
+    channel.setConsumer([&](const AlarmChannel::Alarm &) { thread = QThread::currentThread(); });
+    QVERIFY(channel.post(makeAlarm("inline")));
+    QCOMPARE(thread, QThread::currentThread());
+    QCOMPARE(channel.stats().delivered, quint64(1));
+}
+
+void TestAlarmChannel::testQueueFull()
+{
+    AlarmChannel channel(4);
+    QSemaphore entered;
+    QSemaphore release;
+    std::atomic<int> delivered{0};
+    channel.setConsumer([&](const AlarmChannel::Alarm &) {
+        entered.release();
+        release.acquire();
+        delivered.fetch_add(1);
+    });
+    channel.start();
+
+    // The first alarm holds the consumer, the next four fill the queue
+    QVERIFY(channel.post(makeAlarm("held")));
+    QVERIFY(entered.tryAcquire(1, 5000));
+    for (int i = 0; i < 4; ++i)
+        QVERIFY(channel.post(makeAlarm(QString("queued %1").arg(i))));
+
+    QElapsedTimer timer;
+    timer.start();
+    QVERIFY(!channel.post(makeAlarm("dropped")));
+    QVERIFY(timer.elapsed() < 1000);
+    QCOMPARE(channel.stats().dropped, quint64(1));
+
+    release.release(5);
+    QTRY_COMPARE(delivered.load(), 5);
+    channel.stop();
+    QCOMPARE(channel.stats().posted, quint64(5));
+}
+
+void TestAlarmChannel::testStats()
+{
+    AlarmChannel channel;
+    std::atomic<bool> slow{false};
+    channel.setConsumer([&](const AlarmChannel::Alarm &) {
+        if (slow.load())
+            QThread::msleep(5);
+    });
+    channel.setDeadlineUs(1000);
+    channel.start();
+
+    for (int i = 0; i < 200; ++i) {
+        QVERIFY(channel.post(makeAlarm("fast")));
+        if (i % 20 == 0)
+            QThread::msleep(1);
+    }
+    QTRY_COMPARE(channel.stats().delivered, quint64(200));
+    AlarmChannel::Stats stats = channel.stats();
+    QVERIFY(stats.p50Us <= stats.p99Us);
+    QVERIFY(stats.p99Us <= stats.maxUs);
+    QCOMPARE(stats.deadlineUs, qint64(1000));
+    const quint64 missesBefore = stats.deadlineMisses;
+
+    slow.store(true);
+    QVERIFY(channel.post(makeAlarm("slow")));
+    QTRY_COMPARE(channel.stats().delivered, quint64(201));
+    stats = channel.stats();
+    QCOMPARE(stats.deadlineMisses, missesBefore + 1);
+    QVERIFY(stats.maxUs >= 5000);
+
+    const QVariantMap map = stats.toVariantMap();
+    QCOMPARE(map.value("delivered").toULongLong(), quint64(201));
+    QVERIFY(map.contains("p99Us"));
+}
+
+void TestAlarmChannel::testAlarmWhileLogSaturated()
+{
+    cLogger &logger = cLogger::instance();
+    logger.setQueueCapacity(64);
+    logger.setOverflowPolicy(cLogger::OverflowBlock);
+    logger.setAsync(true);
+
+    // Stall the writer thread: newLogMessages runs on it for every batch
+    std::atomic<bool> stall{true};
+    QMetaObject::Connection slowReceiver = connect(&logger, &cLogger::newLogMessages, this,
+            [&](const QList<QString> &) {
+                while (stall.load())
+                    QThread::msleep(5);
+            }, Qt::DirectConnection);
+
+    std::atomic<bool> stop{false};
+    std::vector<std::thread> producers;
+    for (int t = 0; t < 4; ++t) {
+        producers.emplace_back([t, &stop]() {
+            for (int i = 0; !stop.load(); ++i)
+                qDebug("flood %d %d", t, i);
+        });
+    }
+    // Let the queue fill up and the producers block
+    QThread::msleep(200);
+
+    std::atomic<qint64> deliveredNs{0};
+    QMetaObject::Connection alarmReceiver = connect(&logger, &cLogger::postAlarmMessage, this,
+            [&](const QString &msg, const LogMessageContext &) {
+                if (msg.contains("saturated alarm"))
+                    deliveredNs.store(AlarmChannel::now());
+            }, Qt::DirectConnection);
+
+    const qint64 raisedNs = AlarmChannel::now();
+    // Outside the IMX6 build the alarm is also logged and this thread
+    // then blocks on the full queue like the producers; raise it from a
+    // thread of its own
+    std::thread raiser([]() { qCCritical(_alarm_) << "saturated alarm"; });
+
+    QTRY_VERIFY_WITH_TIMEOUT(deliveredNs.load() != 0, 2000);
+    const qint64 latencyMs = (deliveredNs.load() - raisedNs) / 1000000;
+    QVERIFY2(latencyMs < 100, qPrintable(QString("alarm took %1 ms").arg(latencyMs)));
+    QVERIFY(logger.alarmStats().delivered >= 1);
+
+    stall.store(false);
+    stop.store(true);
+    for (std::thread &producer : producers)
+        producer.join();
+    raiser.join();
+    disconnect(slowReceiver);
+    disconnect(alarmReceiver);
+    logger.flush();
+}
+
+void TestAlarmChannel::testAlarmContext()
+{
+    cLogger &logger = cLogger::instance();
+    QThread::currentThread()->setObjectName("AlarmRaiser");
+    QMutex mutex;
+    QString message;
+    LogContext origin;
+    QMetaObject::Connection receiver = connect(&logger, &cLogger::alarmRaised, this,
+            [&](const QString &msg, const LogContext &context) {
+                QMutexLocker locker(&mutex);
+                message = msg;
+                origin = context;
+            }, Qt::DirectConnection);
+
+    const int line = __LINE__ + 1;
+    qCCritical(_alarm_) << "context alarm";
+    const auto received = [&]() {
+        QMutexLocker locker(&mutex);
+        return message.contains("context alarm");
+    };
+    QTRY_VERIFY_WITH_TIMEOUT(received(), 2000);
+    disconnect(receiver);
+
+    QMutexLocker locker(&mutex);
+    QCOMPARE(origin.line, line);
+    QCOMPARE(origin.fileName(), QString(__FILE__));
+    QVERIFY(origin.functionName().contains("testAlarmContext"));
+    QCOMPARE(origin.threadName(), QString("AlarmRaiser"));
+    QCOMPARE(origin.moduleName(), QString("App"));
+}
+
+// =============================================================================
+// Test Entry Point
+// =============================================================================
+
+QTEST_MAIN(TestAlarmChannel)
+#include "test_alarmchannel.moc"
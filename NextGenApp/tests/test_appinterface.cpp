@@ -12,6 +12,8 @@
  * - Signal emissions for property changes
  * - Enum value validation (Telltale, GaugeType, SafetyButton)
  * - Vector initialization for telltales and gauges
+ * - Trip counters restored from the trip journal
+ * - Derived trip hours notify only when they change
  *
  * @note The AppInterface class uses ZMQ for inter-process communication.
  *       Tests use a static instance to avoid thread cleanup issues with
@@ -23,8 +25,10 @@
 
 #include <QtTest/QtTest>
 #include <QSignalSpy>
+#include <QTemporaryDir>
 #include <QVector>
 #include "appinterface.h"
+#include "constants.h"
 
 /**
  * @class TestAppInterface
@@ -338,6 +342,20 @@ private slots:
 
     void testCanCallProcessFrame();
 
+    // =========================================================================
+    // Trip Journal Tests
+    // =========================================================================
+
+    /**
+     * @brief Verify trip counters are restored from the trip journal.
+     */
+    void testTripJournalRestore();
+
+    /**
+     * @brief Verify tripHoursChanged is not emitted for an unchanged value.
+     */
+    void testTripHoursNotifiedOnlyOnChange();
+
 private:
     /**
      * @brief Pointer to the AppInterface instance under test.
@@ -812,6 +830,52 @@ void TestAppInterface::testCanCallProcessFrame()
     QVERIFY(true);
 }
 
+// =============================================================================
+// Trip Journal Tests
+// =============================================================================
+
+void TestAppInterface::testTripJournalRestore()
+{
+    // Separate instances: the shared one must keep its default counters
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    const QString path = dir.filePath("trip.journal");
+    {
+        AppInterface first;
+        QVERIFY(first.openTripJournal(path));
+        first.setLastResetDate("03/07/2026");
+        first.setLastTripHours(1250.5f);
+        first.setFuelUsage(42.0f);
+        first.setDefUsage(3.5f);
+    }   // The destructor writes the last state
+
+    AppInterface second;
+    QCOMPARE(second.lastResetDate(), LAST_RESET_DATE);
+    QSignalSpy spy(&second, &AppInterface::fuelUsageChanged);
+    QVERIFY(second.openTripJournal(path));
+    QCOMPARE(second.lastResetDate(), QString("03/07/2026"));
+    QCOMPARE(second.lastTripHours(), 1250.5f);
+    QCOMPARE(second.fuelUsage(), 42.0f);
+    QCOMPARE(second.defUsage(), 3.5f);
+    QCOMPARE(spy.count(), 1);
+
+    const QVariantMap journal = second.diagnostics().value("tripJournal").toMap();
+    QCOMPARE(journal.value("open").toBool(), true);
+    QCOMPARE(journal.value("path").toString(), path);
+}
+
+void TestAppInterface::testTripHoursNotifiedOnlyOnChange()
+{
+    // Engine hours are 0: every reset point at or above them keeps the
+    // derived trip hours at 0
+    QSignalSpy spy(m_appInterface, &AppInterface::tripHoursChanged);
+    m_appInterface->setLastTripHours(7.0f);
+    m_appInterface->setLastTripHours(8.0f);
+    QCOMPARE(spy.count(), 0);
+    QCOMPARE(m_appInterface->tripHours(), 0.0f);
+    m_appInterface->setLastTripHours(0.0f);
+}
+
 // =============================================================================
 // Test Entry Point
 // =============================================================================
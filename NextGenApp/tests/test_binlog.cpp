@@ -0,0 +1,368 @@
+/**
+ * @file test_binlog.cpp
+ * @brief Unit tests for the binary log sink (BinLog) and its decoder.
+ *
+ * Messages are logged with NG_BINLOG() through cLogger and read back with
+ * BinLogReader, as tools/binlog_decode does.
+ *
+ * The tests cover:
+ * - Varint/zigzag encoding and printf rendering of encoded arguments
+ * - Round trip of numbers, strings and doubles through the binary file
+ * - Decoded lines equal the text lines cLogger writes for the same call
+ * - Categories that are not selected are logged as text
+ * - Several sessions in one file and records from several threads
+ * - A truncated file is read up to the last complete block
+ *
+ * @author Gangadhar Thalange
+ * @date 2026-10-18
+ */
+
+#include <QtTest/QtTest>
+#include <QTemporaryDir>
+#include <QFile>
+#include <thread>
+#include <vector>
+#include "clogger.h"
+#include "binlog.h"
+#include "binlogreader.h"
+
+Q_LOGGING_CATEGORY(lcBinary, "test.binary")
+Q_LOGGING_CATEGORY(lcText, "test.text")
+
+/**
+ * @class TestBinLog
+ * @brief Test fixture for BinLog and BinLogReader.
+ */
+class TestBinLog : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    /**
+     * @brief Installs the handler.
+     */
+    void initTestCase();
+
+    /**
+     * @brief Deselects all binary categories, which closes the binary file.
+     */
+    void cleanup();
+
+    /**
+     * @brief Verify varints, zigzag and printf rendering of encoded arguments.
+     */
+    void testEncoding();
+
+    /**
+     * @brief Verify arguments survive the round trip through the file.
+     */
+    void testRoundTrip();
+
+    /**
+     * @brief Verify a decoded line equals the text line of the same call.
+     */
+    void testMatchesTextLine();
+
+    /**
+     * @brief Verify messages of other categories go to the text log.
+     */
+    void testTextFallback();
+
+    /**
+     * @brief Verify a reopened file holds two readable sessions.
+     */
+    void testSessions();
+
+    /**
+     * @brief Verify records of several threads are all decoded in time order.
+     */
+    void testThreads();
+
+    /**
+     * @brief Verify a file cut off mid-block is read up to the cut.
+     */
+    void testTruncated();
+
+private:
+    /**
+     * @brief Points the logger at a fresh file in the temporary directory.
+     */
+    QString useNewLogFile(const QString &name);
+
+    /**
+     * @brief Returns the lines of @p path that contain @p tag.
+     */
+    static QStringList linesWith(const QString &path, const QString &tag);
+
+    /**
+     * @brief One fixed call site, used in text and binary form.
+     */
+    static void logSample(int value);
+
+    QTemporaryDir m_dir;
+};
+
+// =============================================================================
+// Helpers
+// =============================================================================
+
+QString TestBinLog::useNewLogFile(const QString &name)
+{
+    const QString path = m_dir.filePath(name);
+    cLogger::instance().setLogFilePath(path);
+    return path;
+}
+
+QStringList TestBinLog::linesWith(const QString &path, const QString &tag)
+{
+    QStringList lines;
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly))
+        return lines;
+    while (!file.atEnd()) {
+        const QString line = QString::fromUtf8(file.readLine()).trimmed();
+        if (line.contains(tag))
+            lines.append(line);
+    }
+    return lines;
+}
+
+void TestBinLog::logSample(int value)
+{
+    NG_BINLOG(lcBinary, QtWarningMsg, "sample %d: %s %5.1f%% 0x%04x", value, "text", value / 2.0, unsigned(value));
+}
+
+// =============================================================================
+// Setup / Teardown
+// =============================================================================
+
+void TestBinLog::initTestCase()
+{
+    QVERIFY(m_dir.isValid());
+    QVERIFY(cLogger::instance().init("TestBinLog"));
+    cLogger::instance().setEchoToStandardOut(false);
+    cLogger::instance().setLoggerLevel(QtDebugMsg, "NextGenApp");
+}
+
+void TestBinLog::cleanup()
+{
+    cLogger::instance().setBinaryCategories(QStringList());
+    QVERIFY(BinLog::path().isEmpty());
+}
+
+// =============================================================================
+// Tests
+// =============================================================================
+
+void TestBinLog::testEncoding()
+{
+    std::string data;
+    for (int64_t value : { int64_t(0), int64_t(-1), int64_t(1), int64_t(-300), INT64_MAX, INT64_MIN })
+        BinLogFormat::putVarint(data, BinLogFormat::zigzag(value));
+    const uint8_t *pos = reinterpret_cast<const uint8_t *>(data.data());
+    const uint8_t *end = pos + data.size();
+    for (int64_t value : { int64_t(0), int64_t(-1), int64_t(1), int64_t(-300), INT64_MAX, INT64_MIN }) {
+        uint64_t encoded = 0;
+        QVERIFY(BinLogFormat::getVarint(pos, end, encoded));
+        QCOMPARE(qint64(BinLogFormat::unzigzag(encoded)), qint64(value));
+    }
+    QVERIFY(pos == end);
+
+    // Arguments as NG_BINLOG() encodes them: i, u, d, s
+    data.clear();
+    BinLogFormat::putVarint(data, BinLogFormat::zigzag(-42));
+    BinLogFormat::putVarint(data, 7);
+    const double real = 3.25;
+    BinLogFormat::putFixed(data, &real, sizeof(real));
+    BinLogFormat::putString(data, "abc", 3);
+    pos = reinterpret_cast<const uint8_t *>(data.data());
+    end = pos + data.size();
+    QByteArray text;
+    QVERIFY(BinLogReader::formatMessage("a=%ld b=%03hu c=%.2f s=%-4s| 100%%", "iuds", pos, end, text));
+    QCOMPARE(text, QByteArray("a=-42 b=007 c=3.25 s=abc | 100%"));
+    QVERIFY(pos == end);
+
+    // Arguments running past the end are an error
+    pos = reinterpret_cast<const uint8_t *>(data.data());
+    text.clear();
+    QVERIFY(!BinLogReader::formatMessage("%d %d %f %s %d", "iudsi", pos, end, text));
+}
+
+void TestBinLog::testRoundTrip()
+{
+    const QString path = useNewLogFile("roundtrip.log");
+    cLogger::instance().setBinaryCategories({ "test.binary" });
+    QCOMPARE(BinLog::path(), path + ".bin");
+
+    const quint64 before = BinLog::recordCount();
+    for (int i = 0; i < 100; ++i)
+        NG_BINLOG(lcBinary, QtDebugMsg, "round %d %u %s %.3f %c", -i, unsigned(i) * 1000000u,
+                  i % 2 ? "odd" : "even", i * 0.125, 'a' + i % 26);
+    cLogger::instance().flush();
+    QCOMPARE(BinLog::recordCount() - before, quint64(100));
+
+    // Nothing reached the text log
+    QVERIFY(linesWith(path, "round ").isEmpty());
+
+    BinLogReader reader;
+    QVERIFY2(reader.read(path + ".bin"), qPrintable(reader.errorString()));
+    QVERIFY(!reader.truncated());
+    QCOMPARE(reader.entries().size(), 100);
+    for (int i = 0; i < 100; ++i) {
+        const BinLogReader::Entry &entry = reader.entries().at(i);
+        const QByteArray expected = QString::asprintf("round %d %u %s %.3f %c", -i, unsigned(i) * 1000000u,
+                                                      i % 2 ? "odd" : "even", i * 0.125, 'a' + i % 26).toUtf8();
+        QCOMPARE(entry.message, expected);
+        QCOMPARE(entry.category, QByteArray("test.binary"));
+        QCOMPARE(entry.type, QtDebugMsg);
+        QVERIFY(entry.file.endsWith("test_binlog.cpp"));
+    }
+    // Times are close to now
+    const qint64 nowUs = QDateTime::currentMSecsSinceEpoch() * 1000;
+    QVERIFY(qAbs(nowUs - reader.entries().last().utcUs) < 60 * 1000000LL);
+}
+
+void TestBinLog::testMatchesTextLine()
+{
+    // The same call site, once as text and once in binary form
+    const QString textPath = useNewLogFile("text.log");
+    logSample(7);
+    cLogger::instance().flush();
+    const QStringList textLines = linesWith(textPath, "sample 7");
+    QCOMPARE(textLines.size(), 1);
+
+    const QString binaryPath = useNewLogFile("binary.log");
+    cLogger::instance().setBinaryCategories({ "test" });
+    logSample(7);
+    cLogger::instance().flush();
+    QVERIFY(linesWith(binaryPath, "sample 7").isEmpty());
+
+    BinLogReader reader;
+    QVERIFY2(reader.read(binaryPath + ".bin"), qPrintable(reader.errorString()));
+    QCOMPARE(reader.entries().size(), 1);
+    const QString decoded = QString::fromUtf8(reader.formatLine(reader.entries().first()));
+
+    // Everything after the time stamp is identical
+    const int stamp = int(LogLineFormatter::TIMESTAMP_SIZE);
+    QCOMPARE(decoded.mid(stamp), textLines.first().mid(stamp));
+    QVERIFY(decoded.contains(" [WAR App "));
+    QVERIFY(decoded.contains("sample 7: text   3.5% 0x0007 in "));
+}
+
+void TestBinLog::testTextFallback()
+{
+    const QString path = useNewLogFile("fallback.log");
+    cLogger::instance().setBinaryCategories({ "test.binary" });
+
+    NG_BINLOG(lcText, QtInfoMsg, "fallback %d", 1);
+    NG_BINLOG(lcText, QtInfoMsg, "fallback without arguments 100%");
+    NG_BINLOG(lcBinary, QtInfoMsg, "selected %d", 2);
+    cLogger::instance().flush();
+
+    QCOMPARE(linesWith(path, "fallback 1").size(), 1);
+    QCOMPARE(linesWith(path, "fallback without arguments 100%").size(), 1);
+    QVERIFY(linesWith(path, "selected").isEmpty());
+
+    BinLogReader reader;
+    QVERIFY2(reader.read(path + ".bin"), qPrintable(reader.errorString()));
+    QCOMPARE(reader.entries().size(), 1);
+    QCOMPARE(reader.entries().first().message, QByteArray("selected 2"));
+
+    // A prefix does not select a longer name that merely starts with it
+    cLogger::instance().setBinaryCategories({ "test.bin" });
+    NG_BINLOG(lcBinary, QtInfoMsg, "prefix %d", 3);
+    cLogger::instance().flush();
+    QCOMPARE(linesWith(path, "prefix 3").size(), 1);
+}
+
+void TestBinLog::testSessions()
+{
+    const QString path = useNewLogFile("sessions.log");
+    cLogger::instance().setBinaryCategories({ "test.binary" });
+    NG_BINLOG(lcBinary, QtDebugMsg, "first session %d", 1);
+
+    // Closing and reopening appends a new session with all formats
+    cLogger::instance().setBinaryCategories(QStringList());
+    cLogger::instance().setBinaryCategories({ "test.binary" });
+    NG_BINLOG(lcBinary, QtDebugMsg, "second session %d", 2);
+    NG_BINLOG(lcBinary, QtDebugMsg, "first session %d", 3);
+    cLogger::instance().flush();
+
+    BinLogReader reader;
+    QVERIFY2(reader.read(path + ".bin"), qPrintable(reader.errorString()));
+    QCOMPARE(reader.entries().size(), 3);
+    QCOMPARE(reader.entries().at(0).message, QByteArray("first session 1"));
+    QCOMPARE(reader.entries().at(1).message, QByteArray("second session 2"));
+    QCOMPARE(reader.entries().at(2).message, QByteArray("first session 3"));
+
+    QVERIFY(!reader.read(m_dir.filePath("missing.bin")));
+    QVERIFY(!reader.read(path));
+    QVERIFY(!reader.errorString().isEmpty());
+}
+
+void TestBinLog::testThreads()
+{
+    const QString path = useNewLogFile("threads.log");
+    cLogger::instance().setBinaryCategories({ "test.binary" });
+
+    const int threadCount = 4;
+    const int perThread = 5000;
+    std::vector<std::thread> threads;
+    for (int t = 0; t < threadCount; ++t) {
+        threads.emplace_back([t]() {
+            for (int i = 0; i < perThread; ++i)
+                NG_BINLOG(lcBinary, QtDebugMsg, "thread %d message %d", t, i);
+        });
+    }
+    for (std::thread &thread : threads)
+        thread.join();
+    cLogger::instance().flush();
+
+    BinLogReader reader;
+    QVERIFY2(reader.read(path + ".bin"), qPrintable(reader.errorString()));
+    QCOMPARE(reader.entries().size(), threadCount * perThread);
+
+    QVector<int> next(threadCount, 0);
+    qint64 lastUs = 0;
+    for (const BinLogReader::Entry &entry : reader.entries()) {
+        QVERIFY(entry.utcUs >= lastUs);
+        lastUs = entry.utcUs;
+        int t = -1;
+        int i = -1;
+        QCOMPARE(sscanf(entry.message.constData(), "thread %d message %d", &t, &i), 2);
+        QVERIFY(t >= 0 && t < threadCount);
+        // In order per thread
+        QCOMPARE(i, next[t]++);
+    }
+}
+
+void TestBinLog::testTruncated()
+{
+    const QString path = useNewLogFile("truncated.log");
+    cLogger::instance().setBinaryCategories({ "test.binary" });
+    for (int i = 0; i < 10; ++i) {
+        NG_BINLOG(lcBinary, QtDebugMsg, "before cut %d", i);
+        if (i == 4)
+            cLogger::instance().flush();
+    }
+    cLogger::instance().flush();
+    cLogger::instance().setBinaryCategories(QStringList());
+
+    QFile file(path + ".bin");
+    QVERIFY(file.open(QIODevice::ReadWrite));
+    QVERIFY(file.resize(file.size() - 3));
+    file.close();
+
+    BinLogReader reader;
+    QVERIFY2(reader.read(path + ".bin"), qPrintable(reader.errorString()));
+    QVERIFY(reader.truncated());
+    QCOMPARE(reader.entries().size(), 5);
+    QCOMPARE(reader.entries().last().message, QByteArray("before cut 4"));
+}
+
+// =============================================================================
+// Test Entry Point
+// =============================================================================
+
+QTEST_MAIN(TestBinLog)
+#include "test_binlog.moc"
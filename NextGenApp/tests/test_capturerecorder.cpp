@@ -0,0 +1,340 @@
+/**
+ * @file test_capturerecorder.cpp
+ * @brief Unit tests for the CaptureRecorder class.
+ *
+ * This file contains unit tests for the binary capture recorder tapping
+ * the ingest thread. Frames are fed through record() directly, as the
+ * ZMQ receive loop does, and the resulting file is checked against the
+ * layout in captureformat.h.
+ *
+ * The tests cover:
+ * - Header fields and record content
+ * - Flags for short and over-long messages
+ * - Segment rollover and the segment time index
+ * - A failed restart leaving an empty capture
+ * - Sustained recording at 100k frames/s without drops
+ * - Drop accounting when the writer cannot keep up
+ * - Inactive recorder ignoring frames
+ *
+ * @author Gangadhar Thalange
+ * @date 2026-10-18
+ */
+
+#include <QtTest/QtTest>
+#include <QTemporaryDir>
+#include <QElapsedTimer>
+#include <cstring>
+#include "capturerecorder.h"
+
+#ifdef Q_OS_LINUX
+#include <csignal>
+#include <sys/resource.h>
+#endif
+
+using Capture::CaptureHeader;
+using Capture::CaptureRecord;
+
+/**
+ * @class TestCaptureRecorder
+ * @brief Test fixture for CaptureRecorder unit tests.
+ */
+class TestCaptureRecorder : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    // =========================================================================
+    // Format Tests
+    // =========================================================================
+
+    /**
+     * @brief Verify header fields and record content of a small capture.
+     */
+    void testWritesHeaderAndRecords();
+
+    /**
+     * @brief Verify short and long messages are flagged.
+     */
+    void testFlagsMalformedMessages();
+
+    /**
+     * @brief Verify frames are ignored while no capture runs.
+     */
+    void testInactiveIgnoresFrames();
+
+    // =========================================================================
+    // Segment Tests
+    // =========================================================================
+
+    /**
+     * @brief Verify records continue in new segments and are indexed.
+     */
+    void testSegmentRollover();
+
+    /**
+     * @brief Verify a restart that cannot map its first segment leaves an
+     *        empty capture rather than the previous record count.
+     */
+    void testFailedRestartLeavesEmptyCapture();
+
+    // =========================================================================
+    // Throughput Tests
+    // =========================================================================
+
+    /**
+     * @brief Verify 100k frames/s are recorded for one second without drops.
+     */
+    void testSustains100kFramesPerSecond();
+
+    /**
+     * @brief Verify frames beyond the ring capacity are counted as dropped.
+     */
+    void testOverflowIsCounted();
+
+private:
+    /**
+     * @brief Feeds one 12-byte frame to the recorder.
+     */
+    static void feed(CaptureRecorder &recorder, uint32_t id, uint8_t value);
+
+    /**
+     * @brief Reads a capture file into memory.
+     */
+    static QByteArray readFile(const QString &path);
+
+    QTemporaryDir m_dir;
+};
+
+// =============================================================================
+// Helpers
+// =============================================================================
+
+void TestCaptureRecorder::feed(CaptureRecorder &recorder, uint32_t id, uint8_t value)
+{
+    char frame[12] = {};
+    memcpy(frame, &id, sizeof(id));
+    frame[4] = char(value);
+    frame[11] = char(value);
+    recorder.record(frame, sizeof(frame));
+}
+
+QByteArray TestCaptureRecorder::readFile(const QString &path)
+{
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly))
+        return QByteArray();
+    return file.readAll();
+}
+
+// =============================================================================
+// Format Tests
+// =============================================================================
+
+void TestCaptureRecorder::testWritesHeaderAndRecords()
+{
+    // Three frames produce a header page plus three records, nothing more
+    const QString path = m_dir.filePath("basic.ngcap");
+    CaptureRecorder recorder;
+    QVERIFY(recorder.start(path));
+    QVERIFY(recorder.isActive());
+
+    feed(recorder, 0xDE005000, 1);
+    feed(recorder, 0xDE001001, 2);
+    feed(recorder, 0xDE005000, 3);
+    recorder.stop();
+
+    QVERIFY(!recorder.isActive());
+    QCOMPARE(recorder.recordedCount(), quint64(3));
+
+    const QByteArray data = readFile(path);
+    QCOMPARE(data.size(), int(Capture::CAPTURE_HEADER_SIZE + 3 * sizeof(CaptureRecord)));
+
+    CaptureHeader header;
+    memcpy(&header, data.constData(), sizeof(header));
+    QVERIFY(Capture::isValidHeader(header));
+    QCOMPARE(header.recordCount, quint64(3));
+    QCOMPARE(header.droppedCount, quint64(0));
+    QCOMPARE(header.segmentCount, 1u);
+    QVERIFY(header.startWallMs > 0);
+
+    CaptureRecord records[3];
+    memcpy(records, data.constData() + Capture::CAPTURE_HEADER_SIZE, sizeof(records));
+    QCOMPARE(records[1].id, uint32_t(0xDE001001));
+    QCOMPARE(int(records[1].length), 8);
+    QCOMPARE(int(records[1].flags), 0);
+    QCOMPARE(int(records[1].payload[0]), 2);
+    QCOMPARE(int(records[1].payload[7]), 2);
+    QVERIFY(records[0].tNs <= records[1].tNs);
+    QVERIFY(records[1].tNs <= records[2].tNs);
+    QCOMPARE(header.segmentFirstNs[0], records[0].tNs);
+}
+
+void TestCaptureRecorder::testFlagsMalformedMessages()
+{
+    // Messages that are not exactly id + 8 bytes are kept and flagged
+    const QString path = m_dir.filePath("flags.ngcap");
+    CaptureRecorder recorder;
+    QVERIFY(recorder.start(path));
+
+    const char shortMessage[6] = { 1, 0, 0, 0, 7, 7 };
+    char longMessage[16] = {};
+    longMessage[0] = 2;
+    recorder.record(shortMessage, sizeof(shortMessage));
+    recorder.record(longMessage, sizeof(longMessage));
+    recorder.stop();
+
+    const QByteArray data = readFile(path);
+    CaptureRecord records[2];
+    QCOMPARE(data.size(), int(Capture::CAPTURE_HEADER_SIZE + sizeof(records)));
+    memcpy(records, data.constData() + Capture::CAPTURE_HEADER_SIZE, sizeof(records));
+
+    QCOMPARE(records[0].id, uint32_t(1));
+    QCOMPARE(int(records[0].length), 2);
+    QCOMPARE(int(records[0].flags), int(Capture::FlagShort));
+    QCOMPARE(records[1].id, uint32_t(2));
+    QCOMPARE(int(records[1].length), 8);
+    QCOMPARE(int(records[1].flags), int(Capture::FlagTruncated));
+}
+
+void TestCaptureRecorder::testInactiveIgnoresFrames()
+{
+    // record() before start and after stop must not reach the next file
+    const QString path = m_dir.filePath("inactive.ngcap");
+    CaptureRecorder recorder;
+    feed(recorder, 0xDE000001, 1);
+
+    QVERIFY(recorder.start(path));
+    feed(recorder, 0xDE000002, 2);
+    recorder.stop();
+    feed(recorder, 0xDE000003, 3);
+
+    QCOMPARE(recorder.recordedCount(), quint64(1));
+    QCOMPARE(readFile(path).size(), int(Capture::CAPTURE_HEADER_SIZE + sizeof(CaptureRecord)));
+
+    QVERIFY(recorder.start(path));
+    recorder.stop();
+    QCOMPARE(recorder.recordedCount(), quint64(0));
+}
+
+// =============================================================================
+// Segment Tests
+// =============================================================================
+
+void TestCaptureRecorder::testSegmentRollover()
+{
+    // 10 records per segment: 25 records span three indexed segments
+    const QString path = m_dir.filePath("segments.ngcap");
+    CaptureRecorder recorder(64, 10);
+    QVERIFY(recorder.start(path));
+
+    for (int i = 0; i < 25; ++i) {
+        feed(recorder, uint32_t(i), uint8_t(i));
+        QTest::qWait(1);
+    }
+    recorder.stop();
+
+    const QByteArray data = readFile(path);
+    CaptureHeader header;
+    memcpy(&header, data.constData(), sizeof(header));
+    QCOMPARE(header.recordCount, quint64(25));
+    QCOMPARE(header.segmentRecords, 10u);
+    QCOMPARE(header.segmentCount, 3u);
+
+    const CaptureRecord *records = reinterpret_cast<const CaptureRecord *>(
+        data.constData() + Capture::CAPTURE_HEADER_SIZE);
+    for (int i = 0; i < 25; ++i)
+        QCOMPARE(records[i].id, uint32_t(i));
+    QCOMPARE(header.segmentFirstNs[1], records[10].tNs);
+    QCOMPARE(header.segmentFirstNs[2], records[20].tNs);
+}
+
+void TestCaptureRecorder::testFailedRestartLeavesEmptyCapture()
+{
+#ifdef Q_OS_LINUX
+    // A file size limit lets the header page through but not the first
+    // segment, so the second start() fails after creating the file
+    const QString path = m_dir.filePath("restart.ngcap");
+    CaptureRecorder recorder(64, 1000);
+    QVERIFY(recorder.start(path));
+    for (int i = 0; i < 5; ++i)
+        feed(recorder, uint32_t(i), uint8_t(i));
+    recorder.stop();
+    QCOMPARE(recorder.recordedCount(), quint64(5));
+
+    struct rlimit saved;
+    QCOMPARE(getrlimit(RLIMIT_FSIZE, &saved), 0);
+    struct rlimit limited = saved;
+    limited.rlim_cur = Capture::CAPTURE_HEADER_SIZE + 10 * sizeof(CaptureRecord);
+    void (*savedHandler)(int) = signal(SIGXFSZ, SIG_IGN);
+    QCOMPARE(setrlimit(RLIMIT_FSIZE, &limited), 0);
+
+    const bool started = recorder.start(path);
+
+    setrlimit(RLIMIT_FSIZE, &saved);
+    signal(SIGXFSZ, savedHandler);
+
+    QVERIFY(!started);
+    QVERIFY(!recorder.isActive());
+    QCOMPARE(recorder.recordedCount(), quint64(0));
+
+    const QByteArray data = readFile(path);
+    QCOMPARE(data.size(), int(Capture::CAPTURE_HEADER_SIZE));
+    CaptureHeader header;
+    memcpy(&header, data.constData(), sizeof(header));
+    QCOMPARE(header.recordCount, quint64(0));
+    QCOMPARE(header.droppedCount, quint64(0));
+#else
+    QSKIP("Needs RLIMIT_FSIZE to fail the segment allocation");
+#endif
+}
+
+// =============================================================================
+// Throughput Tests
+// =============================================================================
+
+void TestCaptureRecorder::testSustains100kFramesPerSecond()
+{
+    // 100 bursts of 1000 frames every 10 ms, as a saturated bus would deliver
+    const QString path = m_dir.filePath("rate.ngcap");
+    CaptureRecorder recorder;
+    QVERIFY(recorder.start(path));
+
+    QElapsedTimer timer;
+    timer.start();
+    for (int burst = 0; burst < 100; ++burst) {
+        for (int i = 0; i < 1000; ++i)
+            feed(recorder, uint32_t(i), uint8_t(burst));
+        while (timer.elapsed() < (burst + 1) * 10)
+            QThread::usleep(200);
+    }
+    recorder.stop();
+
+    QCOMPARE(recorder.droppedCount(), quint64(0));
+    QCOMPARE(recorder.recordedCount(), quint64(100000));
+}
+
+void TestCaptureRecorder::testOverflowIsCounted()
+{
+    // A burst larger than the ring loses frames, but never blocks
+    const QString path = m_dir.filePath("overflow.ngcap");
+    CaptureRecorder recorder(16);
+    QVERIFY(recorder.start(path));
+
+    for (int i = 0; i < 100000; ++i)
+        feed(recorder, uint32_t(i), 0);
+    recorder.stop();
+
+    QVERIFY(recorder.droppedCount() > 0);
+    QCOMPARE(recorder.recordedCount() + recorder.droppedCount(), quint64(100000));
+
+    CaptureHeader header;
+    memcpy(&header, readFile(path).constData(), sizeof(header));
+    QCOMPARE(header.droppedCount, recorder.droppedCount());
+}
+
+// =============================================================================
+// Test Entry Point
+// =============================================================================
+
+QTEST_MAIN(TestCaptureRecorder)
+#include "test_capturerecorder.moc"
@@ -0,0 +1,228 @@
+/**
+ * @file test_cloggerasync.cpp
+ * @brief Unit tests for the asynchronous cLogger backend.
+ *
+ * Kept apart from test_clogger.cpp because the cLogger singleton stays in
+ * asynchronous mode across tests. The queue is created with a small
+ * capacity so that both overflow policies are exercised.
+ *
+ * The tests cover:
+ * - All queued messages reach the file after flush()
+ * - No loss from several threads under OverflowBlock
+ * - Written plus dropped equals sent under OverflowDrop
+ * - Disabling asynchronous mode writes the queued messages
+ * - init() takes logAsync from its defaults unless the settings set it
+ *
+ * @author Gangadhar Thalange
+ * @date 2026-10-18
+ */
+
+#include <QtTest/QtTest>
+#include <QTemporaryDir>
+#include <QFile>
+#include <thread>
+#include <vector>
+#include "clogger.h"
+#include "settingsservice.h"
+
+/**
+ * @class TestCLoggerAsync
+ * @brief Test fixture for the asynchronous logging path.
+ */
+class TestCLoggerAsync : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    /**
+     * @brief Installs the handler and sizes the queue.
+     */
+    void initTestCase();
+
+    /**
+     * @brief Returns the logger to synchronous mode.
+     */
+    void cleanupTestCase();
+
+    /**
+     * @brief Verify flush() writes every queued message.
+     */
+    void testAsyncWritesAllMessages();
+
+    /**
+     * @brief Verify OverflowBlock loses nothing with several producers.
+     */
+    void testBlockPolicyFromThreads();
+
+    /**
+     * @brief Verify OverflowDrop accounts for every message.
+     */
+    void testDropPolicyCountsDrops();
+
+    /**
+     * @brief Verify setAsync(false) writes the queued messages.
+     */
+    void testDisableWritesQueue();
+
+    /**
+     * @brief Verify the settings override the defaults passed to init().
+     */
+    void testInitSettingDefaults();
+
+private:
+    /**
+     * @brief Points the logger at a fresh file in the temporary directory.
+     */
+    QString useNewLogFile(const QString &name);
+
+    /**
+     * @brief Counts the lines of @p path that contain @p tag.
+     */
+    static int countLines(const QString &path, const QString &tag);
+
+    QTemporaryDir m_dir;
+};
+
+// =============================================================================
+// Helpers
+// =============================================================================
+
+QString TestCLoggerAsync::useNewLogFile(const QString &name)
+{
+    const QString path = m_dir.filePath(name);
+    cLogger::instance().setLogFilePath(path);
+    return path;
+}
+
+int TestCLoggerAsync::countLines(const QString &path, const QString &tag)
+{
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly))
+        return -1;
+    int count = 0;
+    while (!file.atEnd()) {
+        if (QString::fromUtf8(file.readLine()).contains(tag))
+            ++count;
+    }
+    return count;
+}
+
+// =============================================================================
+// Setup / Teardown
+// =============================================================================
+
+void TestCLoggerAsync::initTestCase()
+{
+    QVERIFY(m_dir.isValid());
+    QVERIFY(cLogger::instance().init("TestCLoggerAsync"));
+    cLogger::instance().setEchoToStandardOut(false);
+    cLogger::instance().setLoggerLevel(QtDebugMsg, "NextGenApp");
+    cLogger::instance().setQueueCapacity(64);
+}
+
+void TestCLoggerAsync::cleanupTestCase()
+{
+    cLogger::instance().setAsync(false);
+    QVERIFY(!cLogger::instance().isAsync());
+}
+
+// =============================================================================
+// Tests
+// =============================================================================
+
+void TestCLoggerAsync::testAsyncWritesAllMessages()
+{
+    const QString path = useNewLogFile("all.log");
+    cLogger::instance().setOverflowPolicy(cLogger::OverflowBlock);
+    cLogger::instance().setAsync(true);
+    QVERIFY(cLogger::instance().isAsync());
+
+    // Messages must differ, identical ones are folded into a repeat count
+    for (int i = 0; i < 2000; ++i)
+        qDebug("all-msg %d", i);
+    cLogger::instance().flush();
+
+    QCOMPARE(countLines(path, "all-msg"), 2000);
+}
+
+void TestCLoggerAsync::testBlockPolicyFromThreads()
+{
+    const QString path = useNewLogFile("block.log");
+    cLogger::instance().setOverflowPolicy(cLogger::OverflowBlock);
+    cLogger::instance().setAsync(true);
+
+    const int threads = 4;
+    const int perThread = 5000;
+    std::vector<std::thread> producers;
+    for (int t = 0; t < threads; ++t) {
+        producers.emplace_back([t]() {
+            for (int i = 0; i < perThread; ++i)
+                qDebug("block-msg %d %d", t, i);
+        });
+    }
+    for (std::thread &producer : producers)
+        producer.join();
+    cLogger::instance().flush();
+
+    QCOMPARE(countLines(path, "block-msg"), threads * perThread);
+}
+
+void TestCLoggerAsync::testDropPolicyCountsDrops()
+{
+    const QString path = useNewLogFile("drop.log");
+    cLogger::instance().setOverflowPolicy(cLogger::OverflowDrop);
+    cLogger::instance().setAsync(true);
+
+    // A burst far larger than the 64-slot queue
+    const int sent = 20000;
+    const quint64 droppedBefore = cLogger::instance().droppedMessageCount();
+    for (int i = 0; i < sent; ++i)
+        qDebug("drop-msg %d", i);
+    cLogger::instance().flush();
+    const int dropped = int(cLogger::instance().droppedMessageCount() - droppedBefore);
+
+    QCOMPARE(countLines(path, "drop-msg") + dropped, sent);
+    cLogger::instance().setOverflowPolicy(cLogger::OverflowBlock);
+}
+
+void TestCLoggerAsync::testDisableWritesQueue()
+{
+    const QString path = useNewLogFile("disable.log");
+    cLogger::instance().setOverflowPolicy(cLogger::OverflowBlock);
+    cLogger::instance().setAsync(true);
+
+    for (int i = 0; i < 500; ++i)
+        qDebug("disable-msg %d", i);
+    cLogger::instance().setAsync(false);
+    QVERIFY(!cLogger::instance().isAsync());
+    QCOMPARE(countLines(path, "disable-msg"), 500);
+
+    // Synchronous mode writes immediately again
+    qDebug("sync-msg");
+    QCOMPARE(countLines(path, "sync-msg"), 1);
+}
+
+void TestCLoggerAsync::testInitSettingDefaults()
+{
+    SettingsService &settings = SettingsService::instance();
+    const QVariantMap defaults{ { "logAsync", true } };
+
+    settings.remove("logAsync");
+    QVERIFY(cLogger::instance().init("TestCLoggerAsync", defaults));
+    QVERIFY(cLogger::instance().isAsync());
+
+    // A unit's configuration can turn the program default off
+    settings.setValue("logAsync", false);
+    QVERIFY(cLogger::instance().init("TestCLoggerAsync", defaults));
+    QVERIFY(!cLogger::instance().isAsync());
+
+    settings.remove("logAsync");
+    cLogger::instance().setEchoToStandardOut(false);
+}
+
+// =============================================================================
+// Test Entry Point
+// =============================================================================
+
+QTEST_MAIN(TestCLoggerAsync)
+#include "test_cloggerasync.moc"
@@ -0,0 +1,324 @@
+/**
+ * @file test_cloggerhistory.cpp
+ * @brief Unit tests for reading back log history from cLogger.
+ *
+ * Messages are logged in two batches separated by a pause, and the time
+ * in the pause is used as query start, so the expected lines are known
+ * without controlling the clock. A hand-written file checks time stamp
+ * parsing and files that have no index yet.
+ *
+ * The tests cover:
+ * - The sparse time index sidecar file
+ * - Forward and reverse time queries
+ * - Logging continues into the live file after a query
+ * - Index reload when a file is reopened, files without an index
+ * - Tail reads, also across the rotated generation
+ * - The in-memory ring of recent messages, also while threads log
+ *
+ * @author Gangadhar Thalange
+ * @date 2026-10-18
+ */
+
+#include <QtTest/QtTest>
+#include <QTemporaryDir>
+#include <QFile>
+#include <QFileInfo>
+#include <atomic>
+#include <thread>
+#include <vector>
+#include "clogger.h"
+
+/**
+ * @class TestCLoggerHistory
+ * @brief Test fixture for log history queries.
+ */
+class TestCLoggerHistory : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    /**
+     * @brief Installs the handler and logs the two batches.
+     */
+    void initTestCase();
+
+    /**
+     * @brief Verify one index entry is written per 64 lines.
+     */
+    void testIndexSidecar();
+
+    /**
+     * @brief Verify a forward query returns the first lines after start.
+     */
+    void testForwardQuery();
+
+    /**
+     * @brief Verify a reverse query returns the last lines before start.
+     */
+    void testReverseQuery();
+
+    /**
+     * @brief Verify logging continues into the live file after a query.
+     */
+    void testQueryKeepsLiveFile();
+
+    /**
+     * @brief Verify queries still work after the file is reopened.
+     */
+    void testIndexReloaded();
+
+    /**
+     * @brief Verify time stamps are parsed in a file without index.
+     */
+    void testFileWithoutIndex();
+
+    /**
+     * @brief Verify tail() returns the last lines in file order.
+     */
+    void testTail();
+
+    /**
+     * @brief Verify tail() continues into generation 1 after a rotation.
+     */
+    void testTailSpansGeneration();
+
+    /**
+     * @brief Verify recentEntries() holds the structured messages.
+     */
+    void testRecentEntries();
+
+    /**
+     * @brief Verify previousMessages() returns complete log file lines.
+     */
+    void testPreviousMessagesFullLines();
+
+    /**
+     * @brief Verify snapshots taken while threads log are consistent.
+     */
+    void testRecentEntriesWhileLogging();
+
+private:
+    QTemporaryDir m_dir;
+    QString m_path;
+    QDateTime m_between;    ///< Time between batch A and batch B
+};
+
+// =============================================================================
+// Setup
+// =============================================================================
+
+void TestCLoggerHistory::initTestCase()
+{
+    QVERIFY(m_dir.isValid());
+    QVERIFY(cLogger::instance().init("TestCLoggerHistory"));
+    cLogger::instance().setEchoToStandardOut(false);
+    cLogger::instance().setLoggerLevel(QtDebugMsg, "NextGenApp");
+
+    m_path = m_dir.filePath("history.log");
+    cLogger::instance().setLogFilePath(m_path);
+
+    for (int i = 0; i < 100; ++i)
+        qDebug("batch-a %d", i);
+    QTest::qSleep(20);
+    m_between = QDateTime::currentDateTimeUtc();
+    QTest::qSleep(20);
+    for (int i = 0; i < 100; ++i)
+        qDebug("batch-b %d", i);
+}
+
+// =============================================================================
+// Tests
+// =============================================================================
+
+void TestCLoggerHistory::testIndexSidecar()
+{
+    // 200 lines -> entries for lines 0, 64, 128 and 192
+    QCOMPARE(QFileInfo(m_path + ".idx").size(), qint64(4 * 16));
+}
+
+void TestCLoggerHistory::testForwardQuery()
+{
+    const QList<QString> lines = cLogger::instance().previousMessages(m_between, 10, false);
+    QCOMPARE(lines.size(), 10);
+    QVERIFY(lines.first().endsWith("batch-b 0"));
+    QVERIFY(lines.last().endsWith("batch-b 9"));
+
+    // Before everything: starts at the first line
+    const QList<QString> all = cLogger::instance().previousMessages(m_between.addSecs(-3600), 1, false);
+    QCOMPARE(all.size(), 1);
+    QVERIFY(all.first().endsWith("batch-a 0"));
+
+    // After everything: nothing
+    QVERIFY(cLogger::instance().previousMessages(m_between.addSecs(3600), 10, false).isEmpty());
+}
+
+void TestCLoggerHistory::testReverseQuery()
+{
+    const QList<QString> lines = cLogger::instance().previousMessages(m_between, 10, true);
+    QCOMPARE(lines.size(), 10);
+    QVERIFY(lines.first().endsWith("batch-a 90"));
+    QVERIFY(lines.last().endsWith("batch-a 99"));
+
+    QVERIFY(cLogger::instance().previousMessages(m_between.addSecs(-3600), 10, true).isEmpty());
+}
+
+void TestCLoggerHistory::testQueryKeepsLiveFile()
+{
+    cLogger::instance().previousMessages(m_between, 5, false);
+    qDebug("after-query");
+    QCOMPARE(cLogger::instance().logFilePath(), m_path);
+
+    QFile file(m_path);
+    QVERIFY(file.open(QIODevice::ReadOnly));
+    QVERIFY(file.readAll().contains("after-query"));
+}
+
+void TestCLoggerHistory::testIndexReloaded()
+{
+    const qint64 indexSize = QFileInfo(m_path + ".idx").size();
+    cLogger::instance().setLogFilePath(m_dir.filePath("other.log"));
+    cLogger::instance().setLogFilePath(m_path);
+    QCOMPARE(QFileInfo(m_path + ".idx").size(), indexSize);
+
+    const QList<QString> lines = cLogger::instance().previousMessages(m_between, 3, false);
+    QCOMPARE(lines.size(), 3);
+    QVERIFY(lines.first().endsWith("batch-b 0"));
+}
+
+void TestCLoggerHistory::testFileWithoutIndex()
+{
+    const QString path = m_dir.filePath("handwritten.log");
+    QFile file(path);
+    QVERIFY(file.open(QIODevice::WriteOnly));
+    for (int i = 0; i < 10; ++i)
+        file.write(QString("[2026/01/01 00:00:%1.000] [DEB App main] line %2\n")
+                   .arg(i, 2, 10, QChar('0')).arg(i).toUtf8());
+    file.close();
+    cLogger::instance().setLogFilePath(path);
+
+    const QDateTime start(QDate(2026, 1, 1), QTime(0, 0, 4, 500), Qt::UTC);
+    const QList<QString> forward = cLogger::instance().previousMessages(start, 2, false);
+    QCOMPARE(forward.size(), 2);
+    QVERIFY(forward.at(0).endsWith("line 5"));
+    QVERIFY(forward.at(1).endsWith("line 6"));
+
+    const QList<QString> reverse = cLogger::instance().previousMessages(start, 2, true);
+    QCOMPARE(reverse.size(), 2);
+    QVERIFY(reverse.at(0).endsWith("line 3"));
+    QVERIFY(reverse.at(1).endsWith("line 4"));
+}
+
+void TestCLoggerHistory::testTail()
+{
+    cLogger::instance().setLogFilePath(m_dir.filePath("tail.log"));
+    for (int i = 0; i < 50; ++i)
+        qDebug("tail-msg %d", i);
+
+    const QList<QString> last = cLogger::instance().tail(5);
+    QCOMPARE(last.size(), 5);
+    QVERIFY(last.first().endsWith("tail-msg 45"));
+    QVERIFY(last.last().endsWith("tail-msg 49"));
+
+    // Asking for more than the file holds returns the whole file
+    QCOMPARE(cLogger::instance().tail(1000).size(), 50);
+    QCOMPARE(cLogger::instance().previousMessages().size(), 50);
+    QVERIFY(cLogger::instance().tail(0).isEmpty());
+}
+
+void TestCLoggerHistory::testTailSpansGeneration()
+{
+    const QString path = m_dir.filePath("span.log");
+    cLogger::instance().setLogFilePath(path);
+    cLogger::instance().setLogRotation(2048, 2);
+
+    const int before = cLogger::instance().rotationCount();
+    int sent = 0;
+    while (sent < 100)
+        qDebug("span-msg %d", sent++);
+    QTRY_VERIFY(cLogger::instance().rotationCount() > before);
+    for (int i = 0; i < 3; ++i)
+        qDebug("span-new %d", i);
+
+    const QList<QString> last = cLogger::instance().tail(10);
+    QCOMPARE(last.size(), 10);
+    QVERIFY(last.at(6).endsWith(QString("span-msg %1").arg(sent - 1)));
+    QVERIFY(last.at(7).endsWith("span-new 0"));
+    QVERIFY(last.at(9).endsWith("span-new 2"));
+}
+
+void TestCLoggerHistory::testRecentEntries()
+{
+    cLogger::instance().setLoggerLevel(QtWarningMsg, "NextGenApp");
+    qDebug("recent-debug");
+    qWarning("recent-warning");
+
+    const QList<cLogger::LogEntry> entries = cLogger::instance().recentEntries(2);
+    QCOMPARE(entries.size(), 2);
+    QCOMPARE(entries.at(0).type, QtDebugMsg);
+    QCOMPARE(entries.at(0).message, QString("recent-debug"));
+    QCOMPARE(entries.at(0).module, QString("App"));
+    QCOMPARE(entries.at(1).type, QtWarningMsg);
+    QVERIFY(entries.at(1).message.startsWith("recent-warning in "));
+    QVERIFY(entries.at(1).utcMs >= entries.at(0).utcMs);
+    QVERIFY(qAbs(entries.at(1).utcMs - QDateTime::currentMSecsSinceEpoch()) < 5000);
+
+    // Long messages are truncated, not dropped
+    qDebug("%s", QByteArray(1000, 'x').constData());
+    QCOMPARE(cLogger::instance().recentEntries(1).first().message.size(), 200);
+}
+
+void TestCLoggerHistory::testPreviousMessagesFullLines()
+{
+    cLogger::instance().setLogFilePath(m_dir.filePath("full.log"));
+    cLogger::instance().setLoggerLevel(QtWarningMsg, "NextGenApp");
+    const QString text(300, 'w');
+    qWarning("%s", qPrintable(text));
+
+    // Longer than a ring record, with the source location still attached
+    const QList<QString> lines = cLogger::instance().previousMessages();
+    QVERIFY(!lines.isEmpty());
+    QVERIFY(lines.last().contains(text + " in "));
+    QCOMPARE(lines, cLogger::instance().tail(cLogger::instance().previousMessageBufferSize()));
+}
+
+void TestCLoggerHistory::testRecentEntriesWhileLogging()
+{
+    cLogger::instance().setLogFilePath(m_dir.filePath("concurrent.log"));
+    std::atomic<bool> done{false};
+    std::vector<std::thread> producers;
+    for (int t = 0; t < 3; ++t) {
+        producers.emplace_back([t]() {
+            for (int i = 0; i < 3000; ++i)
+                qDebug("ring-msg %d %d", t, i);
+        });
+    }
+
+    int snapshots = 0;
+    int torn = 0;
+    std::thread reader([&]() {
+        while (!done.load()) {
+            for (const cLogger::LogEntry &entry : cLogger::instance().recentEntries(256)) {
+                if (entry.message.startsWith("ring-msg") && entry.message.split(' ').size() != 3)
+                    ++torn;
+            }
+            ++snapshots;
+            std::this_thread::yield();
+        }
+    });
+
+    for (std::thread &producer : producers)
+        producer.join();
+    done = true;
+    reader.join();
+
+    QVERIFY(snapshots > 0);
+    QCOMPARE(torn, 0);
+    QCOMPARE(cLogger::instance().recentEntries(5000).size(), 1024);
+}
+
+// =============================================================================
+// Test Entry Point
+// =============================================================================
+
+QTEST_MAIN(TestCLoggerHistory)
+#include "test_cloggerhistory.moc"
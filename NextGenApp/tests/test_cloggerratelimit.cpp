@@ -0,0 +1,283 @@
+/**
+ * @file test_cloggerratelimit.cpp
+ * @brief Unit tests for per-call-site log rate limiting.
+ *
+ * LogRateLimiter is tested with explicit times, so the token bucket
+ * arithmetic is exact. The cLogger tests log storms from fixed call sites
+ * and check what reaches the file.
+ *
+ * The tests cover:
+ * - Burst and sustained rate of the token bucket
+ * - Duplicate suppression within the window, also when interleaved
+ * - Independent budgets for different call sites
+ * - Summaries: when they are due and what they report
+ * - A cLogger storm is cut to the burst and summarised on flush()
+ * - Interleaved identical messages from several threads are folded
+ *
+ * @author Gangadhar Thalange
+ * @date 2026-10-18
+ */
+
+#include <QtTest/QtTest>
+#include <QTemporaryDir>
+#include <QFile>
+#include <QRegularExpression>
+#include <thread>
+#include <vector>
+#include "clogger.h"
+#include "logratelimiter.h"
+
+/**
+ * @class TestCLoggerRateLimit
+ * @brief Test fixture for LogRateLimiter and its use in cLogger.
+ */
+class TestCLoggerRateLimit : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    /**
+     * @brief Installs the handler.
+     */
+    void initTestCase();
+
+    /**
+     * @brief Disables the rate limit again.
+     */
+    void cleanup();
+
+    /**
+     * @brief Verify a site gets its burst, then the sustained rate.
+     */
+    void testTokenBucket();
+
+    /**
+     * @brief Verify identical messages are suppressed within the window.
+     */
+    void testDuplicateWindow();
+
+    /**
+     * @brief Verify call sites do not share a budget.
+     */
+    void testSitesIndependent();
+
+    /**
+     * @brief Verify summaries are due once per window and reset the counts.
+     */
+    void testSummaries();
+
+    /**
+     * @brief Verify a message storm is cut to the burst and summarised.
+     */
+    void testLoggerStorm();
+
+    /**
+     * @brief Verify identical messages from several threads are folded.
+     */
+    void testInterleavedDuplicates();
+
+    /**
+     * @brief Verify nothing is suppressed while the limit is off.
+     */
+    void testDisabled();
+
+private:
+    /**
+     * @brief Points the logger at a fresh file in the temporary directory.
+     */
+    QString useNewLogFile(const QString &name);
+
+    /**
+     * @brief Returns the lines of @p path that contain @p tag.
+     */
+    static QStringList linesWith(const QString &path, const QString &tag);
+
+    QTemporaryDir m_dir;
+};
+
+// =============================================================================
+// Helpers
+// =============================================================================
+
+QString TestCLoggerRateLimit::useNewLogFile(const QString &name)
+{
+    const QString path = m_dir.filePath(name);
+    cLogger::instance().setLogFilePath(path);
+    return path;
+}
+
+QStringList TestCLoggerRateLimit::linesWith(const QString &path, const QString &tag)
+{
+    QStringList lines;
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly))
+        return lines;
+    while (!file.atEnd()) {
+        const QString line = QString::fromUtf8(file.readLine()).trimmed();
+        if (line.contains(tag))
+            lines.append(line);
+    }
+    return lines;
+}
+
+// =============================================================================
+// Setup / Teardown
+// =============================================================================
+
+void TestCLoggerRateLimit::initTestCase()
+{
+    QVERIFY(m_dir.isValid());
+    QVERIFY(cLogger::instance().init("TestCLoggerRateLimit"));
+    cLogger::instance().setEchoToStandardOut(false);
+    cLogger::instance().setLoggerLevel(QtDebugMsg, "NextGenApp");
+}
+
+void TestCLoggerRateLimit::cleanup()
+{
+    cLogger::instance().setRateLimit(0);
+}
+
+// =============================================================================
+// Tests
+// =============================================================================
+
+void TestCLoggerRateLimit::testTokenBucket()
+{
+    LogRateLimiter limiter;
+    limiter.configure(10, 5, 1000);
+    const quint64 key = LogRateLimiter::siteKey("src/appinterface.cpp", 357, "default");
+
+    int admitted = 0;
+    for (int i = 0; i < 100; ++i)
+        admitted += limiter.admit(key, "src/appinterface.cpp", 357, quint64(i + 1), 1000000) ? 1 : 0;
+    QCOMPARE(admitted, 5);
+    QCOMPARE(quint64(limiter.suppressedCount()), quint64(95));
+
+    // 100 distinct messages per second for 10 s: 10 per second pass
+    admitted = 0;
+    for (int i = 0; i < 1000; ++i)
+        admitted += limiter.admit(key, "src/appinterface.cpp", 357, quint64(1000 + i), 1000000 + i * 10000) ? 1 : 0;
+    QVERIFY2(admitted >= 99 && admitted <= 101, qPrintable(QString::number(admitted)));
+}
+
+void TestCLoggerRateLimit::testDuplicateWindow()
+{
+    LogRateLimiter limiter;
+    limiter.configure(1000, 1000, 1000);
+    const quint64 key = LogRateLimiter::siteKey("a.cpp", 1, "default");
+
+    QVERIFY(limiter.admit(key, "a.cpp", 1, 42, 1000000));
+    QVERIFY(!limiter.admit(key, "a.cpp", 1, 42, 1000100));
+    QVERIFY(!limiter.admit(key, "a.cpp", 1, 42, 1999999));
+    // Window over: the same message is logged again
+    QVERIFY(limiter.admit(key, "a.cpp", 1, 42, 2000000));
+    // A different message is not a duplicate
+    QVERIFY(limiter.admit(key, "a.cpp", 1, 43, 2000001));
+    QCOMPARE(quint64(limiter.suppressedCount()), quint64(2));
+}
+
+void TestCLoggerRateLimit::testSitesIndependent()
+{
+    LogRateLimiter limiter;
+    limiter.configure(1, 2, 1000);
+    for (int line = 1; line <= 100; ++line) {
+        const quint64 key = LogRateLimiter::siteKey("b.cpp", line, "default");
+        QVERIFY(limiter.admit(key, "b.cpp", line, 1, 1000000));
+        QVERIFY(limiter.admit(key, "b.cpp", line, 2, 1000000));
+        QVERIFY(!limiter.admit(key, "b.cpp", line, 3, 1000000));
+    }
+    // Category is part of the site
+    QVERIFY(LogRateLimiter::siteKey("b.cpp", 1, "default") != LogRateLimiter::siteKey("b.cpp", 1, "qml"));
+}
+
+void TestCLoggerRateLimit::testSummaries()
+{
+    LogRateLimiter limiter;
+    limiter.configure(1, 1, 1000);
+    const quint64 key = LogRateLimiter::siteKey("/home/user/src/c.cpp", 7, "default");
+
+    QVERIFY(!limiter.summaryDue(1000000));
+    for (int i = 0; i < 4; ++i)
+        limiter.admit(key, "/home/user/src/c.cpp", 7, quint64(i + 1), 1000000);
+    QVERIFY(limiter.summaryDue(1000000));
+    // Only one caller gets it per window
+    QVERIFY(!limiter.summaryDue(1000001));
+
+    QStringList reports;
+    limiter.takeSummaries([&reports](const char *site, size_t length, quint64 count) {
+        reports.append(QString("%1=%2").arg(QString::fromUtf8(site, int(length))).arg(count));
+    });
+    QCOMPARE(reports, QStringList{ "c.cpp:7=3" });
+
+    // Counts were reset: nothing due even after the window
+    QVERIFY(!limiter.summaryDue(5000000));
+}
+
+void TestCLoggerRateLimit::testLoggerStorm()
+{
+    const QString path = useNewLogFile("storm.log");
+    cLogger::instance().setRateLimit(5, 10);
+    const quint64 before = cLogger::instance().suppressedMessageCount();
+
+    // Distinct messages from one call site, faster than the rate
+    for (int i = 0; i < 1000; ++i)
+        qDebug("storm-msg %d", i);
+    // Another site still gets through
+    qDebug("other-site");
+    cLogger::instance().flush();
+
+    const int written = linesWith(path, "storm-msg").size();
+    QVERIFY2(written >= 10 && written <= 12, qPrintable(QString::number(written)));
+    QCOMPARE(linesWith(path, "other-site").size(), 1);
+    QCOMPARE(cLogger::instance().suppressedMessageCount() - before, quint64(1000 - written));
+
+    // The summaries add up to the suppressed messages
+    int reported = 0;
+    const QRegularExpression summary("\\((\\d+) messages suppressed from test_cloggerratelimit\\.cpp:\\d+\\)");
+    for (const QString &line : linesWith(path, "messages suppressed from")) {
+        const QRegularExpressionMatch match = summary.match(line);
+        QVERIFY2(match.hasMatch(), qPrintable(line));
+        reported += match.captured(1).toInt();
+    }
+    QCOMPARE(reported, 1000 - written);
+}
+
+void TestCLoggerRateLimit::testInterleavedDuplicates()
+{
+    const QString path = useNewLogFile("interleaved.log");
+    cLogger::instance().setRateLimit(1000, 1000);
+
+    // Two threads alternate the same message, which defeated the
+    // consecutive-duplicate check of the writer
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 2; ++t) {
+        threads.emplace_back([]() {
+            for (int i = 0; i < 200; ++i)
+                qDebug("Safety Button Index: 3 State: true");
+        });
+    }
+    for (std::thread &thread : threads)
+        thread.join();
+    cLogger::instance().flush();
+
+    QCOMPARE(linesWith(path, "Safety Button Index").size(), 1);
+}
+
+void TestCLoggerRateLimit::testDisabled()
+{
+    const QString path = useNewLogFile("disabled.log");
+    const quint64 before = cLogger::instance().suppressedMessageCount();
+    for (int i = 0; i < 500; ++i)
+        qDebug("free-msg %d", i);
+    cLogger::instance().flush();
+
+    QCOMPARE(linesWith(path, "free-msg").size(), 500);
+    QCOMPARE(cLogger::instance().suppressedMessageCount(), before);
+}
+
+// =============================================================================
+// Test Entry Point
+// =============================================================================
+
+QTEST_MAIN(TestCLoggerRateLimit)
+#include "test_cloggerratelimit.moc"
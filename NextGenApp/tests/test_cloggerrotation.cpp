@@ -0,0 +1,199 @@
+/**
+ * @file test_cloggerrotation.cpp
+ * @brief Unit tests for cLogger log file rotation.
+ *
+ * Rotation thresholds are set to a few KiB so that each test rotates
+ * several times within milliseconds. Rotation runs on a background
+ * thread, so the tests wait on cLogger::rotationCount().
+ *
+ * The tests cover:
+ * - Rotation triggered by the bytes-written counter
+ * - The counter starting from the size of an existing file
+ * - Compressed generations and the generation limit
+ * - The disk budget
+ *
+ * @author Gangadhar Thalange
+ * @date 2026-10-18
+ */
+
+#include <QtTest/QtTest>
+#include <QTemporaryDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QRandomGenerator>
+#include "clogger.h"
+
+/**
+ * @class TestCLoggerRotation
+ * @brief Test fixture for log rotation.
+ */
+class TestCLoggerRotation : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    /**
+     * @brief Installs the handler and enables debug messages.
+     */
+    void initTestCase();
+
+    /**
+     * @brief Verify exceeding the size rotates into generation 1.
+     */
+    void testRotationBySize();
+
+    /**
+     * @brief Verify the counter starts at the size of an existing file.
+     */
+    void testCounterStartsAtFileSize();
+
+    /**
+     * @brief Verify older generations are compressed and limited in number.
+     */
+    void testCompressedGenerations();
+
+    /**
+     * @brief Verify the oldest generations are deleted to meet the budget.
+     */
+    void testDiskBudget();
+
+private:
+    /**
+     * @brief Logs distinct lines with about @p bytes of message text.
+     */
+    void logBytes(const char *tag, int bytes);
+
+    /**
+     * @brief Logs past the threshold and waits for the rotation.
+     */
+    bool rotateOnce(const char *tag, int rolloverBytes);
+
+    QTemporaryDir m_dir;
+    int m_sequence = 0;
+};
+
+// =============================================================================
+// Helpers
+// =============================================================================
+
+void TestCLoggerRotation::logBytes(const char *tag, int bytes)
+{
+    // Random hex keeps the lines distinct and poorly compressible
+    for (int written = 0; written < bytes; written += 100) {
+        const QByteArray noise = QByteArray::number(QRandomGenerator::global()->generate64(), 16)
+                + QByteArray::number(QRandomGenerator::global()->generate64(), 16);
+        qDebug("%s %d %s", tag, m_sequence++, noise.constData());
+    }
+}
+
+bool TestCLoggerRotation::rotateOnce(const char *tag, int rolloverBytes)
+{
+    const int before = cLogger::instance().rotationCount();
+    logBytes(tag, rolloverBytes + 200);
+    return QTest::qWaitFor([before]() {
+        return cLogger::instance().rotationCount() > before;
+    }, 5000);
+}
+
+// =============================================================================
+// Tests
+// =============================================================================
+
+void TestCLoggerRotation::initTestCase()
+{
+    QVERIFY(m_dir.isValid());
+    QVERIFY(cLogger::instance().init("TestCLoggerRotation"));
+    cLogger::instance().setEchoToStandardOut(false);
+    cLogger::instance().setLoggerLevel(QtDebugMsg, "NextGenApp");
+}
+
+void TestCLoggerRotation::testRotationBySize()
+{
+    const QString path = m_dir.filePath("size.log");
+    cLogger::instance().setLogFilePath(path);
+    cLogger::instance().setLogRotation(4096, 3);
+
+    QVERIFY(rotateOnce("size-msg", 4096));
+
+    QVERIFY(QFile::exists(path + ".1"));
+    QVERIFY(QFileInfo(path + ".1").size() > 4096);
+    QVERIFY(QFileInfo(path).size() < 4096);
+
+    // Logging continues into the new live file
+    qDebug("size-after-rotation");
+    QFile live(path);
+    QVERIFY(live.open(QIODevice::ReadOnly));
+    QVERIFY(live.readAll().contains("size-after-rotation"));
+}
+
+void TestCLoggerRotation::testCounterStartsAtFileSize()
+{
+    // A file left over from a previous run is 3000 bytes already
+    const QString path = m_dir.filePath("existing.log");
+    QFile existing(path);
+    QVERIFY(existing.open(QIODevice::WriteOnly));
+    existing.write(QByteArray(2999, 'x') + '\n');
+    existing.close();
+
+    cLogger::instance().setLogFilePath(path);
+    cLogger::instance().setLogRotation(4096, 3);
+    const int before = cLogger::instance().rotationCount();
+
+    logBytes("existing-msg", 1400);
+    QTRY_VERIFY(cLogger::instance().rotationCount() > before);
+    QVERIFY(QFile::exists(path + ".1"));
+}
+
+void TestCLoggerRotation::testCompressedGenerations()
+{
+    const QString path = m_dir.filePath("gen.log");
+    cLogger::instance().setLogFilePath(path);
+    cLogger::instance().setLogRotation(2048, 3);
+
+    QVERIFY(rotateOnce("gen-first", 2048));
+    for (int i = 0; i < 4; ++i)
+        QVERIFY(rotateOnce("gen-msg", 2048));
+
+    QVERIFY(QFile::exists(path + ".1"));
+    QVERIFY(QFile::exists(path + ".2.z"));
+    QVERIFY(QFile::exists(path + ".3.z"));
+    QVERIFY(!QFile::exists(path + ".4.z"));
+
+    // Compressed generations hold the original text
+    QFile compressed(path + ".2.z");
+    QVERIFY(compressed.open(QIODevice::ReadOnly));
+    const QByteArray text = qUncompress(compressed.readAll());
+    QVERIFY(text.contains("gen-msg"));
+    QVERIFY(text.size() > 2048);
+}
+
+void TestCLoggerRotation::testDiskBudget()
+{
+    const QString path = m_dir.filePath("budget.log");
+    cLogger::instance().setLogFilePath(path);
+    cLogger::instance().setLogRotation(1024, 10, 3000);
+
+    for (int i = 0; i < 8; ++i)
+        QVERIFY(rotateOnce("budget-msg", 1024));
+
+    qint64 total = QFileInfo(path + ".1").size();
+    int compressedCount = 0;
+    for (int generation = 2; generation <= 10; ++generation) {
+        const QFileInfo info(path + QString(".%1.z").arg(generation));
+        if (info.exists()) {
+            total += info.size();
+            ++compressedCount;
+        }
+    }
+    QVERIFY(QFile::exists(path + ".1"));
+    QVERIFY(compressedCount >= 1);
+    QVERIFY(compressedCount < 7);
+    QVERIFY2(total <= 3000, qPrintable(QString("generations use %1 bytes").arg(total)));
+}
+
+// =============================================================================
+// Test Entry Point
+// =============================================================================
+
+QTEST_MAIN(TestCLoggerRotation)
+#include "test_cloggerrotation.moc"
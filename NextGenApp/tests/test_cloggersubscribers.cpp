@@ -0,0 +1,293 @@
+/**
+ * @file test_cloggersubscribers.cpp
+ * @brief Unit tests for batched delivery of log lines to cLogger subscribers.
+ *
+ * The tests cover:
+ * - A subscriber receives every line, in order, on its context's thread
+ * - Batches are bounded and their sequence numbers are contiguous
+ * - In synchronous mode an incomplete batch is handed out once it is old
+ * - Several subscribers share the same immutable batch
+ * - A handler may log without deadlocking the logger
+ * - unsubscribe() and destroying the context end delivery
+ * - newLogMessages is still emitted, without the log lock held
+ *
+ * @author Gangadhar Thalange
+ * @date 2026-10-18
+ */
+
+#include <QtTest/QtTest>
+#include <QTemporaryDir>
+#include <QFile>
+#include <QMutex>
+#include <QThread>
+#include <memory>
+#include <vector>
+#include "clogger.h"
+
+/**
+ * @class TestCLoggerSubscribers
+ * @brief Test fixture for cLogger::subscribe() and newLogMessages.
+ */
+class TestCLoggerSubscribers : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    /**
+     * @brief Installs the handler.
+     */
+    void initTestCase();
+
+    /**
+     * @brief Returns the logger to synchronous mode.
+     */
+    void cleanupTestCase();
+
+    /**
+     * @brief Verify all lines arrive in order on the consumer thread.
+     */
+    void testConsumerThread();
+
+    /**
+     * @brief Verify two subscribers receive the same batch objects.
+     */
+    void testSharedBatches();
+
+    /**
+     * @brief Verify a partial batch arrives without flush() in synchronous mode.
+     */
+    void testAgedBatchSync();
+
+    /**
+     * @brief Verify a handler that logs does not deadlock.
+     */
+    void testHandlerMayLog();
+
+    /**
+     * @brief Verify unsubscribe() and a destroyed context end delivery.
+     */
+    void testUnsubscribe();
+
+    /**
+     * @brief Verify newLogMessages is emitted off the log lock.
+     */
+    void testSignalOffLock();
+
+private:
+    /**
+     * @brief Collects the batches handed to one subscriber.
+     */
+    struct Collector {
+        QMutex mutex;
+        std::vector<LogBatchPtr> batches;
+        QThread *thread = nullptr;
+
+        cLogger::LogBatchHandler handler()
+        {
+            return [this](const LogBatchPtr &batch) {
+                QMutexLocker locker(&mutex);
+                batches.push_back(batch);
+                thread = QThread::currentThread();
+            };
+        }
+
+        /**
+         * @brief Messages of all batches that contain @p tag.
+         */
+        QStringList messages(const QString &tag)
+        {
+            QMutexLocker locker(&mutex);
+            QStringList result;
+            for (const LogBatchPtr &batch : batches) {
+                for (int i = 0; i < batch->size(); ++i) {
+                    const QString message = batch->message(i);
+                    if (message.contains(tag))
+                        result.append(message);
+                }
+            }
+            return result;
+        }
+    };
+
+    QTemporaryDir m_dir;
+};
+
+// =============================================================================
+// Setup / Teardown
+// =============================================================================
+
+void TestCLoggerSubscribers::initTestCase()
+{
+    QVERIFY(m_dir.isValid());
+    QVERIFY(cLogger::instance().init("TestCLoggerSubscribers"));
+    cLogger::instance().setEchoToStandardOut(false);
+    cLogger::instance().setLoggerLevel(QtDebugMsg, "NextGenApp");
+    cLogger::instance().setLogFilePath(m_dir.filePath("subscribers.log"));
+}
+
+void TestCLoggerSubscribers::cleanupTestCase()
+{
+    cLogger::instance().setAsync(false);
+}
+
+// =============================================================================
+// Tests
+// =============================================================================
+
+void TestCLoggerSubscribers::testConsumerThread()
+{
+    QThread consumer;
+    consumer.start();
+    QObject *context = new QObject;
+    context->moveToThread(&consumer);
+
+    Collector collector;
+    const int id = cLogger::instance().subscribe(context, collector.handler());
+    QVERIFY(id > 0);
+
+    cLogger::instance().setAsync(true);
+    // Messages must differ, identical ones are folded into a repeat count
+    for (int i = 0; i < 1000; ++i)
+        qDebug("consumer-msg %d", i);
+    cLogger::instance().flush();
+
+    QTRY_COMPARE(collector.messages("consumer-msg").size(), 1000);
+    const QStringList messages = collector.messages("consumer-msg");
+    for (int i = 0; i < messages.size(); ++i)
+        QCOMPARE(messages.at(i), QString("consumer-msg %1").arg(i));
+
+    {
+        QMutexLocker locker(&collector.mutex);
+        QCOMPARE(collector.thread, &consumer);
+        for (size_t i = 0; i < collector.batches.size(); ++i) {
+            const LogBatchPtr &batch = collector.batches[i];
+            QVERIFY(!batch->isEmpty());
+            QVERIFY(batch->size() <= 256);
+            QVERIFY(batch->line(0).endsWith(batch->message(0).toUtf8()));
+            if (i > 0) {
+                const LogBatchPtr &previous = collector.batches[i - 1];
+                QCOMPARE(batch->firstSequence(), previous->firstSequence() + quint64(previous->size()));
+            }
+        }
+    }
+
+    cLogger::instance().unsubscribe(id);
+    cLogger::instance().setAsync(false);
+    QMetaObject::invokeMethod(context, &QObject::deleteLater);
+    consumer.quit();
+    QVERIFY(consumer.wait(5000));
+}
+
+void TestCLoggerSubscribers::testSharedBatches()
+{
+    QObject context;
+    Collector first;
+    Collector second;
+    const int firstId = cLogger::instance().subscribe(&context, first.handler());
+    const int secondId = cLogger::instance().subscribe(&context, second.handler());
+    QVERIFY(firstId != secondId);
+
+    for (int i = 0; i < 300; ++i)
+        qDebug("shared-msg %d", i);
+    cLogger::instance().flush();
+
+    QTRY_COMPARE(first.messages("shared-msg").size(), 300);
+    QTRY_COMPARE(second.messages("shared-msg").size(), 300);
+    QCOMPARE(first.batches.size(), second.batches.size());
+    for (size_t i = 0; i < first.batches.size(); ++i)
+        QVERIFY(first.batches[i].get() == second.batches[i].get());
+
+    cLogger::instance().unsubscribe(firstId);
+    cLogger::instance().unsubscribe(secondId);
+}
+
+void TestCLoggerSubscribers::testAgedBatchSync()
+{
+    QObject context;
+    Collector collector;
+    QVERIFY(!cLogger::instance().isAsync());
+    const int id = cLogger::instance().subscribe(&context, collector.handler());
+
+    // No further line, no flush(): the batch timer hands it out
+    qDebug("aged-msg");
+    QTRY_COMPARE_WITH_TIMEOUT(collector.messages("aged-msg").size(), 1, 1000);
+
+    cLogger::instance().unsubscribe(id);
+}
+
+void TestCLoggerSubscribers::testHandlerMayLog()
+{
+    QObject context;
+    Collector collector;
+    int logged = 0;
+    const int id = cLogger::instance().subscribe(&context, [&](const LogBatchPtr &batch) {
+        for (int i = 0; i < batch->size(); ++i) {
+            if (batch->message(i).contains("trigger-msg")) {
+                qDebug("handler-msg %d", logged++);
+                break;
+            }
+        }
+        collector.handler()(batch);
+    });
+
+    qDebug("trigger-msg");
+    cLogger::instance().flush();
+    QTRY_COMPARE(logged, 1);
+
+    cLogger::instance().flush();
+    QTRY_COMPARE(collector.messages("handler-msg").size(), 1);
+    QCOMPARE(logged, 1);
+
+    cLogger::instance().unsubscribe(id);
+}
+
+void TestCLoggerSubscribers::testUnsubscribe()
+{
+    QObject context;
+    Collector collector;
+    const int id = cLogger::instance().subscribe(&context, collector.handler());
+    cLogger::instance().unsubscribe(id);
+    QCOMPARE(cLogger::instance().subscribe(nullptr, collector.handler()), 0);
+    QCOMPARE(cLogger::instance().subscribe(&context, cLogger::LogBatchHandler()), 0);
+
+    QObject *shortLived = new QObject;
+    Collector orphan;
+    cLogger::instance().subscribe(shortLived, orphan.handler());
+    delete shortLived;
+
+    qDebug("after-unsubscribe");
+    cLogger::instance().flush();
+    QTest::qWait(100);
+    QVERIFY(collector.messages("after-unsubscribe").isEmpty());
+    QVERIFY(orphan.messages("after-unsubscribe").isEmpty());
+}
+
+void TestCLoggerSubscribers::testSignalOffLock()
+{
+    QStringList received;
+    // flush() takes the log lock; it would deadlock if the signal were
+    // emitted with the lock held
+    QMetaObject::Connection connection = connect(&cLogger::instance(), &cLogger::newLogMessages, this,
+            [&](const QList<QString> &msgs) {
+                for (const QString &msg : msgs) {
+                    if (msg.contains("signal-msg"))
+                        received.append(msg);
+                }
+                cLogger::instance().flush();
+            }, Qt::DirectConnection);
+
+    for (int i = 0; i < 600; ++i)
+        qDebug("signal-msg %d", i);
+    cLogger::instance().flush();
+
+    QCOMPARE(received.size(), 600);
+    QVERIFY(received.last().endsWith("signal-msg 599"));
+    disconnect(connection);
+}
+
+// =============================================================================
+// Test Entry Point
+// =============================================================================
+
+QTEST_MAIN(TestCLoggerSubscribers)
+#include "test_cloggersubscribers.moc"
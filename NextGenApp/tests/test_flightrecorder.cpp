@@ -0,0 +1,278 @@
+/**
+ * @file test_flightrecorder.cpp
+ * @brief Unit tests for the FlightRecorder log ring file.
+ *
+ * The tests cover:
+ * - Lines are read back in order, also after the ring wrapped
+ * - Reopening continues the ring; a new capacity resets it
+ * - Torn or corrupted records are skipped
+ * - Lines of a writer killed without closing the file survive
+ * - cLogger copies its lines into `<log>.ring`
+ *
+ * @author Gangadhar Thalange
+ * @date 2026-10-18
+ */
+
+#include <QtTest/QtTest>
+#include <QTemporaryDir>
+#include <QFile>
+#include "clogger.h"
+#include "flightrecorder.h"
+
+#ifdef Q_OS_UNIX
+#include <csignal>
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
+
+/**
+ * @class TestFlightRecorder
+ * @brief Test fixture for FlightRecorder and its use in cLogger.
+ */
+class TestFlightRecorder : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    /**
+     * @brief Installs the handler.
+     */
+    void initTestCase();
+
+    /**
+     * @brief Verify lines are read back in order.
+     */
+    void testAppendRead();
+
+    /**
+     * @brief Verify the newest lines are kept when the ring wraps.
+     */
+    void testWrapAround();
+
+    /**
+     * @brief Verify reopening continues the ring and a new size resets it.
+     */
+    void testReopen();
+
+    /**
+     * @brief Verify a corrupted record is skipped and the rest is read.
+     */
+    void testCorruptRecord();
+
+    /**
+     * @brief Verify lines survive a writer killed without closing the file.
+     */
+    void testKilledWriter();
+
+    /**
+     * @brief Verify cLogger copies its lines into the ring.
+     */
+    void testLoggerRing();
+
+private:
+    static QByteArray lineFor(int i);
+
+    QTemporaryDir m_dir;
+};
+
+// =============================================================================
+// Helpers
+// =============================================================================
+
+QByteArray TestFlightRecorder::lineFor(int i)
+{
+    // Lines of varying length, so records do not line up with the ring end
+    return QByteArray("line ") + QByteArray::number(i) + ' ' + QByteArray(i % 37, 'x');
+}
+
+// =============================================================================
+// Setup / Teardown
+// =============================================================================
+
+void TestFlightRecorder::initTestCase()
+{
+    QVERIFY(m_dir.isValid());
+    QVERIFY(cLogger::instance().init("TestFlightRecorder"));
+    cLogger::instance().setEchoToStandardOut(false);
+    cLogger::instance().setLoggerLevel(QtDebugMsg, "NextGenApp");
+}
+
+// =============================================================================
+// Tests
+// =============================================================================
+
+void TestFlightRecorder::testAppendRead()
+{
+    const QString path = m_dir.filePath("append.ring");
+    FlightRecorder recorder;
+    QVERIFY(recorder.open(path, 64 * 1024));
+    QCOMPARE(recorder.path(), path);
+    QCOMPARE(QFileInfo(path).size(), FlightRecorder::HEADER_SIZE + 64 * 1024);
+
+    for (int i = 0; i < 100; ++i) {
+        const QByteArray line = lineFor(i);
+        recorder.append(line.constData(), size_t(line.size()));
+    }
+    // Readable while the writer still has the file mapped
+    const QByteArrayList lines = FlightRecorder::read(path);
+    QCOMPARE(lines.size(), 100);
+    for (int i = 0; i < 100; ++i)
+        QCOMPARE(lines.at(i), lineFor(i));
+
+    recorder.close();
+    QVERIFY(!recorder.isOpen());
+    QCOMPARE(FlightRecorder::read(path).size(), 100);
+}
+
+void TestFlightRecorder::testWrapAround()
+{
+    const QString path = m_dir.filePath("wrap.ring");
+    FlightRecorder recorder;
+    QVERIFY(recorder.open(path, FlightRecorder::MIN_CAPACITY));
+
+    const int count = 2000;
+    for (int i = 0; i < count; ++i) {
+        const QByteArray line = lineFor(i);
+        recorder.append(line.constData(), size_t(line.size()));
+    }
+    const QByteArrayList lines = FlightRecorder::read(path);
+    QVERIFY(lines.size() > 20);
+    QVERIFY(lines.size() < count);
+    // The newest lines, without gaps
+    const int first = count - lines.size();
+    for (int i = 0; i < lines.size(); ++i)
+        QCOMPARE(lines.at(i), lineFor(first + i));
+
+    // Over-long lines are cut to a quarter of the ring
+    const QByteArray longLine(int(FlightRecorder::MIN_CAPACITY), 'L');
+    recorder.append(longLine.constData(), size_t(longLine.size()));
+    QCOMPARE(FlightRecorder::read(path).last(), longLine.left(int(FlightRecorder::MIN_CAPACITY / 4)));
+}
+
+void TestFlightRecorder::testReopen()
+{
+    const QString path = m_dir.filePath("reopen.ring");
+    {
+        FlightRecorder recorder;
+        QVERIFY(recorder.open(path, 16 * 1024));
+        for (int i = 0; i < 10; ++i)
+            recorder.append(lineFor(i).constData(), size_t(lineFor(i).size()));
+    }
+    {
+        FlightRecorder recorder;
+        QVERIFY(recorder.open(path, 16 * 1024));
+        for (int i = 10; i < 20; ++i)
+            recorder.append(lineFor(i).constData(), size_t(lineFor(i).size()));
+    }
+    QByteArrayList lines = FlightRecorder::read(path);
+    QCOMPARE(lines.size(), 20);
+    QCOMPARE(lines.first(), lineFor(0));
+    QCOMPARE(lines.last(), lineFor(19));
+
+    // A different size starts over
+    FlightRecorder recorder;
+    QVERIFY(recorder.open(path, 32 * 1024));
+    recorder.append("fresh", 5);
+    lines = FlightRecorder::read(path);
+    QCOMPARE(lines, QByteArrayList{ "fresh" });
+
+    QString error;
+    QVERIFY(FlightRecorder::read(m_dir.filePath("missing.ring"), &error).isEmpty());
+    QVERIFY(!error.isEmpty());
+}
+
+void TestFlightRecorder::testCorruptRecord()
+{
+    const QString path = m_dir.filePath("corrupt.ring");
+    {
+        FlightRecorder recorder;
+        QVERIFY(recorder.open(path, 16 * 1024));
+        for (int i = 0; i < 3; ++i)
+            recorder.append(lineFor(i).constData(), size_t(lineFor(i).size()));
+    }
+
+    // Damage the text of the second record, as a torn write would
+    QFile file(path);
+    QVERIFY(file.open(QIODevice::ReadWrite));
+    const qint64 second = FlightRecorder::HEADER_SIZE
+            + ((qint64(sizeof(FlightRecorder::RecordHeader)) + lineFor(0).size() + 7) & ~qint64(7));
+    QVERIFY(file.seek(second + qint64(sizeof(FlightRecorder::RecordHeader)) + 2));
+    QVERIFY(file.putChar('#'));
+    file.close();
+
+    const QByteArrayList lines = FlightRecorder::read(path);
+    QCOMPARE(lines, (QByteArrayList{ lineFor(0), lineFor(2) }));
+}
+
+void TestFlightRecorder::testKilledWriter()
+{
+#ifdef Q_OS_UNIX
+    const QString path = m_dir.filePath("killed.ring");
+    const pid_t child = fork();
+    QVERIFY(child >= 0);
+    if (child == 0) {
+        FlightRecorder recorder;
+        if (!recorder.open(path, 64 * 1024))
+            _exit(1);
+        for (int i = 0; i < 500; ++i)
+            recorder.append(lineFor(i).constData(), size_t(lineFor(i).size()));
+        // No close(), no msync(), no destructors
+        raise(SIGKILL);
+        _exit(2);
+    }
+    int status = 0;
+    QCOMPARE(waitpid(child, &status, 0), child);
+    QVERIFY(WIFSIGNALED(status));
+    QCOMPARE(WTERMSIG(status), SIGKILL);
+
+    const QByteArrayList lines = FlightRecorder::read(path);
+    QVERIFY(!lines.isEmpty());
+    QCOMPARE(lines.last(), lineFor(499));
+    const int first = 500 - lines.size();
+    for (int i = 0; i < lines.size(); ++i)
+        QCOMPARE(lines.at(i), lineFor(first + i));
+#else
+    QSKIP("Needs fork()");
+#endif
+}
+
+void TestFlightRecorder::testLoggerRing()
+{
+    const QString logPath = m_dir.filePath("logger.log");
+    cLogger::instance().setLogFilePath(logPath);
+    cLogger::instance().setFlightRecorder(64 * 1024);
+
+    for (int i = 0; i < 50; ++i)
+        qDebug("ring message %d", i);
+
+    // The ring has the lines without any flush of the log file
+    const QByteArrayList ring = FlightRecorder::read(logPath + ".ring");
+    QByteArrayList copied;
+    for (const QByteArray &line : ring) {
+        if (line.contains("ring message"))
+            copied.append(line);
+    }
+    QCOMPARE(copied.size(), 50);
+    QVERIFY(copied.last().endsWith("ring message 49"));
+
+    // Same bytes as the log file, once it is flushed
+    cLogger::instance().flush();
+    QFile file(logPath);
+    QVERIFY(file.open(QIODevice::ReadOnly));
+    QByteArrayList written;
+    while (!file.atEnd()) {
+        const QByteArray line = file.readLine();
+        if (line.contains("ring message"))
+            written.append(line.left(line.size() - 1));
+    }
+    QCOMPARE(written, copied);
+
+    cLogger::instance().setFlightRecorder(0);
+}
+
+// =============================================================================
+// Test Entry Point
+// =============================================================================
+
+QTEST_MAIN(TestFlightRecorder)
+#include "test_flightrecorder.moc"
@@ -0,0 +1,178 @@
+/**
+ * @file test_logcategories.cpp
+ * @brief Unit tests for the LogCategoryFilter per-module log levels.
+ *
+ * The tests use their own "ngtest.*" categories so that the results do
+ * not depend on Qt's own categories or on QT_LOGGING_RULES.
+ *
+ * The tests cover:
+ * - Severity ordering of message types
+ * - Prefix matching of modules against category names
+ * - Category flags updated at runtime, for existing and new categories
+ * - Disabled qCDebug() does not evaluate its message
+ *
+ * @author Gangadhar Thalange
+ * @date 2026-10-18
+ */
+
+#include <QtTest/QtTest>
+#include <QLoggingCategory>
+#include "logcategories.h"
+
+Q_LOGGING_CATEGORY(lcNgTest, "ngtest")
+Q_LOGGING_CATEGORY(lcNgTestDecode, "ngtest.decode")
+Q_LOGGING_CATEGORY(lcNgTestDecoder, "ngtest.decoder")
+
+/**
+ * @class TestLogCategories
+ * @brief Test fixture for LogCategoryFilter.
+ */
+class TestLogCategories : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    /**
+     * @brief Installs the filter.
+     */
+    void initTestCase();
+
+    /**
+     * @brief Resets all levels to debug.
+     */
+    void cleanup();
+
+    /**
+     * @brief Verify types are ranked debug < info < warning < critical < fatal.
+     */
+    void testSeverityOrder();
+
+    /**
+     * @brief Verify the longest matching module prefix applies.
+     */
+    void testPrefixMatching();
+
+    /**
+     * @brief Verify setLevel() updates existing category flags at once.
+     */
+    void testRuntimeUpdate();
+
+    /**
+     * @brief Verify a global level resets the module levels.
+     */
+    void testGlobalLevel();
+
+    /**
+     * @brief Verify categories created later get the level too.
+     */
+    void testNewCategory();
+
+    /**
+     * @brief Verify a disabled qCDebug() does not build its message.
+     */
+    void testDisabledMessageNotEvaluated();
+};
+
+// =============================================================================
+// Setup / Teardown
+// =============================================================================
+
+void TestLogCategories::initTestCase()
+{
+    LogCategoryFilter::install();
+    QVERIFY(lcNgTest().isDebugEnabled());
+}
+
+void TestLogCategories::cleanup()
+{
+    LogCategoryFilter::setLevel(QString(), QtDebugMsg);
+}
+
+// =============================================================================
+// Tests
+// =============================================================================
+
+void TestLogCategories::testSeverityOrder()
+{
+    QVERIFY(LogCategoryFilter::severity(QtDebugMsg) < LogCategoryFilter::severity(QtInfoMsg));
+    QVERIFY(LogCategoryFilter::severity(QtInfoMsg) < LogCategoryFilter::severity(QtWarningMsg));
+    QVERIFY(LogCategoryFilter::severity(QtWarningMsg) < LogCategoryFilter::severity(QtCriticalMsg));
+    QVERIFY(LogCategoryFilter::severity(QtCriticalMsg) < LogCategoryFilter::severity(QtFatalMsg));
+}
+
+void TestLogCategories::testPrefixMatching()
+{
+    LogCategoryFilter::setLevel("ngtest", QtWarningMsg);
+    LogCategoryFilter::setLevel("ngtest.decode", QtInfoMsg);
+
+    QCOMPARE(LogCategoryFilter::level("ngtest"), QtWarningMsg);
+    QCOMPARE(LogCategoryFilter::level("ngtest.decode"), QtInfoMsg);
+    QCOMPARE(LogCategoryFilter::level("ngtest.decode.can"), QtInfoMsg);
+    // "ngtest.decoder" is not inside module "ngtest.decode"
+    QCOMPARE(LogCategoryFilter::level("ngtest.decoder"), QtWarningMsg);
+    QCOMPARE(LogCategoryFilter::level("other"), QtDebugMsg);
+
+    QVERIFY(!LogCategoryFilter::isEnabled("ngtest", QtInfoMsg));
+    QVERIFY(LogCategoryFilter::isEnabled("ngtest.decode", QtInfoMsg));
+    QVERIFY(LogCategoryFilter::isEnabled("ngtest", QtFatalMsg));
+}
+
+void TestLogCategories::testRuntimeUpdate()
+{
+    LogCategoryFilter::setLevel("ngtest", QtWarningMsg);
+    QVERIFY(!lcNgTest().isDebugEnabled());
+    QVERIFY(!lcNgTest().isInfoEnabled());
+    QVERIFY(lcNgTest().isWarningEnabled());
+    QVERIFY(!lcNgTestDecoder().isDebugEnabled());
+
+    LogCategoryFilter::setLevel("ngtest.decode", QtDebugMsg);
+    QVERIFY(lcNgTestDecode().isDebugEnabled());
+    QVERIFY(!lcNgTest().isDebugEnabled());
+
+    // Lowering the level enables the category again
+    LogCategoryFilter::setLevel("ngtest", QtDebugMsg);
+    QVERIFY(lcNgTest().isDebugEnabled());
+}
+
+void TestLogCategories::testGlobalLevel()
+{
+    LogCategoryFilter::setLevel("ngtest.decode", QtDebugMsg);
+    LogCategoryFilter::setLevel(QString(), QtCriticalMsg);
+
+    QVERIFY(!lcNgTest().isWarningEnabled());
+    QVERIFY(!lcNgTestDecode().isDebugEnabled());
+    QVERIFY(lcNgTestDecode().isCriticalEnabled());
+    QVERIFY(!QLoggingCategory::defaultCategory()->isWarningEnabled());
+}
+
+void TestLogCategories::testNewCategory()
+{
+    LogCategoryFilter::setLevel("ngtest.late", QtWarningMsg);
+    QLoggingCategory late("ngtest.late.sub");
+    QVERIFY(!late.isDebugEnabled());
+    QVERIFY(late.isWarningEnabled());
+}
+
+void TestLogCategories::testDisabledMessageNotEvaluated()
+{
+    int evaluated = 0;
+    const auto expensive = [&evaluated]() {
+        ++evaluated;
+        return QString("expensive");
+    };
+
+    LogCategoryFilter::setLevel("ngtest", QtInfoMsg);
+    qCDebug(lcNgTest) << expensive();
+    QCOMPARE(evaluated, 0);
+
+    LogCategoryFilter::setLevel("ngtest", QtDebugMsg);
+    qCDebug(lcNgTest) << expensive();
+    QCOMPARE(evaluated, 1);
+}
+
+// =============================================================================
+// Test Entry Point
+// =============================================================================
+
+QTEST_MAIN(TestLogCategories)
+#include "test_logcategories.moc"
@@ -0,0 +1,156 @@
+/**
+ * @file test_logformat.cpp
+ * @brief Unit tests for the LogLineFormatter UTF-8 line buffer.
+ *
+ * Output is compared with what Qt produces for the same input, which is
+ * what cLogger wrote before the formatter was introduced.
+ *
+ * The tests cover:
+ * - Time stamps, including the per-second cache and times before 1970
+ * - UTF-16 to UTF-8 conversion with surrogate pairs and unpaired surrogates
+ * - Decimal numbers
+ * - Buffer reuse across lines
+ *
+ * @author Gangadhar Thalange
+ * @date 2026-10-18
+ */
+
+#include <QtTest/QtTest>
+#include <QDateTime>
+#include <limits>
+#include "logformat.h"
+
+/**
+ * @class TestLogFormat
+ * @brief Test fixture for LogLineFormatter.
+ */
+class TestLogFormat : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    /**
+     * @brief Verify time stamps match QDateTime for many times.
+     */
+    void testTimestamp();
+
+    /**
+     * @brief Verify cached seconds are refreshed when the second changes.
+     */
+    void testTimestampCache();
+
+    /**
+     * @brief Verify UTF-8 output matches QString::toUtf8().
+     */
+    void testUtf16Conversion();
+
+    /**
+     * @brief Verify numbers including zero, negatives and 64-bit limits.
+     */
+    void testNumbers();
+
+    /**
+     * @brief Verify clear() starts a new line without freeing the buffer.
+     */
+    void testBufferReused();
+
+private:
+    static QByteArray bytes(const LogLineFormatter &line)
+    {
+        return QByteArray(line.data(), int(line.size()));
+    }
+};
+
+// =============================================================================
+// Tests
+// =============================================================================
+
+void TestLogFormat::testTimestamp()
+{
+    LogLineFormatter line;
+    const qint64 times[] = { 0, 999, 1000, -1, -1001, 951782400000LL /* 2000-02-29 */,
+                             4107542399999LL /* 2100-02-28 23:59:59.999 */,
+                             1792300000123LL, 253402300799999LL /* 9999-12-31 */ };
+    for (qint64 ms : times) {
+        line.clear();
+        line.appendTimestamp(ms);
+        const QString expected = QDateTime::fromMSecsSinceEpoch(ms, Qt::UTC)
+                .toString("[yyyy/MM/dd HH:mm:ss.zzz]");
+        QCOMPARE(bytes(line), expected.toUtf8());
+    }
+
+    // A day's worth of seconds across a month and year boundary
+    for (qint64 ms = 1798761600000LL - 43200000LL; ms < 1798761600000LL + 43200000LL; ms += 7777) {
+        line.clear();
+        line.appendTimestamp(ms);
+        QCOMPARE(line.size(), LogLineFormatter::TIMESTAMP_SIZE);
+        QCOMPARE(bytes(line), QDateTime::fromMSecsSinceEpoch(ms, Qt::UTC)
+                 .toString("[yyyy/MM/dd HH:mm:ss.zzz]").toUtf8());
+    }
+}
+
+void TestLogFormat::testTimestampCache()
+{
+    LogLineFormatter line;
+    line.appendTimestamp(1792300000999LL);
+    line.appendTimestamp(1792300001000LL);
+    line.appendTimestamp(1792300000500LL);
+    const QByteArray expected =
+            QDateTime::fromMSecsSinceEpoch(1792300000999LL, Qt::UTC).toString("[yyyy/MM/dd HH:mm:ss.zzz]").toUtf8()
+            + QDateTime::fromMSecsSinceEpoch(1792300001000LL, Qt::UTC).toString("[yyyy/MM/dd HH:mm:ss.zzz]").toUtf8()
+            + QDateTime::fromMSecsSinceEpoch(1792300000500LL, Qt::UTC).toString("[yyyy/MM/dd HH:mm:ss.zzz]").toUtf8();
+    QCOMPARE(bytes(line), expected);
+}
+
+void TestLogFormat::testUtf16Conversion()
+{
+    const QString texts[] = {
+        QString("plain ascii"),
+        QString::fromUtf8("Temp 90 \xc2\xb0" "C, \xe2\x82\xac 5, \xe0\xa4\xb9"),
+        QString::fromUtf8("emoji \xf0\x9f\x9a\x9c tractor"),
+        QString(),
+    };
+    for (const QString &text : texts) {
+        LogLineFormatter line;
+        line.appendUtf16(reinterpret_cast<const char16_t *>(text.utf16()), size_t(text.size()));
+        QCOMPARE(bytes(line), text.toUtf8());
+    }
+
+    // Unpaired surrogates become U+FFFD
+    const char16_t broken[] = { u'a', 0xD800, u'b', 0xDC00 };
+    LogLineFormatter line;
+    line.appendUtf16(broken, 4);
+    QCOMPARE(bytes(line), QByteArray("a\xef\xbf\xbd" "b\xef\xbf\xbd"));
+}
+
+void TestLogFormat::testNumbers()
+{
+    LogLineFormatter line;
+    line.appendNumber(0);
+    line.append(' ');
+    line.appendNumber(-42);
+    line.append(' ');
+    line.appendNumber(std::numeric_limits<qint64>::max());
+    line.append(' ');
+    line.appendNumber(std::numeric_limits<qint64>::min());
+    QCOMPARE(bytes(line), QByteArray("0 -42 9223372036854775807 -9223372036854775808"));
+}
+
+void TestLogFormat::testBufferReused()
+{
+    LogLineFormatter line(64);
+    line.append(QByteArray(200, 'x').constData());
+    const char *grown = line.data();
+    line.clear();
+    QCOMPARE(line.size(), size_t(0));
+    line.append("short line");
+    QVERIFY(line.data() == grown);
+    QCOMPARE(bytes(line), QByteArray("short line"));
+}
+
+// =============================================================================
+// Test Entry Point
+// =============================================================================
+
+QTEST_MAIN(TestLogFormat)
+#include "test_logformat.moc"
@@ -17,13 +17,17 @@
  * - All setter methods
  * - Assignment operator
  * - Edge cases with special characters and boundary values
+ * - LogContext: interning, capture and conversion to LogMessageContext
  *
  * @author Gangadhar Thalange
  * @date 2026-01-13
  */
 
 #include <QtTest/QtTest>
+#include <QThread>
+#include <cstring>
 #include "clogger.h"
+#include "logcontext.h"
 
 /**
  * @class TestLogMessageContext
@@ -167,6 +171,40 @@ private slots:
      * @brief Test handling of maximum integer line number.
      */
     void testMaxLineNumber();
+
+    // =========================================================================
+    // LogContext Tests
+    // =========================================================================
+
+    /**
+     * @brief Test LogContext copies as plain bytes.
+     */
+    void testLogContextIsPlainValue();
+
+    /**
+     * @brief Test equal strings intern to one pointer.
+     */
+    void testInternDeduplicates();
+
+    /**
+     * @brief Test a reused buffer is interned by content.
+     */
+    void testInternReusedBuffer();
+
+    /**
+     * @brief Test name IDs round-trip and 0 is the empty name.
+     */
+    void testInternName();
+
+    /**
+     * @brief Test capture() records the thread and module.
+     */
+    void testCapture();
+
+    /**
+     * @brief Test conversion of a LogContext to a LogMessageContext.
+     */
+    void testFromLogContext();
 };
 
 // =============================================================================
@@ -402,6 +440,99 @@ void TestLogMessageContext::testMaxLineNumber()
     QCOMPARE(context.lineNumber(), INT32_MAX);
 }
 
+// =============================================================================
+// LogContext Tests
+// =============================================================================
+
+void TestLogMessageContext::testLogContextIsPlainValue()
+{
+    QVERIFY(std::is_trivially_copyable<LogContext>::value);
+    QVERIFY(sizeof(LogContext) <= 2 * sizeof(void *) + 8);
+
+    const LogContext source = LogContext::capture("plain.cpp", "plainFunc", 7, "App");
+    LogContext copy;
+    memcpy(&copy, &source, sizeof(LogContext));
+    QCOMPARE(copy.fileName(), QString("plain.cpp"));
+    QCOMPARE(copy.functionName(), QString("plainFunc"));
+    QCOMPARE(copy.line, 7);
+    QCOMPARE(copy.moduleName(), QString("App"));
+
+    const LogContext empty;
+    QCOMPARE(empty.fileName(), QString());
+    QCOMPARE(empty.threadName(), QString());
+}
+
+void TestLogMessageContext::testInternDeduplicates()
+{
+    char first[] = "dedup.cpp";
+    char second[] = "dedup.cpp";
+    const char *a = LogContext::intern(first);
+    const char *b = LogContext::intern(second);
+    QCOMPARE(a, b);
+    QVERIFY(a != first);
+    QCOMPARE(QString(a), QString("dedup.cpp"));
+    QCOMPARE(QString(LogContext::intern(nullptr)), QString(""));
+}
+
+void TestLogMessageContext::testInternReusedBuffer()
+{
+    char buffer[32];
+    strcpy(buffer, "reused_a.cpp");
+    const char *a = LogContext::intern(buffer);
+    strcpy(buffer, "reused_b.cpp");
+    const char *b = LogContext::intern(buffer);
+    QVERIFY(a != b);
+    QCOMPARE(QString(a), QString("reused_a.cpp"));
+    QCOMPARE(QString(b), QString("reused_b.cpp"));
+}
+
+void TestLogMessageContext::testInternName()
+{
+    QCOMPARE(LogContext::internName(QString()), quint16(0));
+    QCOMPARE(LogContext::name(0), QString());
+    const quint16 id = LogContext::internName("Ingest");
+    QVERIFY(id != 0);
+    QCOMPARE(LogContext::internName("Ingest"), id);
+    QCOMPARE(LogContext::name(id), QString("Ingest"));
+    QVERIFY(LogContext::internName("Render") != id);
+    QCOMPARE(LogContext::name(0xFFFF), QString());
+}
+
+void TestLogMessageContext::testCapture()
+{
+    LogContext captured;
+    QThread *thread = QThread::create([&captured]() {
+        captured = LogContext::capture(__FILE__, Q_FUNC_INFO, __LINE__, "QML");
+    });
+    thread->setObjectName("CaptureWorker");
+    thread->start();
+    QVERIFY(thread->wait(5000));
+    delete thread;
+
+    QCOMPARE(captured.threadName(), QString("CaptureWorker"));
+    QCOMPARE(captured.moduleName(), QString("QML"));
+    QCOMPARE(captured.fileName(), QString(__FILE__));
+    QVERIFY(captured.line > 0);
+
+    // A renamed thread is picked up by the next capture
+    QThread::currentThread()->setObjectName("CaptureMainA");
+    QCOMPARE(LogContext::capture("", "", 0, "App").threadName(), QString("CaptureMainA"));
+    QThread::currentThread()->setObjectName("CaptureMainB");
+    QCOMPARE(LogContext::capture("", "", 0, "App").threadName(), QString("CaptureMainB"));
+}
+
+void TestLogMessageContext::testFromLogContext()
+{
+    QThread::currentThread()->setObjectName("Converter");
+    const LogContext source = LogContext::capture("convert.cpp", "convertFunc", 321, "App");
+    LogMessageContext context(source);
+    QCOMPARE(context.threadName(), QString("Converter"));
+    QCOMPARE(context.moduleName(), QString("App"));
+    QCOMPARE(context.fileName(), QString("convert.cpp"));
+    QCOMPARE(context.functionName(), QString("convertFunc"));
+    QCOMPARE(context.lineNumber(), 321);
+}
+
 // =============================================================================
 // Test Entry Point
 // =============================================================================
@@ -0,0 +1,356 @@
+/**
+ * @file test_logstreamserver.cpp
+ * @brief Unit tests for the live log stream on a Unix-domain socket.
+ *
+ * The tests cover:
+ * - A client receives the lines logged after it connected
+ * - Level and module filters
+ * - A client that does not read loses lines, which are counted and
+ *   reported to it, while logging continues
+ * - Disconnects, stale socket files and stopping the server
+ *
+ * @author Gangadhar Thalange
+ * @date 2026-10-18
+ */
+
+#include <QtTest/QtTest>
+#include <QTemporaryDir>
+#include <QFile>
+#include <QRegularExpression>
+#include "clogger.h"
+#include "logstreamserver.h"
+
+#ifdef Q_OS_UNIX
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#endif
+
+Q_LOGGING_CATEGORY(lcStreamTest, "ngapp.streamtest.sub")
+Q_LOGGING_CATEGORY(lcStreamOther, "ngapp.streamother")
+
+/**
+ * @class TestLogStreamServer
+ * @brief Test fixture for LogStreamServer and cLogger::setLogStreamSocket().
+ */
+class TestLogStreamServer : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    /**
+     * @brief Installs the handler.
+     */
+    void initTestCase();
+
+    /**
+     * @brief Verify a connected client receives new lines.
+     */
+    void testStreamLines();
+
+    /**
+     * @brief Verify the level and module filter.
+     */
+    void testFilter();
+
+    /**
+     * @brief Verify a client that does not read only loses its own lines.
+     */
+    void testSlowClientDrops();
+
+    /**
+     * @brief Verify disconnects, stale sockets and stopping.
+     */
+    void testLifecycle();
+
+private:
+    /**
+     * @brief Connects to @p path, returns the socket or -1.
+     */
+    static int connectTo(const QString &path);
+
+    /**
+     * @brief Reads from @p fd into @p received until it contains @p until.
+     */
+    static bool readUntil(int fd, QByteArray &received, const QByteArray &until, int timeoutMs = 5000);
+
+    /**
+     * @brief Reads from @p fd into @p received until nothing arrives for 200 ms.
+     */
+    static void drain(int fd, QByteArray &received);
+
+    /**
+     * @brief Sends @p command and waits for the server's answer to an
+     *        unknown command, so the command has been applied.
+     */
+    static bool sendCommand(int fd, const QByteArray &command);
+
+    QTemporaryDir m_dir;
+};
+
+// =============================================================================
+// Helpers
+// =============================================================================
+
+int TestLogStreamServer::connectTo(const QString &path)
+{
+#ifdef Q_OS_UNIX
+    sockaddr_un address;
+    memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+    const QByteArray native = QFile::encodeName(path);
+    memcpy(address.sun_path, native.constData(), size_t(native.size()));
+    const int fd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd >= 0 && ::connect(fd, reinterpret_cast<const sockaddr *>(&address), sizeof(address)) == 0)
+        return fd;
+    if (fd >= 0)
+        ::close(fd);
+#else
+    Q_UNUSED(path);
+#endif
+    return -1;
+}
+
+bool TestLogStreamServer::readUntil(int fd, QByteArray &received, const QByteArray &until, int timeoutMs)
+{
+#ifdef Q_OS_UNIX
+    QElapsedTimer timer;
+    timer.start();
+    while (!received.contains(until)) {
+        const qint64 left = timeoutMs - timer.elapsed();
+        if (left <= 0)
+            return false;
+        pollfd pfd = { fd, POLLIN, 0 };
+        if (::poll(&pfd, 1, int(left)) <= 0)
+            continue;
+        char buffer[65536];
+        const ssize_t count = ::read(fd, buffer, sizeof(buffer));
+        if (count <= 0)
+            return false;
+        received.append(buffer, int(count));
+    }
+    return true;
+#else
+    Q_UNUSED(fd);
+    Q_UNUSED(received);
+    Q_UNUSED(until);
+    Q_UNUSED(timeoutMs);
+    return false;
+#endif
+}
+
+void TestLogStreamServer::drain(int fd, QByteArray &received)
+{
+#ifdef Q_OS_UNIX
+    for (;;) {
+        pollfd pfd = { fd, POLLIN, 0 };
+        if (::poll(&pfd, 1, 200) <= 0)
+            return;
+        char buffer[65536];
+        const ssize_t count = ::read(fd, buffer, sizeof(buffer));
+        if (count <= 0)
+            return;
+        received.append(buffer, int(count));
+    }
+#else
+    Q_UNUSED(fd);
+    Q_UNUSED(received);
+#endif
+}
+
+bool TestLogStreamServer::sendCommand(int fd, const QByteArray &command)
+{
+#ifdef Q_OS_UNIX
+    const QByteArray data = command + "\nsync\n";
+    if (::write(fd, data.constData(), size_t(data.size())) != data.size())
+        return false;
+    QByteArray received;
+    return readUntil(fd, received, "-- unknown command: sync --\n");
+#else
+    Q_UNUSED(fd);
+    Q_UNUSED(command);
+    return false;
+#endif
+}
+
+// =============================================================================
+// Setup / Teardown
+// =============================================================================
+
+void TestLogStreamServer::initTestCase()
+{
+#ifndef Q_OS_UNIX
+    QSKIP("Needs Unix-domain sockets");
+#endif
+    QVERIFY(m_dir.isValid());
+    QVERIFY(cLogger::instance().init("TestLogStreamServer"));
+    cLogger::instance().setEchoToStandardOut(false);
+    cLogger::instance().setLoggerLevel(QtDebugMsg, "NextGenApp");
+    // Each call adds its type to the logged ones, as in main.cpp
+    cLogger::instance().setLoggerLevel(QtWarningMsg, "NextGenApp");
+    cLogger::instance().setLogFilePath(m_dir.filePath("stream.log"));
+}
+
+// =============================================================================
+// Tests
+// =============================================================================
+
+void TestLogStreamServer::testStreamLines()
+{
+    const QString path = m_dir.filePath("lines.sock");
+    QVERIFY(cLogger::instance().setLogStreamSocket(path));
+    QCOMPARE(cLogger::instance().logStreamSocket(), path);
+
+    const int fd = connectTo(path);
+    QVERIFY(fd >= 0);
+    QVERIFY(sendCommand(fd, "filter debug"));
+
+    // Messages must differ, identical ones are folded into a repeat count
+    for (int i = 0; i < 100; ++i)
+        qDebug("stream-msg %d", i);
+    cLogger::instance().flush();
+
+    QByteArray received;
+    QVERIFY(readUntil(fd, received, "stream-msg 99\n"));
+    const QList<QByteArray> lines = received.split('\n');
+    int next = 0;
+    for (const QByteArray &line : lines) {
+        if (line.contains("stream-msg")) {
+            QVERIFY(line.endsWith("stream-msg " + QByteArray::number(next)));
+            ++next;
+        }
+    }
+    QCOMPARE(next, 100);
+
+    ::close(fd);
+    QVERIFY(cLogger::instance().setLogStreamSocket(QString()));
+    QVERIFY(cLogger::instance().logStreamSocket().isEmpty());
+}
+
+void TestLogStreamServer::testFilter()
+{
+    const QString path = m_dir.filePath("filter.sock");
+    QVERIFY(cLogger::instance().setLogStreamSocket(path));
+    const int fd = connectTo(path);
+    QVERIFY(fd >= 0);
+    QVERIFY(sendCommand(fd, "filter warning ngapp.streamtest"));
+
+    qCDebug(lcStreamTest) << "filter-debug";
+    qCWarning(lcStreamOther) << "filter-other";
+    qWarning() << "filter-default";
+    qCWarning(lcStreamTest) << "filter-pass";
+    qCCritical(lcStreamTest) << "filter-end";
+    cLogger::instance().flush();
+
+    QByteArray received;
+    QVERIFY(readUntil(fd, received, "filter-end"));
+    QVERIFY(received.contains("filter-pass"));
+    QVERIFY(!received.contains("filter-debug"));
+    QVERIFY(!received.contains("filter-other"));
+    QVERIFY(!received.contains("filter-default"));
+
+    // A new filter replaces the old one
+    QVERIFY(sendCommand(fd, "filter debug"));
+    qWarning() << "filter-all";
+    cLogger::instance().flush();
+    QVERIFY(readUntil(fd, received, "filter-all"));
+
+    ::close(fd);
+    cLogger::instance().setLogStreamSocket(QString());
+}
+
+void TestLogStreamServer::testSlowClientDrops()
+{
+    const QString path = m_dir.filePath("slow.sock");
+    LogStreamServer server;
+    QVERIFY(server.start(path, 4096));
+    const int fd = connectTo(path);
+    QVERIFY(fd >= 0);
+    QVERIFY(sendCommand(fd, "filter debug"));
+
+    // The client does not read; logging must not wait for it
+    const int total = 20000;
+    QElapsedTimer timer;
+    timer.start();
+    for (int i = 0; i < total; ++i)
+        qDebug("slow-msg %d", i);
+    cLogger::instance().flush();
+    QVERIFY(timer.elapsed() < 30000);
+    QTRY_VERIFY(server.droppedLines() > 0);
+
+    // Once the client reads again, it learns how many lines it missed
+    QByteArray received;
+    drain(fd, received);
+    qDebug("slow-end");
+    cLogger::instance().flush();
+    QVERIFY(readUntil(fd, received, "slow-end"));
+
+    int lines = 0;
+    quint64 reported = 0;
+    static const QRegularExpression notice("^-- (\\d+) lines dropped --$");
+    for (const QByteArray &line : received.split('\n')) {
+        if (line.contains("slow-msg"))
+            ++lines;
+        const QRegularExpressionMatch match = notice.match(QString::fromUtf8(line));
+        if (match.hasMatch())
+            reported += match.captured(1).toULongLong();
+    }
+    QVERIFY(reported > 0);
+    QCOMPARE(quint64(lines) + reported, quint64(total));
+    QCOMPARE(reported, server.droppedLines());
+    ::close(fd);
+}
+
+void TestLogStreamServer::testLifecycle()
+{
+#ifdef Q_OS_UNIX
+    const QString path = m_dir.filePath("life.sock");
+
+    // A socket file left behind by a crashed process
+    {
+        sockaddr_un address;
+        memset(&address, 0, sizeof(address));
+        address.sun_family = AF_UNIX;
+        const QByteArray native = QFile::encodeName(path);
+        memcpy(address.sun_path, native.constData(), size_t(native.size()));
+        const int stale = ::socket(AF_UNIX, SOCK_STREAM, 0);
+        QCOMPARE(::bind(stale, reinterpret_cast<const sockaddr *>(&address), sizeof(address)), 0);
+        ::close(stale);
+    }
+    QVERIFY(QFile::exists(path));
+
+    LogStreamServer server;
+    QVERIFY(server.start(path));
+    QVERIFY(server.isRunning());
+
+    const int fd = connectTo(path);
+    QVERIFY(fd >= 0);
+    QTRY_COMPARE(server.clientCount(), 1);
+    ::close(fd);
+    QTRY_COMPARE(server.clientCount(), 0);
+
+    const int open = connectTo(path);
+    QVERIFY(open >= 0);
+    QTRY_COMPARE(server.clientCount(), 1);
+    server.stop();
+    QVERIFY(!server.isRunning());
+    QVERIFY(!QFile::exists(path));
+    QCOMPARE(server.clientCount(), 0);
+    // The server closed the connection
+    char byte;
+    QCOMPARE(int(::read(open, &byte, 1)), 0);
+    ::close(open);
+
+    QVERIFY(!server.start(m_dir.filePath(QString(200, 'x'))));
+    QVERIFY(!cLogger::instance().setLogStreamSocket(m_dir.filePath("missing/dir.sock")));
+    QVERIFY(cLogger::instance().logStreamSocket().isEmpty());
+#endif
+}
+
+// =============================================================================
+// Test Entry Point
+// =============================================================================
+
+QTEST_MAIN(TestLogStreamServer)
+#include "test_logstreamserver.moc"
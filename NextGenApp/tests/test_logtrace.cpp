@@ -0,0 +1,178 @@
+/**
+ * @file test_logtrace.cpp
+ * @brief Unit tests for the NG_DEBUG()/NG_INFO()/NG_WARNING() trace macros.
+ *
+ * This file is built with NG_LOG_MIN_LEVEL set to info, as the
+ * application is in non-Debug builds, and captures messages with its own
+ * message handler.
+ *
+ * The tests cover:
+ * - Debug messages (stream, printf and NG_BINLOG()) are compiled out and
+ *   never evaluate their arguments, even with the category enabled
+ * - Compiled-in levels check the category before evaluating arguments
+ * - Messages keep their category, file and line
+ *
+ * @author Gangadhar Thalange
+ * @date 2026-10-18
+ */
+
+#define NG_LOG_MIN_LEVEL 1
+
+#include <QtTest/QtTest>
+#include <QLoggingCategory>
+#include "logtrace.h"
+#include "binlog.h"
+
+Q_LOGGING_CATEGORY(lcTrace, "ngtest.trace")
+
+static_assert(!NgLog::compiledIn(QtDebugMsg), "debug is below the minimum level");
+static_assert(NgLog::compiledIn(QtInfoMsg), "info is the minimum level");
+static_assert(NgLog::compiledIn(QtCriticalMsg), "critical is never compiled out");
+
+/**
+ * @brief A message seen by the test handler.
+ */
+struct TraceMessage
+{
+    QtMsgType type;
+    QString category;
+    QString file;
+    int line;
+    QString text;
+};
+
+static QList<TraceMessage> g_messages;
+
+static void traceHandler(QtMsgType type, const QMessageLogContext &context, const QString &msg)
+{
+    g_messages.append({ type, QString(context.category), QString(context.file), context.line, msg });
+}
+
+/**
+ * @class TestLogTrace
+ * @brief Test fixture for the trace macros.
+ */
+class TestLogTrace : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    /**
+     * @brief Installs the capturing message handler.
+     */
+    void initTestCase();
+
+    /**
+     * @brief Restores the default message handler.
+     */
+    void cleanupTestCase();
+
+    /**
+     * @brief Enables every level of the test category and clears messages.
+     */
+    void init();
+
+    /**
+     * @brief Verify debug messages are compiled out.
+     */
+    void testDebugCompiledOut();
+
+    /**
+     * @brief Verify NG_BINLOG() debug messages are compiled out.
+     */
+    void testBinLogCompiledOut();
+
+    /**
+     * @brief Verify a disabled category does not evaluate arguments.
+     */
+    void testRuntimeCategoryCheck();
+
+    /**
+     * @brief Verify stream and printf messages reach the handler.
+     */
+    void testMessagesLogged();
+
+private:
+    int sideEffect() { return ++m_evaluated; }
+
+    int m_evaluated = 0;
+    QtMessageHandler m_previousHandler = nullptr;
+};
+
+// =============================================================================
+// Setup / Teardown
+// =============================================================================
+
+void TestLogTrace::initTestCase()
+{
+    m_previousHandler = qInstallMessageHandler(traceHandler);
+}
+
+void TestLogTrace::cleanupTestCase()
+{
+    qInstallMessageHandler(m_previousHandler);
+}
+
+void TestLogTrace::init()
+{
+    lcTrace().setEnabled(QtDebugMsg, true);
+    lcTrace().setEnabled(QtInfoMsg, true);
+    lcTrace().setEnabled(QtWarningMsg, true);
+    g_messages.clear();
+    m_evaluated = 0;
+}
+
+// =============================================================================
+// Tests
+// =============================================================================
+
+void TestLogTrace::testDebugCompiledOut()
+{
+    NG_DEBUG(lcTrace) << "stream" << sideEffect();
+    NG_DEBUG(lcTrace, "printf %d", sideEffect());
+    QCOMPARE(m_evaluated, 0);
+    QVERIFY(g_messages.isEmpty());
+}
+
+void TestLogTrace::testBinLogCompiledOut()
+{
+    NG_BINLOG(lcTrace, QtDebugMsg, "[MAIN] Safety Button Index: %d State: %s", sideEffect(), "true");
+    QCOMPARE(m_evaluated, 0);
+    QVERIFY(g_messages.isEmpty());
+}
+
+void TestLogTrace::testRuntimeCategoryCheck()
+{
+    lcTrace().setEnabled(QtInfoMsg, false);
+    lcTrace().setEnabled(QtWarningMsg, false);
+    NG_INFO(lcTrace) << "stream" << sideEffect();
+    NG_WARNING(lcTrace, "printf %d", sideEffect());
+    QCOMPARE(m_evaluated, 0);
+    QVERIFY(g_messages.isEmpty());
+}
+
+void TestLogTrace::testMessagesLogged()
+{
+    const int line = __LINE__ + 1;
+    NG_INFO(lcTrace) << "value:" << sideEffect();
+    NG_WARNING(lcTrace, "printf %d", sideEffect());
+    QCOMPARE(m_evaluated, 2);
+    QCOMPARE(g_messages.size(), 2);
+
+    QCOMPARE(g_messages.at(0).type, QtInfoMsg);
+    QCOMPARE(g_messages.at(0).text, QString("value: 1"));
+    QCOMPARE(g_messages.at(0).category, QString("ngtest.trace"));
+    QCOMPARE(g_messages.at(0).line, line);
+    QVERIFY(g_messages.at(0).file.endsWith("test_logtrace.cpp"));
+
+    QCOMPARE(g_messages.at(1).type, QtWarningMsg);
+    QCOMPARE(g_messages.at(1).text, QString("printf 2"));
+    QCOMPARE(g_messages.at(1).category, QString("ngtest.trace"));
+}
+
+// =============================================================================
+// Test Entry Point
+// =============================================================================
+
+QTEST_MAIN(TestLogTrace)
+#include "test_logtrace.moc"
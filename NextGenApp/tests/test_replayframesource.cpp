@@ -0,0 +1,357 @@
+/**
+ * @file test_replayframesource.cpp
+ * @brief Unit tests for CaptureReader and ReplayFrameSource.
+ *
+ * Capture files with chosen timestamps are written directly in the
+ * captureformat.h layout, so timing and seek behaviour can be checked
+ * without recording real traffic.
+ *
+ * The tests cover:
+ * - Rejection of files that are not captures
+ * - Seek by time through the segment index
+ * - Original timing and speed scaling
+ * - As-fast-as-possible mode, skipping of short records and delivery of
+ *   truncated ones
+ * - Start offset, loop mode and stop during a long gap
+ * - Recorded time stamps passed to a timed frame handler
+ *
+ * @author Gangadhar Thalange
+ * @date 2026-10-18
+ */
+
+#include <QtTest/QtTest>
+#include <QTemporaryDir>
+#include <QElapsedTimer>
+#include <QSignalSpy>
+#include <QMutex>
+#include <atomic>
+#include <cstring>
+#include "capturereader.h"
+#include "replayframesource.h"
+
+using Capture::CaptureHeader;
+using Capture::CaptureRecord;
+
+/**
+ * @class TestReplayFrameSource
+ * @brief Test fixture for capture reading and replay.
+ */
+class TestReplayFrameSource : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    // =========================================================================
+    // Reader Tests
+    // =========================================================================
+
+    /**
+     * @brief Verify non-capture files are rejected.
+     */
+    void testReaderRejectsInvalidFile();
+
+    /**
+     * @brief Verify indexAtTime() across segment boundaries.
+     */
+    void testReaderSeekByTime();
+
+    // =========================================================================
+    // Replay Tests
+    // =========================================================================
+
+    /**
+     * @brief Verify speed 0 delivers every valid frame immediately.
+     */
+    void testFastModeDeliversAllFrames();
+
+    /**
+     * @brief Verify speed 1 reproduces the recorded duration.
+     */
+    void testOriginalTiming();
+
+    /**
+     * @brief Verify speed 4 shortens the recorded duration.
+     */
+    void testSpeedFactor();
+
+    /**
+     * @brief Verify a timed handler gets the recorded time at any speed.
+     */
+    void testRecordedTimestamps();
+
+    /**
+     * @brief Verify the start offset skips earlier frames.
+     */
+    void testStartOffset();
+
+    /**
+     * @brief Verify loop mode replays until stopped.
+     */
+    void testLoop();
+
+    /**
+     * @brief Verify stop() interrupts a wait for a distant frame.
+     */
+    void testStopDuringGapIsFast();
+
+private:
+    /**
+     * @brief Writes a capture with one frame per timestamp.
+     *
+     * Frame i has id i and payload byte 0 = i. Record @p shortRecord is
+     * flagged short, record @p truncatedRecord truncated.
+     */
+    QString writeCapture(const QString &name, const QVector<quint64> &timesNs,
+                         quint32 segmentRecords = Capture::DEFAULT_SEGMENT_RECORDS,
+                         int shortRecord = -1, int truncatedRecord = -1);
+
+    QTemporaryDir m_dir;
+};
+
+// =============================================================================
+// Helpers
+// =============================================================================
+
+QString TestReplayFrameSource::writeCapture(const QString &name, const QVector<quint64> &timesNs,
+                                            quint32 segmentRecords, int shortRecord,
+                                            int truncatedRecord)
+{
+    CaptureHeader header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, Capture::MAGIC, sizeof(Capture::MAGIC));
+    header.version = Capture::VERSION;
+    header.headerSize = Capture::CAPTURE_HEADER_SIZE;
+    header.recordSize = sizeof(CaptureRecord);
+    header.segmentRecords = segmentRecords;
+    header.recordCount = quint64(timesNs.size());
+
+    QByteArray records;
+    for (int i = 0; i < timesNs.size(); ++i) {
+        if (i % int(segmentRecords) == 0) {
+            header.segmentFirstNs[header.segmentCount] = timesNs.at(i);
+            ++header.segmentCount;
+        }
+        CaptureRecord record;
+        memset(&record, 0, sizeof(record));
+        record.tNs = timesNs.at(i);
+        record.id = uint32_t(i);
+        record.length = 8;
+        record.payload[0] = uint8_t(i);
+        if (i == shortRecord) {
+            record.length = 2;
+            record.flags = Capture::FlagShort;
+        }
+        if (i == truncatedRecord)
+            record.flags = Capture::FlagTruncated;
+        records.append(reinterpret_cast<const char *>(&record), sizeof(record));
+    }
+
+    const QString path = m_dir.filePath(name);
+    QFile file(path);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate))
+        return QString();
+    file.write(reinterpret_cast<const char *>(&header), sizeof(header));
+    file.write(records);
+    return path;
+}
+
+static QVector<quint64> evenlySpaced(int count, quint64 stepMs)
+{
+    QVector<quint64> times;
+    for (int i = 0; i < count; ++i)
+        times.append(quint64(i) * stepMs * 1000000ULL);
+    return times;
+}
+
+// =============================================================================
+// Reader Tests
+// =============================================================================
+
+void TestReplayFrameSource::testReaderRejectsInvalidFile()
+{
+    // A text file is neither mapped as capture nor crashes the reader
+    const QString path = m_dir.filePath("not_a_capture.txt");
+    QFile file(path);
+    QVERIFY(file.open(QIODevice::WriteOnly));
+    file.write(QByteArray(Capture::CAPTURE_HEADER_SIZE * 2, 'x'));
+    file.close();
+
+    CaptureReader reader;
+    QVERIFY(!reader.open(path));
+    QVERIFY(!reader.isOpen());
+    QVERIFY(!reader.errorString().isEmpty());
+    QVERIFY(!reader.open(m_dir.filePath("missing.ngcap")));
+}
+
+void TestReplayFrameSource::testReaderSeekByTime()
+{
+    // 25 frames 10 ms apart in segments of 10 records
+    const QString path = writeCapture("seek.ngcap", evenlySpaced(25, 10), 10);
+    CaptureReader reader;
+    QVERIFY(reader.open(path));
+    QCOMPARE(reader.recordCount(), quint64(25));
+    QCOMPARE(reader.durationNs(), quint64(240) * 1000000ULL);
+
+    QCOMPARE(reader.indexAtTime(0), quint64(0));
+    QCOMPARE(reader.indexAtTime(50 * 1000000ULL), quint64(5));
+    QCOMPARE(reader.indexAtTime(95 * 1000000ULL), quint64(10));   // next segment start
+    QCOMPARE(reader.indexAtTime(100 * 1000000ULL), quint64(10));
+    QCOMPARE(reader.indexAtTime(201 * 1000000ULL), quint64(21));
+    QCOMPARE(reader.indexAtTime(500 * 1000000ULL), quint64(25));  // past the end
+}
+
+// =============================================================================
+// Replay Tests
+// =============================================================================
+
+void TestReplayFrameSource::testFastModeDeliversAllFrames()
+{
+    // One second of recorded traffic is replayed without waiting; the
+    // flagged short record is not delivered, the truncated one is
+    const QString path = writeCapture("fast.ngcap", evenlySpaced(1001, 1), 1u << 20, 7, 9);
+    ReplayFrameSource replay(path);
+    replay.setSpeed(0);
+    std::atomic<int> received{0};
+    std::atomic<bool> sawShort{false};
+    std::atomic<bool> sawTruncated{false};
+    replay.setFrameHandler([&](uint32_t id, const QByteArray &payload) {
+        if (id == 7)
+            sawShort = true;
+        if (id == 9)
+            sawTruncated = true;
+        if (payload.size() == 8)
+            ++received;
+    });
+    QSignalSpy finishedSpy(&replay, &ReplayFrameSource::finished);
+
+    QElapsedTimer timer;
+    timer.start();
+    QVERIFY(replay.start());
+    QTRY_COMPARE(finishedSpy.count(), 1);
+
+    QVERIFY(timer.elapsed() < 500);
+    QCOMPARE(received.load(), 1000);
+    QVERIFY(!sawShort.load());
+    QVERIFY(sawTruncated.load());
+    QCOMPARE(replay.framesDelivered(), quint64(1000));
+}
+
+void TestReplayFrameSource::testOriginalTiming()
+{
+    // 11 frames over 200 ms take about 200 ms to replay
+    const QString path = writeCapture("timing.ngcap", evenlySpaced(11, 20));
+    ReplayFrameSource replay(path);
+    QSignalSpy finishedSpy(&replay, &ReplayFrameSource::finished);
+
+    QElapsedTimer timer;
+    timer.start();
+    QVERIFY(replay.start());
+    QTRY_COMPARE(finishedSpy.count(), 1);
+    const qint64 elapsed = timer.elapsed();
+
+    QVERIFY2(elapsed >= 190 && elapsed < 600, qPrintable(QString("replay took %1 ms").arg(elapsed)));
+    QCOMPARE(replay.framesDelivered(), quint64(11));
+}
+
+void TestReplayFrameSource::testSpeedFactor()
+{
+    // 400 ms of traffic at 4x takes about 100 ms
+    const QString path = writeCapture("speed.ngcap", evenlySpaced(21, 20));
+    ReplayFrameSource replay(path);
+    replay.setSpeed(4.0);
+    QSignalSpy finishedSpy(&replay, &ReplayFrameSource::finished);
+
+    QElapsedTimer timer;
+    timer.start();
+    QVERIFY(replay.start());
+    QTRY_COMPARE(finishedSpy.count(), 1);
+    const qint64 elapsed = timer.elapsed();
+
+    QVERIFY2(elapsed >= 95 && elapsed < 350, qPrintable(QString("replay took %1 ms").arg(elapsed)));
+}
+
+void TestReplayFrameSource::testRecordedTimestamps()
+{
+    const QVector<quint64> times = evenlySpaced(10, 100);
+    const QString path = writeCapture("timestamps.ngcap", times);
+    ReplayFrameSource replay(path);
+    replay.setSpeed(0);
+    QMutex mutex;
+    QVector<qint64> received;
+    replay.setTimedFrameHandler([&](uint32_t, const QByteArray &, qint64 timeNs) {
+        QMutexLocker locker(&mutex);
+        received.append(timeNs);
+    });
+    QSignalSpy finishedSpy(&replay, &ReplayFrameSource::finished);
+
+    // One second of recorded time, delivered at once
+    QVERIFY(replay.start());
+    QTRY_COMPARE(finishedSpy.count(), 1);
+    QMutexLocker locker(&mutex);
+    QCOMPARE(received.size(), times.size());
+    for (int i = 0; i < times.size(); ++i)
+        QCOMPARE(received.at(i), qint64(times.at(i)));
+}
+
+void TestReplayFrameSource::testStartOffset()
+{
+    // Starting 100 ms in skips the first ten frames
+    const QString path = writeCapture("offset.ngcap", evenlySpaced(20, 10), 8);
+    ReplayFrameSource replay(path);
+    replay.setSpeed(0);
+    replay.setStartOffsetMs(100);
+    std::atomic<int> firstId{-1};
+    replay.setFrameHandler([&](uint32_t id, const QByteArray &) {
+        int expected = -1;
+        firstId.compare_exchange_strong(expected, int(id));
+    });
+    QSignalSpy finishedSpy(&replay, &ReplayFrameSource::finished);
+
+    QVERIFY(replay.start());
+    QTRY_COMPARE(finishedSpy.count(), 1);
+    QCOMPARE(firstId.load(), 10);
+    QCOMPARE(replay.framesDelivered(), quint64(10));
+}
+
+void TestReplayFrameSource::testLoop()
+{
+    // Loop mode keeps replaying and never reports finished
+    const QString path = writeCapture("loop.ngcap", evenlySpaced(5, 2));
+    ReplayFrameSource replay(path);
+    replay.setSpeed(0);
+    replay.setLoop(true);
+    QSignalSpy finishedSpy(&replay, &ReplayFrameSource::finished);
+
+    QVERIFY(replay.start());
+    QTRY_VERIFY(replay.passesCompleted() >= 3);
+    replay.stop();
+
+    QVERIFY(!replay.isRunning());
+    QCOMPARE(finishedSpy.count(), 0);
+    QVERIFY(replay.framesDelivered() >= quint64(15));
+}
+
+void TestReplayFrameSource::testStopDuringGapIsFast()
+{
+    // The second frame is 60 s away; stop must not wait for it
+    const QString path = writeCapture("gap.ngcap", { 0, 60ULL * 1000000000ULL });
+    ReplayFrameSource replay(path);
+    std::atomic<int> received{0};
+    replay.setFrameHandler([&](uint32_t, const QByteArray &) { ++received; });
+
+    QVERIFY(replay.start());
+    QTRY_COMPARE(received.load(), 1);
+
+    QElapsedTimer timer;
+    timer.start();
+    replay.stop();
+    QVERIFY(timer.elapsed() < 100);
+    QCOMPARE(received.load(), 1);
+}
+
+// =============================================================================
+// Test Entry Point
+// =============================================================================
+
+QTEST_MAIN(TestReplayFrameSource)
+#include "test_replayframesource.moc"
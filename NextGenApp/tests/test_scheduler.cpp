@@ -0,0 +1,229 @@
+/**
+ * @file test_scheduler.cpp
+ * @brief Unit tests for the Scheduler class.
+ *
+ * This file contains unit tests for the Scheduler deadline service which
+ * replaces individual periodic QTimers with a single coalescing timer.
+ *
+ * The tests cover:
+ * - Idle behaviour (no timer armed without tasks)
+ * - One-shot and periodic task execution
+ * - Coalescing of deadlines within the tolerance window
+ * - Cancellation, including from inside a running task
+ * - Restarting deadlines (watchdog / debounce pattern)
+ * - Wall-clock aligned tasks
+ *
+ * @author Gangadhar Thalange
+ * @date 2026-10-18
+ */
+
+#include <QtTest/QtTest>
+#include "scheduler.h"
+
+/**
+ * @class TestScheduler
+ * @brief Test fixture for Scheduler unit tests.
+ *
+ * Each test creates its own Scheduler so tests do not share deadlines.
+ */
+class TestScheduler : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    /**
+     * @brief Verify a new scheduler has no timer armed.
+     */
+    void testIdleHasNoWakeup();
+
+    /**
+     * @brief Verify a one-shot task runs once and is removed.
+     */
+    void testScheduleOnce();
+
+    /**
+     * @brief Verify a periodic task runs repeatedly.
+     */
+    void testSchedulePeriodic();
+
+    /**
+     * @brief Verify tasks within tolerance share a single wakeup.
+     */
+    void testCoalescedDeadlines();
+
+    /**
+     * @brief Verify cancelling the last task disarms the timer.
+     */
+    void testCancelDisarms();
+
+    /**
+     * @brief Verify a task may cancel itself while running.
+     */
+    void testCancelFromTask();
+
+    /**
+     * @brief Verify restart() pushes a one-shot deadline out.
+     */
+    void testRestartPostponesDeadline();
+
+    /**
+     * @brief Verify wall-clock aligned tasks are armed for the next boundary.
+     */
+    void testWallClockAligned();
+
+    /**
+     * @brief Verify invalid arguments are rejected.
+     */
+    void testInvalidArguments();
+};
+
+// =============================================================================
+// Idle Tests
+// =============================================================================
+
+void TestScheduler::testIdleHasNoWakeup()
+{
+    // An empty scheduler must not keep a timer running
+    Scheduler scheduler;
+    QCOMPARE(scheduler.taskCount(), 0);
+    QCOMPARE(scheduler.msecsToNextWakeup(), qint64(-1));
+}
+
+// =============================================================================
+// Execution Tests
+// =============================================================================
+
+void TestScheduler::testScheduleOnce()
+{
+    // One-shot tasks run once and are then forgotten
+    Scheduler scheduler;
+    int runs = 0;
+    Scheduler::TaskId id = scheduler.scheduleOnce(10, [&runs]() { ++runs; });
+    QVERIFY(id != 0);
+    QVERIFY(scheduler.isScheduled(id));
+
+    QTRY_COMPARE(runs, 1);
+    QVERIFY(!scheduler.isScheduled(id));
+    QCOMPARE(scheduler.msecsToNextWakeup(), qint64(-1));
+
+    QTest::qWait(30);
+    QCOMPARE(runs, 1);
+}
+
+void TestScheduler::testSchedulePeriodic()
+{
+    // Periodic tasks keep running until cancelled
+    Scheduler scheduler;
+    int runs = 0;
+    Scheduler::TaskId id = scheduler.schedulePeriodic(10, [&runs]() { ++runs; });
+
+    QTRY_VERIFY(runs >= 3);
+    QVERIFY(scheduler.isScheduled(id));
+    QVERIFY(scheduler.cancel(id));
+}
+
+void TestScheduler::testCoalescedDeadlines()
+{
+    // A task due 20 ms after another, with 30 ms tolerance, runs on the
+    // same wakeup as the first one
+    Scheduler scheduler;
+    int first = 0;
+    int second = 0;
+    scheduler.scheduleOnce(20, [&first]() { ++first; });
+    scheduler.scheduleOnce(40, [&second]() { ++second; }, 30);
+
+    QTRY_COMPARE(first, 1);
+    QCOMPARE(second, 1);
+    QCOMPARE(scheduler.wakeupCount(), quint64(1));
+    QCOMPARE(scheduler.taskCount(), 0);
+}
+
+// =============================================================================
+// Cancellation Tests
+// =============================================================================
+
+void TestScheduler::testCancelDisarms()
+{
+    // Removing the only task must leave the scheduler fully idle
+    Scheduler scheduler;
+    Scheduler::TaskId id = scheduler.schedulePeriodic(1000, []() {});
+    QVERIFY(scheduler.msecsToNextWakeup() >= 0);
+
+    QVERIFY(scheduler.cancel(id));
+    QCOMPARE(scheduler.msecsToNextWakeup(), qint64(-1));
+    QVERIFY(!scheduler.cancel(id));
+}
+
+void TestScheduler::testCancelFromTask()
+{
+    // A periodic task can stop itself from within its callback
+    Scheduler scheduler;
+    int runs = 0;
+    Scheduler::TaskId id = 0;
+    id = scheduler.schedulePeriodic(5, [&]() {
+        if (++runs == 2)
+            scheduler.cancel(id);
+    });
+
+    QTRY_COMPARE(runs, 2);
+    QTest::qWait(30);
+    QCOMPARE(runs, 2);
+    QCOMPARE(scheduler.taskCount(), 0);
+}
+
+// =============================================================================
+// Restart Tests
+// =============================================================================
+
+void TestScheduler::testRestartPostponesDeadline()
+{
+    // Restarting a watchdog before it expires keeps it from firing
+    Scheduler scheduler;
+    int expired = 0;
+    Scheduler::TaskId id = scheduler.scheduleOnce(60, [&expired]() { ++expired; });
+
+    for (int i = 0; i < 5; ++i) {
+        QTest::qWait(20);
+        QVERIFY(scheduler.restart(id));
+    }
+    QCOMPARE(expired, 0);
+
+    QTRY_COMPARE(expired, 1);
+    QVERIFY(!scheduler.restart(id));
+}
+
+// =============================================================================
+// Wall Clock Tests
+// =============================================================================
+
+void TestScheduler::testWallClockAligned()
+{
+    // A 1 s aligned task is armed for no later than the next full second
+    Scheduler scheduler;
+    int runs = 0;
+    scheduler.scheduleWallClockAligned(1000, [&runs]() { ++runs; });
+    QVERIFY(scheduler.msecsToNextWakeup() <= 1000 + 20);
+
+    QTRY_VERIFY_WITH_TIMEOUT(runs >= 1, 2000);
+}
+
+// =============================================================================
+// Argument Validation Tests
+// =============================================================================
+
+void TestScheduler::testInvalidArguments()
+{
+    // Zero periods and empty callbacks are refused with id 0
+    Scheduler scheduler;
+    QCOMPARE(scheduler.schedulePeriodic(0, []() {}), Scheduler::TaskId(0));
+    QCOMPARE(scheduler.scheduleWallClockAligned(-1, []() {}), Scheduler::TaskId(0));
+    QCOMPARE(scheduler.scheduleOnce(10, Scheduler::Task()), Scheduler::TaskId(0));
+    QCOMPARE(scheduler.taskCount(), 0);
+}
+
+// =============================================================================
+// Test Entry Point
+// =============================================================================
+
+QTEST_MAIN(TestScheduler)
+#include "test_scheduler.moc"
@@ -0,0 +1,239 @@
+/**
+ * @file test_settingsservice.cpp
+ * @brief Unit tests for the SettingsService cached settings store.
+ *
+ * QSettings files are redirected to a temporary directory, and every test
+ * uses its own application name. Files are checked with a separate
+ * QSettings object.
+ *
+ * The tests cover:
+ * - Values are loaded once, including grouped keys
+ * - Changes are visible at once and written after the debounce time,
+ *   many changes in one write
+ * - flush(), remove() and the destructor write pending changes
+ * - Unchanged values are not written
+ * - Readers on other threads see changes in order
+ *
+ * @author Gangadhar Thalange
+ * @date 2026-10-18
+ */
+
+#include <QtTest/QtTest>
+#include <QSettings>
+#include <QTemporaryDir>
+#include <atomic>
+#include <thread>
+#include <vector>
+#include "settingsservice.h"
+
+static const char *const TEST_ORG = "NgSettingsTest";
+
+/**
+ * @class TestSettingsService
+ * @brief Test fixture for SettingsService.
+ */
+class TestSettingsService : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    /**
+     * @brief Redirects QSettings to a temporary directory.
+     */
+    void initTestCase();
+
+    /**
+     * @brief Verify existing values are loaded.
+     */
+    void testLoadsExistingValues();
+
+    /**
+     * @brief Verify changes are written once after the debounce time.
+     */
+    void testWriteIsDebounced();
+
+    /**
+     * @brief Verify flush() writes at once.
+     */
+    void testFlush();
+
+    /**
+     * @brief Verify removed keys are removed from the file.
+     */
+    void testRemove();
+
+    /**
+     * @brief Verify the destructor writes pending changes.
+     */
+    void testDestructorFlushes();
+
+    /**
+     * @brief Verify setting the current value does not queue a write.
+     */
+    void testUnchangedValueNotWritten();
+
+    /**
+     * @brief Verify readers on other threads see the changes in order.
+     */
+    void testConcurrentReaders();
+
+private:
+    /**
+     * @brief Reads @p key from the settings file of @p application.
+     */
+    static QVariant stored(const QString &application, const QString &key);
+
+    QTemporaryDir m_dir;
+};
+
+// =============================================================================
+// Helpers
+// =============================================================================
+
+QVariant TestSettingsService::stored(const QString &application, const QString &key)
+{
+    QSettings settings(TEST_ORG, application);
+    settings.sync();
+    return settings.value(key);
+}
+
+// =============================================================================
+// Setup / Teardown
+// =============================================================================
+
+void TestSettingsService::initTestCase()
+{
+    QVERIFY(m_dir.isValid());
+    QSettings::setPath(QSettings::NativeFormat, QSettings::UserScope, m_dir.path());
+    QSettings::setPath(QSettings::IniFormat, QSettings::UserScope, m_dir.path());
+}
+
+// =============================================================================
+// Tests
+// =============================================================================
+
+void TestSettingsService::testLoadsExistingValues()
+{
+    {
+        QSettings settings(TEST_ORG, "Load");
+        settings.setValue("dbVersion", 7);
+        settings.setValue("Threads/ingest/cpu", 2);
+    }
+    SettingsService service(TEST_ORG, "Load");
+    QCOMPARE(service.value("dbVersion", -1).toInt(), 7);
+    QCOMPARE(service.value("Threads/ingest/cpu", -1).toInt(), 2);
+    QCOMPARE(service.value("missing", -1).toInt(), -1);
+    QVERIFY(service.contains("dbVersion"));
+    QVERIFY(!service.contains("missing"));
+    QCOMPARE(service.syncCount(), quint64(0));
+}
+
+void TestSettingsService::testWriteIsDebounced()
+{
+    SettingsService service(TEST_ORG, "Debounce");
+    service.setDebounceMs(200);
+    for (int i = 1; i <= 100; ++i)
+        service.setValue("EngineHours", i / 10.0);
+
+    QCOMPARE(service.value("EngineHours").toDouble(), 10.0);
+    QVERIFY(!stored("Debounce", "EngineHours").isValid());
+    QCOMPARE(service.pendingCount(), 1);
+
+    QTRY_COMPARE(service.syncCount(), quint64(1));
+    QCOMPARE(service.pendingCount(), 0);
+    QCOMPARE(stored("Debounce", "EngineHours").toDouble(), 10.0);
+}
+
+void TestSettingsService::testFlush()
+{
+    SettingsService service(TEST_ORG, "Flush");
+    service.setDebounceMs(60000);
+    service.setValue("probeDbVersion", 3);
+    QCOMPARE(service.pendingCount(), 1);
+
+    service.flush();
+    QCOMPARE(service.pendingCount(), 0);
+    QCOMPARE(service.syncCount(), quint64(1));
+    QCOMPARE(stored("Flush", "probeDbVersion").toInt(), 3);
+
+    // Nothing pending: no write
+    service.flush();
+    QCOMPARE(service.syncCount(), quint64(1));
+}
+
+void TestSettingsService::testRemove()
+{
+    {
+        QSettings settings(TEST_ORG, "Remove");
+        settings.setValue("obsolete", true);
+    }
+    SettingsService service(TEST_ORG, "Remove");
+    service.setDebounceMs(60000);
+    QVERIFY(service.contains("obsolete"));
+    service.remove("obsolete");
+    QVERIFY(!service.contains("obsolete"));
+
+    service.flush();
+    QVERIFY(!stored("Remove", "obsolete").isValid());
+}
+
+void TestSettingsService::testDestructorFlushes()
+{
+    {
+        SettingsService service(TEST_ORG, "Shutdown");
+        service.setDebounceMs(60000);
+        service.setValue("dbVersion", 11);
+    }
+    QCOMPARE(stored("Shutdown", "dbVersion").toInt(), 11);
+}
+
+void TestSettingsService::testUnchangedValueNotWritten()
+{
+    {
+        QSettings settings(TEST_ORG, "Unchanged");
+        settings.setValue("dbVersion", 5);
+    }
+    SettingsService service(TEST_ORG, "Unchanged");
+    service.setValue("dbVersion", 5);
+    service.remove("missing");
+    QCOMPARE(service.pendingCount(), 0);
+}
+
+void TestSettingsService::testConcurrentReaders()
+{
+    SettingsService service(TEST_ORG, "Readers");
+    service.setDebounceMs(50);
+    service.setValue("counter", 0);
+
+    std::atomic<bool> stop{false};
+    std::atomic<int> outOfOrder{0};
+    std::vector<std::thread> readers;
+    for (int t = 0; t < 4; ++t) {
+        readers.emplace_back([&]() {
+            int last = 0;
+            while (!stop.load()) {
+                const int value = service.value("counter", -1).toInt();
+                if (value < last)
+                    outOfOrder.fetch_add(1);
+                last = value;
+            }
+        });
+    }
+    for (int i = 1; i <= 2000; ++i)
+        service.setValue("counter", i);
+    stop.store(true);
+    for (std::thread &reader : readers)
+        reader.join();
+
+    QCOMPARE(outOfOrder.load(), 0);
+    QCOMPARE(service.value("counter").toInt(), 2000);
+    service.flush();
+    QCOMPARE(stored("Readers", "counter").toInt(), 2000);
+}
+
+// =============================================================================
+// Test Entry Point
+// =============================================================================
+
+QTEST_MAIN(TestSettingsService)
+#include "test_settingsservice.moc"
@@ -0,0 +1,223 @@
+/**
+ * @file test_signalgraph.cpp
+ * @brief Unit tests for the SignalGraph derived-signal graph.
+ *
+ * The tests cover:
+ * - Derived values are computed when added
+ * - set() marks only the dependents of the input; nothing is computed
+ *   before update()
+ * - Each dirty signal is computed once per cycle, in dependency order
+ * - Notifications fire once per cycle and only for changed values; an
+ *   unchanged value stops the propagation
+ * - set() from a notify callback takes effect in the next cycle
+ * - Invalid inputs are rejected
+ *
+ * @author Gangadhar Thalange
+ * @date 2026-10-18
+ */
+
+#include <QtTest/QtTest>
+#include "signalgraph.h"
+
+/**
+ * @class TestSignalGraph
+ * @brief Test fixture for SignalGraph.
+ */
+class TestSignalGraph : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    /**
+     * @brief Verify derived values are computed when added.
+     */
+    void testInitialValue();
+
+    /**
+     * @brief Verify only the dependents of a changed input are computed.
+     */
+    void testOnlyDependentsRecomputed();
+
+    /**
+     * @brief Verify many changes in one cycle cost one computation.
+     */
+    void testOncePerCycle();
+
+    /**
+     * @brief Verify a diamond is computed once, after both branches.
+     */
+    void testDependencyOrder();
+
+    /**
+     * @brief Verify unchanged values neither notify nor propagate.
+     */
+    void testNotifyOnlyOnChange();
+
+    /**
+     * @brief Verify set() from a notify callback waits for the next cycle.
+     */
+    void testSetFromNotify();
+
+    /**
+     * @brief Verify invalid ids are rejected.
+     */
+    void testInvalidIds();
+};
+
+// =============================================================================
+// Tests
+// =============================================================================
+
+void TestSignalGraph::testInitialValue()
+{
+    SignalGraph graph;
+    const SignalGraph::SignalId engine = graph.addInput(120.5);
+    const SignalGraph::SignalId reset = graph.addInput(100.0);
+    const SignalGraph::SignalId trip = graph.addDerived(
+        { engine, reset }, [&]() { return graph.value(engine) - graph.value(reset); });
+
+    QCOMPARE(graph.value(trip), 20.5);
+    QCOMPARE(graph.size(), 3);
+    QVERIFY(!graph.isDirty());
+    QCOMPARE(graph.update(), 0);
+}
+
+void TestSignalGraph::testOnlyDependentsRecomputed()
+{
+    SignalGraph graph;
+    int doubledComputes = 0;
+    int negatedComputes = 0;
+    const SignalGraph::SignalId a = graph.addInput(1.0);
+    const SignalGraph::SignalId b = graph.addInput(2.0);
+    const SignalGraph::SignalId doubled = graph.addDerived(
+        { a }, [&]() { ++doubledComputes; return graph.value(a) * 2.0; });
+    const SignalGraph::SignalId negated = graph.addDerived(
+        { b }, [&]() { ++negatedComputes; return -graph.value(b); });
+    doubledComputes = negatedComputes = 0;
+
+    graph.set(a, 5.0);
+    QVERIFY(graph.isDirty());
+    QCOMPARE(doubledComputes, 0);
+    QCOMPARE(graph.value(doubled), 2.0);
+
+    graph.update();
+    QCOMPARE(doubledComputes, 1);
+    QCOMPARE(negatedComputes, 0);
+    QCOMPARE(graph.value(doubled), 10.0);
+    QCOMPARE(graph.value(negated), -2.0);
+
+    // Setting the same value is no change
+    graph.set(a, 5.0);
+    QVERIFY(!graph.isDirty());
+}
+
+void TestSignalGraph::testOncePerCycle()
+{
+    SignalGraph graph;
+    int notified = 0;
+    const SignalGraph::SignalId input = graph.addInput();
+    graph.addDerived({ input }, [&]() { return graph.value(input) + 1.0; },
+                     [&](double) { ++notified; });
+    const quint64 before = graph.computeCount();
+
+    for (int i = 1; i <= 100; ++i)
+        graph.set(input, i);
+    QCOMPARE(graph.update(), 2);
+    QCOMPARE(graph.computeCount() - before, quint64(1));
+    QCOMPARE(notified, 1);
+}
+
+void TestSignalGraph::testDependencyOrder()
+{
+    SignalGraph graph;
+    QList<double> sums;
+    const SignalGraph::SignalId a = graph.addInput(1.0);
+    const SignalGraph::SignalId b = graph.addDerived({ a }, [&]() { return graph.value(a) + 1.0; });
+    const SignalGraph::SignalId c = graph.addDerived({ a }, [&]() { return graph.value(a) * 10.0; });
+    const SignalGraph::SignalId d = graph.addDerived(
+        { b, c }, [&]() { return graph.value(b) + graph.value(c); },
+        [&](double value) { sums.append(value); });
+    QCOMPARE(graph.value(d), 12.0);
+    const quint64 before = graph.computeCount();
+
+    graph.set(a, 2.0);
+    graph.update();
+    // b, c and d once each; d saw both new inputs
+    QCOMPARE(graph.computeCount() - before, quint64(3));
+    QCOMPARE(sums, QList<double>({ 23.0 }));
+}
+
+void TestSignalGraph::testNotifyOnlyOnChange()
+{
+    SignalGraph graph;
+    int clampedNotified = 0;
+    int downstreamComputes = 0;
+    const SignalGraph::SignalId engine = graph.addInput(10.0);
+    const SignalGraph::SignalId reset = graph.addInput(20.0);
+    const SignalGraph::SignalId trip = graph.addDerived(
+        { engine, reset }, [&]() { return qMax(0.0, graph.value(engine) - graph.value(reset)); },
+        [&](double) { ++clampedNotified; });
+    graph.addDerived({ trip }, [&]() { ++downstreamComputes; return graph.value(trip) * 60.0; });
+    downstreamComputes = 0;
+
+    // Still below the reset: trip stays 0
+    graph.set(engine, 15.0);
+    graph.update();
+    QCOMPARE(graph.value(trip), 0.0);
+    QCOMPARE(clampedNotified, 0);
+    QCOMPARE(downstreamComputes, 0);
+
+    graph.set(engine, 25.0);
+    graph.update();
+    QCOMPARE(graph.value(trip), 5.0);
+    QCOMPARE(clampedNotified, 1);
+    QCOMPARE(downstreamComputes, 1);
+
+    // Both inputs move together: same difference
+    graph.set(engine, 30.0);
+    graph.set(reset, 25.0);
+    graph.update();
+    QCOMPARE(clampedNotified, 1);
+    QCOMPARE(downstreamComputes, 1);
+}
+
+void TestSignalGraph::testSetFromNotify()
+{
+    SignalGraph graph;
+    const SignalGraph::SignalId input = graph.addInput();
+    const SignalGraph::SignalId echo = graph.addInput();
+    graph.addInput(0.0);
+    const SignalGraph::SignalId derived = graph.addDerived(
+        { input }, [&]() { return graph.value(input) * 2.0; },
+        [&](double value) { graph.set(echo, value); });
+
+    graph.set(input, 4.0);
+    graph.update();
+    QCOMPARE(graph.value(derived), 8.0);
+    QCOMPARE(graph.value(echo), 8.0);
+    // The echo input is pending for the next cycle
+    QVERIFY(graph.isDirty());
+    QCOMPARE(graph.update(), 1);
+    QVERIFY(!graph.isDirty());
+}
+
+void TestSignalGraph::testInvalidIds()
+{
+    SignalGraph graph;
+    const SignalGraph::SignalId input = graph.addInput(1.0);
+    QCOMPARE(graph.addDerived({ input, 7 }, []() { return 0.0; }), -1);
+    QCOMPARE(graph.size(), 1);
+
+    const SignalGraph::SignalId derived = graph.addDerived({ input }, [&]() { return graph.value(input); });
+    graph.set(derived, 42.0);
+    QVERIFY(!graph.isDirty());
+    QCOMPARE(graph.value(derived), 1.0);
+    QCOMPARE(graph.value(99), 0.0);
+}
+
+// =============================================================================
+// Test Entry Point
+// =============================================================================
+
+QTEST_MAIN(TestSignalGraph)
+#include "test_signalgraph.moc"
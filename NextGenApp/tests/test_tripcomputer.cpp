@@ -0,0 +1,279 @@
+/**
+ * @file test_tripcomputer.cpp
+ * @brief Unit tests for the TripComputer and RollingAverage classes.
+ *
+ * Frames are fed with explicit monotonic time stamps, so simulated hours
+ * run in milliseconds.
+ *
+ * The tests cover:
+ * - Fuel usage depends on elapsed time, not on the frame rate or on
+ *   whether the value changed
+ * - Changing rates are integrated with the trapezoidal rule
+ * - Intervals longer than the maximum gap are not integrated
+ * - A clock that restarts (looping replay) starts the samples over
+ * - DEF usage integration
+ * - Engine load averages over a sliding window
+ * - RollingAverage window expiry and reset
+ * - Seeding the counters after a trip reset or restore
+ *
+ * @author Gangadhar Thalange
+ * @date 2026-10-18
+ */
+
+#include <QtTest/QtTest>
+#include "constants.h"
+#include "tripcomputer.h"
+
+static constexpr qint64 NS_PER_S = 1000000000LL;
+static constexpr qint64 NS_PER_MS = 1000000LL;
+
+// Aligned to 10 s, the bucket length of a 10 minute window
+static constexpr qint64 START_NS = 1000 * NS_PER_S;
+
+/**
+ * @class TestTripComputer
+ * @brief Test fixture for TripComputer and RollingAverage.
+ */
+class TestTripComputer : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    /**
+     * @brief Verify fuel usage does not depend on the frame rate.
+     */
+    void testFuelUsageIndependentOfFrameRate();
+
+    /**
+     * @brief Verify a linear ramp is integrated exactly.
+     */
+    void testTrapezoidalIntegration();
+
+    /**
+     * @brief Verify intervals longer than the maximum gap are skipped.
+     */
+    void testGapNotIntegrated();
+
+    /**
+     * @brief Verify time running backwards is not integrated.
+     */
+    void testClockRestart();
+
+    /**
+     * @brief Verify DEF usage is integrated over time.
+     */
+    void testDefUsage();
+
+    /**
+     * @brief Verify the engine load average over its window.
+     */
+    void testEngineLoadAverage();
+
+    /**
+     * @brief Verify RollingAverage expiry and reset.
+     */
+    void testRollingAverage();
+
+    /**
+     * @brief Verify the setters seed and reset the results.
+     */
+    void testSeedAndReset();
+
+    /**
+     * @brief Verify unrelated and short frames are ignored.
+     */
+    void testUnrelatedFramesIgnored();
+
+private:
+    /**
+     * @brief Returns a payload with @p raw in bytes 6 and 7.
+     */
+    static QByteArray frame(int raw);
+
+    /**
+     * @brief Feeds @p raw on @p id every @p periodMs for @p durationMs.
+     *
+     * @return Time stamp of the last frame.
+     */
+    static qint64 feed(TripComputer &computer, uint32_t id, int raw,
+                       qint64 startNs, qint64 periodMs, qint64 durationMs);
+};
+
+// =============================================================================
+// Helpers
+// =============================================================================
+
+QByteArray TestTripComputer::frame(int raw)
+{
+    QByteArray payload(8, 0);
+    payload[6] = char((raw >> 8) & 0xFF);
+    payload[7] = char(raw & 0xFF);
+    return payload;
+}
+
+qint64 TestTripComputer::feed(TripComputer &computer, uint32_t id, int raw,
+                              qint64 startNs, qint64 periodMs, qint64 durationMs)
+{
+    const QByteArray payload = frame(raw);
+    qint64 t = startNs;
+    for (qint64 elapsed = 0; elapsed <= durationMs; elapsed += periodMs) {
+        t = startNs + elapsed * NS_PER_MS;
+        computer.onFrame(id, payload, t);
+    }
+    return t;
+}
+
+// =============================================================================
+// Tests
+// =============================================================================
+
+void TestTripComputer::testFuelUsageIndependentOfFrameRate()
+{
+    // 200 * 0.05 = 10 L/h for one hour
+    TripComputer fast;
+    feed(fast, CAN_ID_FUELRATE, 200, START_NS, 50, 3600 * 1000);
+    TripComputer slow;
+    feed(slow, CAN_ID_FUELRATE, 200, START_NS, 1000, 3600 * 1000);
+
+    QVERIFY(qAbs(fast.results().fuelUsage - 10.0) < 1e-6);
+    QVERIFY(qAbs(slow.results().fuelUsage - 10.0) < 1e-6);
+    QCOMPARE(fast.results().frames, quint64(72001));
+    QVERIFY(qAbs(fast.results().avgFuelRate - 10.0) < 1e-9);
+}
+
+void TestTripComputer::testTrapezoidalIntegration()
+{
+    // Rate ramps from 0 to 20 L/h over one hour: 10 L
+    TripComputer computer;
+    for (int s = 0; s <= 3600; ++s)
+        computer.onFrame(CAN_ID_FUELRATE, frame(s * 400 / 3600), START_NS + s * NS_PER_S);
+    // The raw value is rounded down to whole bits
+    QVERIFY(qAbs(computer.results().fuelUsage - 10.0) < 0.03);
+
+    // One interval from 0 to 20 L/h within 1 s
+    TripComputer step;
+    step.onFrame(CAN_ID_FUELRATE, frame(0), START_NS);
+    step.onFrame(CAN_ID_FUELRATE, frame(400), START_NS + NS_PER_S);
+    QVERIFY(qAbs(step.results().fuelUsage - 10.0 / 3600.0) < 1e-12);
+}
+
+void TestTripComputer::testGapNotIntegrated()
+{
+    TripComputer computer;
+    computer.setMaxGapMs(2000);
+    computer.onFrame(CAN_ID_FUELRATE, frame(200), START_NS);
+    computer.onFrame(CAN_ID_FUELRATE, frame(200), START_NS + 10 * NS_PER_S);
+    QCOMPARE(computer.results().fuelUsage, 0.0);
+    QCOMPARE(computer.results().gaps, quint64(1));
+
+    // Integration resumes after the gap
+    computer.onFrame(CAN_ID_FUELRATE, frame(200), START_NS + 11 * NS_PER_S);
+    QVERIFY(qAbs(computer.results().fuelUsage - 10.0 / 3600.0) < 1e-12);
+}
+
+void TestTripComputer::testClockRestart()
+{
+    // One hour at 10 L/h, then a replay loop restarts at the first frame
+    TripComputer computer;
+    const qint64 end = feed(computer, CAN_ID_FUELRATE, 200, START_NS, 1000, 3600 * 1000);
+    feed(computer, CAN_ID_ENGINELOAD, 50, end, 1000, 10 * 1000);
+    const quint64 gaps = computer.results().gaps;
+
+    feed(computer, CAN_ID_FUELRATE, 200, START_NS, 1000, 3600 * 1000);
+    QVERIFY(qAbs(computer.results().fuelUsage - 20.0) < 1e-6);
+    QCOMPARE(computer.results().gaps, gaps + 1);
+    // The load average started over and has no sample yet
+    QVERIFY(!computer.results().hasEngineLoad);
+    QVERIFY(qAbs(computer.results().avgFuelRate - 10.0) < 1e-9);
+}
+
+void TestTripComputer::testDefUsage()
+{
+    TripComputer computer;
+    feed(computer, CAN_ID_DEFRATE, 3, START_NS, 100, 1800 * 1000);
+    QVERIFY(qAbs(computer.results().defUsage - 1.5) < 1e-6);
+    QCOMPARE(computer.results().fuelUsage, 0.0);
+}
+
+void TestTripComputer::testEngineLoadAverage()
+{
+    TripComputer computer;
+    computer.setEngineLoadWindowMs(600 * 1000);
+    QVERIFY(!computer.results().hasEngineLoad);
+
+    // 5 minutes at 40 %, 5 minutes at 80 %
+    qint64 t = feed(computer, CAN_ID_ENGINELOAD, 40, START_NS, 1000, 300 * 1000);
+    t = feed(computer, CAN_ID_ENGINELOAD, 80, t + NS_PER_S, 1000, 299 * 1000);
+    QVERIFY(computer.results().hasEngineLoad);
+    const double expected = (300 * 40.0 + 60.0 + 299 * 80.0) / 600.0;
+    QVERIFY(qAbs(computer.results().avgEngineLoad - expected) < 1e-9);
+
+    // The 40 % minutes leave the window
+    feed(computer, CAN_ID_ENGINELOAD, 80, t + NS_PER_S, 1000, 599 * 1000);
+    QVERIFY(qAbs(computer.results().avgEngineLoad - 80.0) < 1e-9);
+}
+
+void TestTripComputer::testRollingAverage()
+{
+    RollingAverage average(10 * NS_PER_S, 10);
+    QVERIFY(average.isEmpty());
+    QCOMPARE(average.average(), 0.0);
+
+    average.add(10.0, START_NS, START_NS + 5 * NS_PER_S);
+    average.add(30.0, START_NS + 5 * NS_PER_S, START_NS + 10 * NS_PER_S);
+    QVERIFY(qAbs(average.average() - 20.0) < 1e-9);
+    QCOMPARE(average.coveredNs(), 10 * NS_PER_S);
+
+    // Five seconds later the first five buckets have expired
+    average.add(50.0, START_NS + 10 * NS_PER_S, START_NS + 15 * NS_PER_S);
+    QVERIFY(qAbs(average.average() - 40.0) < 1e-9);
+
+    // An interval longer than the window replaces everything
+    average.add(7.0, START_NS + 15 * NS_PER_S, START_NS + 60 * NS_PER_S);
+    QVERIFY(qAbs(average.average() - 7.0) < 1e-9);
+    QCOMPARE(average.coveredNs(), 10 * NS_PER_S);
+
+    // A jump far ahead drops the history
+    average.add(3.0, START_NS + 500 * NS_PER_S, START_NS + 501 * NS_PER_S);
+    QVERIFY(qAbs(average.average() - 3.0) < 1e-9);
+
+    average.reset();
+    QVERIFY(average.isEmpty());
+}
+
+void TestTripComputer::testSeedAndReset()
+{
+    TripComputer computer;
+    computer.setFuelUsage(12.5);
+    computer.setDefUsage(2.0);
+    feed(computer, CAN_ID_FUELRATE, 200, START_NS, 1000, 360 * 1000);
+    QVERIFY(qAbs(computer.results().fuelUsage - 13.5) < 1e-9);
+    QCOMPARE(computer.results().defUsage, 2.0);
+
+    feed(computer, CAN_ID_ENGINELOAD, 50, START_NS, 1000, 10 * 1000);
+    QVERIFY(computer.results().hasEngineLoad);
+    computer.resetEngineLoad();
+    QVERIFY(!computer.results().hasEngineLoad);
+    QCOMPARE(computer.results().avgEngineLoad, 0.0);
+
+    // Trip reset
+    computer.setFuelUsage(0.0);
+    QCOMPARE(computer.results().fuelUsage, 0.0);
+}
+
+void TestTripComputer::testUnrelatedFramesIgnored()
+{
+    TripComputer computer;
+    computer.onFrame(CAN_ID_RPM, frame(1500), START_NS);
+    computer.onFrame(CAN_ID_FUELRATE, QByteArray(4, 0), START_NS);
+    computer.onFrame(CAN_ID_FUELRATE, frame(200));
+    QCOMPARE(computer.results().frames, quint64(1));
+    QCOMPARE(computer.results().fuelUsage, 0.0);
+}
+
+// =============================================================================
+// Test Entry Point
+// =============================================================================
+
+QTEST_MAIN(TestTripComputer)
+#include "test_tripcomputer.moc"
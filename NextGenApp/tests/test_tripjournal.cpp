@@ -0,0 +1,295 @@
+/**
+ * @file test_tripjournal.cpp
+ * @brief Unit tests for the TripJournal trip counter journal.
+ *
+ * Every test uses its own journal file in a temporary directory.
+ *
+ * The tests cover:
+ * - A new journal has the fixed size and no state
+ * - The latest state is restored after close, also by read()
+ * - Many changes within the minimum interval end in few writes
+ * - close() writes the pending state
+ * - Appending wraps around without growing the file
+ * - A torn latest record falls back to the one before
+ * - A changed slot count keeps the state
+ * - Restoring a full journal takes well under a millisecond
+ *
+ * @author Gangadhar Thalange
+ * @date 2026-10-18
+ */
+
+#include <QtTest/QtTest>
+#include <QFile>
+#include <QTemporaryDir>
+#include <cstddef>
+#include "tripjournal.h"
+
+/**
+ * @class TestTripJournal
+ * @brief Test fixture for TripJournal.
+ */
+class TestTripJournal : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    /**
+     * @brief Verify a new journal is sized once and holds no state.
+     */
+    void testNewJournal();
+
+    /**
+     * @brief Verify the latest state is restored after reopening.
+     */
+    void testRestoreLatest();
+
+    /**
+     * @brief Verify changes within the minimum interval are coalesced.
+     */
+    void testWritesRateLimited();
+
+    /**
+     * @brief Verify close() writes the pending state.
+     */
+    void testClosePersistsPending();
+
+    /**
+     * @brief Verify the journal wraps around at a fixed size.
+     */
+    void testWrapAround();
+
+    /**
+     * @brief Verify a torn latest record is skipped.
+     */
+    void testTornRecordIgnored();
+
+    /**
+     * @brief Verify a changed slot count keeps the state.
+     */
+    void testSlotCountChange();
+
+    /**
+     * @brief Verify a full journal is restored quickly.
+     */
+    void testRestoreTime();
+
+private:
+    /**
+     * @brief Returns a state with all counters derived from @p n.
+     */
+    static TripJournal::State makeState(int n);
+
+    QTemporaryDir m_dir;
+};
+
+// =============================================================================
+// Helpers
+// =============================================================================
+
+TripJournal::State TestTripJournal::makeState(int n)
+{
+    TripJournal::State state;
+    state.lastTripHours = 1000.0f + n;
+    state.fuelUsage = n * 0.5f;
+    state.defUsage = n * 0.25f;
+    state.lastResetDate = QString("%1/05/2026").arg(1 + n % 28, 2, 10, QChar('0'));
+    return state;
+}
+
+// =============================================================================
+// Tests
+// =============================================================================
+
+void TestTripJournal::testNewJournal()
+{
+    const QString path = m_dir.filePath("new.journal");
+    TripJournal journal;
+    QVERIFY(journal.open(path, 64));
+    QVERIFY(journal.isOpen());
+    QCOMPARE(journal.path(), path);
+
+    TripJournal::State state;
+    QVERIFY(!journal.restore(&state));
+    QCOMPARE(QFileInfo(path).size(),
+             TripJournal::HEADER_SIZE + 64 * qint64(sizeof(TripJournal::Record)));
+    QString error;
+    QVERIFY(!TripJournal::read(path, &state, &error));
+    QVERIFY(!error.isEmpty());
+}
+
+void TestTripJournal::testRestoreLatest()
+{
+    const QString path = m_dir.filePath("restore.journal");
+    {
+        TripJournal journal;
+        QVERIFY(journal.open(path));
+        for (int i = 1; i <= 5; ++i) {
+            journal.record(makeState(i));
+            journal.flush();
+        }
+        QCOMPARE(journal.writeCount(), quint64(5));
+    }
+
+    TripJournal::State state;
+    QVERIFY(TripJournal::read(path, &state));
+    QVERIFY(state == makeState(5));
+
+    TripJournal journal;
+    QVERIFY(journal.open(path));
+    QVERIFY(journal.restore(&state));
+    QVERIFY(state == makeState(5));
+
+    // The restored state is not written again
+    journal.record(makeState(5));
+    journal.flush();
+    QCOMPARE(journal.writeCount(), quint64(0));
+}
+
+void TestTripJournal::testWritesRateLimited()
+{
+    const QString path = m_dir.filePath("ratelimit.journal");
+    TripJournal journal;
+    journal.setMinIntervalMs(300);
+    QVERIFY(journal.open(path));
+
+    // Fuel usage changing with every fuel rate frame
+    QElapsedTimer timer;
+    timer.start();
+    int last = 0;
+    while (timer.elapsed() < 200)
+        journal.record(makeState(++last));
+    QVERIFY(last > 100);
+
+    // The first change is written at once, the rest after the interval
+    const auto stored = [&]() {
+        TripJournal::State state;
+        return TripJournal::read(path, &state) && state == makeState(last);
+    };
+    QTRY_VERIFY(stored());
+    QVERIFY(journal.writeCount() <= 2);
+}
+
+void TestTripJournal::testClosePersistsPending()
+{
+    const QString path = m_dir.filePath("close.journal");
+    {
+        TripJournal journal;
+        journal.setMinIntervalMs(60000);
+        QVERIFY(journal.open(path));
+        journal.record(makeState(1));
+        journal.record(makeState(2));
+    }
+    TripJournal::State state;
+    QVERIFY(TripJournal::read(path, &state));
+    QVERIFY(state == makeState(2));
+}
+
+void TestTripJournal::testWrapAround()
+{
+    const QString path = m_dir.filePath("wrap.journal");
+    const int slots = TripJournal::MIN_SLOTS;
+    {
+        TripJournal journal;
+        QVERIFY(journal.open(path, slots));
+        for (int i = 1; i <= slots * 3 + 5; ++i) {
+            journal.record(makeState(i));
+            journal.flush();
+        }
+    }
+    QCOMPARE(QFileInfo(path).size(),
+             TripJournal::HEADER_SIZE + slots * qint64(sizeof(TripJournal::Record)));
+
+    TripJournal journal;
+    QVERIFY(journal.open(path, slots));
+    TripJournal::State state;
+    QVERIFY(journal.restore(&state));
+    QVERIFY(state == makeState(slots * 3 + 5));
+}
+
+void TestTripJournal::testTornRecordIgnored()
+{
+    const QString path = m_dir.filePath("torn.journal");
+    {
+        TripJournal journal;
+        QVERIFY(journal.open(path));
+        for (int i = 1; i <= 3; ++i) {
+            journal.record(makeState(i));
+            journal.flush();
+        }
+    }
+
+    // A crash in the middle of the third record (slot 2)
+    QFile file(path);
+    QVERIFY(file.open(QIODevice::ReadWrite));
+    const qint64 offset = TripJournal::HEADER_SIZE + 2 * qint64(sizeof(TripJournal::Record))
+            + qint64(offsetof(TripJournal::Record, fuelUsage));
+    QVERIFY(file.seek(offset));
+    QVERIFY(file.write("\xff\xff", 2) == 2);
+    file.close();
+
+    TripJournal journal;
+    QVERIFY(journal.open(path));
+    TripJournal::State state;
+    QVERIFY(journal.restore(&state));
+    QVERIFY(state == makeState(2));
+
+    // The next record replaces the torn one
+    journal.record(makeState(4));
+    journal.flush();
+    QVERIFY(TripJournal::read(path, &state));
+    QVERIFY(state == makeState(4));
+}
+
+void TestTripJournal::testSlotCountChange()
+{
+    const QString path = m_dir.filePath("resize.journal");
+    {
+        TripJournal journal;
+        QVERIFY(journal.open(path, 32));
+        journal.record(makeState(7));
+    }
+
+    TripJournal journal;
+    QVERIFY(journal.open(path, 128));
+    QCOMPARE(QFileInfo(path).size(),
+             TripJournal::HEADER_SIZE + 128 * qint64(sizeof(TripJournal::Record)));
+    TripJournal::State state;
+    QVERIFY(journal.restore(&state));
+    QVERIFY(state == makeState(7));
+    journal.close();
+
+    QVERIFY(TripJournal::read(path, &state));
+    QVERIFY(state == makeState(7));
+}
+
+void TestTripJournal::testRestoreTime()
+{
+    const QString path = m_dir.filePath("full.journal");
+    {
+        TripJournal journal;
+        QVERIFY(journal.open(path));
+        for (int i = 1; i <= TripJournal::DEFAULT_SLOTS + 10; ++i) {
+            journal.record(makeState(i));
+            journal.flush();
+        }
+    }
+
+    TripJournal journal;
+    QVERIFY(journal.open(path));
+    TripJournal::State state;
+    QVERIFY(journal.restore(&state));
+    QVERIFY(state == makeState(TripJournal::DEFAULT_SLOTS + 10));
+    qDebug() << "Restored" << TripJournal::DEFAULT_SLOTS << "slots in"
+             << journal.restoreNsecs() / 1000 << "us";
+    // Typically a few tens of microseconds; the bound leaves room for
+    // loaded CI machines
+    QVERIFY2(journal.restoreNsecs() < 5 * 1000 * 1000,
+             qPrintable(QString("restore took %1 us").arg(journal.restoreNsecs() / 1000)));
+}
+
+// =============================================================================
+// Test Entry Point
+// =============================================================================
+
+QTEST_MAIN(TestTripJournal)
+#include "test_tripjournal.moc"
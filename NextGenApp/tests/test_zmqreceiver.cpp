@@ -0,0 +1,362 @@
+/**
+ * @file test_zmqreceiver.cpp
+ * @brief Unit tests for the ZmqReceiver class.
+ *
+ * This file contains unit tests for the ZMQ ingest thread used by
+ * AppInterface. A local PUB socket on an ephemeral TCP port stands in
+ * for the backend publisher.
+ *
+ * The tests cover:
+ * - Delivery of valid frames to the frame handler
+ * - Rejection of messages shorter than 12 bytes
+ * - Shutdown time of stop() and the destructor (idle and under traffic)
+ * - Restart after stop
+ * - Graceful fallback of unsupported thread settings
+ *
+ * @author Gangadhar Thalange
+ * @date 2026-10-18
+ */
+
+#include <QtTest/QtTest>
+#include <QElapsedTimer>
+#include <atomic>
+#include <memory>
+#include <cstring>
+#include "zmqreceiver.h"
+
+/**
+ * @brief Upper bound for a receiver shutdown in milliseconds.
+ *
+ * The previous implementation needed the full 5 s wait timeout.
+ */
+static constexpr qint64 MAX_SHUTDOWN_MS = 100;
+
+/**
+ * @class TestZmqReceiver
+ * @brief Test fixture for ZmqReceiver unit tests.
+ *
+ * Every test gets a fresh publisher socket bound to an ephemeral port.
+ */
+class TestZmqReceiver : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    /**
+     * @brief Bind the stand-in publisher before each test.
+     */
+    void init();
+
+    /**
+     * @brief Close the stand-in publisher after each test.
+     */
+    void cleanup();
+
+    // =========================================================================
+    // Delivery Tests
+    // =========================================================================
+
+    /**
+     * @brief Verify frames are decoded and passed to the handler.
+     */
+    void testReceivesFrames();
+
+    /**
+     * @brief Verify messages shorter than 12 bytes are dropped.
+     */
+    void testDropsShortMessages();
+
+    // =========================================================================
+    // Shutdown Tests
+    // =========================================================================
+
+    /**
+     * @brief Verify stop() of an idle receiver returns within the bound.
+     */
+    void testStopIdleIsFast();
+
+    /**
+     * @brief Verify stop() right after a burst of frames is fast.
+     */
+    void testStopUnderTrafficIsFast();
+
+    /**
+     * @brief Verify the destructor stops the thread within the bound.
+     */
+    void testDestructorIsFast();
+
+    /**
+     * @brief Verify stop() is fast when no publisher is reachable.
+     */
+    void testStopWithoutPublisherIsFast();
+
+    /**
+     * @brief Verify stop() on a receiver that never started is a no-op.
+     */
+    void testStopBeforeStart();
+
+    /**
+     * @brief Verify a stopped receiver can be started again.
+     */
+    void testRestartAfterStop();
+
+    // =========================================================================
+    // Thread Configuration Tests
+    // =========================================================================
+
+    /**
+     * @brief Verify default settings are reported once the thread runs.
+     */
+    void testDefaultThreadConfigReported();
+
+    /**
+     * @brief Verify an invalid CPU is reported and frames still arrive.
+     */
+    void testInvalidThreadConfigFallsBack();
+
+private:
+    /**
+     * @brief Sends one frame with the given id on the stand-in publisher.
+     */
+    void publish(uint32_t id);
+
+    /**
+     * @brief Publishes until the receiver has seen at least one frame.
+     *
+     * Works around the ZMQ slow-joiner effect of PUB/SUB.
+     */
+    bool waitForSubscription(const std::atomic<int> &received);
+
+    std::unique_ptr<zmq::context_t> m_context;
+    std::unique_ptr<zmq::socket_t> m_publisher;
+    QString m_endpoint;
+};
+
+// =============================================================================
+// Test Lifecycle Methods
+// =============================================================================
+
+void TestZmqReceiver::init()
+{
+    m_context.reset(new zmq::context_t(1));
+    m_publisher.reset(new zmq::socket_t(*m_context, zmq::socket_type::pub));
+    m_publisher->set(zmq::sockopt::linger, 0);
+    m_publisher->bind("tcp://127.0.0.1:*");
+    m_endpoint = QString::fromStdString(m_publisher->get(zmq::sockopt::last_endpoint));
+}
+
+void TestZmqReceiver::cleanup()
+{
+    m_publisher.reset();
+    m_context.reset();
+}
+
+void TestZmqReceiver::publish(uint32_t id)
+{
+    char frame[12] = {};
+    memcpy(frame, &id, sizeof(id));
+    frame[11] = 1;
+    m_publisher->send(zmq::buffer(frame, sizeof(frame)), zmq::send_flags::dontwait);
+}
+
+bool TestZmqReceiver::waitForSubscription(const std::atomic<int> &received)
+{
+    for (int i = 0; i < 200 && received.load() == 0; ++i) {
+        publish(0xDE000400);
+        QTest::qWait(10);
+    }
+    return received.load() > 0;
+}
+
+// =============================================================================
+// Delivery Tests
+// =============================================================================
+
+void TestZmqReceiver::testReceivesFrames()
+{
+    // Valid frames arrive on the handler with id and payload intact
+    ZmqReceiver receiver(m_endpoint);
+    std::atomic<int> received{0};
+    std::atomic<uint32_t> lastId{0};
+    std::atomic<int> lastByte{0};
+    receiver.setFrameHandler([&](uint32_t id, const QByteArray &payload) {
+        lastId = id;
+        lastByte = payload.size() == 8 ? payload.at(7) : -1;
+        ++received;
+    });
+    QVERIFY(receiver.start());
+    QVERIFY(waitForSubscription(received));
+
+    publish(0xDE005000);
+    QTRY_COMPARE(lastId.load(), uint32_t(0xDE005000));
+    QCOMPARE(lastByte.load(), 1);
+}
+
+void TestZmqReceiver::testDropsShortMessages()
+{
+    // Messages shorter than id + payload never reach the handler
+    ZmqReceiver receiver(m_endpoint);
+    std::atomic<int> received{0};
+    std::atomic<uint32_t> lastId{0};
+    receiver.setFrameHandler([&](uint32_t id, const QByteArray &) {
+        lastId = id;
+        ++received;
+    });
+    receiver.start();
+    QVERIFY(waitForSubscription(received));
+
+    const int before = received.load();
+    char shortFrame[6] = {};
+    m_publisher->send(zmq::buffer(shortFrame, sizeof(shortFrame)), zmq::send_flags::none);
+    publish(0xDE001001);
+
+    QTRY_COMPARE(lastId.load(), uint32_t(0xDE001001));
+    QCOMPARE(received.load(), before + 1);
+}
+
+// =============================================================================
+// Shutdown Tests
+// =============================================================================
+
+void TestZmqReceiver::testStopIdleIsFast()
+{
+    // The receive loop sits in poll() with no traffic; stop must wake it
+    ZmqReceiver receiver(m_endpoint);
+    receiver.start();
+    QTRY_VERIFY(receiver.isRunning());
+    QTest::qWait(50);
+
+    QElapsedTimer timer;
+    timer.start();
+    receiver.stop();
+    const qint64 elapsed = timer.elapsed();
+
+    QVERIFY(!receiver.isRunning());
+    QVERIFY2(elapsed < MAX_SHUTDOWN_MS, qPrintable(QString("stop took %1 ms").arg(elapsed)));
+}
+
+void TestZmqReceiver::testStopUnderTrafficIsFast()
+{
+    // Pending frames must not delay shutdown noticeably
+    ZmqReceiver receiver(m_endpoint);
+    std::atomic<int> received{0};
+    receiver.setFrameHandler([&](uint32_t, const QByteArray &) { ++received; });
+    receiver.start();
+    QVERIFY(waitForSubscription(received));
+
+    for (int i = 0; i < 1000; ++i)
+        publish(0xDE004000);
+
+    QElapsedTimer timer;
+    timer.start();
+    receiver.stop();
+    const qint64 elapsed = timer.elapsed();
+
+    QVERIFY(!receiver.isRunning());
+    QVERIFY2(elapsed < MAX_SHUTDOWN_MS, qPrintable(QString("stop took %1 ms").arg(elapsed)));
+}
+
+void TestZmqReceiver::testDestructorIsFast()
+{
+    // Destroying a running receiver joins the thread without terminate()
+    std::unique_ptr<ZmqReceiver> receiver(new ZmqReceiver(m_endpoint));
+    receiver->start();
+    QTRY_VERIFY(receiver->isRunning());
+    QTest::qWait(50);
+
+    QElapsedTimer timer;
+    timer.start();
+    receiver.reset();
+    const qint64 elapsed = timer.elapsed();
+
+    QVERIFY2(elapsed < MAX_SHUTDOWN_MS, qPrintable(QString("destructor took %1 ms").arg(elapsed)));
+}
+
+void TestZmqReceiver::testStopWithoutPublisherIsFast()
+{
+    // Nothing listens on the endpoint: the SUB socket keeps reconnecting,
+    // shutdown must still be immediate
+    m_publisher.reset();
+    ZmqReceiver receiver(m_endpoint);
+    receiver.start();
+    QTRY_VERIFY(receiver.isRunning());
+    QTest::qWait(50);
+
+    QElapsedTimer timer;
+    timer.start();
+    receiver.stop();
+    const qint64 elapsed = timer.elapsed();
+
+    QVERIFY2(elapsed < MAX_SHUTDOWN_MS, qPrintable(QString("stop took %1 ms").arg(elapsed)));
+}
+
+void TestZmqReceiver::testStopBeforeStart()
+{
+    // stop() without start() must neither block nor crash
+    ZmqReceiver receiver(m_endpoint);
+    receiver.stop();
+    QVERIFY(!receiver.isRunning());
+}
+
+void TestZmqReceiver::testRestartAfterStop()
+{
+    // The control socket pair survives a stop/start cycle
+    ZmqReceiver receiver(m_endpoint);
+    std::atomic<int> received{0};
+    receiver.setFrameHandler([&](uint32_t, const QByteArray &) { ++received; });
+
+    receiver.start();
+    QTRY_VERIFY(receiver.isRunning());
+    receiver.stop();
+    QVERIFY(!receiver.isRunning());
+
+    QVERIFY(receiver.start());
+    QVERIFY(waitForSubscription(received));
+    receiver.stop();
+}
+
+// =============================================================================
+// Thread Configuration Tests
+// =============================================================================
+
+void TestZmqReceiver::testDefaultThreadConfigReported()
+{
+    // Nothing requested: applied without errors, no real-time policy
+    ZmqReceiver receiver(m_endpoint);
+    QVERIFY(!receiver.effectiveThreadConfig().applied);
+
+    receiver.start();
+    QTRY_VERIFY(receiver.effectiveThreadConfig().applied);
+
+    const ThreadConfig::Effective effective = receiver.effectiveThreadConfig();
+    QVERIFY(effective.errors.isEmpty());
+    QCOMPARE(effective.policy, ThreadConfig::PolicyDefault);
+    receiver.stop();
+}
+
+void TestZmqReceiver::testInvalidThreadConfigFallsBack()
+{
+    // A CPU that does not exist must not keep the thread from running
+    ZmqReceiver receiver(m_endpoint);
+    ThreadConfig config;
+    config.cpu = 100000;
+    receiver.setThreadConfig(config);
+
+    std::atomic<int> received{0};
+    receiver.setFrameHandler([&](uint32_t, const QByteArray &) { ++received; });
+    receiver.start();
+    QVERIFY(waitForSubscription(received));
+
+    const ThreadConfig::Effective effective = receiver.effectiveThreadConfig();
+    QVERIFY(effective.applied);
+    QVERIFY(!effective.errors.isEmpty());
+    QVERIFY(effective.cpu != 100000);
+    receiver.stop();
+}
+
+// =============================================================================
+// Test Entry Point
+// =============================================================================
+
+QTEST_MAIN(TestZmqReceiver)
+#include "test_zmqreceiver.moc"
@@ -0,0 +1,52 @@
+/**
+ * @file tools/binlog_decode.cpp
+ * @brief Prints binary log files (<log>.bin) as cLogger text lines.
+ *
+ * Usage: binlog_decode <log>.bin.1 <log>.bin ...
+ *
+ * The records of all files are merged in time order, so the rotated
+ * generation and the current file can be passed together. The output can
+ * be interleaved with the text log by sorting on the time stamp.
+ *
+ * @date 18-Oct-2026
+ * @author Gangadhar Thalange
+ */
+
+#include <QCoreApplication>
+#include <QCommandLineParser>
+#include <cstdio>
+#include "../include/binlogreader.h"
+
+int main(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+    QCoreApplication::setApplicationName("binlog_decode");
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Decode NextGenApp binary log files into text log lines.");
+    parser.addHelpOption();
+    parser.addPositionalArgument("files", "Binary log files (<log>.bin).", "<file>...");
+    parser.process(app);
+
+    const QStringList files = parser.positionalArguments();
+    if (files.isEmpty())
+        parser.showHelp(1);
+
+    BinLogReader reader;
+    int result = 0;
+    for (const QString &path : files) {
+        if (!reader.read(path)) {
+            fprintf(stderr, "%s: %s\n", qPrintable(path), qPrintable(reader.errorString()));
+            result = 1;
+        } else if (reader.truncated()) {
+            fprintf(stderr, "%s: truncated, read up to the last complete block\n", qPrintable(path));
+        }
+    }
+
+    for (const BinLogReader::Entry &entry : reader.entries()) {
+        const QByteArray line = reader.formatLine(entry);
+        fwrite(line.constData(), 1, size_t(line.size()), stdout);
+        fputc('\n', stdout);
+    }
+    return result;
+}
@@ -0,0 +1,46 @@
+/**
+ * @file tools/flightrec_dump.cpp
+ * @brief Prints the log lines kept in a flight recorder ring (<log>.ring).
+ *
+ * Usage: flightrec_dump <log>.ring
+ *
+ * Run it after a crash, before the application is started again (a new
+ * process continues the ring and overwrites its oldest lines). The lines
+ * are printed oldest first, as cLogger wrote them.
+ *
+ * @date 18-Oct-2026
+ * @author Gangadhar Thalange
+ */
+
+#include <QCoreApplication>
+#include <QCommandLineParser>
+#include <cstdio>
+#include "../include/flightrecorder.h"
+
+int main(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+    QCoreApplication::setApplicationName("flightrec_dump");
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Print the log lines kept in a NextGenApp flight recorder ring.");
+    parser.addHelpOption();
+    parser.addPositionalArgument("file", "Flight recorder file (<log>.ring).");
+    parser.process(app);
+
+    const QStringList files = parser.positionalArguments();
+    if (files.size() != 1)
+        parser.showHelp(1);
+
+    QString error;
+    const QByteArrayList lines = FlightRecorder::read(files.first(), &error);
+    if (!error.isEmpty()) {
+        fprintf(stderr, "%s: %s\n", qPrintable(files.first()), qPrintable(error));
+        return 1;
+    }
+    for (const QByteArray &line : lines) {
+        fwrite(line.constData(), 1, size_t(line.size()), stdout);
+        fputc('\n', stdout);
+    }
+    return 0;
+}
@@ -0,0 +1,86 @@
+/**
+ * @file tools/logstream_tail.cpp
+ * @brief Prints the live log lines served by cLogger::setLogStreamSocket().
+ *
+ * Usage: logstream_tail [--level <level>] [--module <prefix>]... <socket>
+ *
+ * Connects to the application's log socket (NextGenApp uses
+ * `$XDG_RUNTIME_DIR/NextGenApp.log.sock`), sends the filter and prints
+ * every line received until the application closes the connection. A
+ * client that reads too slowly gets `-- N lines dropped --` lines in
+ * the stream; the application is never slowed down.
+ *
+ * @date 18-Oct-2026
+ * @author Gangadhar Thalange
+ */
+
+#include <QCoreApplication>
+#include <QCommandLineParser>
+#include <QFile>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+int main(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+    QCoreApplication::setApplicationName("logstream_tail");
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Print the live log lines of a running NextGenApp.");
+    parser.addHelpOption();
+    const QCommandLineOption levelOption("level",
+        "Least severe level shown: debug, info, warning, critical or fatal (default debug).",
+        "level", "debug");
+    const QCommandLineOption moduleOption("module",
+        "Show only this logging category or prefix (\"qml\", \"ngapp.ingest\"). Repeatable.", "prefix");
+    parser.addOption(levelOption);
+    parser.addOption(moduleOption);
+    parser.addPositionalArgument("socket", "Log stream socket of the application.");
+    parser.process(app);
+
+    const QStringList sockets = parser.positionalArguments();
+    if (sockets.size() != 1)
+        parser.showHelp(1);
+
+    const QByteArray path = QFile::encodeName(sockets.first());
+    sockaddr_un address;
+    memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+    if (size_t(path.size()) >= sizeof(address.sun_path)) {
+        fprintf(stderr, "%s: path too long\n", path.constData());
+        return 1;
+    }
+    memcpy(address.sun_path, path.constData(), size_t(path.size()));
+
+    const int fd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd < 0 || ::connect(fd, reinterpret_cast<const sockaddr *>(&address), sizeof(address)) != 0) {
+        fprintf(stderr, "%s: %s\n", path.constData(), strerror(errno));
+        return 1;
+    }
+
+    QByteArray filter = "filter " + parser.value(levelOption).toLatin1();
+    for (const QString &module : parser.values(moduleOption))
+        filter += ' ' + module.toLatin1();
+    filter += '\n';
+    if (::write(fd, filter.constData(), size_t(filter.size())) != filter.size()) {
+        fprintf(stderr, "%s: %s\n", path.constData(), strerror(errno));
+        return 1;
+    }
+
+    char buffer[16384];
+    for (;;) {
+        const ssize_t count = ::read(fd, buffer, sizeof(buffer));
+        if (count < 0 && errno == EINTR)
+            continue;
+        if (count <= 0)
+            break;
+        fwrite(buffer, 1, size_t(count), stdout);
+        fflush(stdout);
+    }
+    ::close(fd);
+    return 0;
+}